@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    xpd_async.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Asynchronous Transaction Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_ASYNC_H_
+#define __XPD_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+
+/** @defgroup ASYNC
+ * @brief    Asynchronous driver transactions with a single-threaded executor.
+ *           The driver operations are started and finished by @ref ASYNC_vRun in thread context,
+ *           while the driver callbacks only mark the completion of the active transaction.
+ *           The completion callbacks of the driver handles which are used by transactions
+ *           shall be set to @ref ASYNC_vComplete and @ref ASYNC_vError
+ *           (or @ref ASYNC_vCompleteStatic and @ref ASYNC_vErrorStatic for handle-less drivers),
+ *           and these handles shall not be operated outside of transactions.
+ *           The transactions of a driver handle are executed one at a time by default.
+ *           To let a transmission and a reception of the same handle be active at once
+ *           (e.g. to receive a device's immediate response), the transactions shall specify
+ *           their Direction, and the handle's Transmit and Receive callbacks shall be set to
+ *           @ref ASYNC_vTransmitComplete and @ref ASYNC_vReceiveComplete respectively.
+ *           As the executor queue is traversed by these callbacks, XPD_ENTER_CRITICAL
+ *           shall mask the interrupts of the signalling drivers.
+ * @{ */
+
+/** @defgroup ASYNC_Exported_Types ASYNC Exported Types
+ * @{ */
+
+/** @brief ASYNC transaction states */
+typedef enum
+{
+    ASYNC_STATE_IDLE     = 0, /*!< The transaction is not submitted, or it is finished */
+    ASYNC_STATE_PENDING  = 1, /*!< The transaction waits for its driver handle to be available */
+    ASYNC_STATE_ACTIVE   = 2, /*!< The driver operation of the transaction is in progress */
+    ASYNC_STATE_COMPLETE = 3, /*!< The driver operation is complete, the transaction waits to be finished */
+    ASYNC_STATE_FAILED   = 4  /*!< The driver operation failed, the transaction waits to be finished */
+}ASYNC_StateType;
+
+/** @brief ASYNC transaction direction, the part of the driver handle it occupies */
+typedef enum
+{
+    ASYNC_DIRECTION_BOTH     = 0, /*!< The transaction occupies the whole driver handle */
+    ASYNC_DIRECTION_TRANSMIT = 1, /*!< The transaction only occupies the transmitter */
+    ASYNC_DIRECTION_RECEIVE  = 2  /*!< The transaction only occupies the receiver */
+}ASYNC_DirectionType;
+
+typedef struct ASYNC_Transaction ASYNC_TransactionType;
+
+/** @brief ASYNC driver operation start function type */
+typedef XPD_ReturnType ( *ASYNC_StartType ) ( ASYNC_TransactionType * pxTrans );
+
+/** @brief ASYNC transaction structure */
+struct ASYNC_Transaction
+{
+    ASYNC_StartType         Start;          /*!< Starts the driver operation of the transaction,
+                                                 returns BUSY if it shall be retried later */
+    void *                  Handle;         /*!< The driver handle which signals the completion,
+                                                 NULL for handle-less drivers */
+    ASYNC_DirectionType     Direction;      /*!< The part of the driver handle which is used,
+                                                 transactions with different directions can be
+                                                 active on the same handle at once */
+    void *                  Source;         /*!< Source data of the operation */
+    void *                  Destination;    /*!< Destination of the operation */
+    uint16_t                Length;         /*!< Amount of data, in the unit of the driver function */
+    XPD_HandleCallbackType  Complete;       /*!< Callback with the transaction as parameter,
+                                                 called by the executor when the transaction is finished */
+    ASYNC_TransactionType * Then;           /*!< Transaction to submit when this one is finished */
+    volatile ASYNC_StateType State;         /*!< [Internal] Transaction state */
+    XPD_ReturnType          Result;         /*!< [Internal] Transaction result */
+    ASYNC_TransactionType * volatile Next;  /*!< [Internal] Executor queue link */
+};
+
+/** @} */
+
+/** @addtogroup ASYNC_Exported_Functions
+ * @{ */
+void            ASYNC_vSubmit           (ASYNC_TransactionType * pxTrans);
+ASYNC_TransactionType * ASYNC_pxThen    (ASYNC_TransactionType * pxTrans,
+                                         ASYNC_TransactionType * pxNext);
+
+XPD_ReturnType  ASYNC_eGetStatus        (ASYNC_TransactionType * pxTrans);
+XPD_ReturnType  ASYNC_eWait             (ASYNC_TransactionType * pxTrans,
+                                         uint32_t ulTimeout);
+
+void            ASYNC_vRun              (void);
+
+void            ASYNC_vComplete         (void * pvHandle);
+void            ASYNC_vTransmitComplete (void * pvHandle);
+void            ASYNC_vReceiveComplete  (void * pvHandle);
+void            ASYNC_vError            (void * pvHandle);
+void            ASYNC_vCompleteStatic   (void);
+void            ASYNC_vErrorStatic      (void);
+/** @} */
+
+/** @addtogroup ASYNC_Exported_Functions_Start
+ * @{ */
+#ifndef __XPD_USART_NO_DMA
+XPD_ReturnType  ASYNC_eUSART_Transmit_DMA   (ASYNC_TransactionType * pxTrans);
+XPD_ReturnType  ASYNC_eUSART_Receive_DMA    (ASYNC_TransactionType * pxTrans);
+#endif
+#ifndef __XPD_SPI_NO_DMA
+XPD_ReturnType  ASYNC_eSPI_SendReceive_DMA  (ASYNC_TransactionType * pxTrans);
+#endif
+XPD_ReturnType  ASYNC_eADC_Start_DMA        (ASYNC_TransactionType * pxTrans);
+#if defined(CAN) || defined(CAN1)
+XPD_ReturnType  ASYNC_eCAN_Send_IT          (ASYNC_TransactionType * pxTrans);
+#endif
+XPD_ReturnType  ASYNC_eFLASH_Program_IT     (ASYNC_TransactionType * pxTrans);
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_ASYNC_H_ */
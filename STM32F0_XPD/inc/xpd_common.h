@@ -172,6 +172,22 @@ typedef void ( *XPD_HandleCallbackType )    ( void * Handle );
 #define XPD_SAFE_CALLBACK(CALLBACK, ...)        \
     do{ if ((CALLBACK) != NULL) (void) CALLBACK(__VA_ARGS__); }while(0)
 
+/**
+ * @brief  Defines an interrupt vector handler which is statically bound to a peripheral handle,
+ *         so the driver interrupt handler is called with a constant handle address.
+ *         DMA streams are bound with @ref DMA_IRQ_BIND instead.
+ * @param  VECTOR: the interrupt vector name without the _IRQHandler suffix
+ * @param  IRQ_HANDLER: the driver interrupt handler function
+ * @param  HANDLE: pointer to the peripheral handle
+ *
+ * @code
+ * XPD_IRQ_BIND(USART2, USART_vIRQHandler, &xConsole);
+ * XPD_IRQ_BIND(CAN1_RX0, CAN_vIRQHandlerRX0, &xCanBus);
+ * @endcode
+ */
+#define XPD_IRQ_BIND(VECTOR, IRQ_HANDLER, HANDLE)   \
+    void VECTOR##_IRQHandler(void) { IRQ_HANDLER(HANDLE); }
+
 /** @} */
 
 /** @} */
@@ -220,6 +236,11 @@ typedef void ( *XPD_HandleCallbackType )    ( void * Handle );
 
 #include <xpd_config.h>
 
+#ifndef XPD_FAST_DATA
+/** @brief Placement of the interrupt-hot data owned by the drivers (e.g. EXTI_xPinCallbacks) */
+#define XPD_FAST_DATA
+#endif
+
 #ifdef __cplusplus
 }
 #endif
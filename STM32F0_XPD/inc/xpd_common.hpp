@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file    xpd_common.hpp
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers C++ Common Layer
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_COMMON_HPP_
+#define __XPD_COMMON_HPP_
+
+#if (__cplusplus < 201703L)
+#error "The XPD C++ layer requires C++17."
+#endif
+
+#include <xpd_common.h>
+#include <cstddef>
+#include <type_traits>
+
+/** @defgroup XPD_Cpp XPD C++ Layer
+ * @brief    Header-only templates over the XPD handles, where the peripheral instance
+ *           is a template parameter, so the register addresses are compile-time constants.
+ * @{ */
+
+namespace xpd
+{
+
+/** @defgroup XPD_Cpp_Exported_Types XPD C++ Exported Types
+ * @{ */
+
+/**
+ * @brief Register bit with compile-time address, which is accessed through
+ *        the bit-band alias when the register is in the bit-band region,
+ *        and by read-modify-write otherwise.
+ * @tparam ADDRESS: the register address
+ * @tparam POSITION: the bit position in the register
+ */
+template<uintptr_t ADDRESS, uint8_t POSITION>
+struct reg_bit
+{
+#ifdef PERIPH_BB_BASE
+    static constexpr bool bitband = (ADDRESS >= PERIPH_BASE) && (ADDRESS < (PERIPH_BASE + 0x100000));
+    static constexpr uintptr_t alias = PERIPH_BB_BASE + ((ADDRESS - PERIPH_BASE) << 5) + (POSITION << 2);
+#else
+    static constexpr bool bitband = false;
+    static constexpr uintptr_t alias = 0;
+#endif
+
+    /**
+     * @brief Writes the register bit.
+     * @param value: the new bit value
+     */
+    static void write(bool value)
+    {
+        if constexpr (bitband)
+        {
+            *reinterpret_cast<volatile uint32_t *>(alias) = value;
+        }
+        else if (value)
+        {
+            SET_BIT(*reinterpret_cast<volatile uint32_t *>(ADDRESS), 1UL << POSITION);
+        }
+        else
+        {
+            CLEAR_BIT(*reinterpret_cast<volatile uint32_t *>(ADDRESS), 1UL << POSITION);
+        }
+    }
+
+    /**
+     * @brief Reads the register bit.
+     * @return The current bit value
+     */
+    static bool read()
+    {
+        if constexpr (bitband)
+        {
+            return *reinterpret_cast<volatile uint32_t *>(alias) != 0;
+        }
+        else
+        {
+            return (*reinterpret_cast<volatile uint32_t *>(ADDRESS) & (1UL << POSITION)) != 0;
+        }
+    }
+};
+
+/** @brief Empty event set, the handle's callbacks are left untouched */
+struct no_events {};
+
+/** @} */
+
+/** @defgroup XPD_Cpp_Exported_Macros XPD C++ Exported Macros
+ * @{ */
+
+/**
+ * @brief Creates a trait which detects the presence of a static event handler in an event set.
+ * @param EVENT: name of the static member function
+ */
+#define XPD_CPP_EVENT_TRAIT(EVENT)                                              \
+    template<class T, class = void>                                             \
+    struct has_##EVENT : std::false_type {};                                    \
+    template<class T>                                                           \
+    struct has_##EVENT<T, std::void_t<decltype(&T::EVENT)>> : std::true_type {}
+
+/**
+ * @brief Binds the static event handler of the event set to the handle callback, if present.
+ * @param EVENTS: the event set type
+ * @param EVENT: name of the static member function
+ * @param CALLBACK: the handle callback member
+ */
+#define XPD_CPP_EVENT_BIND(EVENTS, EVENT, CALLBACK)                             \
+    do { if constexpr (has_##EVENT<EVENTS>::value)                              \
+        { (CALLBACK) = [](void *) { EVENTS::EVENT(); }; } } while (0)
+
+/** @} */
+
+XPD_CPP_EVENT_TRAIT(on_transmit);
+XPD_CPP_EVENT_TRAIT(on_receive);
+XPD_CPP_EVENT_TRAIT(on_idle);
+XPD_CPP_EVENT_TRAIT(on_error);
+
+/** @defgroup XPD_Cpp_Exported_Functions XPD C++ Exported Functions
+ * @{ */
+
+/**
+ * @brief Inline equivalent of @ref XPD_vReadToStream for the interrupt fast paths.
+ * @param reg: the register to read from
+ * @param stream: the destination stream
+ */
+inline void read_to_stream(const volatile void * reg, DataStreamType & stream)
+{
+    switch (stream.size)
+    {
+        case 1:
+            *static_cast<uint8_t *>(stream.buffer)  = *static_cast<const volatile uint8_t *>(reg);
+            break;
+        case 2:
+            *static_cast<uint16_t *>(stream.buffer) = *static_cast<const volatile uint16_t *>(reg);
+            break;
+        default:
+            *static_cast<uint32_t *>(stream.buffer) = *static_cast<const volatile uint32_t *>(reg);
+            break;
+    }
+    stream.buffer = static_cast<uint8_t *>(stream.buffer) + stream.size;
+    stream.length--;
+}
+
+/**
+ * @brief Inline equivalent of @ref XPD_vWriteFromStream for the interrupt fast paths.
+ * @param reg: the register to write to
+ * @param stream: the source stream
+ */
+inline void write_from_stream(volatile void * reg, DataStreamType & stream)
+{
+    switch (stream.size)
+    {
+        case 1:
+            *static_cast<volatile uint8_t *>(reg)  = *static_cast<const uint8_t *>(stream.buffer);
+            break;
+        case 2:
+            *static_cast<volatile uint16_t *>(reg) = *static_cast<const uint16_t *>(stream.buffer);
+            break;
+        default:
+            *static_cast<volatile uint32_t *>(reg) = *static_cast<const uint32_t *>(stream.buffer);
+            break;
+    }
+    stream.buffer = static_cast<uint8_t *>(stream.buffer) + stream.size;
+    stream.length--;
+}
+
+/** @} */
+
+} /* namespace xpd */
+
+/** @} */
+
+#endif /* __XPD_COMMON_HPP_ */
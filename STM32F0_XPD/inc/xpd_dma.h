@@ -237,6 +237,19 @@ typedef struct
      BASE##_CSELR_CH##CHANNEL##_##SELECTION))
 #endif /* DMA_CSELR_C1S */
 
+/**
+ * @brief  Defines a DMA interrupt vector handler which is statically bound to its handle,
+ *         and calls the owner peripheral's transfer complete function directly.
+ *         The owner peripheral's own vector is bound with @ref XPD_IRQ_BIND.
+ * @param  VECTOR: specifies the interrupt vector name without the _IRQHandler suffix.
+ * @param  HANDLE: specifies the DMA Handle.
+ * @param  COMPLETE: specifies the owner's DMA transfer complete function.
+ * @param  OWNER: specifies the owner peripheral handle.
+ */
+#define         DMA_IRQ_BIND(VECTOR, HANDLE, COMPLETE, OWNER) \
+    void VECTOR##_IRQHandler(void)                            \
+    { if (DMA_eIRQHandler(HANDLE) != RESET) { COMPLETE(OWNER); } }
+
 /** @} */
 
 /** @addtogroup DMA_Exported_Functions
@@ -256,6 +269,7 @@ XPD_ReturnType  DMA_ePollStatus     (DMA_HandleType * pxDMA, DMA_OperationType e
                                      uint32_t ulTimeout);
 
 void            DMA_vIRQHandler     (DMA_HandleType * pxDMA);
+FlagStatus      DMA_eIRQHandler     (DMA_HandleType * pxDMA);
 
 /**
  * @brief  Provides the circular mode of DMA stream.
@@ -66,9 +66,9 @@ void            EXTI_vDeinit         (uint8_t ucLine);
 __STATIC_INLINE FlagStatus EXTI_eGetFlag(uint8_t ucLine)
 {
 #ifdef EXTI_BB
-    return EXTI_BB->PR[ucLine];
+    return (FlagStatus)EXTI_BB->PR[ucLine];
 #else
-    return (EXTI->PR >> ucLine) & 1;
+    return (FlagStatus)((EXTI->PR >> ucLine) & 1);
 #endif
 }
 
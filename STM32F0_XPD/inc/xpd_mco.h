@@ -86,10 +86,13 @@ __STATIC_INLINE void MCO_vInit(
 {
     static const GPIO_InitType xMCOPinCfg = {
         .Mode = GPIO_MODE_ALTERNATE,
-        .AlternateMap = GPIO_MCO_AF0,
-        .Output.Speed = VERY_HIGH,
-        .Output.Type = GPIO_OUTPUT_PUSHPULL,
         .Pull = GPIO_PULL_FLOAT,
+        .Output = { .Type = GPIO_OUTPUT_PUSHPULL, .Speed = VERY_HIGH },
+        .ExtI = { .Edge = EDGE_NONE, .Reaction = REACTION_NONE },
+        .AlternateMap = GPIO_MCO_AF0,
+#ifdef PWR_CR3_APC
+        .PowerDownPull = GPIO_PULL_FLOAT,
+#endif
     };
 
     {
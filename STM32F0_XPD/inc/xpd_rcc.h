@@ -132,6 +132,10 @@ typedef uint16_t RCC_PositionType;
 void            RCC_vClockEnable        (RCC_PositionType PeriphPos);
 void            RCC_vClockDisable       (RCC_PositionType PeriphPos);
 void            RCC_vReset              (RCC_PositionType PeriphPos);
+
+void            RCC_vClockEnableMulti   (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
+void            RCC_vClockDisableMulti  (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
+void            RCC_vResetMulti         (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
 /** @} */
 
 /** @} */
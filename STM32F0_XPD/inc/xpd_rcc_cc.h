@@ -262,7 +262,7 @@ void                RCC_vResetAPB           (void);
  */
 __STATIC_INLINE RCC_ResetSourceType RCC_eGetResetSource(void)
 {
-    return (RCC->CSR.w & (~RCC_CSR_RMVF)) >> 20;
+    return (RCC_ResetSourceType)((RCC->CSR.w & (~RCC_CSR_RMVF)) >> 20);
 }
 
 /**
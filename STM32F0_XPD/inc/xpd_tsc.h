@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file    xpd_tsc.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Touch Sensing Controller Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_TSC_H_
+#define __XPD_TSC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(TSC)
+
+/** @defgroup TSC
+ * @{ */
+
+/** @defgroup TSC_Exported_Types TSC Exported Types
+ * @{ */
+
+/** @brief TSC maximum charge transfer counts */
+typedef enum
+{
+    TSC_MAXCOUNT_255   = 0, /*!< 255 charge transfers */
+    TSC_MAXCOUNT_511   = 1, /*!< 511 charge transfers */
+    TSC_MAXCOUNT_1023  = 2, /*!< 1023 charge transfers */
+    TSC_MAXCOUNT_2047  = 3, /*!< 2047 charge transfers */
+    TSC_MAXCOUNT_4095  = 4, /*!< 4095 charge transfers */
+    TSC_MAXCOUNT_8191  = 5, /*!< 8191 charge transfers */
+    TSC_MAXCOUNT_16383 = 6, /*!< 16383 charge transfers */
+}TSC_MaxCountType;
+
+/** @brief TSC setup structure */
+typedef struct
+{
+    uint8_t          PulseHigh;          /*!< Charge transfer pulse high duration in pulse generator clocks [1 .. 16] */
+    uint8_t          PulseLow;           /*!< Charge transfer pulse low duration in pulse generator clocks [1 .. 16] */
+    ClockDividerType PulsePrescaler;     /*!< Pulse generator clock prescaler from HCLK [CLK_DIV1 .. CLK_DIV128] */
+    TSC_MaxCountType MaxCount;           /*!< Charge transfer count limit of an acquisition */
+    struct {
+        FunctionalState State;           /*!< Spread spectrum activation */
+        uint8_t         Deviation;       /*!< Maximal pulse high extension in spread spectrum clocks [1 .. 128] */
+        FunctionalState HalfClock;       /*!< Spread spectrum clock is HCLK / 2 instead of HCLK */
+    }SpreadSpectrum;                     /*   Spread spectrum configuration */
+    FunctionalState  FloatingIOs;        /*!< Inactive channel IOs float instead of being
+                                              discharged (output low) between acquisitions */
+}TSC_InitType;
+
+/** @brief TSC key state structure */
+typedef struct
+{
+    uint16_t Threshold;                  /*!< Count decrease from the baseline that indicates touch */
+    uint16_t Count;                      /*!< Last acquired charge transfer count */
+    uint16_t Baseline;                   /*!< Untouched count, tracked while the key is released */
+    uint8_t  Debounce;                   /*!< [Internal] Consecutive acquisitions against the current state */
+    uint8_t  Touched;                    /*!< Debounced touch state */
+}TSC_KeyType;
+
+/** @brief TSC error types */
+typedef enum
+{
+    TSC_ERROR_NONE     = 0, /*!< No error */
+    TSC_ERROR_MAXCOUNT = 1, /*!< An acquisition reached the maximal count */
+}TSC_ErrorType;
+
+/** @brief TSC Handle structure */
+typedef struct
+{
+    TSC_TypeDef * Inst;                      /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType Cycle;        /*!< Acquisition cycle of all banks complete callback */
+        XPD_HandleCallbackType Error;        /*!< Max count error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        const uint32_t * Channels;           /*!< [Internal] Channel IO selection of each bank */
+        TSC_KeyType * Keys;                  /*!< [Internal] Key states, @ref TSC_GROUP_COUNT for each bank */
+        uint8_t Count;                       /*!< [Internal] Number of banks */
+        volatile uint8_t Current;            /*!< [Internal] The bank under acquisition */
+    }Banks;                                  /*   Acquisition banks */
+    uint8_t Debounce;                        /*!< Consecutive acquisitions needed to change a key's state */
+    uint8_t BaselineShift;                   /*!< Baseline tracking filter coefficient (2^-BaselineShift) */
+    volatile uint32_t Cycles;                /*!< Completed acquisition cycles */
+    volatile TSC_ErrorType Errors;           /*!< Acquisition errors */
+}TSC_HandleType;
+
+/** @} */
+
+/** @defgroup TSC_Exported_Macros TSC Exported Macros
+ * @{ */
+
+/** @brief Number of TSC IO groups, which are acquired simultaneously */
+#define         TSC_GROUP_COUNT                             8
+
+/**
+ * @brief TSC channel IO selector
+ * @param GROUP: the IO group [1 .. 8]
+ * @param IO: the IO in the group [1 .. 4]
+ */
+#define         TSC_IO(GROUP, IO)                           \
+    (1UL << (((GROUP) - 1) * 4 + ((IO) - 1)))
+
+/**
+ * @brief TSC key accessor
+ * @param HANDLE: specifies the peripheral handle.
+ * @param BANK: the bank index of the key's channel
+ * @param GROUP: the IO group of the key's channel [1 .. 8]
+ */
+#define         TSC_KEY(HANDLE, BANK, GROUP)                \
+    ((HANDLE)->Banks.Keys[(BANK) * TSC_GROUP_COUNT + (GROUP) - 1])
+
+/**
+ * @brief TSC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the TSC peripheral instance.
+ */
+#define         TSC_INST2HANDLE(HANDLE,INSTANCE)            \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief TSC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         TSC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)     \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified TSC flag.
+ * @param  HANDLE: specifies the TSC Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg EOAF:    End of acquisition
+ *            @arg MCEF:    Max count error
+ */
+#define         TSC_FLAG_STATUS(HANDLE, FLAG_NAME)          \
+    (TSC_REG_BIT((HANDLE),ISR,FLAG_NAME))
+
+/** @} */
+
+/** @addtogroup TSC_Exported_Functions
+ * @{ */
+void            TSC_vInit               (TSC_HandleType * pxTSC,
+                                         const TSC_InitType * pxConfig);
+void            TSC_vDeinit             (TSC_HandleType * pxTSC);
+
+void            TSC_vChannelConfig      (TSC_HandleType * pxTSC,
+                                         uint32_t ulSamplingIOs,
+                                         const uint32_t * pulBanks,
+                                         TSC_KeyType * pxKeys,
+                                         uint8_t ucBankCount);
+
+XPD_ReturnType  TSC_eStart_IT           (TSC_HandleType * pxTSC);
+void            TSC_vStop_IT            (TSC_HandleType * pxTSC);
+
+void            TSC_vIRQHandler         (TSC_HandleType * pxTSC);
+
+/** @} */
+
+/** @} */
+
+#endif /* TSC */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_TSC_H_ */
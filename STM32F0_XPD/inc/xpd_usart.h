@@ -111,17 +111,23 @@ typedef struct
         XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
         XPD_HandleCallbackType Transmit;     /*!< Data stream transmission successful callback */
         XPD_HandleCallbackType Receive;      /*!< Data stream reception successful callback */
+#ifndef __XPD_USART_NO_LIN
         XPD_HandleCallbackType Break;        /*!< LIN break detection callback */
+#endif /* __XPD_USART_NO_LIN */
         XPD_HandleCallbackType Idle;         /*!< Idle callback */
+#ifndef __XPD_USART_NO_CTS
         XPD_HandleCallbackType ClearToSend;  /*!< Clear To Send callback */
+#endif /* __XPD_USART_NO_CTS */
 #if defined(__XPD_USART_ERROR_DETECT) || defined(__XPD_DMA_ERROR_DETECT)
         XPD_HandleCallbackType Error;        /*!< Error callbacks */
 #endif
     }Callbacks;                              /*   Handle Callbacks */
+#ifndef __XPD_USART_NO_DMA
     struct {
         DMA_HandleType * Transmit;           /*!< DMA handle for data transmission */
         DMA_HandleType * Receive;            /*!< DMA handle for data reception */
     }DMA;                                    /*   DMA handle references */
+#endif /* __XPD_USART_NO_DMA */
     DataStreamType RxStream;                 /*!< Data reception stream */
     DataStreamType TxStream;                 /*!< Data transmission stream */
     RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
@@ -426,6 +432,7 @@ void            USART_vSendReceive_IT       (USART_HandleType * pxUSART,
 void            USART_vIRQHandler           (USART_HandleType * pxUSART);
 
 
+#ifndef __XPD_USART_NO_DMA
 XPD_ReturnType  USART_eTransmit_DMA         (USART_HandleType * pxUSART,
                                              void * pvTxData,
                                              uint16_t usLength);
@@ -450,6 +457,10 @@ XPD_ReturnType  USART_eSendReceive_DMA      (USART_HandleType * pxUSART,
 
 void            USART_vStop_DMA             (USART_HandleType * pxUSART);
 
+void            USART_vTransmitComplete_DMA (USART_HandleType * pxUSART);
+void            USART_vReceiveComplete_DMA  (USART_HandleType * pxUSART);
+#endif /* __XPD_USART_NO_DMA */
+
 #ifdef USART_CR3_OVRDIS
 void            USART_vOverrunEnable        (USART_HandleType * pxUSART);
 void            USART_vOverrunDisable       (USART_HandleType * pxUSART);
@@ -579,9 +590,11 @@ typedef struct {
 
 /** @addtogroup LIN_Exported_Functions
  * @{ */
+#ifndef __XPD_USART_NO_LIN
 void            USART_vInitLIN              (USART_HandleType * pxUSART,
                                              const LIN_InitType * pxConfig);
 void            USART_vSendBreak            (USART_HandleType * pxUSART);
+#endif /* __XPD_USART_NO_LIN */
 /** @} */
 
 /** @} */
@@ -603,7 +616,7 @@ typedef enum
 /** @brief MSUART wakeup selection */
 typedef enum
 {
-    MSUART_WAKEUP_ADDRESSED     = 1, /*!< Wakeup on matching Address Mark (address MSB = 1, data MSB = 0) */
+    MSUART_WAKEUP_ADDRESSED     = 0, /*!< Wakeup on matching Address Mark (address MSB = 1, data MSB = 0) */
     MSUART_WAKEUP_START_BIT     = 2, /*!< Wakeup on Start bit detection */
     MSUART_WAKEUP_DATA_RECEIVED = 3, /*!< Wakeup on RXNE flag */
 }MSUART_WakeUpType;
@@ -635,8 +648,10 @@ typedef struct {
 
 /** @addtogroup MSUART_Exported_Functions
  * @{ */
+#ifndef __XPD_USART_NO_MULTISLAVE
 void            USART_vInitMultiSlave       (USART_HandleType * pxUSART,
                                              const MSUART_InitType * pxConfig);
+#endif /* __XPD_USART_NO_MULTISLAVE */
 
 /**
  * @brief Mutes the MultiSlave UART
@@ -667,7 +682,7 @@ __STATIC_INLINE void USART_vUnmute(USART_HandleType * pxUSART)
 #endif
 }
 
-#if (__USART_PERIPHERAL_VERSION > 2)
+#if (__USART_PERIPHERAL_VERSION > 2) && !defined(__XPD_USART_NO_WAKEUP)
 /**
  * @brief Enables the Stop mode for the UART
  * @note  The UART is able to wake up the MCU from Stop 1 mode as long as UART clock is HSI or LSE.
@@ -740,8 +755,10 @@ typedef struct
 
 /** @addtogroup SmartCard_Exported_Functions
  * @{ */
+#ifndef __XPD_USART_NO_SMARTCARD
 void            USART_vInitSmartCard        (USART_HandleType * pxUSART,
                                              const SmartCard_InitType * pxConfig);
+#endif /* __XPD_USART_NO_SMARTCARD */
 /** @} */
 
 /** @} */
@@ -766,8 +783,10 @@ typedef struct
 
 /** @addtogroup IrDA_Exported_Functions
  * @{ */
+#ifndef __XPD_USART_NO_IRDA
 void            USART_vInitIrDA             (USART_HandleType * pxUSART,
                                              const IrDA_InitType * pxConfig);
+#endif /* __XPD_USART_NO_IRDA */
 /** @} */
 
 /** @} */
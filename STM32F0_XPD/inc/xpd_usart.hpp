@@ -0,0 +1,272 @@
+/**
+  ******************************************************************************
+  * @file    xpd_usart.hpp
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers USART C++ Layer
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_USART_HPP_
+#define __XPD_USART_HPP_
+
+#include <xpd_common.hpp>
+#include <xpd_usart.h>
+
+/** @addtogroup XPD_Cpp
+ * @{ */
+
+namespace xpd
+{
+
+/**
+ * @brief USART with compile-time instance, reset and clock control position and DMA bindings.
+ *        The C driver functions operate on the static handle, while the interrupt handler
+ *        processes the stream elements inline with constant register addresses.
+ *        The stream ends are also finished inline when the event set has a handler for them,
+ *        which is then called directly. @ref USART_vIRQHandler is only called for the
+ *        remaining events, which reach the event handlers through the handle callbacks.
+ * @tparam BASE: the USART instance base address
+ * @tparam POS: the USART reset and clock control position
+ * @tparam EVENTS: event set with optional static on_transmit, on_receive, on_idle, on_error handlers
+ * @tparam TXDMA: DMA handle for data transmission
+ * @tparam RXDMA: DMA handle for data reception
+ *
+ * @code
+ * struct console_events { static void on_receive(); };
+ * using console = XPD_USART(USART2, console_events);
+ *
+ * console::call<USART_vInitAsync>(&xConsoleConfig);
+ * extern "C" void USART2_IRQHandler(void) { console::irq(); }
+ * @endcode
+ */
+template<uintptr_t BASE, RCC_PositionType POS, class EVENTS = no_events,
+         DMA_HandleType * TXDMA = nullptr, DMA_HandleType * RXDMA = nullptr>
+class usart
+{
+public:
+    /** @brief The C driver handle of the instance */
+    static inline USART_HandleType handle = {};
+
+    /**
+     * @brief Gets the peripheral instance.
+     * @return The constant USART instance address
+     */
+    static USART_TypeDef * inst()
+    {
+        return reinterpret_cast<USART_TypeDef *>(BASE);
+    }
+
+    /** @brief Control register bits with compile-time access method */
+    template<uint8_t POSITION>
+    using cr1_bit = reg_bit<BASE + offsetof(USART_TypeDef, CR1), POSITION>;
+    template<uint8_t POSITION>
+    using cr3_bit = reg_bit<BASE + offsetof(USART_TypeDef, CR3), POSITION>;
+
+    /**
+     * @brief Binds the instance, DMA handles and event handlers to the C driver handle.
+     *        The event handlers are bound for the DMA and C interrupt handler paths.
+     *        Shall be called before any other function.
+     */
+    static void bind()
+    {
+        handle.Inst         = inst();
+#ifdef USART_BB
+        handle.Inst_BB      = USART_BB(inst());
+#endif
+        handle.CtrlPos      = POS;
+#ifndef __XPD_USART_NO_DMA
+        handle.DMA.Transmit = TXDMA;
+        handle.DMA.Receive  = RXDMA;
+#endif
+
+        XPD_CPP_EVENT_BIND(EVENTS, on_transmit, handle.Callbacks.Transmit);
+        XPD_CPP_EVENT_BIND(EVENTS, on_receive,  handle.Callbacks.Receive);
+        XPD_CPP_EVENT_BIND(EVENTS, on_idle,     handle.Callbacks.Idle);
+#if defined(__XPD_USART_ERROR_DETECT) || defined(__XPD_DMA_ERROR_DETECT)
+        XPD_CPP_EVENT_BIND(EVENTS, on_error,    handle.Callbacks.Error);
+#endif
+    }
+
+    /**
+     * @brief Calls a C driver function with the instance's handle.
+     * @tparam FUNCTION: the USART driver function
+     * @param args: the further arguments of the function
+     * @return The result of the function
+     */
+    template<auto FUNCTION, class... ARGS>
+    static auto call(ARGS... args)
+    {
+        return FUNCTION(&handle, args...);
+    }
+
+    /**
+     * @brief Starts interrupt-driven data transmission.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     */
+    static void transmit_it(void * data, uint16_t length)
+    {
+        USART_vTransmit_IT(&handle, data, length);
+    }
+
+    /**
+     * @brief Starts interrupt-driven data reception.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     */
+    static void receive_it(void * data, uint16_t length)
+    {
+        USART_vReceive_IT(&handle, data, length);
+    }
+
+#ifndef __XPD_USART_NO_DMA
+    /**
+     * @brief Starts DMA-managed data transmission.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     * @return BUSY if DMA is in use, OK if transfer is started
+     */
+    static XPD_ReturnType transmit_dma(void * data, uint16_t length)
+    {
+        static_assert(TXDMA != nullptr, "No transmit DMA is bound to the USART.");
+        return USART_eTransmit_DMA(&handle, data, length);
+    }
+
+    /**
+     * @brief Starts DMA-managed data reception.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     * @return BUSY if DMA is in use, OK if transfer is started
+     */
+    static XPD_ReturnType receive_dma(void * data, uint16_t length)
+    {
+        static_assert(RXDMA != nullptr, "No receive DMA is bound to the USART.");
+        return USART_eReceive_DMA(&handle, data, length);
+    }
+
+    /**
+     * @brief Transmit DMA interrupt handler, which calls the transfer completion
+     *        of the instance directly instead of through the DMA handle callback.
+     */
+    static void tx_dma_irq()
+    {
+        static_assert(TXDMA != nullptr, "No transmit DMA is bound to the USART.");
+        if (DMA_eIRQHandler(TXDMA) != RESET)
+        {
+            USART_vTransmitComplete_DMA(&handle);
+        }
+    }
+
+    /**
+     * @brief Receive DMA interrupt handler, which calls the transfer completion
+     *        of the instance directly instead of through the DMA handle callback.
+     */
+    static void rx_dma_irq()
+    {
+        static_assert(RXDMA != nullptr, "No receive DMA is bound to the USART.");
+        if (DMA_eIRQHandler(RXDMA) != RESET)
+        {
+            USART_vReceiveComplete_DMA(&handle);
+        }
+    }
+#endif /* __XPD_USART_NO_DMA */
+
+    /**
+     * @brief USART interrupt handler, moves the stream elements inline and
+     *        finishes the streams inline if the event set handles their completion,
+     *        otherwise passes the last elements and all other events to the C driver.
+     */
+    static void irq()
+    {
+#if (__USART_PERIPHERAL_VERSION > 1)
+        const uint32_t sr = inst()->ISR.w;
+        constexpr uint32_t rxne = USART_ISR_RXNE, txe = USART_ISR_TXE,
+                errors = USART_ISR_PE | USART_ISR_FE | USART_ISR_NE | USART_ISR_ORE;
+        volatile void * const rdr = &inst()->RDR;
+        volatile void * const tdr = &inst()->TDR;
+#else
+        const uint32_t sr = inst()->SR.w;
+        constexpr uint32_t rxne = USART_SR_RXNE, txe = USART_SR_TXE,
+                errors = USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE;
+        volatile void * const rdr = &inst()->DR;
+        volatile void * const tdr = &inst()->DR;
+#endif
+        const uint32_t cr1 = inst()->CR1.w;
+
+        if ((sr & errors) == 0)
+        {
+            if (((sr & rxne) != 0) && ((cr1 & USART_CR1_RXNEIE) != 0))
+            {
+                if (handle.RxStream.length > 1)
+                {
+                    read_to_stream(rdr, handle.RxStream);
+                    return;
+                }
+                if constexpr (has_on_receive<EVENTS>::value)
+                {
+                    read_to_stream(rdr, handle.RxStream);
+
+                    /* end of reception */
+                    cr1_bit<USART_CR1_RXNEIE_Pos>::write(false);
+#ifdef __XPD_USART_ERROR_DETECT
+                    cr1_bit<USART_CR1_PEIE_Pos>::write(false);
+                    cr3_bit<USART_CR3_EIE_Pos>::write(false);
+#endif
+                    EVENTS::on_receive();
+                    return;
+                }
+            }
+            if (((sr & txe) != 0) && ((cr1 & USART_CR1_TXEIE) != 0))
+            {
+                if (handle.TxStream.length > 1)
+                {
+                    write_from_stream(tdr, handle.TxStream);
+                    return;
+                }
+                if constexpr (has_on_transmit<EVENTS>::value)
+                {
+                    write_from_stream(tdr, handle.TxStream);
+
+                    /* last transmission, disable TXE */
+                    cr1_bit<USART_CR1_TXEIE_Pos>::write(false);
+
+                    /* callback if transmit completion isn't waited for */
+                    if ((cr1 & USART_CR1_TCIE) != 0)
+                    {
+                        EVENTS::on_transmit();
+                    }
+                    return;
+                }
+            }
+        }
+        USART_vIRQHandler(&handle);
+    }
+};
+
+} /* namespace xpd */
+
+/**
+ * @brief USART template instantiation by the instance name.
+ * @param INSTANCE: specifies the USART peripheral instance.
+ * @param ...: optional event set and DMA handles
+ */
+#define XPD_USART(INSTANCE, ...)    \
+    xpd::usart<INSTANCE##_BASE, RCC_POS_##INSTANCE, ##__VA_ARGS__>
+
+/** @} */
+
+#endif /* __XPD_USART_HPP_ */
@@ -0,0 +1,391 @@
+/**
+  ******************************************************************************
+  * @file    xpd_async.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Asynchronous Transaction Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_async.h>
+#include <xpd_adc.h>
+#include <xpd_can.h>
+#include <xpd_flash.h>
+#include <xpd_spi.h>
+#include <xpd_usart.h>
+#include <xpd_utils.h>
+
+/** @addtogroup ASYNC
+ * @{ */
+
+/* Submitted transactions in submission order, modified only by the thread context */
+static ASYNC_TransactionType * volatile async_pxQueue = NULL;
+
+/* Appends the transaction to the end of the queue */
+static void ASYNC_prvEnqueue(ASYNC_TransactionType * pxTrans, ASYNC_StateType eState)
+{
+    ASYNC_TransactionType * volatile * ppxLink = &async_pxQueue;
+
+    while (*ppxLink != NULL)
+    {
+        ppxLink = &(*ppxLink)->Next;
+    }
+
+    XPD_ENTER_CRITICAL(pxTrans);
+
+    /* the transaction is complete before it becomes visible to the interrupts */
+    pxTrans->Next  = NULL;
+    pxTrans->State = eState;
+    *ppxLink = pxTrans;
+
+    XPD_EXIT_CRITICAL(pxTrans);
+}
+
+/* Converts the direction to a mask of the occupied handle parts */
+#define ASYNC_DIRECTION_MASK(DIRECTION)     \
+    (((DIRECTION) == ASYNC_DIRECTION_BOTH) ? \
+    (ASYNC_DIRECTION_TRANSMIT | ASYNC_DIRECTION_RECEIVE) : (DIRECTION))
+
+/* Determines if an earlier transaction of the same driver handle direction is in progress */
+static boolean_t ASYNC_prvHandleBusy(ASYNC_TransactionType * pxTrans)
+{
+    ASYNC_TransactionType * pxItem;
+    uint8_t ucMask = ASYNC_DIRECTION_MASK(pxTrans->Direction);
+
+    for (pxItem = async_pxQueue; pxItem != pxTrans; pxItem = pxItem->Next)
+    {
+        if ((pxItem->Handle == pxTrans->Handle) && (pxItem->State != ASYNC_STATE_PENDING)
+         && ((ASYNC_DIRECTION_MASK(pxItem->Direction) & ucMask) != 0))
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Marks the active transaction of the driver handle direction, called from interrupt context */
+static void ASYNC_prvSignal(void * pvHandle, ASYNC_DirectionType eDirection, ASYNC_StateType eState)
+{
+    ASYNC_TransactionType * pxItem;
+    uint8_t ucMask = ASYNC_DIRECTION_MASK(eDirection);
+
+    for (pxItem = async_pxQueue; pxItem != NULL; pxItem = pxItem->Next)
+    {
+        if ((pxItem->Handle == pvHandle) && (pxItem->State == ASYNC_STATE_ACTIVE)
+         && ((ASYNC_DIRECTION_MASK(pxItem->Direction) & ucMask) != 0))
+        {
+            pxItem->State = eState;
+            break;
+        }
+    }
+}
+
+/** @defgroup ASYNC_Exported_Functions ASYNC Exported Functions
+ * @{ */
+
+/**
+ * @brief Submits the transaction to the executor, which starts it
+ *        when the previous transactions of its driver handle (direction) are finished.
+ * @note  The transaction shall be idle, and this function shall be called from thread context.
+ * @param pxTrans: pointer to the transaction
+ */
+void ASYNC_vSubmit(ASYNC_TransactionType * pxTrans)
+{
+    pxTrans->Result = XPD_BUSY;
+
+    ASYNC_prvEnqueue(pxTrans, ASYNC_STATE_PENDING);
+}
+
+/**
+ * @brief Chains a transaction to be submitted when the first one is finished successfully.
+ *        If the first transaction fails, the chained transactions are finished with its result
+ *        without being started.
+ * @param pxTrans: pointer to the first transaction
+ * @param pxNext: pointer to the chained transaction
+ * @return The chained transaction, so further transactions can be chained to it
+ */
+ASYNC_TransactionType * ASYNC_pxThen(ASYNC_TransactionType * pxTrans, ASYNC_TransactionType * pxNext)
+{
+    pxTrans->Then = pxNext;
+    return pxNext;
+}
+
+/**
+ * @brief Polls the status of the transaction.
+ * @param pxTrans: pointer to the transaction
+ * @return BUSY until the transaction is finished, then OK or the failure reason
+ */
+XPD_ReturnType ASYNC_eGetStatus(ASYNC_TransactionType * pxTrans)
+{
+    return (pxTrans->State == ASYNC_STATE_IDLE) ? pxTrans->Result : XPD_BUSY;
+}
+
+/**
+ * @brief Runs the executor until the transaction is finished, or until times out.
+ * @note  This function shall not be called from transaction completion callbacks.
+ *        The milliseconds based waiting utilities shall not be used concurrently.
+ * @param pxTrans: pointer to the transaction
+ * @param ulTimeout: the timeout in ms
+ * @return TIMEOUT if timed out, otherwise the result of the transaction
+ */
+XPD_ReturnType ASYNC_eWait(ASYNC_TransactionType * pxTrans, uint32_t ulTimeout)
+{
+    /* Initially clear flag */
+    (void) SysTick->CTRL.b.COUNTFLAG;
+
+    for (ASYNC_vRun(); pxTrans->State != ASYNC_STATE_IDLE; ASYNC_vRun())
+    {
+        if (ulTimeout == 0)
+        {
+            return XPD_TIMEOUT;
+        }
+        /* COUNTFLAG returns 1 if timer counted to 0 since the last flag read */
+        ulTimeout -= SysTick->CTRL.b.COUNTFLAG;
+    }
+    return pxTrans->Result;
+}
+
+/**
+ * @brief Runs the executor once: starts the pending transactions whose driver handle is available,
+ *        and finishes the completed and failed transactions by calling their completion callback
+ *        and submitting the chained transactions.
+ * @note  This function shall be called from a single thread context, e.g. the main loop.
+ */
+void ASYNC_vRun(void)
+{
+    ASYNC_TransactionType * volatile * ppxLink = &async_pxQueue;
+
+    while (*ppxLink != NULL)
+    {
+        ASYNC_TransactionType * pxTrans = *ppxLink;
+        ASYNC_TransactionType * pxThen;
+        ASYNC_StateType eState = pxTrans->State;
+        XPD_ReturnType eResult;
+
+        if ((eState == ASYNC_STATE_PENDING) && !ASYNC_prvHandleBusy(pxTrans))
+        {
+            /* the operation can complete before the start function returns */
+            pxTrans->State = ASYNC_STATE_ACTIVE;
+            eResult = pxTrans->Start(pxTrans);
+
+            if (eResult == XPD_BUSY)
+            {
+                pxTrans->State = ASYNC_STATE_PENDING;
+            }
+            else if (eResult != XPD_OK)
+            {
+                pxTrans->Result = eResult;
+                pxTrans->State  = ASYNC_STATE_FAILED;
+            }
+            eState = pxTrans->State;
+        }
+
+        if ((eState != ASYNC_STATE_COMPLETE) && (eState != ASYNC_STATE_FAILED))
+        {
+            ppxLink = &pxTrans->Next;
+            continue;
+        }
+
+        /* remove the finished transaction from the queue */
+        {
+            XPD_ENTER_CRITICAL(pxTrans);
+
+            *ppxLink = pxTrans->Next;
+
+            XPD_EXIT_CRITICAL(pxTrans);
+        }
+
+        if (eState == ASYNC_STATE_COMPLETE)
+        {
+            pxTrans->Result = XPD_OK;
+        }
+        else if (pxTrans->Result == XPD_BUSY)
+        {
+            pxTrans->Result = XPD_ERROR;
+        }
+        eResult = pxTrans->Result;
+        pxThen  = pxTrans->Then;
+        pxTrans->State = ASYNC_STATE_IDLE;
+
+        /* the callback may resubmit the transaction */
+        XPD_SAFE_CALLBACK(pxTrans->Complete, pxTrans);
+
+        if (pxThen != NULL)
+        {
+            if (eResult == XPD_OK)
+            {
+                ASYNC_vSubmit(pxThen);
+            }
+            else
+            {
+                /* the chain is aborted, the failure is propagated through it */
+                pxThen->Result = eResult;
+                ASYNC_prvEnqueue(pxThen, ASYNC_STATE_FAILED);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Driver handle callback which marks the active transaction of the handle complete.
+ * @param pvHandle: pointer to the driver handle
+ */
+void ASYNC_vComplete(void * pvHandle)
+{
+    ASYNC_prvSignal(pvHandle, ASYNC_DIRECTION_BOTH, ASYNC_STATE_COMPLETE);
+}
+
+/**
+ * @brief Driver handle Transmit callback which marks the active transmitting
+ *        (or whole handle) transaction of the handle complete.
+ * @param pvHandle: pointer to the driver handle
+ */
+void ASYNC_vTransmitComplete(void * pvHandle)
+{
+    ASYNC_prvSignal(pvHandle, ASYNC_DIRECTION_TRANSMIT, ASYNC_STATE_COMPLETE);
+}
+
+/**
+ * @brief Driver handle Receive callback which marks the active receiving
+ *        (or whole handle) transaction of the handle complete.
+ * @param pvHandle: pointer to the driver handle
+ */
+void ASYNC_vReceiveComplete(void * pvHandle)
+{
+    ASYNC_prvSignal(pvHandle, ASYNC_DIRECTION_RECEIVE, ASYNC_STATE_COMPLETE);
+}
+
+/**
+ * @brief Driver handle callback which marks the first active transaction of the handle failed.
+ * @param pvHandle: pointer to the driver handle
+ */
+void ASYNC_vError(void * pvHandle)
+{
+    ASYNC_prvSignal(pvHandle, ASYNC_DIRECTION_BOTH, ASYNC_STATE_FAILED);
+}
+
+/**
+ * @brief Handle-less driver callback (e.g. FLASH) which marks the active transaction
+ *        without driver handle complete.
+ */
+void ASYNC_vCompleteStatic(void)
+{
+    ASYNC_prvSignal(NULL, ASYNC_DIRECTION_BOTH, ASYNC_STATE_COMPLETE);
+}
+
+/**
+ * @brief Handle-less driver callback (e.g. FLASH) which marks the active transaction
+ *        without driver handle failed.
+ */
+void ASYNC_vErrorStatic(void)
+{
+    ASYNC_prvSignal(NULL, ASYNC_DIRECTION_BOTH, ASYNC_STATE_FAILED);
+}
+
+/** @} */
+
+/** @defgroup ASYNC_Exported_Functions_Start ASYNC Driver Operation Start Functions
+ *  @brief    Transaction start functions of the driver operations
+ * @{ */
+
+#ifndef __XPD_USART_NO_DMA
+/**
+ * @brief Starts DMA-managed USART transmission of Length transfers from Source.
+ *        The handle's Transmit callback signals the completion.
+ * @param pxTrans: pointer to the transaction with the USART handle
+ * @return BUSY if DMA is in use, OK if transfer is started
+ */
+XPD_ReturnType ASYNC_eUSART_Transmit_DMA(ASYNC_TransactionType * pxTrans)
+{
+    return USART_eTransmit_DMA(pxTrans->Handle, pxTrans->Source, pxTrans->Length);
+}
+
+/**
+ * @brief Starts DMA-managed USART reception of Length transfers to Destination.
+ *        The handle's Receive callback signals the completion.
+ * @param pxTrans: pointer to the transaction with the USART handle
+ * @return BUSY if DMA is in use, OK if transfer is started
+ */
+XPD_ReturnType ASYNC_eUSART_Receive_DMA(ASYNC_TransactionType * pxTrans)
+{
+    return USART_eReceive_DMA(pxTrans->Handle, pxTrans->Destination, pxTrans->Length);
+}
+#endif /* __XPD_USART_NO_DMA */
+
+#ifndef __XPD_SPI_NO_DMA
+/**
+ * @brief Starts DMA-managed SPI transfer of Length transfers from Source and to Destination.
+ *        If Destination is NULL, only transmission is performed, which the handle's Transmit
+ *        callback signals. Otherwise the handle's Receive callback signals the completion,
+ *        and if Source is NULL, only reception is performed.
+ * @param pxTrans: pointer to the transaction with the SPI handle
+ * @return BUSY if DMA is in use, OK if transfer is started
+ */
+XPD_ReturnType ASYNC_eSPI_SendReceive_DMA(ASYNC_TransactionType * pxTrans)
+{
+    if (pxTrans->Destination == NULL)
+    {
+        return SPI_eTransmit_DMA(pxTrans->Handle, pxTrans->Source, pxTrans->Length);
+    }
+    else if (pxTrans->Source == NULL)
+    {
+        return SPI_eReceive_DMA(pxTrans->Handle, pxTrans->Destination, pxTrans->Length);
+    }
+    else
+    {
+        return SPI_eSendReceive_DMA(pxTrans->Handle, pxTrans->Source, pxTrans->Destination, pxTrans->Length);
+    }
+}
+#endif /* __XPD_SPI_NO_DMA */
+
+/**
+ * @brief Starts DMA-managed ADC conversions to Destination.
+ *        The handle's ConvComplete callback signals the completion.
+ * @param pxTrans: pointer to the transaction with the ADC handle
+ * @return BUSY if DMA is in use, OK if conversions are started
+ */
+XPD_ReturnType ASYNC_eADC_Start_DMA(ASYNC_TransactionType * pxTrans)
+{
+    return ADC_eStart_DMA(pxTrans->Handle, pxTrans->Destination);
+}
+
+#if defined(CAN) || defined(CAN1)
+/**
+ * @brief Starts interrupt-driven CAN frame transmission of the Source frame.
+ *        The handle's Transmit callback signals the completion.
+ * @param pxTrans: pointer to the transaction with the CAN handle
+ * @return BUSY if all transmit mailboxes are in use, OK if transmission is started
+ */
+XPD_ReturnType ASYNC_eCAN_Send_IT(ASYNC_TransactionType * pxTrans)
+{
+    return CAN_eSend_IT(pxTrans->Handle, pxTrans->Source);
+}
+#endif
+
+/**
+ * @brief Starts interrupt-driven FLASH programming of Length bytes from Source to Destination.
+ *        The ProgramComplete callback signals the completion, the transaction's Handle shall be NULL.
+ * @param pxTrans: pointer to the transaction
+ * @return BUSY if FLASH is in use, OK if programming is started
+ */
+XPD_ReturnType ASYNC_eFLASH_Program_IT(ASYNC_TransactionType * pxTrans)
+{
+    return FLASH_eProgram_IT(pxTrans->Destination, pxTrans->Source, pxTrans->Length);
+}
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,345 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dac.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital to Analog Converter Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_dac.h>
+#include <xpd_utils.h>
+
+#if defined(DAC)
+
+/** @addtogroup DAC
+ * @{ */
+
+/* Channel 2 control and status bits are the channel 1 bits shifted by this amount */
+#define DAC_CHANNEL_SHIFT(CH)       ((uint32_t)(CH) * 16)
+
+#define DAC_CR_CHANNEL_CONFIG       (DAC_CR_BOFF1 | DAC_CR_TEN1 | DAC_CR_TSEL1 | \
+                                     DAC_CR_WAVE1 | DAC_CR_MAMP1)
+
+#ifdef DAC_CR_EN2
+#define DAC_LAST_CHANNEL            DAC_CHANNEL_2
+#else
+#define DAC_LAST_CHANNEL            DAC_CHANNEL_1
+#endif
+
+/* Gets the channel which uses the DMA stream */
+static DAC_ChannelType DAC_prvDmaChannel(DAC_HandleType * pxDAC, void * pxDMA)
+{
+#ifdef DAC_CR_EN2
+    if (pxDMA == pxDAC->DMA.Channel[DAC_CHANNEL_2])
+    {
+        return DAC_CHANNEL_2;
+    }
+#endif
+    return DAC_CHANNEL_1;
+}
+
+static void DAC_prvDmaHalfCompleteRedirect(void * pxDMA)
+{
+    DAC_HandleType * pxDAC = (DAC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+    DAC_ChannelType eChannel = DAC_prvDmaChannel(pxDAC, pxDMA);
+
+    /* The first half of the buffer is consumed */
+    pxDAC->ActiveChannel = eChannel;
+    pxDAC->FreeBuffer    = pxDAC->Stream[eChannel].Buffer;
+
+    XPD_SAFE_CALLBACK(pxDAC->Callbacks.Produce, pxDAC);
+}
+
+static void DAC_prvDmaCompleteRedirect(void * pxDMA)
+{
+    DAC_HandleType * pxDAC = (DAC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+    DAC_ChannelType eChannel = DAC_prvDmaChannel(pxDAC, pxDMA);
+
+    pxDAC->ActiveChannel = eChannel;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is consumed */
+        pxDAC->FreeBuffer = pxDAC->Stream[eChannel].Buffer
+                          + pxDAC->Stream[eChannel].HalfSize;
+    }
+    else
+    {
+        /* The whole buffer is consumed, end of the single transfer */
+        pxDAC->FreeBuffer = pxDAC->Stream[eChannel].Buffer;
+
+        CLEAR_BIT(pxDAC->Inst->CR.w,
+                (DAC_CR_DMAEN1 | DAC_CR_DMAUDRIE1) << DAC_CHANNEL_SHIFT(eChannel));
+    }
+
+    XPD_SAFE_CALLBACK(pxDAC->Callbacks.Produce, pxDAC);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void DAC_prvDmaErrorRedirect(void * pxDMA)
+{
+    DAC_HandleType * pxDAC = (DAC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxDAC->ActiveChannel = DAC_prvDmaChannel(pxDAC, pxDMA);
+
+    /* Update error code */
+    pxDAC->Errors |= DAC_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxDAC->Callbacks.Error, pxDAC);
+}
+#endif
+
+/* Starts the DMA transfer to a data holding register */
+static XPD_ReturnType DAC_prvStart_DMA(
+        DAC_HandleType *    pxDAC,
+        DAC_ChannelType     eChannel,
+        volatile uint32_t * pulDHR,
+        const void *        pvSamples,
+        uint16_t            usCount,
+        uint16_t            usSampleSize)
+{
+    DMA_HandleType * pxDMA = pxDAC->DMA.Channel[eChannel];
+    XPD_ReturnType eResult;
+
+    eResult = DMA_eStart_IT(pxDMA, (void*)pulDHR, (void*)pvSamples, usCount);
+
+    if (eResult == XPD_OK)
+    {
+        pxDAC->Stream[eChannel].Buffer   = (uint8_t*)pvSamples;
+        pxDAC->Stream[eChannel].HalfSize = (usCount / 2) * usSampleSize;
+        pxDAC->Errors = DAC_ERROR_NONE;
+
+        /* Set the callback owner */
+        pxDMA->Owner = pxDAC;
+
+        /* Set the DMA transfer callbacks */
+        pxDMA->Callbacks.Complete     = DAC_prvDmaCompleteRedirect;
+        pxDMA->Callbacks.HalfComplete = DAC_prvDmaHalfCompleteRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+        pxDMA->Callbacks.Error        = DAC_prvDmaErrorRedirect;
+#endif
+
+        /* In circular mode each consumed buffer half is reported to the producer */
+        if (DMA_eCircularMode(pxDMA) != 0)
+        {
+            DMA_IT_ENABLE(pxDMA, HT);
+        }
+
+        /* Clear pending underrun, enable DMA requests and underrun interrupt */
+        pxDAC->Inst->SR.w = DAC_SR_DMAUDR1 << DAC_CHANNEL_SHIFT(eChannel);
+        SET_BIT(pxDAC->Inst->CR.w,
+                (DAC_CR_DMAEN1 | DAC_CR_DMAUDRIE1 | DAC_CR_EN1) << DAC_CHANNEL_SHIFT(eChannel));
+    }
+    return eResult;
+}
+
+/** @defgroup DAC_Exported_Functions DAC Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the DAC peripheral.
+ * @param pxDAC: pointer to the DAC handle structure
+ */
+void DAC_vInit(DAC_HandleType * pxDAC)
+{
+    /* enable clock */
+    RCC_vClockEnable(pxDAC->CtrlPos);
+
+    pxDAC->Inst->CR.w = 0;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxDAC->Callbacks.DepInit, pxDAC);
+
+    pxDAC->Errors = DAC_ERROR_NONE;
+}
+
+/**
+ * @brief Restores the DAC peripheral to its default inactive state.
+ * @param pxDAC: pointer to the DAC handle structure
+ */
+void DAC_vDeinit(DAC_HandleType * pxDAC)
+{
+    DAC_vStop_DMA(pxDAC, DAC_CHANNEL_1);
+#ifdef DAC_CR_EN2
+    DAC_vStop_DMA(pxDAC, DAC_CHANNEL_2);
+#endif
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxDAC->Callbacks.DepDeinit, pxDAC);
+
+    /* disable clock */
+    RCC_vClockDisable(pxDAC->CtrlPos);
+}
+
+/**
+ * @brief Configures a DAC channel's conversion trigger, output stage and wave generation.
+ * @note  Wave generation adds the generated pattern to the data holding register value,
+ *        which therefore sets the base level of the wave. The pattern advances on each trigger,
+ *        so the wave frequency is determined by the trigger source (typically a timer TRGO).
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ * @param pxConfig: pointer to the channel setup configuration
+ */
+void DAC_vChannelConfig(DAC_HandleType * pxDAC, DAC_ChannelType eChannel,
+        const DAC_Channel_InitType * pxConfig)
+{
+    uint32_t ulConfig =
+              ((uint32_t)pxConfig->Trigger   << DAC_CR_TEN1_Pos)
+            | ((uint32_t)pxConfig->Wave      << DAC_CR_WAVE1_Pos)
+            | ((uint32_t)pxConfig->Amplitude << DAC_CR_MAMP1_Pos);
+
+    if (pxConfig->OutputBuffer == DISABLE)
+    {
+        ulConfig |= DAC_CR_BOFF1;
+    }
+
+    MODIFY_REG(pxDAC->Inst->CR.w,
+            DAC_CR_CHANNEL_CONFIG << DAC_CHANNEL_SHIFT(eChannel),
+            ulConfig              << DAC_CHANNEL_SHIFT(eChannel));
+}
+
+/**
+ * @brief Enables a DAC channel's output.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ */
+void DAC_vStart(DAC_HandleType * pxDAC, DAC_ChannelType eChannel)
+{
+    SET_BIT(pxDAC->Inst->CR.w, DAC_CR_EN1 << DAC_CHANNEL_SHIFT(eChannel));
+}
+
+/**
+ * @brief Disables a DAC channel's output.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ */
+void DAC_vStop(DAC_HandleType * pxDAC, DAC_ChannelType eChannel)
+{
+    CLEAR_BIT(pxDAC->Inst->CR.w, DAC_CR_EN1 << DAC_CHANNEL_SHIFT(eChannel));
+}
+
+/**
+ * @brief Enables a DAC channel and starts streaming samples to it by DMA.
+ *        Each trigger event converts the next sample.
+ * @note  The DMA stream shall be configured for halfword data transfer from memory to peripheral.
+ *        If the DMA is in circular mode, the Produce callback is called whenever a half of the buffer
+ *        is consumed, with FreeBuffer pointing to the consumed half, which can be refilled
+ *        while the DMA transfers the other half. In normal mode the Produce callback
+ *        is called once, at the end of the transfer.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ * @param pusSamples: pointer to the 12-bit right aligned samples
+ * @param usCount: the number of samples in the buffer (even number in circular mode)
+ * @return BUSY if the DMA is used by other peripheral, OK otherwise
+ */
+XPD_ReturnType DAC_eStart_DMA(DAC_HandleType * pxDAC, DAC_ChannelType eChannel,
+        const uint16_t * pusSamples, uint16_t usCount)
+{
+    volatile uint32_t * pulDHR = &pxDAC->Inst->DHR1.D12R;
+
+#ifdef DAC_CR_EN2
+    if (eChannel == DAC_CHANNEL_2)
+    {
+        pulDHR = &pxDAC->Inst->DHR2.D12R;
+    }
+#endif
+
+    return DAC_prvStart_DMA(pxDAC, eChannel, pulDHR,
+            pusSamples, usCount, sizeof(*pusSamples));
+}
+
+#ifdef DAC_CR_EN2
+/**
+ * @brief Enables both DAC channels and starts streaming dual channel samples to them
+ *        by a single DMA, using the channel 1 DMA handle. Each trigger event
+ *        of channel 1 updates both outputs simultaneously.
+ * @note  The DMA stream shall be configured for word data transfer from memory to peripheral.
+ *        Both channels should be configured with the same trigger source.
+ *        The Produce callback is called the same way as for @ref DAC_eStart_DMA.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param pulSamples: pointer to the samples packed by @ref DAC_DUAL_SAMPLE
+ * @param usCount: the number of dual samples in the buffer (even number in circular mode)
+ * @return BUSY if the DMA is used by other peripheral, OK otherwise
+ */
+XPD_ReturnType DAC_eStartDual_DMA(DAC_HandleType * pxDAC,
+        const uint32_t * pulSamples, uint16_t usCount)
+{
+    XPD_ReturnType eResult = DAC_prvStart_DMA(pxDAC, DAC_CHANNEL_1,
+            &pxDAC->Inst->DHRD.D12R, pulSamples, usCount, sizeof(*pulSamples));
+
+    if (eResult == XPD_OK)
+    {
+        DAC_vStart(pxDAC, DAC_CHANNEL_2);
+    }
+    return eResult;
+}
+#endif /* DAC_CR_EN2 */
+
+/**
+ * @brief Disables a DAC channel and its DMA transfer.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ */
+void DAC_vStop_DMA(DAC_HandleType * pxDAC, DAC_ChannelType eChannel)
+{
+    CLEAR_BIT(pxDAC->Inst->CR.w,
+            (DAC_CR_EN1 | DAC_CR_DMAEN1 | DAC_CR_DMAUDRIE1) << DAC_CHANNEL_SHIFT(eChannel));
+
+    if (pxDAC->DMA.Channel[eChannel] != NULL)
+    {
+        DMA_vStop_IT(pxDAC->DMA.Channel[eChannel]);
+    }
+}
+
+/**
+ * @brief DAC interrupt handler that provides handle callbacks.
+ * @note  After a DMA underrun the channel's DMA requests are no longer served,
+ *        the stream has to be restarted.
+ * @param pxDAC: pointer to the DAC handle structure
+ */
+void DAC_vIRQHandler(DAC_HandleType * pxDAC)
+{
+    uint32_t ulCR = pxDAC->Inst->CR.w;
+    uint32_t ulSR = pxDAC->Inst->SR.w;
+    DAC_ChannelType eChannel;
+
+    for (eChannel = DAC_CHANNEL_1; eChannel <= DAC_LAST_CHANNEL; eChannel++)
+    {
+        uint32_t ulShift = DAC_CHANNEL_SHIFT(eChannel);
+
+        if (((ulSR & (DAC_SR_DMAUDR1 << ulShift)) != 0) &&
+            ((ulCR & (DAC_CR_DMAUDRIE1 << ulShift)) != 0))
+        {
+            pxDAC->Inst->SR.w = DAC_SR_DMAUDR1 << ulShift;
+
+            /* Stop the channel's stream */
+            CLEAR_BIT(pxDAC->Inst->CR.w, (DAC_CR_DMAEN1 | DAC_CR_DMAUDRIE1) << ulShift);
+            DMA_vStop_IT(pxDAC->DMA.Channel[eChannel]);
+
+            pxDAC->ActiveChannel = eChannel;
+            pxDAC->Errors |= DAC_ERROR_UNDERRUN;
+
+            XPD_SAFE_CALLBACK(pxDAC->Callbacks.Error, pxDAC);
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* DAC */
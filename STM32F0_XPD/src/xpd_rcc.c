@@ -38,6 +38,43 @@ typedef union {
 
 #define PPOS    ((rccPosType)ePeriphPos)
 
+/* Number of peripheral control registers in each register set */
+#define RCC_REG_COUNT   ((RCC_POS_APB1 / 32) + 1)
+
+/* Collects the control bits of the peripherals into one mask per register */
+static void RCC_prvCollectMasks(
+        const RCC_PositionType  aePeriphPos[],
+        uint8_t                 ucCount,
+        uint32_t                aulMasks[])
+{
+    uint8_t ucIndex;
+
+    for (ucIndex = 0; ucIndex < RCC_REG_COUNT; ucIndex++)
+    {
+        aulMasks[ucIndex] = 0;
+    }
+    for (ucIndex = 0; ucIndex < ucCount; ucIndex++)
+    {
+        rccPosType xPos = { .w = aePeriphPos[ucIndex] };
+
+        aulMasks[xPos.regIndex] |= 1 << xPos.bitIndex;
+    }
+}
+
+/* Gets the reset register of the peripheral control register index */
+static __IO uint32_t * RCC_prvResetRegister(uint16_t usRegIndex)
+{
+    /* These devices have different layout for RSTR than ENR registers */
+    if (usRegIndex == (RCC_POS_AHB / 32))
+    {
+        return &RCC->AHBRSTR.w;
+    }
+    else
+    {
+        return &RCC->CIR.w + usRegIndex;
+    }
+}
+
 /** @defgroup RCC_Peripheral_Control_Exported_Functions RCC Peripheral Control Exported Functions
  * @{ */
 
@@ -107,6 +144,82 @@ void RCC_vReset(RCC_PositionType ePeriphPos)
 #endif
 }
 
+/**
+ * @brief Enables the clock of multiple peripherals
+ *        with a single read-modify-write access per enable register.
+ * @param aePeriphPos: array of relative positions of the peripheral control bits
+ *        in the RCC register space
+ * @param ucCount: number of peripherals in the array
+ */
+void RCC_vClockEnableMulti(const RCC_PositionType aePeriphPos[], uint8_t ucCount)
+{
+    uint32_t aulMasks[RCC_REG_COUNT];
+    uint8_t ucReg;
+
+    RCC_prvCollectMasks(aePeriphPos, ucCount, aulMasks);
+
+    for (ucReg = 0; ucReg < RCC_REG_COUNT; ucReg++)
+    {
+        if (aulMasks[ucReg] != 0)
+        {
+            __IO uint32_t *pulENR = &RCC->AHBENR.w + ucReg;
+            SET_BIT(*pulENR, aulMasks[ucReg]);
+
+            /* Read back to ensure effect */
+            (void) *pulENR;
+        }
+    }
+}
+
+/**
+ * @brief Disables the clock of multiple peripherals
+ *        with a single read-modify-write access per enable register.
+ * @param aePeriphPos: array of relative positions of the peripheral control bits
+ *        in the RCC register space
+ * @param ucCount: number of peripherals in the array
+ */
+void RCC_vClockDisableMulti(const RCC_PositionType aePeriphPos[], uint8_t ucCount)
+{
+    uint32_t aulMasks[RCC_REG_COUNT];
+    uint8_t ucReg;
+
+    RCC_prvCollectMasks(aePeriphPos, ucCount, aulMasks);
+
+    for (ucReg = 0; ucReg < RCC_REG_COUNT; ucReg++)
+    {
+        if (aulMasks[ucReg] != 0)
+        {
+            __IO uint32_t *pulENR = &RCC->AHBENR.w + ucReg;
+            CLEAR_BIT(*pulENR, aulMasks[ucReg]);
+        }
+    }
+}
+
+/**
+ * @brief Forces and releases a reset on multiple peripherals
+ *        with a single set and clear access per reset register.
+ * @param aePeriphPos: array of relative positions of the peripheral control bits
+ *        in the RCC register space
+ * @param ucCount: number of peripherals in the array
+ */
+void RCC_vResetMulti(const RCC_PositionType aePeriphPos[], uint8_t ucCount)
+{
+    uint32_t aulMasks[RCC_REG_COUNT];
+    uint8_t ucReg;
+
+    RCC_prvCollectMasks(aePeriphPos, ucCount, aulMasks);
+
+    for (ucReg = 0; ucReg < RCC_REG_COUNT; ucReg++)
+    {
+        if (aulMasks[ucReg] != 0)
+        {
+            __IO uint32_t *pulRSTR = RCC_prvResetRegister(ucReg);
+            SET_BIT  (*pulRSTR, aulMasks[ucReg]);
+            CLEAR_BIT(*pulRSTR, aulMasks[ucReg]);
+        }
+    }
+}
+
 /** @} */
 
 /** @} */
@@ -0,0 +1,369 @@
+/**
+  ******************************************************************************
+  * @file    xpd_rtos.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers RTOS Integration Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_rtos.h>
+#include <xpd_utils.h>
+
+#ifdef __XPD_RTOS
+
+/** @addtogroup RTOS
+ * @{ */
+
+/* Bound driver handles, only extended at initialization */
+static RTOS_SyncType * rtos_pxSyncs = NULL;
+
+/* Finds the synchronization structure of the driver handle */
+static RTOS_SyncType * RTOS_prvFind(void * pvHandle)
+{
+    RTOS_SyncType * pxSync;
+
+    for (pxSync = rtos_pxSyncs; pxSync != NULL; pxSync = pxSync->Next)
+    {
+        if (pxSync->Handle == pvHandle)
+        {
+            break;
+        }
+    }
+    return pxSync;
+}
+
+/* Releases the waiting task with the operation result */
+static void RTOS_prvRelease(void * pvHandle, XPD_ReturnType eResult)
+{
+    RTOS_SyncType * pxSync = RTOS_prvFind(pvHandle);
+
+    if (pxSync != NULL)
+    {
+        pxSync->Result = eResult;
+        XPD_RTOS_SEM_GIVE_FROM_ISR(pxSync->Semaphore);
+    }
+}
+
+/** @defgroup RTOS_Exported_Functions RTOS Exported Functions
+ * @{ */
+
+/**
+ * @brief Binds a synchronization structure to the driver handle.
+ * @note  Only a single blocking operation shall be in progress on a driver handle at a time.
+ * @param pxSync: pointer to the synchronization structure
+ * @param pvHandle: pointer to the driver handle
+ */
+void RTOS_vBind(RTOS_SyncType * pxSync, void * pvHandle)
+{
+    pxSync->Handle = pvHandle;
+    pxSync->Result = XPD_OK;
+    (void) XPD_RTOS_SEM_INIT(pxSync->Semaphore);
+
+    XPD_ENTER_CRITICAL(pxSync);
+
+    pxSync->Next = rtos_pxSyncs;
+    rtos_pxSyncs = pxSync;
+
+    XPD_EXIT_CRITICAL(pxSync);
+}
+
+/**
+ * @brief Driver handle callback which releases the task waiting for the operation.
+ * @param pvHandle: pointer to the driver handle
+ */
+void RTOS_vComplete(void * pvHandle)
+{
+    RTOS_prvRelease(pvHandle, XPD_OK);
+}
+
+/**
+ * @brief Driver handle callback which releases the task waiting for the operation with error.
+ * @param pvHandle: pointer to the driver handle
+ */
+void RTOS_vError(void * pvHandle)
+{
+    RTOS_prvRelease(pvHandle, XPD_ERROR);
+}
+
+/**
+ * @brief Discards the previous completions of the driver handle,
+ *        shall be called before the operation which is waited for is started.
+ *        Has no effect if the driver handle isn't bound.
+ * @param pvHandle: pointer to the driver handle
+ */
+void RTOS_vPrepare(void * pvHandle)
+{
+    RTOS_SyncType * pxSync = RTOS_prvFind(pvHandle);
+
+    if (pxSync != NULL)
+    {
+        (void) XPD_RTOS_SEM_TAKE(pxSync->Semaphore, 0);
+        pxSync->Result = XPD_OK;
+    }
+}
+
+/**
+ * @brief Puts the calling task to sleep until the operation of the driver handle completes.
+ *        This can be used with any driver operation which has a completion callback,
+ *        e.g. a DMA transfer whose Owner is the DMA handle itself.
+ * @param pvHandle: pointer to the driver handle
+ * @param ulTimeout: the timeout in ms
+ * @return ERROR if the driver handle isn't bound or the operation failed,
+ *         TIMEOUT if timed out, OK if it completed
+ */
+XPD_ReturnType RTOS_eWait(void * pvHandle, uint32_t ulTimeout)
+{
+    RTOS_SyncType * pxSync = RTOS_prvFind(pvHandle);
+    XPD_ReturnType eResult = XPD_TIMEOUT;
+
+    if (pxSync == NULL)
+    {
+        eResult = XPD_ERROR;
+    }
+    else if (XPD_RTOS_SEM_TAKE(pxSync->Semaphore, ulTimeout))
+    {
+        eResult = pxSync->Result;
+    }
+    return eResult;
+}
+
+/**
+ * @brief Transmits data and sleeps until completion or timeout.
+ *        The transfer is DMA-managed if a transmit DMA is set, interrupt-driven otherwise.
+ * @note  The transfer is not stopped when the timeout expires.
+ * @param pxUSART: pointer to the USART handle structure
+ * @param pvTxData: pointer to the data buffer
+ * @param usLength: amount of data transfers
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if DMA is in use, TIMEOUT if timed out, ERROR if the transfer failed, OK if complete
+ */
+XPD_ReturnType RTOS_eUSART_Transmit(
+        USART_HandleType *  pxUSART,
+        void *              pvTxData,
+        uint16_t            usLength,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    RTOS_vPrepare(pxUSART);
+
+#ifndef __XPD_USART_NO_DMA
+    if (pxUSART->DMA.Transmit != NULL)
+    {
+        eResult = USART_eTransmit_DMA(pxUSART, pvTxData, usLength);
+    }
+    else
+#endif
+    {
+        USART_vTransmit_IT(pxUSART, pvTxData, usLength);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxUSART, ulTimeout);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Receives data and sleeps until completion or timeout.
+ *        The transfer is DMA-managed if a receive DMA is set, interrupt-driven otherwise.
+ * @note  The transfer is not stopped when the timeout expires.
+ * @param pxUSART: pointer to the USART handle structure
+ * @param pvRxData: pointer to the data buffer
+ * @param usLength: amount of data transfers
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if DMA is in use, TIMEOUT if timed out, ERROR if the transfer failed, OK if complete
+ */
+XPD_ReturnType RTOS_eUSART_Receive(
+        USART_HandleType *  pxUSART,
+        void *              pvRxData,
+        uint16_t            usLength,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    RTOS_vPrepare(pxUSART);
+
+#ifndef __XPD_USART_NO_DMA
+    if (pxUSART->DMA.Receive != NULL)
+    {
+        eResult = USART_eReceive_DMA(pxUSART, pvRxData, usLength);
+    }
+    else
+#endif
+    {
+        USART_vReceive_IT(pxUSART, pvRxData, usLength);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxUSART, ulTimeout);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Transmits data and sleeps until completion or timeout.
+ *        The transfer is DMA-managed if a transmit DMA is set, interrupt-driven otherwise.
+ * @note  The transfer is not stopped when the timeout expires.
+ * @param pxSPI: pointer to the SPI handle structure
+ * @param pvTxData: pointer to the data buffer
+ * @param usLength: amount of data transfers
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if DMA is in use, TIMEOUT if timed out, ERROR if the transfer failed, OK if complete
+ */
+XPD_ReturnType RTOS_eSPI_Send(
+        SPI_HandleType *    pxSPI,
+        void *              pvTxData,
+        uint16_t            usLength,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    RTOS_vPrepare(pxSPI);
+
+#ifndef __XPD_SPI_NO_DMA
+    if (pxSPI->DMA.Transmit != NULL)
+    {
+        eResult = SPI_eTransmit_DMA(pxSPI, pvTxData, usLength);
+    }
+    else
+#endif
+    {
+        SPI_vTransmit_IT(pxSPI, pvTxData, usLength);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxSPI, ulTimeout);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Receives data and sleeps until completion or timeout.
+ *        The transfer is DMA-managed if a receive DMA is set, interrupt-driven otherwise.
+ * @note  The transfer is not stopped when the timeout expires.
+ * @param pxSPI: pointer to the SPI handle structure
+ * @param pvRxData: pointer to the data buffer
+ * @param usLength: amount of data transfers
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if DMA is in use, TIMEOUT if timed out, ERROR if the transfer failed, OK if complete
+ */
+XPD_ReturnType RTOS_eSPI_Receive(
+        SPI_HandleType *    pxSPI,
+        void *              pvRxData,
+        uint16_t            usLength,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    RTOS_vPrepare(pxSPI);
+
+#ifndef __XPD_SPI_NO_DMA
+    if (pxSPI->DMA.Receive != NULL)
+    {
+        eResult = SPI_eReceive_DMA(pxSPI, pvRxData, usLength);
+    }
+    else
+#endif
+    {
+        SPI_vReceive_IT(pxSPI, pvRxData, usLength);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxSPI, ulTimeout);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Transmits and receives data and sleeps until completion or timeout.
+ *        The transfer is DMA-managed if both DMAs are set, interrupt-driven otherwise.
+ * @note  The transfer is not stopped when the timeout expires.
+ * @param pxSPI: pointer to the SPI handle structure
+ * @param pvTxData: pointer to the transmit data buffer
+ * @param pvRxData: pointer to the receive data buffer
+ * @param usLength: amount of data transfers
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if DMA is in use, TIMEOUT if timed out, ERROR if the transfer failed, OK if complete
+ */
+XPD_ReturnType RTOS_eSPI_SendReceive(
+        SPI_HandleType *    pxSPI,
+        void *              pvTxData,
+        void *              pvRxData,
+        uint16_t            usLength,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    RTOS_vPrepare(pxSPI);
+
+#ifndef __XPD_SPI_NO_DMA
+    if ((pxSPI->DMA.Transmit != NULL) && (pxSPI->DMA.Receive != NULL))
+    {
+        eResult = SPI_eSendReceive_DMA(pxSPI, pvTxData, pvRxData, usLength);
+    }
+    else
+#endif
+    {
+        SPI_vTransmitReceive_IT(pxSPI, pvTxData, pvRxData, usLength);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxSPI, ulTimeout);
+    }
+    return eResult;
+}
+
+#if defined(CAN) || defined(CAN1)
+/**
+ * @brief Transmits a frame and sleeps until completion or timeout.
+ * @note  The frame is not aborted when the timeout expires.
+ * @param pxCAN: pointer to the CAN handle structure
+ * @param pxFrame: pointer to the frame to transmit
+ * @param ulTimeout: the timeout in ms
+ * @return BUSY if no empty mailbox was available, TIMEOUT if timed out,
+ *         ERROR if an error was detected, OK if frame is sent
+ */
+XPD_ReturnType RTOS_eCAN_Send(
+        CAN_HandleType *    pxCAN,
+        CAN_FrameType *     pxFrame,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult;
+
+    RTOS_vPrepare(pxCAN);
+
+    eResult = CAN_eSend_IT(pxCAN, pxFrame);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = RTOS_eWait(pxCAN, ulTimeout);
+    }
+    return eResult;
+}
+#endif
+
+/** @} */
+
+/** @} */
+
+#endif /* __XPD_RTOS */
@@ -94,43 +94,10 @@ static XPD_ReturnType SPI_prvReceiveCRC(SPI_HandleType * pxSPI, uint32_t * ulTim
 }
 #endif
 
-static void SPI_prvDmaTransmitRedirect(void * pxDMA)
-{
-    SPI_HandleType * pxSPI = (SPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
-
-    if (DMA_eCircularMode((DMA_HandleType*)pxDMA) == 0)
-    {
-        /* Disable Tx DMA Request */
-        SPI_REG_BIT(pxSPI, CR2, TXDMAEN) = 0;
-
-        /* Clear overrun flag in 2 Lines communication mode because received data is not read */
-        if (SPI_REG_BIT(pxSPI, CR1, BIDIMODE) == 0)
-        {
-            /* Nothing to receive */
-            if (pxSPI->RxStream.length == 0)
-            {
-                /* Empty previously received data from data register  */
-                while (SPI_FLAG_STATUS(pxSPI, RXNE) != 0)
-                {
-                    (void) SPI_REG_BY_SIZE(&pxSPI->Inst->DR, pxSPI->RxStream.size);
-                }
-            }
-            SPI_FLAG_CLEAR(pxSPI, OVR);
-        }
-
-        /* Update stream status */
-        pxSPI->TxStream.buffer += pxSPI->TxStream.length * pxSPI->TxStream.size;
-        pxSPI->TxStream.length = 0;
-    }
-
-    XPD_SAFE_CALLBACK(pxSPI->Callbacks.Transmit, pxSPI);
-}
-
-static void SPI_prvDmaReceiveRedirect(void * pxDMA)
+#ifndef __XPD_SPI_NO_DMA
+static void SPI_prvDmaReceiveComplete(SPI_HandleType * pxSPI)
 {
-    SPI_HandleType * pxSPI = (SPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
-
-    if (DMA_eCircularMode((DMA_HandleType*)pxDMA) == 0)
+    if (DMA_eCircularMode(pxSPI->DMA.Receive) == 0)
     {
         /* Disable Rx DMA Request */
         SPI_REG_BIT(pxSPI, CR2, RXDMAEN) = 0;
@@ -159,11 +126,9 @@ static void SPI_prvDmaReceiveRedirect(void * pxDMA)
     XPD_SAFE_CALLBACK(pxSPI->Callbacks.Receive, pxSPI);
 }
 
-static void SPI_prvDmaTransmitReceiveRedirect(void * pxDMA)
+static void SPI_prvDmaTransmitReceiveComplete(SPI_HandleType * pxSPI)
 {
-    SPI_HandleType * pxSPI = (SPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
-
-    if (DMA_eCircularMode((DMA_HandleType*)pxDMA) == 0)
+    if (DMA_eCircularMode(pxSPI->DMA.Receive) == 0)
     {
         /* Disable DMA Requests */
         CLEAR_BIT(pxSPI->Inst->CR2.w, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
@@ -196,6 +161,16 @@ static void SPI_prvDmaTransmitReceiveRedirect(void * pxDMA)
     XPD_SAFE_CALLBACK(pxSPI->Callbacks.Receive, pxSPI);
 }
 
+static void SPI_prvDmaTransmitRedirect(void * pxDMA)
+{
+    SPI_vTransmitComplete_DMA((SPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner);
+}
+
+static void SPI_prvDmaReceiveRedirect(void * pxDMA)
+{
+    SPI_vReceiveComplete_DMA((SPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner);
+}
+
 #ifdef __XPD_DMA_ERROR_DETECT
 static void SPI_prvDmaErrorRedirect(void * pxDMA)
 {
@@ -206,6 +181,7 @@ static void SPI_prvDmaErrorRedirect(void * pxDMA)
     XPD_SAFE_CALLBACK(pxSPI->Callbacks.Error, pxSPI);
 }
 #endif
+#endif /* __XPD_SPI_NO_DMA */
 
 /**
  * @brief Enables the SPI peripheral.
@@ -925,6 +901,7 @@ void SPI_vIRQHandler(SPI_HandleType * pxSPI)
 #endif
 }
 
+#ifndef __XPD_SPI_NO_DMA
 /**
  * @brief Starts DMA-managed data transmission over SPI.
  * @note  The Transmit callback will be called when the last data is written to buffer,
@@ -1104,14 +1081,7 @@ XPD_ReturnType SPI_eSendReceive_DMA(
         pxSPI->DMA.Receive->Owner = pxSPI;
 
         /* Set the DMA transfer callbacks */
-        if (pxSPI->TxStream.buffer == NULL)
-        {
-            pxSPI->DMA.Receive->Callbacks.Complete  = SPI_prvDmaReceiveRedirect;
-        }
-        else
-        {
-            pxSPI->DMA.Receive->Callbacks.Complete  = SPI_prvDmaTransmitReceiveRedirect;
-        }
+        pxSPI->DMA.Receive->Callbacks.Complete      = SPI_prvDmaReceiveRedirect;
 #ifdef __XPD_DMA_ERROR_DETECT
         /* Set the DMA error callback */
         pxSPI->DMA.Receive->Callbacks.Error         = SPI_prvDmaErrorRedirect;
@@ -1185,6 +1155,68 @@ void SPI_vStop_DMA(SPI_HandleType * pxSPI)
     }
 }
 
+/**
+ * @brief Finishes the DMA-managed data transmission over SPI.
+ * @note  Called by the DMA interrupt through the handle callbacks,
+ *        or directly from a vector defined by @ref DMA_IRQ_BIND.
+ * @param pxSPI: pointer to the SPI handle structure
+ */
+void SPI_vTransmitComplete_DMA(SPI_HandleType * pxSPI)
+{
+    /* full-duplex transfers are closed by the reception complete handler */
+    if (SPI_REG_BIT(pxSPI, CR2, RXDMAEN) != 0)
+    {
+        return;
+    }
+
+    if (DMA_eCircularMode(pxSPI->DMA.Transmit) == 0)
+    {
+        /* Disable Tx DMA Request */
+        SPI_REG_BIT(pxSPI, CR2, TXDMAEN) = 0;
+
+        /* Clear overrun flag in 2 Lines communication mode because received data is not read */
+        if (SPI_REG_BIT(pxSPI, CR1, BIDIMODE) == 0)
+        {
+            /* Nothing to receive */
+            if (pxSPI->RxStream.length == 0)
+            {
+                /* Empty previously received data from data register  */
+                while (SPI_FLAG_STATUS(pxSPI, RXNE) != 0)
+                {
+                    (void) SPI_REG_BY_SIZE(&pxSPI->Inst->DR, pxSPI->RxStream.size);
+                }
+            }
+            SPI_FLAG_CLEAR(pxSPI, OVR);
+        }
+
+        /* Update stream status */
+        pxSPI->TxStream.buffer += pxSPI->TxStream.length * pxSPI->TxStream.size;
+        pxSPI->TxStream.length = 0;
+    }
+
+    XPD_SAFE_CALLBACK(pxSPI->Callbacks.Transmit, pxSPI);
+}
+
+/**
+ * @brief Finishes the DMA-managed data reception or full-duplex transfer over SPI.
+ * @note  Called by the DMA interrupt through the handle callbacks,
+ *        or directly from a vector defined by @ref DMA_IRQ_BIND.
+ * @param pxSPI: pointer to the SPI handle structure
+ */
+void SPI_vReceiveComplete_DMA(SPI_HandleType * pxSPI)
+{
+    /* dummy data transmission is not reported */
+    if ((SPI_REG_BIT(pxSPI, CR2, TXDMAEN) == 0) || (pxSPI->TxStream.buffer == NULL))
+    {
+        SPI_prvDmaReceiveComplete(pxSPI);
+    }
+    else
+    {
+        SPI_prvDmaTransmitReceiveComplete(pxSPI);
+    }
+}
+#endif /* __XPD_SPI_NO_DMA */
+
 /** @} */
 
 /** @} */
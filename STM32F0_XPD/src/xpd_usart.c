@@ -66,6 +66,7 @@
 #define USART_BAUDRATEMODE_MASK     0
 #endif
 
+#ifndef __XPD_USART_NO_DMA
 #ifdef __XPD_DMA_ERROR_DETECT
 static void USART_prvDmaErrorRedirect(void *pxDMA)
 {
@@ -79,43 +80,14 @@ static void USART_prvDmaErrorRedirect(void *pxDMA)
 
 static void USART_prvDmaTransmitRedirect(void *pxDMA)
 {
-    USART_HandleType * pxUSART = (USART_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
-
-    /* DMA normal mode */
-    if (DMA_eCircularMode((DMA_HandleType*)pxDMA) == 0)
-    {
-        /* Disable Tx DMA Request */
-        USART_REG_BIT(pxUSART, CR3, DMAT) = 0;
-
-        /* Update stream status */
-        pxUSART->TxStream.buffer += pxUSART->TxStream.length * pxUSART->TxStream.size;
-        pxUSART->TxStream.length = 0;
-    }
-
-    /* If the completion of the character sending isn't waited for,
-     * provide callback now */
-    if (USART_REG_BIT(pxUSART, CR1, TCIE) == 0)
-    {
-        XPD_SAFE_CALLBACK(pxUSART->Callbacks.Transmit, pxUSART);
-    }
+    USART_vTransmitComplete_DMA((USART_HandleType*) ((DMA_HandleType*) pxDMA)->Owner);
 }
 
 static void USART_prvDmaReceiveRedirect(void *pxDMA)
 {
-    USART_HandleType * pxUSART = (USART_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
-
-    /* DMA normal mode */
-    if (DMA_eCircularMode((DMA_HandleType*)pxDMA) == 0)
-    {
-        /* Disable Rx DMA Request */
-        USART_REG_BIT(pxUSART, CR3, DMAR) = 0;
-
-        /* Update stream status */
-        pxUSART->RxStream.buffer += pxUSART->RxStream.length * pxUSART->RxStream.size;
-        pxUSART->RxStream.length = 0;
-    }
-    XPD_SAFE_CALLBACK(pxUSART->Callbacks.Receive, pxUSART);
+    USART_vReceiveComplete_DMA((USART_HandleType*) ((DMA_HandleType*) pxDMA)->Owner);
 }
+#endif /* __XPD_USART_NO_DMA */
 
 /* Calculates and configures the baudrate */
 static void USART_prvSetBaudrate(USART_HandleType * pxUSART, uint32_t ulBaudrate)
@@ -658,8 +630,13 @@ void USART_vIRQHandler(USART_HandleType * pxUSART)
 {
     uint32_t ulSR  = USART_STATR(pxUSART);
     uint32_t ulCR1 = pxUSART->Inst->CR1.w;
+#ifndef __XPD_USART_NO_LIN
     uint32_t ulCR2 = pxUSART->Inst->CR2.w;
+#endif /* __XPD_USART_NO_LIN */
+#if defined(__XPD_USART_ERROR_DETECT) || !defined(__XPD_USART_NO_CTS) || \
+   ((__USART_PERIPHERAL_VERSION > 2) && !defined(__XPD_USART_NO_WAKEUP))
     uint32_t ulCR3 = pxUSART->Inst->CR3.w;
+#endif
 
 #ifdef __XPD_USART_ERROR_DETECT
     /* parity error */
@@ -753,6 +730,7 @@ void USART_vIRQHandler(USART_HandleType * pxUSART)
         XPD_SAFE_CALLBACK(pxUSART->Callbacks.Idle, pxUSART);
     }
 
+#ifndef __XPD_USART_NO_LIN
     /* LIN break detected */
     if (((ulSR & USART_STATF(LBD)) != 0) && ((ulCR2 & USART_CR2_LBDIE) != 0))
     {
@@ -760,7 +738,9 @@ void USART_vIRQHandler(USART_HandleType * pxUSART)
 
         XPD_SAFE_CALLBACK(pxUSART->Callbacks.Break, pxUSART);
     }
+#endif /* __XPD_USART_NO_LIN */
 
+#ifndef __XPD_USART_NO_CTS
     /* CTS detected */
     if (((ulSR & USART_STATF(CTS)) != 0) && ((ulCR3 & USART_CR3_CTSIE) != 0))
     {
@@ -768,8 +748,9 @@ void USART_vIRQHandler(USART_HandleType * pxUSART)
 
         XPD_SAFE_CALLBACK(pxUSART->Callbacks.ClearToSend, pxUSART);
     }
+#endif /* __XPD_USART_NO_CTS */
 
-#if (__USART_PERIPHERAL_VERSION > 2)
+#if (__USART_PERIPHERAL_VERSION > 2) && !defined(__XPD_USART_NO_WAKEUP)
     /* UART wakeup from Stop mode interrupt occurred */
     if(((ulSR & USART_ISR_WUF) != 0) && ((ulCR3 & USART_CR3_WUFIE) != 0))
     {
@@ -778,6 +759,7 @@ void USART_vIRQHandler(USART_HandleType * pxUSART)
 #endif
 }
 
+#ifndef __XPD_USART_NO_DMA
 /**
  * @brief Starts DMA-managed data transmission over USART.
  * @param pxUSART: pointer to the USART handle structure
@@ -1007,6 +989,55 @@ void USART_vStop_DMA(USART_HandleType * pxUSART)
     }
 }
 
+/**
+ * @brief Finishes the DMA-managed data transmission over USART.
+ * @note  Called by the DMA interrupt through the handle callbacks,
+ *        or directly from a vector defined by @ref DMA_IRQ_BIND.
+ * @param pxUSART: pointer to the USART handle structure
+ */
+void USART_vTransmitComplete_DMA(USART_HandleType * pxUSART)
+{
+    /* DMA normal mode */
+    if (DMA_eCircularMode(pxUSART->DMA.Transmit) == 0)
+    {
+        /* Disable Tx DMA Request */
+        USART_REG_BIT(pxUSART, CR3, DMAT) = 0;
+
+        /* Update stream status */
+        pxUSART->TxStream.buffer += pxUSART->TxStream.length * pxUSART->TxStream.size;
+        pxUSART->TxStream.length = 0;
+    }
+
+    /* If the completion of the character sending isn't waited for,
+     * provide callback now */
+    if (USART_REG_BIT(pxUSART, CR1, TCIE) == 0)
+    {
+        XPD_SAFE_CALLBACK(pxUSART->Callbacks.Transmit, pxUSART);
+    }
+}
+
+/**
+ * @brief Finishes the DMA-managed data reception over USART.
+ * @note  Called by the DMA interrupt through the handle callbacks,
+ *        or directly from a vector defined by @ref DMA_IRQ_BIND.
+ * @param pxUSART: pointer to the USART handle structure
+ */
+void USART_vReceiveComplete_DMA(USART_HandleType * pxUSART)
+{
+    /* DMA normal mode */
+    if (DMA_eCircularMode(pxUSART->DMA.Receive) == 0)
+    {
+        /* Disable Rx DMA Request */
+        USART_REG_BIT(pxUSART, CR3, DMAR) = 0;
+
+        /* Update stream status */
+        pxUSART->RxStream.buffer += pxUSART->RxStream.length * pxUSART->RxStream.size;
+        pxUSART->RxStream.length = 0;
+    }
+    XPD_SAFE_CALLBACK(pxUSART->Callbacks.Receive, pxUSART);
+}
+#endif /* __XPD_USART_NO_DMA */
+
 #ifdef USART_CR3_OVRDIS
 /**
  * @brief Sets the overrun detection configuration for the USART (enabled by default)
@@ -1156,6 +1187,7 @@ void USART_vInitSync(USART_HandleType * pxUSART, const USRT_InitType * pxConfig)
 
 /** @} */
 
+#ifndef __XPD_USART_NO_LIN
 /** @addtogroup LIN
  * @{ */
 
@@ -1217,6 +1249,7 @@ void USART_vSendBreak(USART_HandleType * pxUSART)
 /** @} */
 
 /** @} */
+#endif /* __XPD_USART_NO_LIN */
 
 /** @addtogroup MSUART
  * @{ */
@@ -1224,12 +1257,13 @@ void USART_vSendBreak(USART_HandleType * pxUSART)
 /** @defgroup MSUART_Exported_Functions MultiSlave UART Exported Functions
  * @{ */
 
+#ifndef __XPD_USART_NO_MULTISLAVE
 /**
  * @brief Sets the UART peripheral in MultiProcessor slave mode
  * @param pxUSART: pointer to the USART handle structure
  * @param pxConfig: MultiSlave UART setup configuration
  */
-void USART_InitMultiSlave(USART_HandleType * pxUSART, const MSUART_InitType * pxConfig)
+void USART_vInitMultiSlave(USART_HandleType * pxUSART, const MSUART_InitType * pxConfig)
 {
     USART_prvPreinit(pxUSART, pxConfig->DataSize, pxConfig->Parity);
 
@@ -1282,11 +1316,13 @@ void USART_InitMultiSlave(USART_HandleType * pxUSART, const MSUART_InitType * px
     }
 #endif
 }
+#endif /* __XPD_USART_NO_MULTISLAVE */
 
 /** @} */
 
 /** @} */
 
+#ifndef __XPD_USART_NO_SMARTCARD
 /** @addtogroup SmartCard
  * @{ */
 
@@ -1354,7 +1390,9 @@ void USART_vInitSmartCard(USART_HandleType * pxUSART, const SmartCard_InitType *
 /** @} */
 
 /** @} */
+#endif /* __XPD_USART_NO_SMARTCARD */
 
+#ifndef __XPD_USART_NO_IRDA
 /** @addtogroup IrDA
  * @{ */
 
@@ -1400,6 +1438,7 @@ void USART_vInitIrDA(USART_HandleType * pxUSART, const IrDA_InitType * pxConfig)
 /** @} */
 
 /** @} */
+#endif /* __XPD_USART_NO_IRDA */
 
 #ifdef USART_CR3_DEM
 /** @addtogroup RS485
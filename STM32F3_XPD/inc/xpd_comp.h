@@ -0,0 +1,213 @@
+/**
+  ******************************************************************************
+  * @file    xpd_comp.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Comparator Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_COMP_H_
+#define __XPD_COMP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_exti.h>
+#include <xpd_rcc.h>
+
+#if defined(COMP_CSR_COMPxEN)
+
+/** @defgroup COMP
+ * @{ */
+
+/** @defgroup COMP_Exported_Types COMP Exported Types
+ * @{ */
+
+/** @brief COMP inverting input selection */
+typedef enum
+{
+    COMP_INVERTING_VREFINT_1_4 = 0, /*!< 1/4 of VREFINT */
+    COMP_INVERTING_VREFINT_1_2 = 1, /*!< 1/2 of VREFINT */
+    COMP_INVERTING_VREFINT_3_4 = 2, /*!< 3/4 of VREFINT */
+    COMP_INVERTING_VREFINT     = 3, /*!< VREFINT */
+    COMP_INVERTING_DAC1_CH1    = 4, /*!< DAC1 channel 1 output */
+    COMP_INVERTING_DAC1_CH2    = 5, /*!< DAC1 channel 2 output */
+    COMP_INVERTING_IO1         = 6, /*!< First dedicated input pin */
+    COMP_INVERTING_IO2         = 7, /*!< Second dedicated input pin (or DAC2 channel 1) */
+}COMP_InvertingInputType;
+
+/** @brief COMP output routing to timer break inputs */
+typedef enum
+{
+    COMP_OUTPUT_NONE                = 0x0, /*!< Output only available on GPIO and EXTI */
+    COMP_OUTPUT_TIM1_BKIN           = 0x1, /*!< TIM1 break input */
+    COMP_OUTPUT_TIM1_BKIN2          = 0x2, /*!< TIM1 break input 2 */
+    COMP_OUTPUT_TIM8_BKIN           = 0x3, /*!< TIM8 break input */
+    COMP_OUTPUT_TIM8_BKIN2          = 0x4, /*!< TIM8 break input 2 */
+    COMP_OUTPUT_TIM1_TIM8_BKIN2     = 0x5, /*!< TIM1 and TIM8 break input 2 */
+#ifdef TIM20
+    COMP_OUTPUT_TIM20_BKIN          = 0xA, /*!< TIM20 break input */
+    COMP_OUTPUT_TIM20_BKIN2         = 0xB, /*!< TIM20 break input 2 */
+    COMP_OUTPUT_TIM1_TIM8_TIM20_BKIN2 = 0xC, /*!< TIM1, TIM8 and TIM20 break input 2 */
+#endif
+}COMP_OutputType;
+
+#ifdef COMP_CSR_COMPxHYST
+/** @brief COMP hysteresis levels */
+typedef enum
+{
+    COMP_HYSTERESIS_NONE   = 0, /*!< No hysteresis */
+    COMP_HYSTERESIS_LOW    = 1, /*!< Low hysteresis */
+    COMP_HYSTERESIS_MEDIUM = 2, /*!< Medium hysteresis */
+    COMP_HYSTERESIS_HIGH   = 3, /*!< High hysteresis */
+}COMP_HysteresisType;
+#endif
+
+#ifdef COMP_CSR_COMPxMODE
+/** @brief COMP power modes */
+typedef enum
+{
+    COMP_POWER_HIGHSPEED     = 0, /*!< High speed, highest consumption */
+    COMP_POWER_MEDIUMSPEED   = 1, /*!< Medium speed, medium consumption */
+    COMP_POWER_LOWPOWER      = 2, /*!< Low speed, low consumption */
+    COMP_POWER_ULTRALOWPOWER = 3, /*!< Lowest speed, lowest consumption */
+}COMP_PowerModeType;
+#endif
+
+/** @brief COMP setup structure */
+typedef struct
+{
+    COMP_InvertingInputType InvertingInput;    /*!< Inverting input (reference) selection */
+#ifdef COMP_CSR_COMPxNONINSEL
+    uint8_t                 NonInvertingInput; /*!< Non-inverting input pin selection [0 .. 1] */
+#endif
+    COMP_OutputType         Output;            /*!< Output routing to timer break inputs,
+                                                    other values select comparator specific timer inputs */
+    FunctionalState         InvertedOutput;    /*!< Output polarity inversion */
+    uint8_t                 Blanking;          /*!< Comparator specific blanking timer output compare channel,
+                                                    0 disables blanking */
+#ifdef COMP_CSR_COMPxHYST
+    COMP_HysteresisType     Hysteresis;        /*!< Input hysteresis */
+#endif
+#ifdef COMP_CSR_COMPxMODE
+    COMP_PowerModeType      PowerMode;         /*!< Speed and consumption trade-off */
+#endif
+#ifdef COMP_CSR_COMPxWNDWEN
+    FunctionalState         WindowMode;        /*!< Non-inverting input is connected to the
+                                                    preceding comparator's (even comparators only) */
+#endif
+}COMP_InitType;
+
+/** @brief COMP Handle structure */
+typedef struct
+{
+    COMP_TypeDef * Inst;                     /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType Trigger;      /*!< Output edge detected on the EXTI line callback */
+    }Callbacks;                              /*   Handle Callbacks */
+}COMP_HandleType;
+
+/** @} */
+
+/** @defgroup COMP_Exported_Macros COMP Exported Macros
+ * @{ */
+
+/**
+ * @brief COMP Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the COMP peripheral instance.
+ */
+#define         COMP_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief COMP register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         COMP_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/** @} */
+
+/** @addtogroup COMP_Exported_Functions
+ * @{ */
+void            COMP_vInit              (COMP_HandleType * pxCOMP,
+                                         const COMP_InitType * pxConfig);
+void            COMP_vDeinit            (COMP_HandleType * pxCOMP);
+
+uint8_t         COMP_ucExtiLine         (COMP_HandleType * pxCOMP);
+void            COMP_vExtiConfig        (COMP_HandleType * pxCOMP,
+                                         const EXTI_InitType * pxConfig);
+void            COMP_vIRQHandler        (COMP_HandleType * pxCOMP);
+
+/**
+ * @brief Enables the comparator.
+ * @note  The comparator output is valid after the startup time (a few microseconds).
+ * @param pxCOMP: pointer to the COMP handle structure
+ */
+__STATIC_INLINE void COMP_vEnable(COMP_HandleType * pxCOMP)
+{
+    SET_BIT(pxCOMP->Inst->CSR.w, COMP_CSR_COMPxEN);
+}
+
+/**
+ * @brief Disables the comparator.
+ * @param pxCOMP: pointer to the COMP handle structure
+ */
+__STATIC_INLINE void COMP_vDisable(COMP_HandleType * pxCOMP)
+{
+    CLEAR_BIT(pxCOMP->Inst->CSR.w, COMP_CSR_COMPxEN);
+}
+
+/**
+ * @brief Gets the current output level of the comparator.
+ * @param pxCOMP: pointer to the COMP handle structure
+ * @return SET if the output is high, RESET otherwise
+ */
+__STATIC_INLINE FlagStatus COMP_eGetOutput(COMP_HandleType * pxCOMP)
+{
+    return ((pxCOMP->Inst->CSR.w & COMP_CSR_COMPxOUT) != 0) ? SET : RESET;
+}
+
+/**
+ * @brief Locks the comparator configuration (including the break routing)
+ *        until the next system reset.
+ * @param pxCOMP: pointer to the COMP handle structure
+ */
+__STATIC_INLINE void COMP_vLock(COMP_HandleType * pxCOMP)
+{
+    SET_BIT(pxCOMP->Inst->CSR.w, COMP_CSR_COMPxLOCK);
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* COMP_CSR_COMPxEN */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_COMP_H_ */
@@ -68,20 +68,20 @@ __STATIC_INLINE FlagStatus EXTI_eGetFlag(uint8_t ucLine)
 #ifdef EXTI_BB
     if (ucLine < 32)
     {
-        return EXTI_BB->PR[ucLine];
+        return (FlagStatus)EXTI_BB->PR[ucLine];
     }
     else
     {
-        return EXTI_BB->PR2[ucLine - 32];
+        return (FlagStatus)EXTI_BB->PR2[ucLine - 32];
     }
 #else
     if (ucLine < 32)
     {
-        return (EXTI->PR >> ucLine) & 1;
+        return (FlagStatus)((EXTI->PR >> ucLine) & 1);
     }
     else
     {
-        return (EXTI->PR2 >> (ucLine - 32)) & 1;
+        return (FlagStatus)((EXTI->PR2 >> (ucLine - 32)) & 1);
     }
 #endif
 }
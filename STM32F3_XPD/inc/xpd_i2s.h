@@ -4,7 +4,7 @@
   * @author  Benedek Kupper
   * @version 0.1
   * @date    2018-01-28
-  * @brief   STM32 eXtensible Peripheral Drivers CEC Module
+  * @brief   STM32 eXtensible Peripheral Drivers I2S Module
   *
   * Copyright (c) 2018 Benedek Kupper
   *
@@ -29,11 +29,189 @@ extern "C"
 #endif
 
 #include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(SPI_I2SCFGR_I2SMOD)
+
+/** @defgroup I2S
+ * @{ */
+
+/** @defgroup I2S_Exported_Types I2S Exported Types
+ * @{ */
+
+/** @brief I2S operating modes */
+typedef enum
+{
+    I2S_MODE_SLAVE_TX  = 0,                     /*!< Slave transmitter */
+    I2S_MODE_SLAVE_RX  = SPI_I2SCFGR_I2SCFG_0,  /*!< Slave receiver */
+    I2S_MODE_MASTER_TX = SPI_I2SCFGR_I2SCFG_1,  /*!< Master transmitter */
+    I2S_MODE_MASTER_RX = SPI_I2SCFGR_I2SCFG,    /*!< Master receiver */
+}I2S_ModeType;
+
+/** @brief I2S audio standards */
+typedef enum
+{
+    I2S_STANDARD_PHILIPS   = 0,                                         /*!< I2S Philips standard */
+    I2S_STANDARD_MSB       = SPI_I2SCFGR_I2SSTD_0,                      /*!< Left justified standard */
+    I2S_STANDARD_LSB       = SPI_I2SCFGR_I2SSTD_1,                      /*!< Right justified standard */
+    I2S_STANDARD_PCM_SHORT = SPI_I2SCFGR_I2SSTD,                        /*!< PCM standard with short frame sync */
+    I2S_STANDARD_PCM_LONG  = SPI_I2SCFGR_I2SSTD | SPI_I2SCFGR_PCMSYNC,  /*!< PCM standard with long frame sync */
+}I2S_StandardType;
+
+/** @brief I2S data and channel lengths */
+typedef enum
+{
+    I2S_FRAME_16BIT          = 0,                                       /*!< 16 bit data in 16 bit channel */
+    I2S_FRAME_16BIT_EXTENDED = SPI_I2SCFGR_CHLEN,                       /*!< 16 bit data in 32 bit channel */
+    I2S_FRAME_24BIT          = SPI_I2SCFGR_CHLEN | SPI_I2SCFGR_DATLEN_0,/*!< 24 bit data in 32 bit channel */
+    I2S_FRAME_32BIT          = SPI_I2SCFGR_CHLEN | SPI_I2SCFGR_DATLEN_1,/*!< 32 bit data in 32 bit channel */
+}I2S_FrameType;
+
+/** @brief I2S setup structure */
+typedef struct
+{
+    I2S_ModeType     Mode;          /*!< Operating mode of the main instance */
+    I2S_StandardType Standard;      /*!< Audio standard */
+    I2S_FrameType    Frame;         /*!< Data and channel lengths */
+    ActiveLevelType  Polarity;      /*!< Clock steady state level */
+    FunctionalState  MasterClock;   /*!< Master clock output (256 * sample rate) */
+    uint32_t         AudioFreq;     /*!< Sample rate in Hz (only used in master modes) */
+}I2S_InitType;
+
+/** @brief I2S error types */
+typedef enum
+{
+    I2S_ERROR_NONE      = 0, /*!< No error */
+    I2S_ERROR_UNDERRUN  = 1, /*!< Transmit underrun (slave transmitter) */
+    I2S_ERROR_OVERRUN   = 2, /*!< Receive overrun */
+    I2S_ERROR_FRAME     = 4, /*!< Frame error (slave) */
+    I2S_ERROR_DMA       = 8, /*!< DMA transfer error */
+}I2S_ErrorType;
+
+/** @brief I2S Handle structure */
+typedef struct
+{
+    SPI_TypeDef * Inst;                      /*!< The address of the peripheral instance used by the handle */
+    SPI_TypeDef * Ext;                       /*!< The address of the full-duplex extension instance, or NULL */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Transmit;     /*!< Transmit block consumed callback, TxBlock can be refilled */
+        XPD_HandleCallbackType Receive;      /*!< Receive block filled callback, RxBlock can be processed */
+        XPD_HandleCallbackType Error;        /*!< Underrun, overrun or DMA error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        DMA_HandleType * Transmit;           /*!< DMA handle for data transmission */
+        DMA_HandleType * Receive;            /*!< DMA handle for data reception */
+    }DMA;                                    /*   DMA handle references */
+    struct {
+        uint16_t * Buffer;                   /*!< [Internal] Start of the stream buffer */
+        uint16_t HalfLength;                 /*!< [Internal] Half of the buffer length in half-words */
+    }TxStream, RxStream;                     /*   DMA stream buffers */
+    uint16_t * volatile TxBlock;             /*!< The transmit block which is free to be filled */
+    uint16_t * volatile RxBlock;             /*!< The receive block which is ready to be processed */
+    RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
+    volatile I2S_ErrorType Errors;           /*!< Streaming errors */
+}I2S_HandleType;
+
+/** @} */
+
+/** @defgroup I2S_Exported_Macros I2S Exported Macros
+ * @{ */
+
+/**
+ * @brief I2S Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SPI peripheral instance.
+ */
+#define         I2S_INST2HANDLE(HANDLE,INSTANCE)            \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->Ext     = NULL,                              \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief I2S full-duplex instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SPI peripheral instance.
+ * @param EXTENSION: specifies the I2Sx_ext peripheral instance of the SPI.
+ */
+#define         I2S_INST2HANDLE_FULLDUPLEX(HANDLE,INSTANCE,EXTENSION) \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->Ext     = (EXTENSION),                       \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief I2S register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         I2S_REG_BIT(HANDLE, REG_NAME, BIT_NAME)     \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified I2S flag of the main instance.
+ * @param  HANDLE: specifies the I2S Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg TXE:     Transmit empty
+ *            @arg RXNE:    Receive not empty
+ *            @arg CHSIDE:  Channel side (0: left, 1: right)
+ *            @arg UDR:     Underrun
+ *            @arg OVR:     Overrun
+ *            @arg BSY:     Busy
+ *            @arg FRE:     Frame format error
+ */
+#define         I2S_FLAG_STATUS(HANDLE, FLAG_NAME)          \
+    (I2S_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/**
+ * @brief  Number of I2S kernel clock cycles in a sample period, before the prescaling.
+ * @param  MCLK: the master clock output state
+ * @param  FRAME: the @ref I2S_FrameType
+ */
+#define         I2S_CLOCK_RATIO(MCLK, FRAME)                \
+    (((MCLK) != DISABLE) ? 256 : ((((FRAME) & SPI_I2SCFGR_CHLEN) != 0) ? 64 : 32))
+
+/** @} */
+
+/** @addtogroup I2S_Exported_Functions
+ * @{ */
+XPD_ReturnType  I2S_eInit               (I2S_HandleType * pxI2S,
+                                         const I2S_InitType * pxConfig);
+void            I2S_vDeinit             (I2S_HandleType * pxI2S);
+
+XPD_ReturnType  I2S_eStart_DMA          (I2S_HandleType * pxI2S,
+                                         void * pvTxBuffer,
+                                         void * pvRxBuffer,
+                                         uint16_t usLength);
+void            I2S_vStop_DMA           (I2S_HandleType * pxI2S);
+
+void            I2S_vIRQHandler         (I2S_HandleType * pxI2S);
+
+uint32_t        I2S_ulGetAudioFreq      (I2S_HandleType * pxI2S);
+
+/**
+ * @brief Gets the error state of the I2S.
+ * @param pxI2S: pointer to the I2S handle structure
+ * @return Current I2S error state
+ */
+__STATIC_INLINE I2S_ErrorType I2S_eGetError(I2S_HandleType * pxI2S)
+{
+    return pxI2S->Errors;
+}
+
+/** @} */
+
+/** @} */
 
 #define XPD_I2S_API
 #include <xpd_rcc_pc.h>
 #undef XPD_I2S_API
 
+#endif /* SPI_I2SCFGR_I2SMOD */
+
 #ifdef __cplusplus
 }
 #endif
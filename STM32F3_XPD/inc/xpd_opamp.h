@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    xpd_opamp.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Operational Amplifier Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_OPAMP_H_
+#define __XPD_OPAMP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(OPAMP_CSR_OPAMPxEN)
+
+/** @defgroup OPAMP
+ * @{ */
+
+/** @defgroup OPAMP_Exported_Types OPAMP Exported Types
+ * @{ */
+
+/** @brief OPAMP modes */
+typedef enum
+{
+    OPAMP_MODE_STANDALONE = 0, /*!< Inverting input is connected to a pin */
+    OPAMP_MODE_PGA        = 2, /*!< Programmable gain amplifier with internal feedback */
+    OPAMP_MODE_FOLLOWER   = 3, /*!< Voltage follower */
+}OPAMP_ModeType;
+
+/** @brief OPAMP PGA gains */
+typedef enum
+{
+    OPAMP_PGA_GAIN_2  = 0, /*!< Non-inverting gain of 2 */
+    OPAMP_PGA_GAIN_4  = 1, /*!< Non-inverting gain of 4 */
+    OPAMP_PGA_GAIN_8  = 2, /*!< Non-inverting gain of 8 */
+    OPAMP_PGA_GAIN_16 = 3, /*!< Non-inverting gain of 16 */
+}OPAMP_PgaGainType;
+
+/** @brief OPAMP setup structure */
+typedef struct
+{
+    OPAMP_ModeType    Mode;              /*!< Operating mode */
+    uint8_t           NonInvertingInput; /*!< Non-inverting input pin selection [0 .. 3] */
+    uint8_t           InvertingInput;    /*!< Inverting input pin selection [0 .. 1] (standalone mode only) */
+    OPAMP_PgaGainType PgaGain;           /*!< Gain (PGA mode only) */
+}OPAMP_InitType;
+
+/** @brief OPAMP Handle structure */
+typedef struct
+{
+    OPAMP_TypeDef * Inst;                    /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs) */
+    }Callbacks;                              /*   Handle Callbacks */
+}OPAMP_HandleType;
+
+/** @} */
+
+/** @defgroup OPAMP_Exported_Macros OPAMP Exported Macros
+ * @{ */
+
+/**
+ * @brief OPAMP Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the OPAMP peripheral instance.
+ */
+#define         OPAMP_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief OPAMP register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         OPAMP_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/** @} */
+
+/** @addtogroup OPAMP_Exported_Functions
+ * @{ */
+void            OPAMP_vInit             (OPAMP_HandleType * pxOPAMP,
+                                         const OPAMP_InitType * pxConfig);
+void            OPAMP_vDeinit           (OPAMP_HandleType * pxOPAMP);
+
+void            OPAMP_vCalibrate        (OPAMP_HandleType * pxOPAMP);
+
+/**
+ * @brief Enables the operational amplifier.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+__STATIC_INLINE void OPAMP_vEnable(OPAMP_HandleType * pxOPAMP)
+{
+    OPAMP_REG_BIT(pxOPAMP, CSR, EN) = 1;
+}
+
+/**
+ * @brief Disables the operational amplifier.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+__STATIC_INLINE void OPAMP_vDisable(OPAMP_HandleType * pxOPAMP)
+{
+    OPAMP_REG_BIT(pxOPAMP, CSR, EN) = 0;
+}
+
+/**
+ * @brief Locks the operational amplifier configuration until the next system reset.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+__STATIC_INLINE void OPAMP_vLock(OPAMP_HandleType * pxOPAMP)
+{
+    OPAMP_REG_BIT(pxOPAMP, CSR, LOCK) = 1;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* OPAMP_CSR_OPAMPxEN */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_OPAMP_H_ */
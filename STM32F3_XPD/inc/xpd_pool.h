@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file    xpd_pool.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Buffer Pool Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_POOL_H_
+#define __XPD_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+
+/** @defgroup POOL
+ * @brief    Fixed-size block buffer pool with reference counting. The buffers are
+ *           plain data pointers, so they can be passed to any XPD transfer function,
+ *           and handed over between interrupt and thread contexts without copying.
+ * @{ */
+
+/** @defgroup POOL_Exported_Types POOL Exported Types
+ * @{ */
+
+/** @brief POOL size class structure */
+typedef struct
+{
+    void *            Memory;       /*!< Block storage of POOL_MEMORY_SIZE(BlockSize, BlockCount) bytes,
+                                         word aligned */
+    uint16_t          BlockSize;    /*!< Usable data size of each block in bytes */
+    uint16_t          BlockCount;   /*!< Number of blocks in the class */
+    void * volatile   Free;         /*!< [Internal] Head of the free block list */
+    volatile uint32_t Used;         /*!< Number of allocated blocks */
+    volatile uint32_t HighWater;    /*!< Largest number of simultaneously allocated blocks */
+    volatile uint32_t Failures;     /*!< Allocations which found the class exhausted */
+}POOL_ClassType;
+
+/** @brief POOL Handle structure */
+typedef struct
+{
+    POOL_ClassType *  Classes;      /*!< Size classes in ascending block size order */
+    uint8_t           Count;        /*!< Number of size classes */
+    volatile uint32_t Failures;     /*!< Allocations which could not be served by any class */
+}POOL_HandleType;
+
+/** @} */
+
+/** @defgroup POOL_Exported_Macros POOL Exported Macros
+ * @{ */
+
+/** @brief Size of the block header preceding the buffer data */
+#define POOL_HEADER_SIZE                8
+
+/**
+ * @brief  Calculates the storage size of a size class.
+ * @param  BLOCK_SIZE: the usable data size of each block in bytes
+ * @param  BLOCK_COUNT: the number of blocks
+ */
+#define POOL_MEMORY_SIZE(BLOCK_SIZE, BLOCK_COUNT)   \
+    ((POOL_HEADER_SIZE + (((BLOCK_SIZE) + 3) & ~3)) * (BLOCK_COUNT))
+
+/**
+ * @brief  Defines a word aligned storage for a size class.
+ * @param  NAME: the name of the storage array
+ * @param  BLOCK_SIZE: the usable data size of each block in bytes
+ * @param  BLOCK_COUNT: the number of blocks
+ */
+#define POOL_MEMORY_DEFINE(NAME, BLOCK_SIZE, BLOCK_COUNT)   \
+    uint32_t NAME[POOL_MEMORY_SIZE(BLOCK_SIZE, BLOCK_COUNT) / sizeof(uint32_t)]
+
+/** @} */
+
+/** @addtogroup POOL_Exported_Functions
+ * @{ */
+void            POOL_vInit              (POOL_HandleType * pxPool,
+                                         POOL_ClassType * axClasses,
+                                         uint8_t ucCount);
+
+void *          POOL_pvAlloc            (POOL_HandleType * pxPool,
+                                         uint16_t usSize);
+void            POOL_vRetain            (void * pvBuffer);
+void            POOL_vRelease           (void * pvBuffer);
+
+uint16_t        POOL_usGetSize          (void * pvBuffer);
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_POOL_H_ */
@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    xpd_rtos.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers RTOS Integration Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_RTOS_H_
+#define __XPD_RTOS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+
+#ifdef __XPD_RTOS
+#include <xpd_can.h>
+#include <xpd_spi.h>
+#include <xpd_usart.h>
+
+/** @defgroup RTOS
+ * @brief    Blocking transfers which start the interrupt or DMA driven operation,
+ *           and put the calling task to sleep on the semaphore of the driver handle
+ *           until the completion callback releases it.
+ *           The RTOS port (see templates/xpd_rtos_port.h) is included by xpd_config.h.
+ *           The completion callbacks of the bound driver handles shall be set to
+ *           @ref RTOS_vComplete and the error callbacks to @ref RTOS_vError.
+ * @{ */
+
+/** @defgroup RTOS_Exported_Types RTOS Exported Types
+ * @{ */
+
+/** @brief RTOS driver handle synchronization structure */
+typedef struct
+{
+    void *                   Handle;    /*!< The bound driver handle */
+    XPD_RTOS_SemaphoreType   Semaphore; /*!< Completion semaphore of the handle */
+    volatile XPD_ReturnType  Result;    /*!< [Internal] Result of the last operation */
+    void *                   Next;      /*!< [Internal] Bound handle list link */
+}RTOS_SyncType;
+
+/** @} */
+
+/** @addtogroup RTOS_Exported_Functions
+ * @{ */
+void            RTOS_vBind              (RTOS_SyncType * pxSync,
+                                         void * pvHandle);
+
+void            RTOS_vComplete          (void * pvHandle);
+void            RTOS_vError             (void * pvHandle);
+
+void            RTOS_vPrepare           (void * pvHandle);
+XPD_ReturnType  RTOS_eWait              (void * pvHandle,
+                                         uint32_t ulTimeout);
+
+XPD_ReturnType  RTOS_eUSART_Transmit    (USART_HandleType * pxUSART,
+                                         void * pvTxData,
+                                         uint16_t usLength,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  RTOS_eUSART_Receive     (USART_HandleType * pxUSART,
+                                         void * pvRxData,
+                                         uint16_t usLength,
+                                         uint32_t ulTimeout);
+
+XPD_ReturnType  RTOS_eSPI_Send          (SPI_HandleType * pxSPI,
+                                         void * pvTxData,
+                                         uint16_t usLength,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  RTOS_eSPI_Receive       (SPI_HandleType * pxSPI,
+                                         void * pvRxData,
+                                         uint16_t usLength,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  RTOS_eSPI_SendReceive   (SPI_HandleType * pxSPI,
+                                         void * pvTxData,
+                                         void * pvRxData,
+                                         uint16_t usLength,
+                                         uint32_t ulTimeout);
+
+#if defined(CAN) || defined(CAN1)
+XPD_ReturnType  RTOS_eCAN_Send          (CAN_HandleType * pxCAN,
+                                         CAN_FrameType * pxFrame,
+                                         uint32_t ulTimeout);
+#endif
+/** @} */
+
+/** @} */
+
+#endif /* __XPD_RTOS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_RTOS_H_ */
@@ -4,7 +4,7 @@
   * @author  Benedek Kupper
   * @version 0.1
   * @date    2018-01-28
-  * @brief   STM32 eXtensible Peripheral Drivers CEC Module
+  * @brief   STM32 eXtensible Peripheral Drivers Sigma-Delta ADC Module
   *
   * Copyright (c) 2018 Benedek Kupper
   *
@@ -29,11 +29,369 @@ extern "C"
 #endif
 
 #include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(SDADC1)
+
+/** @defgroup SDADC
+ * @{ */
+
+/** @defgroup SDADC_Exported_Types SDADC Exported Types
+ * @{ */
+
+/** @brief SDADC reference voltage selection (common for all SDADCs) */
+typedef enum
+{
+    SDADC_REFERENCE_EXTERNAL     = 0, /*!< External VREFSD+ pin */
+    SDADC_REFERENCE_INTERNAL_1V2 = 1, /*!< Internal 1.2V reference */
+    SDADC_REFERENCE_INTERNAL_1V8 = 2, /*!< Internal 1.8V reference */
+    SDADC_REFERENCE_VDDSD        = 3, /*!< VDDSD analog supply */
+}SDADC_ReferenceType;
+
+/** @brief SDADC programmable gain */
+typedef enum
+{
+    SDADC_GAIN_1    = 0, /*!< Gain of 1 */
+    SDADC_GAIN_2    = 1, /*!< Gain of 2 */
+    SDADC_GAIN_4    = 2, /*!< Gain of 4 */
+    SDADC_GAIN_8    = 3, /*!< Gain of 8 */
+    SDADC_GAIN_16   = 4, /*!< Gain of 16 */
+    SDADC_GAIN_32   = 5, /*!< Gain of 32 */
+    SDADC_GAIN_1_2  = 7, /*!< Gain of 1/2 */
+}SDADC_GainType;
+
+/** @brief SDADC input modes */
+typedef enum
+{
+    SDADC_INPUT_DIFFERENTIAL        = 0, /*!< Differential input, signed result */
+    SDADC_INPUT_SINGLE_ENDED_OFFSET = 1, /*!< Single ended input referred to VSSSD, signed result with offset */
+    SDADC_INPUT_SINGLE_ENDED_ZERO   = 3, /*!< Single ended input referred to the common mode voltage, signed result */
+}SDADC_InputModeType;
+
+/** @brief SDADC common mode voltage for the single ended inputs */
+typedef enum
+{
+    SDADC_COMMONMODE_VSSSD      = 0, /*!< VSSSD */
+    SDADC_COMMONMODE_VDDSD_DIV2 = 1, /*!< VDDSD / 2 */
+    SDADC_COMMONMODE_VDDSD      = 2, /*!< VDDSD */
+}SDADC_CommonModeType;
+
+/** @brief SDADC conversion configuration, up to 3 are stored in each SDADC
+ *         and assigned to the input channels */
+typedef struct
+{
+    SDADC_GainType       Gain;        /*!< Amplification of the input signal */
+    SDADC_InputModeType  InputMode;   /*!< Differential or single ended input */
+    SDADC_CommonModeType CommonMode;  /*!< Common mode voltage of the single ended input */
+    uint16_t             Offset;      /*!< 12 bit offset subtracted from the conversion results
+                                           (overwritten by the calibration) */
+}SDADC_ConfigType;
+
+/** @brief SDADC setup structure */
+typedef struct
+{
+    FunctionalState FastMode;    /*!< Fast continuous mode: the filter settling is only waited
+                                      at the start of a continuous conversion sequence */
+    FunctionalState SlowClock;   /*!< Slow clock mode for 1.5 MHz SDADC clock */
+    FunctionalState Synchronous; /*!< Start the conversions together with SDADC1
+                                      (only for SDADC2 and SDADC3) */
+}SDADC_InitType;
+
+/** @brief SDADC1 injected trigger sources */
+typedef enum
+{
+    SDADC1_TRIGGER_TIM13_CC1 = 0, /*!< TIM13 Channel 1 */
+    SDADC1_TRIGGER_TIM14_CC1 = 1, /*!< TIM14 Channel 1 */
+    SDADC1_TRIGGER_TIM16_CC1 = 2, /*!< TIM16 Channel 1 */
+    SDADC1_TRIGGER_TIM3_CC1  = 3, /*!< TIM3 Channel 1 */
+    SDADC1_TRIGGER_TIM4_CC1  = 4, /*!< TIM4 Channel 1 */
+    SDADC1_TRIGGER_TIM19_CC2 = 5, /*!< TIM19 Channel 2 */
+    SDADC1_TRIGGER_EXTI15    = 6, /*!< EXTI Line 15 */
+    SDADC1_TRIGGER_EXTI11    = 7, /*!< EXTI Line 11 */
+    SDADC1_TRIGGER_SOFTWARE  = 8, /*!< Implicit trigger by software on start call */
+}SDADC1_TriggerSourceType;
+
+/** @brief SDADC2 injected trigger sources */
+typedef enum
+{
+    SDADC2_TRIGGER_TIM17_CC1 = 0, /*!< TIM17 Channel 1 */
+    SDADC2_TRIGGER_TIM12_CC1 = 1, /*!< TIM12 Channel 1 */
+    SDADC2_TRIGGER_TIM2_CC3  = 2, /*!< TIM2 Channel 3 */
+    SDADC2_TRIGGER_TIM3_CC2  = 3, /*!< TIM3 Channel 2 */
+    SDADC2_TRIGGER_TIM4_CC2  = 4, /*!< TIM4 Channel 2 */
+    SDADC2_TRIGGER_TIM19_CC3 = 5, /*!< TIM19 Channel 3 */
+    SDADC2_TRIGGER_EXTI15    = 6, /*!< EXTI Line 15 */
+    SDADC2_TRIGGER_EXTI11    = 7, /*!< EXTI Line 11 */
+    SDADC2_TRIGGER_SOFTWARE  = 8, /*!< Implicit trigger by software on start call */
+}SDADC2_TriggerSourceType;
+
+/** @brief SDADC3 injected trigger sources */
+typedef enum
+{
+    SDADC3_TRIGGER_TIM16_CC1 = 0, /*!< TIM16 Channel 1 */
+    SDADC3_TRIGGER_TIM12_CC1 = 1, /*!< TIM12 Channel 1 */
+    SDADC3_TRIGGER_TIM2_CC4  = 2, /*!< TIM2 Channel 4 */
+    SDADC3_TRIGGER_TIM3_CC3  = 3, /*!< TIM3 Channel 3 */
+    SDADC3_TRIGGER_TIM4_CC3  = 4, /*!< TIM4 Channel 3 */
+    SDADC3_TRIGGER_TIM19_CC4 = 5, /*!< TIM19 Channel 4 */
+    SDADC3_TRIGGER_EXTI15    = 6, /*!< EXTI Line 15 */
+    SDADC3_TRIGGER_EXTI11    = 7, /*!< EXTI Line 11 */
+    SDADC3_TRIGGER_SOFTWARE  = 8, /*!< Implicit trigger by software on start call */
+}SDADC3_TriggerSourceType;
+
+/** @brief SDADC injected group setup structure */
+typedef struct
+{
+    uint16_t        Channels;        /*!< Bit mask of the converted channels [0 .. 8],
+                                          they are converted in ascending order */
+    FunctionalState ContinuousMode;  /*!< Restart the group conversion when it's finished */
+    struct {
+        uint8_t     Source;          /*!< Source of the conversion trigger (SDADCx_TRIGGER_...),
+                                          ignored for synchronous SDADCs */
+        EdgeType    Edge;            /*!< Trigger edges that initiate conversion */
+    }Trigger;
+}SDADC_InjectedInitType;
+
+/** @brief SDADC data registers for DMA transfers */
+typedef enum
+{
+    SDADC_DATA_SINGLE = 0, /*!< The 16 bit injected result of the SDADC (halfword transfers) */
+    SDADC_DATA_PAIR12 = 1, /*!< SDADC1 and SDADC2 injected results packed in a word (SDADC1 only) */
+    SDADC_DATA_PAIR13 = 2, /*!< SDADC1 and SDADC3 injected results packed in a word (SDADC1 only) */
+}SDADC_DataType;
+
+/** @brief SDADC operation types */
+typedef enum
+{
+    SDADC_OPERATION_CALIBRATION   = SDADC_ISR_EOCALF, /*!< Calibration */
+    SDADC_OPERATION_INJCONVERSION = SDADC_ISR_JEOCF,  /*!< Injected conversion */
+    SDADC_OPERATION_CONVERSION    = SDADC_ISR_REOCF,  /*!< Regular conversion */
+}SDADC_OperationType;
+
+/** @brief SDADC error types */
+typedef enum
+{
+    SDADC_ERROR_NONE        = 0, /*!< No error */
+    SDADC_ERROR_OVERRUN     = 1, /*!< Regular conversion data overrun */
+    SDADC_ERROR_INJOVERRUN  = 2, /*!< Injected conversion data overrun */
+    SDADC_ERROR_DMA         = 4, /*!< DMA transfer error */
+}SDADC_ErrorType;
+
+/** @brief SDADC Handle structure */
+typedef struct
+{
+    SDADC_TypeDef * Inst;                    /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType ConvComplete; /*!< Regular conversion complete callback */
+        XPD_HandleCallbackType InjConvComplete; /*!< Injected conversion complete callback,
+                                                     or block of injected conversions complete with DMA */
+        XPD_HandleCallbackType Error;        /*!< Overrun or DMA error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    DMA_HandleType * DMA;                    /*!< DMA handle for the injected conversion data */
+    struct {
+        uint8_t * Buffer;                    /*!< [Internal] Start of the stream buffer */
+        uint16_t HalfLength;                 /*!< [Internal] Half of the buffer length in transfers */
+        uint8_t TransferSize;                /*!< [Internal] Size of a transfer in the buffer in bytes */
+    }Stream;                                 /*   DMA stream buffer */
+    void * volatile Block;                   /*!< The buffer half which is available to the application */
+    uint8_t InjectedTrigger;                 /*!< [Internal] The injected trigger edge configuration */
+    RCC_PositionType CtrlPos;              /*!< Relative position for reset and clock control */
+    volatile SDADC_ErrorType Errors;         /*!< Conversion errors */
+}SDADC_HandleType;
+
+/** @} */
+
+/** @defgroup SDADC_Exported_Macros SDADC Exported Macros
+ * @{ */
+
+/** @brief Number of SDADC input channels */
+#define         SDADC_CHANNEL_COUNT             9
+
+/** @brief Number of SDADC conversion configurations */
+#define         SDADC_CONFIG_COUNT              3
+
+/**
+ * @brief SDADC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SDADC peripheral instance.
+ */
+#define         SDADC_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief SDADC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         SDADC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Enable the specified SDADC interrupt.
+ * @param  HANDLE: specifies the SDADC Handle.
+ * @param  IT_NAME: specifies the interrupt to enable.
+ *         This parameter can be one of the following values:
+ *            @arg EOCAL:   End of calibration
+ *            @arg JEOC:    End of injected conversion
+ *            @arg JOVR:    Injected conversion overrun
+ *            @arg REOC:    End of regular conversion
+ *            @arg ROVR:    Regular conversion overrun
+ */
+#define         SDADC_IT_ENABLE(HANDLE, IT_NAME)            \
+    (SDADC_REG_BIT((HANDLE),CR1,IT_NAME##IE) = 1)
+
+/**
+ * @brief  Disable the specified SDADC interrupt.
+ * @param  HANDLE: specifies the SDADC Handle.
+ * @param  IT_NAME: specifies the interrupt to disable.
+ *         This parameter can be one of the following values:
+ *            @arg EOCAL:   End of calibration
+ *            @arg JEOC:    End of injected conversion
+ *            @arg JOVR:    Injected conversion overrun
+ *            @arg REOC:    End of regular conversion
+ *            @arg ROVR:    Regular conversion overrun
+ */
+#define         SDADC_IT_DISABLE(HANDLE, IT_NAME)           \
+    (SDADC_REG_BIT((HANDLE),CR1,IT_NAME##IE) = 0)
+
+/**
+ * @brief  Get the specified SDADC flag.
+ * @param  HANDLE: specifies the SDADC Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg EOCALF:  End of calibration
+ *            @arg JEOCF:   End of injected conversion
+ *            @arg JOVRF:   Injected conversion overrun
+ *            @arg REOCF:   End of regular conversion
+ *            @arg ROVRF:   Regular conversion overrun
+ *            @arg CALIBIP: Calibration in progress
+ *            @arg JCIP:    Injected conversion in progress
+ *            @arg RCIP:    Regular conversion in progress
+ *            @arg STABIP:  Stabilization in progress
+ *            @arg INITRDY: Initialization mode is ready
+ */
+#define         SDADC_FLAG_STATUS(HANDLE, FLAG_NAME)        \
+    (SDADC_REG_BIT((HANDLE),ISR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified SDADC flag.
+ * @param  HANDLE: specifies the SDADC Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg EOCALF:  End of calibration
+ *            @arg JOVRF:   Injected conversion overrun
+ *            @arg ROVRF:   Regular conversion overrun
+ */
+#define         SDADC_FLAG_CLEAR(HANDLE, FLAG_NAME)         \
+    ((HANDLE)->Inst->CLRISR.w = SDADC_CLRISR_CLR##FLAG_NAME)
+
+/**
+ * @brief  Gets the first (SDADC1) result of a packed pair data register value.
+ * @param  PAIR: the JDATA12R or JDATA13R value transferred by the DMA
+ */
+#define         SDADC_PAIR_FIRST(PAIR)                      \
+    ((int16_t)((PAIR) & 0xFFFF))
+
+/**
+ * @brief  Gets the second (SDADC2 or SDADC3) result of a packed pair data register value.
+ * @param  PAIR: the JDATA12R or JDATA13R value transferred by the DMA
+ */
+#define         SDADC_PAIR_SECOND(PAIR)                     \
+    ((int16_t)((PAIR) >> 16))
+
+/** @} */
+
+/** @addtogroup SDADC_Exported_Functions
+ * @{ */
+XPD_ReturnType  SDADC_eReferenceConfig  (SDADC_ReferenceType eReference);
+
+XPD_ReturnType  SDADC_eInit             (SDADC_HandleType * pxSDADC,
+                                         const SDADC_InitType * pxConfig);
+void            SDADC_vDeinit           (SDADC_HandleType * pxSDADC);
+
+XPD_ReturnType  SDADC_eConfigInit       (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucConfig,
+                                         const SDADC_ConfigType * pxConfig);
+XPD_ReturnType  SDADC_eChannelConfig    (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucChannel,
+                                         uint8_t ucConfig);
+uint16_t        SDADC_usGetOffset       (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucConfig);
+
+XPD_ReturnType  SDADC_eCalibrate        (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucConfigCount);
+
+XPD_ReturnType  SDADC_ePollStatus       (SDADC_HandleType * pxSDADC,
+                                         SDADC_OperationType eOperation,
+                                         uint32_t ulTimeout);
+
+void            SDADC_vStart            (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucChannel,
+                                         FunctionalState eContinuous);
+void            SDADC_vStop             (SDADC_HandleType * pxSDADC);
+void            SDADC_vStart_IT         (SDADC_HandleType * pxSDADC,
+                                         uint8_t ucChannel,
+                                         FunctionalState eContinuous);
+void            SDADC_vStop_IT          (SDADC_HandleType * pxSDADC);
+
+XPD_ReturnType  SDADC_eInjectedInit     (SDADC_HandleType * pxSDADC,
+                                         const SDADC_InjectedInitType * pxConfig);
+void            SDADC_vInjectedStart    (SDADC_HandleType * pxSDADC);
+void            SDADC_vInjectedStop     (SDADC_HandleType * pxSDADC);
+void            SDADC_vInjectedStart_IT (SDADC_HandleType * pxSDADC);
+void            SDADC_vInjectedStop_IT  (SDADC_HandleType * pxSDADC);
+int16_t         SDADC_sGetInjectedValue (SDADC_HandleType * pxSDADC,
+                                         uint8_t * pucChannel);
+
+XPD_ReturnType  SDADC_eInjectedStart_DMA(SDADC_HandleType * pxSDADC,
+                                         SDADC_DataType eData,
+                                         void * pvBuffer,
+                                         uint16_t usLength);
+void            SDADC_vInjectedStop_DMA (SDADC_HandleType * pxSDADC);
+
+void            SDADC_vIRQHandler       (SDADC_HandleType * pxSDADC);
+
+void            SDADC_vUnpackPairs      (const uint32_t * pulPairs,
+                                         int16_t * const apsFirst[],
+                                         int16_t * const apsSecond[],
+                                         uint8_t ucChannels,
+                                         uint16_t usScans);
+
+/**
+ * @brief Gets the result of the last regular conversion.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @return The signed conversion result
+ */
+__STATIC_INLINE int16_t SDADC_sGetValue(SDADC_HandleType * pxSDADC)
+{
+    return (int16_t)pxSDADC->Inst->RDATAR.w;
+}
+
+/**
+ * @brief Gets the error state of the SDADC.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @return Current SDADC error state
+ */
+__STATIC_INLINE SDADC_ErrorType SDADC_eGetError(SDADC_HandleType * pxSDADC)
+{
+    return pxSDADC->Errors;
+}
+
+/** @} */
+
+/** @} */
 
 #define XPD_SDADC_API
 #include <xpd_rcc_pc.h>
 #undef XPD_SDADC_API
 
+#endif /* SDADC1 */
+
 #ifdef __cplusplus
 }
 #endif
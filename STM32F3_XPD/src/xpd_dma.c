@@ -92,6 +92,64 @@ __STATIC_INLINE void DMA_prvCalcBase(DMA_HandleType * pxDMA)
     pxDMA->ChannelOffset = DMA_CHANNEL_NUMBER(pxDMA->Inst) * 4;
 }
 
+/*
+ * @brief Handles the half transfer and transfer complete interrupts of the DMA stream.
+ * @param pxDMA: pointer to the DMA stream handle structure
+ * @return SET if the transfer is complete, RESET otherwise
+ */
+static FlagStatus DMA_prvTransferIRQHandler(DMA_HandleType * pxDMA)
+{
+    FlagStatus eComplete = RESET;
+
+    /* Half Transfer Complete interrupt management */
+    if ((DMA_REG_BIT(pxDMA,CCR,HTIE) != 0) && (DMA_FLAG_STATUS(pxDMA, HT) != 0))
+    {
+        /* clear the half transfer complete flag */
+        DMA_FLAG_CLEAR(pxDMA, HT);
+
+        /* half transfer callback */
+        XPD_SAFE_CALLBACK(pxDMA->Callbacks.HalfComplete, pxDMA);
+    }
+
+    /* Transfer Complete interrupt management */
+    if (DMA_FLAG_STATUS(pxDMA, TC) != 0)
+    {
+        /* clear the transfer complete flag */
+        DMA_FLAG_CLEAR(pxDMA, TC);
+
+        /* DMA mode is not CIRCULAR */
+        if (DMA_eCircularMode(pxDMA) == 0)
+        {
+            CLEAR_BIT(pxDMA->Inst->CCR.w, DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+        }
+
+        eComplete = SET;
+    }
+
+    return eComplete;
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+/*
+ * @brief Handles the error interrupts of the DMA stream.
+ * @param pxDMA: pointer to the DMA stream handle structure
+ */
+static void DMA_prvErrorIRQHandler(DMA_HandleType * pxDMA)
+{
+    /* Transfer Error interrupt management */
+    if (DMA_FLAG_STATUS(pxDMA, TE) != 0)
+    {
+        /* clear the transfer error flag */
+        DMA_FLAG_CLEAR(pxDMA, TE);
+
+        pxDMA->Errors |= DMA_ERROR_TRANSFER;
+
+        /* transfer errors callback */
+        XPD_SAFE_CALLBACK(pxDMA->Callbacks.Error, pxDMA);
+    }
+}
+#endif
+
 /** @defgroup DMA_Exported_Functions DMA Exported Functions
  * @{ */
 
@@ -152,7 +210,7 @@ void DMA_vDeinit(DMA_HandleType * pxDMA)
  * @param pvPeriphAddress: pointer to the peripheral data register
  * @param pvMemAddress: pointer to the memory data
  * @param usDataCount: the amount of data to be transferred
- * @return BUSY if DMA is in use, OK if success
+ * @return BUSY if DMA is in use, ERROR if an address is in the CCM RAM, OK if success
  */
 XPD_ReturnType DMA_eStart(
         DMA_HandleType *    pxDMA,
@@ -162,6 +220,14 @@ XPD_ReturnType DMA_eStart(
 {
     XPD_ReturnType eResult = XPD_OK;
 
+#if defined(__XPD_DMA_ERROR_DETECT) && defined(CCMDATARAM_BASE)
+    /* The CCM RAM is not reachable by DMA */
+    if (XPD_IS_CCMRAM(pvPeriphAddress) || XPD_IS_CCMRAM(pvMemAddress))
+    {
+        return XPD_ERROR;
+    }
+#endif
+
     /* Enter critical section to ensure single user of DMA */
     XPD_ENTER_CRITICAL(pxDMA);
 
@@ -315,50 +381,39 @@ XPD_ReturnType DMA_ePollStatus(
     return eResult;
 }
 
+/**
+ * @brief DMA channel transfer interrupt handler for statically bound owners,
+ *        which leaves the transfer complete notification to the caller.
+ * @param pxDMA: pointer to the DMA channel handle structure
+ * @note  Transfer errors are handled before returning, so the Error callback
+ *        precedes the caller's transfer complete notification.
+ * @return SET if the transfer is complete, RESET otherwise
+ */
+FlagStatus DMA_eIRQHandler(DMA_HandleType * pxDMA)
+{
+    FlagStatus eComplete = DMA_prvTransferIRQHandler(pxDMA);
+
+#ifdef __XPD_DMA_ERROR_DETECT
+    DMA_prvErrorIRQHandler(pxDMA);
+#endif
+
+    return eComplete;
+}
+
 /**
  * @brief DMA stream transfer interrupt handler that provides handle callbacks.
  * @param pxDMA: pointer to the DMA stream handle structure
  */
 void DMA_vIRQHandler(DMA_HandleType * pxDMA)
 {
-    /* Half Transfer Complete interrupt management */
-    if ((DMA_REG_BIT(pxDMA,CCR,HTIE) != 0) && (DMA_FLAG_STATUS(pxDMA, HT) != 0))
-    {
-        /* clear the half transfer complete flag */
-        DMA_FLAG_CLEAR(pxDMA, HT);
-
-        /* half transfer callback */
-        XPD_SAFE_CALLBACK(pxDMA->Callbacks.HalfComplete, pxDMA);
-    }
-
-    /* Transfer Complete interrupt management */
-    if (DMA_FLAG_STATUS(pxDMA, TC) != 0)
+    if (DMA_prvTransferIRQHandler(pxDMA) != RESET)
     {
-        /* clear the transfer complete flag */
-        DMA_FLAG_CLEAR(pxDMA, TC);
-
-        /* DMA mode is not CIRCULAR */
-        if (DMA_eCircularMode(pxDMA) == 0)
-        {
-            CLEAR_BIT(pxDMA->Inst->CCR.w, DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
-        }
-
         /* transfer complete callback */
         XPD_SAFE_CALLBACK(pxDMA->Callbacks.Complete, pxDMA);
     }
 
 #ifdef __XPD_DMA_ERROR_DETECT
-    /* Transfer Error interrupt management */
-    if (DMA_FLAG_STATUS(pxDMA, TE) != 0)
-    {
-        /* clear the transfer error flag */
-        DMA_FLAG_CLEAR(pxDMA, TE);
-
-        pxDMA->Errors |= DMA_ERROR_TRANSFER;
-
-        /* transfer errors callback */
-        XPD_SAFE_CALLBACK(pxDMA->Callbacks.Error, pxDMA);
-    }
+    DMA_prvErrorIRQHandler(pxDMA);
 #endif
 }
 
@@ -0,0 +1,198 @@
+/**
+  ******************************************************************************
+  * @file    xpd_fmc.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Flexible Memory Controller Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_fmc.h>
+#include <xpd_utils.h>
+
+#if defined(FMC_Bank1)
+
+/** @addtogroup FMC
+ * @{ */
+
+/* NOR/PSRAM register fields */
+#define FMC_BCR_MBKEN               0x00000001U
+#define FMC_BCR_MTYP_Pos            2
+#define FMC_BCR_MWID_Pos            4
+#define FMC_BCR_FACCEN              0x00000040U
+#define FMC_BCR_WREN                0x00001000U
+#define FMC_BCR_EXTMOD              0x00004000U
+#define FMC_BCR_CONFIG_MSK          0x0008FF7FU
+
+#define FMC_BTR_ADDHLD_Pos          4
+#define FMC_BTR_DATAST_Pos          8
+#define FMC_BTR_BUSTURN_Pos         16
+#define FMC_BTR_TIMING_MSK          0x300FFFFFU
+
+#define FMC_BCR_RESET_VALUE(BANK)   (((BANK) == FMC_SRAM_BANK1) ? 0x000030DBU : 0x000030D2U)
+#define FMC_BTR_RESET_VALUE         0x0FFFFFFFU
+
+/* Converts a duration to clock cycles, rounding up and saturating to the field range */
+static uint32_t FMC_prvCycles(uint32_t ulTime_ns, uint32_t ulClock_Hz, uint32_t ulMin, uint32_t ulMax)
+{
+    uint32_t ulCycles = (uint32_t)(((uint64_t)ulTime_ns * ulClock_Hz + 999999999UL) / 1000000000UL);
+
+    if (ulCycles < ulMin)
+    {
+        ulCycles = ulMin;
+    }
+    else if (ulCycles > ulMax)
+    {
+        ulCycles = ulMax;
+    }
+    return ulCycles;
+}
+
+/* Calculates the timing register value of an asynchronous access */
+static uint32_t FMC_prvSRAM_Timing(const FMC_SRAM_TimingType * pxTiming, uint32_t ulHCLK_Hz)
+{
+    return (FMC_prvCycles(pxTiming->AddressSetup_ns,  ulHCLK_Hz, 0, 15))
+         | (FMC_prvCycles(pxTiming->AddressHold_ns,   ulHCLK_Hz, 1, 15)  << FMC_BTR_ADDHLD_Pos)
+         | (FMC_prvCycles(pxTiming->DataSetup_ns,     ulHCLK_Hz, 1, 255) << FMC_BTR_DATAST_Pos)
+         | (FMC_prvCycles(pxTiming->BusTurnaround_ns, ulHCLK_Hz, 0, 15)  << FMC_BTR_BUSTURN_Pos);
+}
+
+/** @defgroup FMC_SRAM_Exported_Functions FMC SRAM Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes an FMC NOR/PSRAM subbank for asynchronous access.
+ * @note  The access timings are calculated from the current HCLK frequency,
+ *        therefore this function shall be called after the clock setup.
+ *        The GPIO configuration of the memory interface is not performed here.
+ * @param eBank: the selected subbank
+ * @param pxConfig: pointer to the memory setup configuration
+ */
+void FMC_vSRAM_Init(FMC_SRAM_BankType eBank, const FMC_SRAM_InitType * pxConfig)
+{
+    uint32_t ulHCLK_Hz = RCC_ulClockFreq_Hz(HCLK);
+    uint32_t ulBCR;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_FMC);
+
+    /* Disable the bank while it's being configured */
+    FMC_Bank1->BCTR[eBank].BCR.w &= ~FMC_BCR_MBKEN;
+
+    ulBCR = FMC_Bank1->BCTR[eBank].BCR.w & ~FMC_BCR_CONFIG_MSK;
+    ulBCR |= ((uint32_t)pxConfig->MemoryType << FMC_BCR_MTYP_Pos)
+           | ((uint32_t)pxConfig->BusWidth   << FMC_BCR_MWID_Pos);
+
+    if (pxConfig->MemoryType == FMC_MEMORY_NOR)
+    {
+        ulBCR |= FMC_BCR_FACCEN;
+    }
+    if (pxConfig->WriteEnable != DISABLE)
+    {
+        ulBCR |= FMC_BCR_WREN;
+    }
+
+    FMC_Bank1->BCTR[eBank].BTR.w = (FMC_Bank1->BCTR[eBank].BTR.w & ~FMC_BTR_TIMING_MSK)
+            | FMC_prvSRAM_Timing(&pxConfig->ReadTiming, ulHCLK_Hz);
+
+    if (pxConfig->ExtendedMode != DISABLE)
+    {
+        ulBCR |= FMC_BCR_EXTMOD;
+
+        FMC_Bank1E->BWTR[eBank * 2].w = (FMC_Bank1E->BWTR[eBank * 2].w & ~FMC_BTR_TIMING_MSK)
+                | FMC_prvSRAM_Timing(&pxConfig->WriteTiming, ulHCLK_Hz);
+    }
+
+    FMC_Bank1->BCTR[eBank].BCR.w = ulBCR | FMC_BCR_MBKEN;
+}
+
+/**
+ * @brief Restores an FMC NOR/PSRAM subbank to its default inactive state.
+ * @param eBank: the selected subbank
+ */
+void FMC_vSRAM_Deinit(FMC_SRAM_BankType eBank)
+{
+    FMC_Bank1->BCTR[eBank].BCR.w = FMC_BCR_RESET_VALUE(eBank);
+    FMC_Bank1->BCTR[eBank].BTR.w = FMC_BTR_RESET_VALUE;
+    FMC_Bank1E->BWTR[eBank * 2].w = FMC_BTR_RESET_VALUE;
+}
+
+/** @} */
+
+static uint8_t * FMC_pucHeapNext = NULL;
+static uint8_t * FMC_pucHeapEnd  = NULL;
+
+/** @defgroup FMC_Heap_Exported_Functions FMC Heap Exported Functions
+ * @{ */
+
+/**
+ * @brief Assigns an initialized external memory area for allocation of large buffers
+ *        (e.g. frame buffers, sample buffers) that are kept for the whole runtime.
+ * @param pvStart: start address of the available memory area
+ * @param ulSize: size of the available memory area in bytes
+ */
+void FMC_vHeapInit(void * pvStart, uint32_t ulSize)
+{
+    FMC_pucHeapNext = pvStart;
+    FMC_pucHeapEnd  = FMC_pucHeapNext + ulSize;
+}
+
+/**
+ * @brief Allocates a buffer from the external memory area. The allocated buffers cannot be freed.
+ * @param ulSize: requested buffer size in bytes
+ * @param ulAlignment: the required buffer address alignment in bytes (power of 2)
+ * @return Address of the allocated buffer, or NULL if there isn't enough free memory
+ */
+void * FMC_pvHeapAlloc(uint32_t ulSize, uint32_t ulAlignment)
+{
+    void * pvBuffer = NULL;
+    uint8_t * pucStart;
+
+    if (ulAlignment == 0)
+    {
+        ulAlignment = sizeof(uint32_t);
+    }
+
+    XPD_ENTER_CRITICAL(NULL);
+
+    pucStart = (uint8_t*)(((uint32_t)FMC_pucHeapNext + ulAlignment - 1) & ~(ulAlignment - 1));
+
+    if ((FMC_pucHeapNext != NULL) && (pucStart <= FMC_pucHeapEnd) &&
+        (ulSize <= (uint32_t)(FMC_pucHeapEnd - pucStart)))
+    {
+        FMC_pucHeapNext = pucStart + ulSize;
+        pvBuffer = pucStart;
+    }
+
+    XPD_EXIT_CRITICAL(NULL);
+
+    return pvBuffer;
+}
+
+/**
+ * @brief Gets the remaining free memory of the external memory area.
+ * @return The amount of unallocated bytes
+ */
+uint32_t FMC_ulHeapFree(void)
+{
+    return (uint32_t)(FMC_pucHeapEnd - FMC_pucHeapNext);
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* FMC_Bank1 */
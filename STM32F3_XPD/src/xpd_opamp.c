@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file    xpd_opamp.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Operational Amplifier Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_opamp.h>
+#include <xpd_utils.h>
+
+#if defined(OPAMP_CSR_OPAMPxEN)
+
+/** @addtogroup OPAMP
+ * @{ */
+
+#define OPAMP_TRIMMING_DELAY_MS     2
+#define OPAMP_TRIMMING_MAX          0x1F
+
+/* Calibration reference voltages */
+#define OPAMP_CALSEL_VDDA_10        1
+#define OPAMP_CALSEL_VDDA_90        3
+
+/* Searches the offset trimming value where the calibration output toggles */
+static void OPAMP_prvTrim(OPAMP_HandleType * pxOPAMP, uint32_t ulTrimPos)
+{
+    uint32_t ulTrim = (OPAMP_TRIMMING_MAX + 1) / 2;
+    uint32_t ulDelta = ulTrim / 2;
+
+    while (ulDelta > 0)
+    {
+        MODIFY_REG(pxOPAMP->Inst->CSR.w, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+        XPD_vDelay_ms(OPAMP_TRIMMING_DELAY_MS);
+
+        if (OPAMP_REG_BIT(pxOPAMP, CSR, OUTCAL) != 0)
+        {
+            ulTrim += ulDelta;
+        }
+        else
+        {
+            ulTrim -= ulDelta;
+        }
+        ulDelta >>= 1;
+    }
+
+    /* The last step decides between the two neighboring values */
+    MODIFY_REG(pxOPAMP->Inst->CSR.w, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+    XPD_vDelay_ms(OPAMP_TRIMMING_DELAY_MS);
+
+    if ((OPAMP_REG_BIT(pxOPAMP, CSR, OUTCAL) != 0) && (ulTrim < OPAMP_TRIMMING_MAX))
+    {
+        ulTrim++;
+        MODIFY_REG(pxOPAMP->Inst->CSR.w, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+    }
+}
+
+/** @defgroup OPAMP_Exported_Functions OPAMP Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the operational amplifier using the setup configuration.
+ *        The amplifier has to be enabled separately.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ * @param pxConfig: OPAMP setup configuration
+ */
+void OPAMP_vInit(OPAMP_HandleType * pxOPAMP, const OPAMP_InitType * pxConfig)
+{
+    uint32_t ulVMSEL = pxConfig->Mode;
+
+    if (pxConfig->Mode == OPAMP_MODE_STANDALONE)
+    {
+        ulVMSEL = pxConfig->InvertingInput;
+    }
+
+    /* the amplifiers are clocked through SYSCFG */
+    RCC_vClockEnable(RCC_POS_SYSCFG);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxOPAMP->Callbacks.DepInit, pxOPAMP);
+
+    /* keep the user trimming values of a previous calibration */
+    pxOPAMP->Inst->CSR.w = (pxOPAMP->Inst->CSR.w &
+            (OPAMP_CSR_USERTRIM | OPAMP_CSR_TRIMOFFSETP | OPAMP_CSR_TRIMOFFSETN))
+            | ((uint32_t)pxConfig->NonInvertingInput << OPAMP_CSR_VPSEL_Pos)
+            | (ulVMSEL << OPAMP_CSR_VMSEL_Pos)
+            | (pxConfig->PgaGain << OPAMP_CSR_PGGAIN_Pos);
+}
+
+/**
+ * @brief Restores the operational amplifier to its default inactive state.
+ * @note  A locked amplifier is only released by system reset.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+void OPAMP_vDeinit(OPAMP_HandleType * pxOPAMP)
+{
+    pxOPAMP->Inst->CSR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxOPAMP->Callbacks.DepDeinit, pxOPAMP);
+}
+
+/**
+ * @brief Calibrates the offset of the operational amplifier, and applies
+ *        the found user trimming values.
+ * @note  The calibration takes about 20 ms, during which the output is invalid.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+void OPAMP_vCalibrate(OPAMP_HandleType * pxOPAMP)
+{
+    uint32_t ulCSR = pxOPAMP->Inst->CSR.w;
+
+    SET_BIT(pxOPAMP->Inst->CSR.w, OPAMP_CSR_OPAMPxEN | OPAMP_CSR_CALON | OPAMP_CSR_USERTRIM);
+
+    /* NMOS differential pair is trimmed with 90% VDDA reference */
+    pxOPAMP->Inst->CSR.b.CALSEL = OPAMP_CALSEL_VDDA_90;
+    OPAMP_prvTrim(pxOPAMP, OPAMP_CSR_TRIMOFFSETN_Pos);
+
+    /* PMOS differential pair is trimmed with 10% VDDA reference */
+    pxOPAMP->Inst->CSR.b.CALSEL = OPAMP_CALSEL_VDDA_10;
+    OPAMP_prvTrim(pxOPAMP, OPAMP_CSR_TRIMOFFSETP_Pos);
+
+    /* Restore the operating configuration with the new trimming values */
+    pxOPAMP->Inst->CSR.w = (ulCSR & ~(OPAMP_CSR_TRIMOFFSETP | OPAMP_CSR_TRIMOFFSETN))
+            | (pxOPAMP->Inst->CSR.w & (OPAMP_CSR_TRIMOFFSETP | OPAMP_CSR_TRIMOFFSETN))
+            | OPAMP_CSR_USERTRIM;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* OPAMP_CSR_OPAMPxEN */
@@ -353,6 +353,8 @@ uint32_t I2C_ulClockFreq_Hz(I2C_HandleType * pxI2C)
 
 /** @} */
 
+#if defined(SPI_I2SCFGR_I2SMOD)
+
 /** @ingroup I2S_Clock_Source
  * @defgroup I2S_Clock_Source_Exported_Functions I2S Clock Source Exported Functions
  * @{ */
@@ -362,7 +364,7 @@ uint32_t I2C_ulClockFreq_Hz(I2C_HandleType * pxI2C)
  * @brief Sets the new source clock for the I2S.
  * @param eClockSource: the new source clock which should be configured
  */
-void XPD_I2S_ClockConfig(I2S_ClockSourceType eClockSource)
+void I2S_vClockConfig(I2S_ClockSourceType eClockSource)
 {
     RCC_REG_BIT(CFGR,I2SSRC) = eClockSource;
 }
@@ -372,7 +374,7 @@ void XPD_I2S_ClockConfig(I2S_ClockSourceType eClockSource)
  * @brief Returns the input clock frequency of the I2S.
  * @return The clock frequency of the I2S in Hz
  */
-uint32_t XPD_I2S_ulClockFreq_Hz(void)
+uint32_t I2S_ulClockFreq_Hz(void)
 {
 #if defined(EXTERNAL_CLOCK_VALUE_Hz) && defined(RCC_CFGR_I2SSRC)
     if (RCC_REG_BIT(CFGR,I2SSRC) == I2S_CLOCKSOURCE_EXT)
@@ -388,6 +390,8 @@ uint32_t XPD_I2S_ulClockFreq_Hz(void)
 
 /** @} */
 
+#endif /* SPI_I2SCFGR_I2SMOD */
+
 /** @ingroup RTC_Clock_Source
  * @defgroup RTC_Clock_Source_Exported_Functions RTC Clock Source Exported Functions
  * @{ */
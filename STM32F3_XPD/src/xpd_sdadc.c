@@ -0,0 +1,698 @@
+/**
+  ******************************************************************************
+  * @file    xpd_sdadc.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Sigma-Delta ADC Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_sdadc.h>
+#include <xpd_utils.h>
+
+#if defined(SDADC1)
+
+/** @addtogroup SDADC
+ * @{ */
+
+#define SDADC_INIT_TIMEOUT          10
+#define SDADC_STAB_TIMEOUT          10
+#define SDADC_CALIBRATION_TIMEOUT   100
+
+/* Channel configuration selector field width in CONFCHR1 */
+#define SDADC_CONFCH_SIZE           (SDADC_CONFCHR1_CONFCH1_Pos - SDADC_CONFCHR1_CONFCH0_Pos)
+
+/* The analog supply switch of the SDADC in the PWR */
+#define SDADC_PWR_ENSD(HANDLE)      \
+    (PWR_CR_ENSD1 << ((HANDLE)->CtrlPos - RCC_POS_SDADC1))
+
+/* The configurations can only be changed in initialization mode */
+static XPD_ReturnType SDADC_prvEnterInit(SDADC_TypeDef * SDADCx)
+{
+    uint32_t ulTimeout = SDADC_INIT_TIMEOUT;
+
+    SET_BIT(SDADCx->CR1.w, SDADC_CR1_INIT);
+
+    return XPD_eWaitForMatch(&SDADCx->ISR.w, SDADC_ISR_INITRDY, SDADC_ISR_INITRDY, &ulTimeout);
+}
+
+static void SDADC_prvExitInit(SDADC_TypeDef * SDADCx)
+{
+    CLEAR_BIT(SDADCx->CR1.w, SDADC_CR1_INIT);
+}
+
+static void SDADC_prvDmaHalfRedirect(void * pxDMA)
+{
+    SDADC_HandleType * pxSDADC = (SDADC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The first half of the buffer is filled */
+    pxSDADC->Block = pxSDADC->Stream.Buffer;
+
+    XPD_SAFE_CALLBACK(pxSDADC->Callbacks.InjConvComplete, pxSDADC);
+}
+
+static void SDADC_prvDmaRedirect(void * pxDMA)
+{
+    SDADC_HandleType * pxSDADC = (SDADC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is filled */
+        pxSDADC->Block = pxSDADC->Stream.Buffer
+                + (pxSDADC->Stream.HalfLength * pxSDADC->Stream.TransferSize);
+    }
+    else
+    {
+        /* The whole buffer is filled, end of the single transfer */
+        pxSDADC->Block = pxSDADC->Stream.Buffer;
+
+        CLEAR_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_JDMAEN);
+    }
+
+    XPD_SAFE_CALLBACK(pxSDADC->Callbacks.InjConvComplete, pxSDADC);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void SDADC_prvDmaErrorRedirect(void * pxDMA)
+{
+    SDADC_HandleType * pxSDADC = (SDADC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* Update error code */
+    pxSDADC->Errors |= SDADC_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxSDADC->Callbacks.Error, pxSDADC);
+}
+#endif
+
+/** @defgroup SDADC_Exported_Functions SDADC Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the reference voltage of the SDADCs (located in SDADC1).
+ *        The reference has to be set up before the calibration,
+ *        and it has to be stable before the conversions start.
+ * @param eReference: the new reference voltage source
+ * @return TIMEOUT if SDADC1 couldn't enter initialization mode, OK if successful
+ */
+XPD_ReturnType SDADC_eReferenceConfig(SDADC_ReferenceType eReference)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    boolean_t eEnabled;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_SDADC1);
+
+    /* The reference can only be changed in initialization mode or when SDADC1 is off */
+    eEnabled = (SDADC1->CR2.w & SDADC_CR2_ADON) != 0;
+    if (eEnabled)
+    {
+        eResult = SDADC_prvEnterInit(SDADC1);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        MODIFY_REG(SDADC1->CR1.w, SDADC_CR1_REFV, eReference << SDADC_CR1_REFV_Pos);
+    }
+
+    if (eEnabled)
+    {
+        SDADC_prvExitInit(SDADC1);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Initializes the SDADC peripheral using the setup configuration,
+ *        and waits for the analog stabilization.
+ *        The SDADC clock has to be set up (see @ref SDADC_vClockConfig) before the call.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param pxConfig: SDADC setup configuration
+ * @return TIMEOUT if the SDADC didn't stabilize, OK if successful
+ */
+XPD_ReturnType SDADC_eInit(SDADC_HandleType * pxSDADC, const SDADC_InitType * pxConfig)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = SDADC_STAB_TIMEOUT;
+
+    /* the analog part of the SDADC is supplied through the PWR */
+    RCC_vClockEnable(RCC_POS_PWR);
+    SET_BIT(PWR->CR.w, SDADC_PWR_ENSD(pxSDADC));
+
+    /* enable clock */
+    RCC_vClockEnable(pxSDADC->CtrlPos);
+
+    /* The modes can only be changed when the SDADC is off */
+    SDADC_REG_BIT(pxSDADC, CR2, ADON) = 0;
+
+    MODIFY_REG(pxSDADC->Inst->CR1.w,
+            SDADC_CR1_SLOWCK | SDADC_CR1_JSYNC | SDADC_CR1_RSYNC
+            | SDADC_CR1_JDMAEN | SDADC_CR1_RDMAEN
+            | SDADC_CR1_EOCALIE | SDADC_CR1_JEOCIE | SDADC_CR1_JOVRIE
+            | SDADC_CR1_REOCIE | SDADC_CR1_ROVRIE,
+            ((pxConfig->SlowClock != DISABLE) ? SDADC_CR1_SLOWCK : 0)
+            | ((pxConfig->Synchronous != DISABLE) ? (SDADC_CR1_JSYNC | SDADC_CR1_RSYNC) : 0));
+
+    pxSDADC->Inst->CR2.w = (pxConfig->FastMode != DISABLE) ? SDADC_CR2_FAST : 0;
+    pxSDADC->Inst->CLRISR.w = SDADC_CLRISR_CLREOCALF | SDADC_CLRISR_CLRJOVRF | SDADC_CLRISR_CLRROVRF;
+
+    SDADC_REG_BIT(pxSDADC, CR2, ADON) = 1;
+
+    /* Wait until the analog part is stabilized */
+    eResult = XPD_eWaitForMatch(&pxSDADC->Inst->ISR.w, SDADC_ISR_STABIP, 0, &ulTimeout);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxSDADC->Callbacks.DepInit, pxSDADC);
+
+    pxSDADC->Block           = NULL;
+    pxSDADC->InjectedTrigger = 0;
+    pxSDADC->Errors          = SDADC_ERROR_NONE;
+
+    return eResult;
+}
+
+/**
+ * @brief Restores the SDADC peripheral to its default inactive state.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vDeinit(SDADC_HandleType * pxSDADC)
+{
+    /* Stop all conversions and turn off the converter */
+    pxSDADC->Inst->CR2.w = 0;
+    pxSDADC->Inst->CR1.w &= SDADC_CR1_REFV;
+
+    if (pxSDADC->DMA != NULL)
+    {
+        DMA_vStop_IT(pxSDADC->DMA);
+    }
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxSDADC->Callbacks.DepDeinit, pxSDADC);
+
+    CLEAR_BIT(PWR->CR.w, SDADC_PWR_ENSD(pxSDADC));
+
+    /* SDADC1 holds the common reference setting */
+    if (pxSDADC->Inst != SDADC1)
+    {
+        /* disable clock */
+        RCC_vClockDisable(pxSDADC->CtrlPos);
+    }
+}
+
+/**
+ * @brief Sets up one of the conversion configurations of the SDADC.
+ *        Each input channel converts with one of the configurations,
+ *        see @ref SDADC_eChannelConfig.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucConfig: index of the configuration [0 .. 2]
+ * @param pxConfig: conversion configuration
+ * @return TIMEOUT if the SDADC couldn't enter initialization mode, OK if successful
+ */
+XPD_ReturnType SDADC_eConfigInit(
+        SDADC_HandleType *          pxSDADC,
+        uint8_t                     ucConfig,
+        const SDADC_ConfigType *    pxConfig)
+{
+    XPD_ReturnType eResult = SDADC_prvEnterInit(pxSDADC->Inst);
+
+    if (eResult == XPD_OK)
+    {
+        (&pxSDADC->Inst->CONF0R.w)[ucConfig] =
+                  ((uint32_t)pxConfig->Offset     << SDADC_CONF0R_OFFSET0_Pos)
+                | ((uint32_t)pxConfig->Gain       << SDADC_CONF0R_GAIN0_Pos)
+                | ((uint32_t)pxConfig->InputMode  << SDADC_CONF0R_SE0_Pos)
+                | ((uint32_t)pxConfig->CommonMode << SDADC_CONF0R_COMMON0_Pos);
+    }
+
+    SDADC_prvExitInit(pxSDADC->Inst);
+
+    return eResult;
+}
+
+/**
+ * @brief Assigns a conversion configuration to an input channel.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucChannel: the input channel [0 .. 8]
+ * @param ucConfig: index of the configuration [0 .. 2]
+ * @return TIMEOUT if the SDADC couldn't enter initialization mode, OK if successful
+ */
+XPD_ReturnType SDADC_eChannelConfig(
+        SDADC_HandleType *  pxSDADC,
+        uint8_t             ucChannel,
+        uint8_t             ucConfig)
+{
+    XPD_ReturnType eResult = SDADC_prvEnterInit(pxSDADC->Inst);
+
+    if (eResult == XPD_OK)
+    {
+        if (ucChannel < (SDADC_CHANNEL_COUNT - 1))
+        {
+            uint8_t ucShift = ucChannel * SDADC_CONFCH_SIZE;
+
+            MODIFY_REG(pxSDADC->Inst->CONFCHR1.w,
+                    SDADC_CONFCHR1_CONFCH0 << ucShift, (uint32_t)ucConfig << ucShift);
+        }
+        else
+        {
+            pxSDADC->Inst->CONFCHR2.w = ucConfig;
+        }
+    }
+
+    SDADC_prvExitInit(pxSDADC->Inst);
+
+    return eResult;
+}
+
+/**
+ * @brief Reads the offset of a conversion configuration (e.g. the calibration result).
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucConfig: index of the configuration [0 .. 2]
+ * @return The 12 bit offset value
+ */
+uint16_t SDADC_usGetOffset(SDADC_HandleType * pxSDADC, uint8_t ucConfig)
+{
+    return ((&pxSDADC->Inst->CONF0R.w)[ucConfig] & SDADC_CONF0R_OFFSET0) >> SDADC_CONF0R_OFFSET0_Pos;
+}
+
+/**
+ * @brief Executes the offset calibration sequence of the SDADC.
+ *        The offsets of the calibrated configurations are overwritten by the results.
+ *        The reference and the configurations have to be set up before the calibration.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucConfigCount: the number of configurations to calibrate, starting from the first [1 .. 3]
+ * @return TIMEOUT if the calibration didn't finish in time, OK if successful
+ */
+XPD_ReturnType SDADC_eCalibrate(SDADC_HandleType * pxSDADC, uint8_t ucConfigCount)
+{
+    XPD_ReturnType eResult = SDADC_prvEnterInit(pxSDADC->Inst);
+
+    if (eResult == XPD_OK)
+    {
+        MODIFY_REG(pxSDADC->Inst->CR2.w, SDADC_CR2_CALIBCNT,
+                (uint32_t)(ucConfigCount - 1) << SDADC_CR2_CALIBCNT_Pos);
+
+        SDADC_prvExitInit(pxSDADC->Inst);
+
+        SDADC_FLAG_CLEAR(pxSDADC, EOCALF);
+
+        SDADC_REG_BIT(pxSDADC, CR2, STARTCALIB) = 1;
+
+        eResult = SDADC_ePollStatus(pxSDADC, SDADC_OPERATION_CALIBRATION, SDADC_CALIBRATION_TIMEOUT);
+    }
+    else
+    {
+        SDADC_prvExitInit(pxSDADC->Inst);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Polls the status of the SDADC operation.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param eOperation: the type of operation to check
+ * @param ulTimeout: the timeout in ms for the polling.
+ * @return TIMEOUT if timed out, OK if successful
+ */
+XPD_ReturnType SDADC_ePollStatus(
+        SDADC_HandleType *  pxSDADC,
+        SDADC_OperationType eOperation,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult;
+
+    /* Wait until operation flag is set */
+    eResult = XPD_eWaitForMatch(&pxSDADC->Inst->ISR.w, eOperation, eOperation, &ulTimeout);
+
+    /* The conversion flags are cleared by reading the data */
+    if ((eResult == XPD_OK) && (eOperation == SDADC_OPERATION_CALIBRATION))
+    {
+        SDADC_FLAG_CLEAR(pxSDADC, EOCALF);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Starts the regular conversion of a single channel.
+ *        A synchronous SDADC starts converting when SDADC1 starts a regular conversion.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucChannel: the input channel [0 .. 8]
+ * @param eContinuous: continuous conversion mode
+ */
+void SDADC_vStart(SDADC_HandleType * pxSDADC, uint8_t ucChannel, FunctionalState eContinuous)
+{
+    MODIFY_REG(pxSDADC->Inst->CR2.w, SDADC_CR2_RCH | SDADC_CR2_RCONT,
+            ((uint32_t)ucChannel << SDADC_CR2_RCH_Pos)
+            | ((eContinuous != DISABLE) ? SDADC_CR2_RCONT : 0));
+
+    if (SDADC_REG_BIT(pxSDADC, CR1, RSYNC) == 0)
+    {
+        SDADC_REG_BIT(pxSDADC, CR2, RSWSTART) = 1;
+    }
+}
+
+/**
+ * @brief Stops the continuous regular conversions, the ongoing conversion is finished.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vStop(SDADC_HandleType * pxSDADC)
+{
+    SDADC_REG_BIT(pxSDADC, CR2, RCONT) = 0;
+}
+
+/**
+ * @brief Starts the regular conversion of a single channel with interrupts.
+ *        The ConvComplete callback has to read the result to clear the flag.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param ucChannel: the input channel [0 .. 8]
+ * @param eContinuous: continuous conversion mode
+ */
+void SDADC_vStart_IT(SDADC_HandleType * pxSDADC, uint8_t ucChannel, FunctionalState eContinuous)
+{
+    SDADC_FLAG_CLEAR(pxSDADC, ROVRF);
+    SET_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_REOCIE | SDADC_CR1_ROVRIE);
+
+    SDADC_vStart(pxSDADC, ucChannel, eContinuous);
+}
+
+/**
+ * @brief Stops the continuous regular conversions and disables their interrupts.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vStop_IT(SDADC_HandleType * pxSDADC)
+{
+    SDADC_vStop(pxSDADC);
+
+    CLEAR_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_REOCIE | SDADC_CR1_ROVRIE);
+}
+
+/**
+ * @brief Initializes the injected channel group using the setup configuration.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param pxConfig: SDADC injected group setup configuration
+ * @return TIMEOUT if the SDADC couldn't enter initialization mode, OK if successful
+ */
+XPD_ReturnType SDADC_eInjectedInit(SDADC_HandleType * pxSDADC, const SDADC_InjectedInitType * pxConfig)
+{
+    XPD_ReturnType eResult = SDADC_prvEnterInit(pxSDADC->Inst);
+
+    if (eResult == XPD_OK)
+    {
+        pxSDADC->Inst->JCHGR.w = pxConfig->Channels;
+
+        MODIFY_REG(pxSDADC->Inst->CR2.w,
+                SDADC_CR2_JCONT | SDADC_CR2_JEXTSEL | SDADC_CR2_JEXTEN,
+                ((pxConfig->ContinuousMode != DISABLE) ? SDADC_CR2_JCONT : 0)
+                | (((uint32_t)pxConfig->Trigger.Source << SDADC_CR2_JEXTSEL_Pos) & SDADC_CR2_JEXTSEL));
+
+        /* The trigger is only armed when the conversions are started */
+        pxSDADC->InjectedTrigger = (pxConfig->Trigger.Source < SDADC1_TRIGGER_SOFTWARE) ?
+                pxConfig->Trigger.Edge : EDGE_NONE;
+    }
+
+    SDADC_prvExitInit(pxSDADC->Inst);
+
+    return eResult;
+}
+
+/**
+ * @brief Starts the injected group conversion, either immediately (software trigger)
+ *        or by arming the external trigger.
+ *        A synchronous SDADC starts converting when SDADC1 starts an injected conversion,
+ *        so SDADC1 has to be started last.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vInjectedStart(SDADC_HandleType * pxSDADC)
+{
+    if (SDADC_REG_BIT(pxSDADC, CR1, JSYNC) != 0)
+    {
+        /* Started by SDADC1 */
+    }
+    else if (pxSDADC->InjectedTrigger == EDGE_NONE)
+    {
+        SDADC_REG_BIT(pxSDADC, CR2, JSWSTART) = 1;
+    }
+    else
+    {
+        MODIFY_REG(pxSDADC->Inst->CR2.w, SDADC_CR2_JEXTEN,
+                (uint32_t)pxSDADC->InjectedTrigger << SDADC_CR2_JEXTEN_Pos);
+    }
+}
+
+/**
+ * @brief Disarms the injected trigger and aborts the ongoing conversions.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vInjectedStop(SDADC_HandleType * pxSDADC)
+{
+    CLEAR_BIT(pxSDADC->Inst->CR2.w, SDADC_CR2_JEXTEN);
+
+    /* Entering initialization mode stops the continuous conversions */
+    (void) SDADC_prvEnterInit(pxSDADC->Inst);
+    SDADC_prvExitInit(pxSDADC->Inst);
+}
+
+/**
+ * @brief Starts the injected group conversion with interrupts.
+ *        The InjConvComplete callback has to read the result to clear the flag.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vInjectedStart_IT(SDADC_HandleType * pxSDADC)
+{
+    SDADC_FLAG_CLEAR(pxSDADC, JOVRF);
+    SET_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_JEOCIE | SDADC_CR1_JOVRIE);
+
+    SDADC_vInjectedStart(pxSDADC);
+}
+
+/**
+ * @brief Stops the injected group conversion and disables its interrupts.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vInjectedStop_IT(SDADC_HandleType * pxSDADC)
+{
+    SDADC_vInjectedStop(pxSDADC);
+
+    CLEAR_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_JEOCIE | SDADC_CR1_JOVRIE);
+}
+
+/**
+ * @brief Gets the result of the last injected conversion.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param pucChannel: the input channel of the result (can be NULL)
+ * @return The signed conversion result
+ */
+int16_t SDADC_sGetInjectedValue(SDADC_HandleType * pxSDADC, uint8_t * pucChannel)
+{
+    uint32_t ulData = pxSDADC->Inst->JDATAR.w;
+
+    if (pucChannel != NULL)
+    {
+        *pucChannel = (ulData & SDADC_JDATAR_JDATACH) >> SDADC_JDATAR_JDATACH_Pos;
+    }
+    return (int16_t)ulData;
+}
+
+/**
+ * @brief Starts the injected group conversions with DMA.
+ *        When the DMA stream is in circular mode, the buffer is double buffered:
+ *        the InjConvComplete callback is called at each filled half,
+ *        with Block pointing to the half that is available to the application.
+ *
+ *        For lockstep conversions of all three SDADCs, set up SDADC2 and SDADC3 as Synchronous,
+ *        and either use a timer trigger on SDADC1, or the fast continuous mode on all of them
+ *        for the highest rate. The SDADC1 DMA stream transfers @ref SDADC_DATA_PAIR12
+ *        (SDADC1 and SDADC2 results in one word), the SDADC3 DMA stream its own results.
+ *        SDADC3 has to be started before SDADC1.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ * @param eData: the transferred data register,
+ *        the DMA stream has to be set up for halfword (single) or word (pair) transfers
+ * @param pvBuffer: pointer to the conversion buffer
+ * @param usLength: length of the buffer in transfers (even in circular mode)
+ * @return ERROR if the data register is invalid for the SDADC,
+ *         BUSY if the DMA stream is in use, OK if the conversions are started
+ */
+XPD_ReturnType SDADC_eInjectedStart_DMA(
+        SDADC_HandleType *  pxSDADC,
+        SDADC_DataType      eData,
+        void *              pvBuffer,
+        uint16_t            usLength)
+{
+    XPD_ReturnType eResult;
+    void * pvData;
+
+    switch (eData)
+    {
+        case SDADC_DATA_PAIR12:
+            pvData = (void*)&pxSDADC->Inst->JDATA12R.w;
+            break;
+        case SDADC_DATA_PAIR13:
+            pvData = (void*)&pxSDADC->Inst->JDATA13R.w;
+            break;
+        default:
+            pvData = (void*)&pxSDADC->Inst->JDATAR.w;
+            break;
+    }
+
+    /* The packed data registers are only available in SDADC1 */
+    if ((eData != SDADC_DATA_SINGLE) && (pxSDADC->Inst != SDADC1))
+    {
+        return XPD_ERROR;
+    }
+
+    pxSDADC->Stream.Buffer       = pvBuffer;
+    pxSDADC->Stream.HalfLength   = usLength / 2;
+    pxSDADC->Stream.TransferSize = (eData == SDADC_DATA_SINGLE) ? sizeof(int16_t) : sizeof(uint32_t);
+    pxSDADC->Block               = NULL;
+    pxSDADC->Errors              = SDADC_ERROR_NONE;
+
+    /* Set the callback owner */
+    pxSDADC->DMA->Owner = pxSDADC;
+
+    /* Set the DMA transfer callbacks */
+    pxSDADC->DMA->Callbacks.Complete     = SDADC_prvDmaRedirect;
+    pxSDADC->DMA->Callbacks.HalfComplete = SDADC_prvDmaHalfRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+    pxSDADC->DMA->Callbacks.Error        = SDADC_prvDmaErrorRedirect;
+#endif
+
+    eResult = DMA_eStart_IT(pxSDADC->DMA, pvData, pvBuffer, usLength);
+
+    if (eResult == XPD_OK)
+    {
+        /* In circular mode each buffer half is a block */
+        if (DMA_eCircularMode(pxSDADC->DMA) != 0)
+        {
+            DMA_IT_ENABLE(pxSDADC->DMA, HT);
+        }
+
+        SDADC_FLAG_CLEAR(pxSDADC, JOVRF);
+        SET_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_JDMAEN | SDADC_CR1_JOVRIE);
+
+        SDADC_vInjectedStart(pxSDADC);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the injected group conversions and their DMA transfer.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vInjectedStop_DMA(SDADC_HandleType * pxSDADC)
+{
+    SDADC_vInjectedStop(pxSDADC);
+
+    CLEAR_BIT(pxSDADC->Inst->CR1.w, SDADC_CR1_JDMAEN | SDADC_CR1_JOVRIE);
+
+    DMA_vStop_IT(pxSDADC->DMA);
+}
+
+/**
+ * @brief SDADC interrupt handler that provides handle callbacks.
+ * @param pxSDADC: pointer to the SDADC handle structure
+ */
+void SDADC_vIRQHandler(SDADC_HandleType * pxSDADC)
+{
+    uint32_t ulISR = pxSDADC->Inst->ISR.w;
+    uint32_t ulCR1 = pxSDADC->Inst->CR1.w;
+
+    /* Regular conversion complete */
+    if (((ulISR & SDADC_ISR_REOCF) != 0) && ((ulCR1 & SDADC_CR1_REOCIE) != 0))
+    {
+        XPD_SAFE_CALLBACK(pxSDADC->Callbacks.ConvComplete, pxSDADC);
+    }
+
+    /* Injected conversion complete */
+    if (((ulISR & SDADC_ISR_JEOCF) != 0) && ((ulCR1 & SDADC_CR1_JEOCIE) != 0))
+    {
+        XPD_SAFE_CALLBACK(pxSDADC->Callbacks.InjConvComplete, pxSDADC);
+    }
+
+    /* Calibration complete */
+    if (((ulISR & SDADC_ISR_EOCALF) != 0) && ((ulCR1 & SDADC_CR1_EOCALIE) != 0))
+    {
+        SDADC_FLAG_CLEAR(pxSDADC, EOCALF);
+    }
+
+    /* Data overruns */
+    if (((ulISR & SDADC_ISR_ROVRF) != 0) && ((ulCR1 & SDADC_CR1_ROVRIE) != 0))
+    {
+        SDADC_FLAG_CLEAR(pxSDADC, ROVRF);
+
+        pxSDADC->Errors |= SDADC_ERROR_OVERRUN;
+
+        XPD_SAFE_CALLBACK(pxSDADC->Callbacks.Error, pxSDADC);
+    }
+    if (((ulISR & SDADC_ISR_JOVRF) != 0) && ((ulCR1 & SDADC_CR1_JOVRIE) != 0))
+    {
+        SDADC_FLAG_CLEAR(pxSDADC, JOVRF);
+
+        pxSDADC->Errors |= SDADC_ERROR_INJOVERRUN;
+
+        XPD_SAFE_CALLBACK(pxSDADC->Callbacks.Error, pxSDADC);
+    }
+}
+
+/**
+ * @brief Separates packed pair results (@ref SDADC_DATA_PAIR12 or @ref SDADC_DATA_PAIR13)
+ *        of an injected group into per-channel arrays.
+ * @param pulPairs: pointer to the packed results (a received block)
+ * @param apsFirst: array of SDADC1 channel output buffers, each with usScans capacity
+ * @param apsSecond: array of SDADC2 / SDADC3 channel output buffers, each with usScans capacity
+ * @param ucChannels: number of channels in the injected group
+ * @param usScans: number of injected group conversions to process
+ */
+void SDADC_vUnpackPairs(
+        const uint32_t *    pulPairs,
+        int16_t * const     apsFirst[],
+        int16_t * const     apsSecond[],
+        uint8_t             ucChannels,
+        uint16_t            usScans)
+{
+    uint8_t ucCh;
+
+    for (ucCh = 0; ucCh < ucChannels; ucCh++)
+    {
+        const uint32_t * pulIn = &pulPairs[ucCh];
+        int16_t * psFirst = apsFirst[ucCh];
+        int16_t * psSecond = apsSecond[ucCh];
+        uint16_t usCount = usScans;
+
+        /* Unrolled to keep the loop overhead off the load-store pairs */
+        for (; usCount >= 2; usCount -= 2)
+        {
+            uint32_t ulPair0 = pulIn[0];
+            uint32_t ulPair1 = pulIn[ucChannels];
+
+            psFirst[0]  = SDADC_PAIR_FIRST(ulPair0);
+            psSecond[0] = SDADC_PAIR_SECOND(ulPair0);
+            psFirst[1]  = SDADC_PAIR_FIRST(ulPair1);
+            psSecond[1] = SDADC_PAIR_SECOND(ulPair1);
+            pulIn    += 2 * ucChannels;
+            psFirst  += 2;
+            psSecond += 2;
+        }
+        if (usCount > 0)
+        {
+            *psFirst  = SDADC_PAIR_FIRST(*pulIn);
+            *psSecond = SDADC_PAIR_SECOND(*pulIn);
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* SDADC1 */
@@ -40,6 +40,7 @@
 
 #define TIM_ACTIVE_CHANNELS(HANDLE) (HANDLE->Inst->CCER.w & TIM_ALL_CHANNELS)
 
+#ifndef __XPD_TIM_NO_DMA
 #ifdef __XPD_DMA_ERROR_DETECT
 static void TIM_prvDmaErrorRedirect(void *pxDMA)
 {
@@ -103,6 +104,7 @@ static const XPD_HandleCallbackType TIM_apxDmaRedirects[] = {
         TIM_prvDmaCommutationCallbackRedirect,
         TIM_prvDmaTriggerCallbackRedirect,
 };
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @defgroup TIM_Common_Exported_Functions TIM Common Exported Functions
  *  @brief    TIM common functions (timer, channels control)
@@ -213,6 +215,7 @@ void TIM_vIRQHandler_UP(TIM_HandleType * pxTIM)
     }
 }
 
+#ifndef __XPD_TIM_NO_DMA
 /**
  * @brief Sets up and enables a DMA transfer for the TIM counter.
  * @param pxTIM: pointer to the TIM handle structure
@@ -264,6 +267,7 @@ void TIM_vCounterStop_DMA(TIM_HandleType * pxTIM)
     /* disable the counter */
     TIM_vCounterStop(pxTIM);
 }
+#endif /* __XPD_TIM_NO_DMA */
 
 /**
  * @brief Starts the selected timer channel (and the timer if required).
@@ -353,6 +357,7 @@ void TIM_vIRQHandler_CC(TIM_HandleType * pxTIM)
     }
 }
 
+#ifndef __XPD_TIM_NO_DMA
 /**
  * @brief Starts the selected timer channel (and the timer if required)
  *        using a DMA transfer to provide channel pulse values.
@@ -407,11 +412,13 @@ void TIM_vChannelStop_DMA(TIM_HandleType * pxTIM, TIM_ChannelType eChannel)
 
     TIM_vChannelStop(pxTIM, eChannel);
 }
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @} */
 
 /** @} */
 
+#ifndef __XPD_TIM_NO_DMA
 /** @addtogroup TIM_Burst
  * @{ */
 
@@ -480,6 +487,7 @@ void TIM_vBurstStop_DMA(TIM_HandleType * pxTIM, TIM_EventType Source)
 /** @} */
 
 /** @} */
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @addtogroup TIM_Output
  * @{ */
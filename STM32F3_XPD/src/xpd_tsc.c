@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    xpd_tsc.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Touch Sensing Controller Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_tsc.h>
+#include <xpd_utils.h>
+
+#if defined(TSC)
+
+/** @addtogroup TSC
+ * @{ */
+
+/* Starts the acquisition of the current bank on all of its groups */
+static void TSC_prvStartBank(TSC_HandleType * pxTSC)
+{
+    uint32_t ulChannels = pxTSC->Banks.Channels[pxTSC->Banks.Current];
+    uint32_t ulGroups = 0;
+    uint8_t ucGroup;
+
+    for (ucGroup = 0; ucGroup < TSC_GROUP_COUNT; ucGroup++)
+    {
+        if ((ulChannels & (0xFUL << (ucGroup * 4))) != 0)
+        {
+            ulGroups |= 1UL << ucGroup;
+        }
+    }
+
+    pxTSC->Inst->IOCCR.w  = ulChannels;
+    pxTSC->Inst->IOGCSR.w = ulGroups;
+
+    pxTSC->Inst->ICR.w = TSC_ICR_EOAIC | TSC_ICR_MCEIC;
+    SET_BIT(pxTSC->Inst->CR.w, TSC_CR_START);
+}
+
+/* Updates the key state with a new acquisition result */
+static void TSC_prvKeyUpdate(TSC_HandleType * pxTSC, TSC_KeyType * pxKey, uint16_t usCount)
+{
+    int32_t lDelta;
+
+    /* The first acquisition sets the initial baseline */
+    if (pxKey->Baseline == 0)
+    {
+        pxKey->Baseline = usCount;
+    }
+    pxKey->Count = usCount;
+
+    /* Touch increases the electrode capacitance, reducing the count */
+    lDelta = (int32_t)pxKey->Baseline - (int32_t)usCount;
+
+    if (pxKey->Touched == 0)
+    {
+        if (lDelta > pxKey->Threshold)
+        {
+            if (++pxKey->Debounce >= pxTSC->Debounce)
+            {
+                pxKey->Touched  = 1;
+                pxKey->Debounce = 0;
+            }
+        }
+        else
+        {
+            pxKey->Debounce = 0;
+
+            /* Follow the slow environmental drift while released */
+            pxKey->Baseline -= lDelta / (1L << pxTSC->BaselineShift);
+        }
+    }
+    /* Release with half threshold hysteresis */
+    else if (lDelta < (pxKey->Threshold / 2))
+    {
+        if (++pxKey->Debounce >= pxTSC->Debounce)
+        {
+            pxKey->Touched  = 0;
+            pxKey->Debounce = 0;
+        }
+    }
+    else
+    {
+        pxKey->Debounce = 0;
+    }
+}
+
+/** @defgroup TSC_Exported_Functions TSC Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the TSC peripheral using the setup configuration.
+ * @param pxTSC: pointer to the TSC handle structure
+ * @param pxConfig: TSC setup configuration
+ */
+void TSC_vInit(TSC_HandleType * pxTSC, const TSC_InitType * pxConfig)
+{
+    uint32_t ulCR = TSC_CR_TSCE
+            | ((uint32_t)(pxConfig->PulseHigh - 1) << TSC_CR_CTPH_Pos)
+            | ((uint32_t)(pxConfig->PulseLow  - 1) << TSC_CR_CTPL_Pos)
+            | (pxConfig->PulsePrescaler << TSC_CR_PGPSC_Pos)
+            | (pxConfig->MaxCount << TSC_CR_MCV_Pos)
+            | (pxConfig->FloatingIOs << TSC_CR_IODEF_Pos);
+
+    if (pxConfig->SpreadSpectrum.State != DISABLE)
+    {
+        ulCR |= TSC_CR_SSE
+             | ((uint32_t)(pxConfig->SpreadSpectrum.Deviation - 1) << TSC_CR_SSD_Pos)
+             | (pxConfig->SpreadSpectrum.HalfClock << TSC_CR_SSPSC_Pos);
+    }
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_TSC);
+
+    pxTSC->Inst->CR.w  = ulCR;
+    pxTSC->Inst->IER.w = 0;
+
+    pxTSC->Banks.Count   = 0;
+    pxTSC->Banks.Current = 0;
+    pxTSC->Cycles        = 0;
+    pxTSC->Errors        = TSC_ERROR_NONE;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxTSC->Callbacks.DepInit, pxTSC);
+}
+
+/**
+ * @brief Restores the TSC peripheral to its default inactive state.
+ * @param pxTSC: pointer to the TSC handle structure
+ */
+void TSC_vDeinit(TSC_HandleType * pxTSC)
+{
+    pxTSC->Inst->IER.w = 0;
+    pxTSC->Inst->CR.w  = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxTSC->Callbacks.DepDeinit, pxTSC);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_TSC);
+}
+
+/**
+ * @brief Sets up the sampling capacitor IOs and the channel banks of the TSC.
+ *        Each acquisition measures one bank, on all of its groups simultaneously.
+ * @note  The key states are reset, the key thresholds are left unchanged.
+ * @param pxTSC: pointer to the TSC handle structure
+ * @param ulSamplingIOs: the sampling capacitor IOs (one per used group), see @ref TSC_IO
+ * @param pulBanks: array of channel IO selections, at most one channel per group in each,
+ *        see @ref TSC_IO
+ * @param pxKeys: array of (ucBankCount * @ref TSC_GROUP_COUNT) key states
+ * @param ucBankCount: number of banks
+ */
+void TSC_vChannelConfig(TSC_HandleType * pxTSC, uint32_t ulSamplingIOs,
+        const uint32_t * pulBanks, TSC_KeyType * pxKeys, uint8_t ucBankCount)
+{
+    uint32_t ulIOs = ulSamplingIOs;
+    uint16_t usKey;
+    uint8_t ucBank;
+
+    for (ucBank = 0; ucBank < ucBankCount; ucBank++)
+    {
+        ulIOs |= pulBanks[ucBank];
+    }
+    for (usKey = 0; usKey < (ucBankCount * TSC_GROUP_COUNT); usKey++)
+    {
+        pxKeys[usKey].Baseline = 0;
+        pxKeys[usKey].Debounce = 0;
+        pxKeys[usKey].Touched  = 0;
+    }
+
+    /* Schmitt trigger hysteresis is disabled on the TSC IOs */
+    CLEAR_BIT(pxTSC->Inst->IOHCR.w, ulIOs);
+    pxTSC->Inst->IOSCR.w  = ulSamplingIOs;
+
+    pxTSC->Banks.Channels = pulBanks;
+    pxTSC->Banks.Keys     = pxKeys;
+    pxTSC->Banks.Count    = ucBankCount;
+    pxTSC->Banks.Current  = ucBankCount;
+}
+
+/**
+ * @brief Starts an interrupt-driven acquisition cycle of all banks.
+ *        Once all banks are acquired, the keys are updated and the Cycle callback is called.
+ * @note  Periodic scanning can be achieved by restarting the cycle from the Cycle callback
+ *        or from a timer.
+ * @param pxTSC: pointer to the TSC handle structure
+ * @return BUSY if a cycle is already in progress, OK otherwise
+ */
+XPD_ReturnType TSC_eStart_IT(TSC_HandleType * pxTSC)
+{
+    XPD_ReturnType eResult = XPD_BUSY;
+
+    if (pxTSC->Banks.Current >= pxTSC->Banks.Count)
+    {
+        pxTSC->Banks.Current = 0;
+        pxTSC->Errors        = TSC_ERROR_NONE;
+
+        pxTSC->Inst->IER.w = TSC_IER_EOAIE | TSC_IER_MCEIE;
+        TSC_prvStartBank(pxTSC);
+
+        eResult = XPD_OK;
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the acquisition cycle after the ongoing acquisition.
+ * @param pxTSC: pointer to the TSC handle structure
+ */
+void TSC_vStop_IT(TSC_HandleType * pxTSC)
+{
+    pxTSC->Inst->IER.w   = 0;
+    pxTSC->Banks.Current = pxTSC->Banks.Count;
+}
+
+/**
+ * @brief TSC interrupt handler that processes the acquired bank and continues the cycle.
+ * @param pxTSC: pointer to the TSC handle structure
+ */
+void TSC_vIRQHandler(TSC_HandleType * pxTSC)
+{
+    uint32_t ulISR = pxTSC->Inst->ISR.w;
+
+    if ((ulISR & (TSC_ISR_EOAF | TSC_ISR_MCEF)) != 0)
+    {
+        uint32_t ulStatus = pxTSC->Inst->IOGCSR.w;
+        TSC_KeyType * pxKeys = &pxTSC->Banks.Keys[pxTSC->Banks.Current * TSC_GROUP_COUNT];
+        uint8_t ucGroup;
+
+        pxTSC->Inst->ICR.w = TSC_ICR_EOAIC | TSC_ICR_MCEIC;
+
+        if ((ulISR & TSC_ISR_MCEF) != 0)
+        {
+            pxTSC->Errors |= TSC_ERROR_MAXCOUNT;
+
+            XPD_SAFE_CALLBACK(pxTSC->Callbacks.Error, pxTSC);
+        }
+
+        /* Only the completed groups are evaluated */
+        ulStatus &= ulStatus >> TSC_IOGCSR_G1S_Pos;
+
+        for (ucGroup = 0; ucGroup < TSC_GROUP_COUNT; ucGroup++)
+        {
+            if ((ulStatus & (1UL << ucGroup)) != 0)
+            {
+                TSC_prvKeyUpdate(pxTSC, &pxKeys[ucGroup],
+                        pxTSC->Inst->IOGXCR[ucGroup]);
+            }
+        }
+
+        /* Continue with the next bank */
+        if (++pxTSC->Banks.Current < pxTSC->Banks.Count)
+        {
+            TSC_prvStartBank(pxTSC);
+        }
+        else
+        {
+            pxTSC->Inst->IER.w = 0;
+            pxTSC->Cycles++;
+
+            XPD_SAFE_CALLBACK(pxTSC->Callbacks.Cycle, pxTSC);
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* TSC */
@@ -145,6 +145,134 @@ __weak XPD_ReturnType XPD_eWaitForDiff(
     return eResult;
 }
 
+/**
+ * @brief Waits until the result of an interrupt-driven operation is set, or until times out.
+ * @note  The milliseconds based waiting utilities shall not be used concurrently.
+ *        The time of the preempted waiters do not elapse.
+ * @param peResult: pointer to the operation result, which is BUSY while in progress
+ * @param pulTimeout: pointer to the timeout in ms
+ * @return TIMEOUT if timed out, or OK if the result was set within the deadline
+ */
+XPD_ReturnType XPD_eWaitForResult(
+        volatile XPD_ReturnType * peResult,
+        uint32_t *                pulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    /* Initially clear flag */
+    (void) SysTick->CTRL.b.COUNTFLAG;
+
+    while (*peResult == XPD_BUSY)
+    {
+        if (*pulTimeout == 0)
+        {
+            eResult = XPD_TIMEOUT;
+            break;
+        }
+        /* COUNTFLAG returns 1 if timer counted to 0 since the last flag read */
+        *pulTimeout -= SysTick->CTRL.b.COUNTFLAG;
+    }
+    return eResult;
+}
+
+/** @} */
+
+/** @defgroup XPD_Exported_Functions_Cycles XPD Cycle Measurement Functions
+ *  @brief    XPD Utilities execution time measurement in core clock cycles
+ * @{
+ */
+
+/**
+ * @brief Starts the core cycle counter.
+ * @note  Without the DWT cycle counter (Cortex-M0) the SysTick current value is used,
+ *        which requires the running SysTick clocked from HCLK (see @ref XPD_vInitTimer),
+ *        and limits the measurable interval to one SysTick period.
+ */
+void XPD_vInitCycleCounter(void)
+{
+#if (__CORTEX_M >= 3U)
+    CoreDebug->DEMCR.b.TRCENA = 1;
+    DWT->CYCCNT = 0;
+    DWT->CTRL.b.CYCCNTENA = 1;
+#endif
+}
+
+/**
+ * @brief Reads the core cycle counter.
+ * @return The current counter value
+ */
+uint32_t XPD_ulGetCycles(void)
+{
+#if (__CORTEX_M >= 3U)
+    return DWT->CYCCNT;
+#else
+    /* SysTick counts down */
+    return SysTick->LOAD - SysTick->VAL;
+#endif
+}
+
+/**
+ * @brief Calculates the elapsed core cycles.
+ * @param ulStart: the earlier counter value from @ref XPD_ulGetCycles
+ * @return The elapsed cycles since the start value
+ */
+uint32_t XPD_ulCyclesSince(uint32_t ulStart)
+{
+    uint32_t ulCycles = XPD_ulGetCycles() - ulStart;
+#if (__CORTEX_M < 3U)
+    /* The SysTick period is LOAD + 1 */
+    if (ulCycles > SysTick->LOAD)
+    {
+        ulCycles += SysTick->LOAD + 1;
+    }
+#endif
+    return ulCycles;
+}
+
+/**
+ * @brief Clears the cycle statistics.
+ * @param pxStat: pointer to the cycle statistics
+ */
+void XPD_vCycleStatReset(XPD_CycleStatType * pxStat)
+{
+    pxStat->Last  = 0;
+    pxStat->Min   = ~0;
+    pxStat->Max   = 0;
+    pxStat->Count = 0;
+    pxStat->Total = 0;
+}
+
+/**
+ * @brief Starts a cycle measurement.
+ * @param pxStat: pointer to the cycle statistics
+ */
+void XPD_vCycleStatStart(XPD_CycleStatType * pxStat)
+{
+    pxStat->Start = XPD_ulGetCycles();
+}
+
+/**
+ * @brief Finishes the cycle measurement and adds the result to the statistics.
+ * @param pxStat: pointer to the cycle statistics
+ */
+void XPD_vCycleStatStop(XPD_CycleStatType * pxStat)
+{
+    uint32_t ulCycles = XPD_ulCyclesSince(pxStat->Start);
+
+    pxStat->Last   = ulCycles;
+    pxStat->Total += ulCycles;
+    pxStat->Count++;
+
+    if (ulCycles < pxStat->Min)
+    {
+        pxStat->Min = ulCycles;
+    }
+    if (ulCycles > pxStat->Max)
+    {
+        pxStat->Max = ulCycles;
+    }
+}
+
 /** @} */
 
 /** @defgroup XPD_Exported_Functions_Stream XPD Data Stream Handling Functions
@@ -216,14 +344,13 @@ void XPD_vWriteFromStream(uint32_t * pulReg, DataStreamType * pxStream)
  */
 void XPD_vInit(void)
 {
+    static const RCC_PositionType aeClocks[] = { RCC_POS_PWR, RCC_POS_SYSCFG };
+
     /* Configure systick timer */
     XPD_vInitTimer();
 
-    /* Enable clock for PWR */
-    RCC_vClockEnable(RCC_POS_PWR);
-
-    /* Enable SYSCFG clock  */
-    RCC_vClockEnable(RCC_POS_SYSCFG);
+    /* Enable PWR and SYSCFG clocks */
+    RCC_vClockEnableMulti(aeClocks, sizeof(aeClocks) / sizeof(aeClocks[0]));
 }
 
 /**
@@ -0,0 +1,216 @@
+/**
+  ******************************************************************************
+  * @file    xpd_cryp.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Cryptographic Processor Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_CRYP_H_
+#define __XPD_CRYP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(CRYP)
+
+/** @defgroup CRYP
+ * @{ */
+
+/** @defgroup CRYP_Exported_Types CRYP Exported Types
+ * @{ */
+
+/** @brief CRYP AES chaining modes */
+typedef enum
+{
+    CRYP_MODE_AES_ECB = CRYP_CR_ALGOMODE_AES_ECB, /*!< Electronic codebook */
+    CRYP_MODE_AES_CBC = CRYP_CR_ALGOMODE_AES_CBC, /*!< Cipher block chaining */
+    CRYP_MODE_AES_CTR = CRYP_CR_ALGOMODE_AES_CTR, /*!< Counter mode */
+#ifdef CRYP_CR_GCM_CCMPH
+    CRYP_MODE_AES_GCM = CRYP_CR_ALGOMODE_3,       /*!< Galois/counter mode (STM32F43x only) */
+#endif
+}CRYP_ModeType;
+
+/** @brief CRYP operation direction */
+typedef enum
+{
+    CRYP_OPERATION_ENCRYPT = 0, /*!< Plaintext input, ciphertext output */
+    CRYP_OPERATION_DECRYPT = 1, /*!< Ciphertext input, plaintext output */
+}CRYP_OperationType;
+
+/** @brief CRYP AES key sizes */
+typedef enum
+{
+    CRYP_KEYSIZE_128BIT = 0, /*!< 16 bytes key */
+    CRYP_KEYSIZE_192BIT = 1, /*!< 24 bytes key */
+    CRYP_KEYSIZE_256BIT = 2, /*!< 32 bytes key */
+}CRYP_KeySizeType;
+
+/** @brief CRYP setup structure */
+typedef struct
+{
+    const uint8_t *  Key;     /*!< The AES key in byte order, has to remain valid while used */
+    CRYP_KeySizeType KeySize; /*!< The AES key size */
+}CRYP_InitType;
+
+/** @brief CRYP error types */
+typedef enum
+{
+    CRYP_ERROR_NONE    = 0, /*!< No error */
+    CRYP_ERROR_DMA     = 1, /*!< DMA transfer error */
+    CRYP_ERROR_TIMEOUT = 2, /*!< The processor didn't finish a setup phase */
+}CRYP_ErrorType;
+
+/** @brief CRYP processing request structure */
+typedef struct
+{
+    const void *           Input;        /*!< Word aligned input data */
+    void *                 Output;       /*!< Word aligned output data of Length bytes */
+    uint32_t               Length;       /*!< Data length in bytes, multiple of the 16 byte AES block,
+                                              except for CTR and GCM decryption */
+    const uint8_t *        IV;           /*!< Initialization vector (16 bytes, GCM: 12 bytes nonce),
+                                              NULL continues the chain of the previous CBC or CTR request */
+    CRYP_ModeType          Mode;         /*!< AES chaining mode */
+    CRYP_OperationType     Operation;    /*!< Encryption or decryption */
+#ifdef CRYP_CR_GCM_CCMPH
+    const void *           Header;       /*!< GCM additional authenticated data */
+    uint32_t               HeaderLength; /*!< GCM additional authenticated data length in bytes */
+    uint8_t *              Tag;          /*!< GCM 16 bytes authentication tag output */
+#endif
+    XPD_HandleCallbackType Callback;     /*!< Request completion callback (called with the request pointer) */
+    volatile XPD_ReturnType Result;      /*!< BUSY while queued or in progress, OK or ERROR when completed */
+}CRYP_RequestType;
+
+#ifndef CRYP_QUEUE_LENGTH
+/** @brief Number of requests which can be queued at once (power of 2) */
+#define CRYP_QUEUE_LENGTH       4
+#endif
+
+/** @brief CRYP Handle structure */
+typedef struct
+{
+    CRYP_TypeDef * Inst;                     /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (DMAs) */
+        XPD_HandleCallbackType QueueEmpty;   /*!< All queued requests are completed callback */
+        XPD_HandleCallbackType Error;        /*!< Processing error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        DMA_HandleType * Input;              /*!< DMA handle for feeding the input FIFO (word size) */
+        DMA_HandleType * Output;             /*!< DMA handle for draining the output FIFO (word size) */
+    }DMA;                                    /*   DMA handle references */
+    struct {
+        const uint8_t * Data;                /*!< [Internal] The AES key */
+        uint32_t Size;                       /*!< [Internal] CR register key size setting */
+    }Key;                                    /*   Active key */
+    struct {
+        CRYP_RequestType * volatile Items[CRYP_QUEUE_LENGTH]; /*!< [Internal] Request ring buffer */
+        volatile uint8_t Head;               /*!< [Internal] Free running index of the active request */
+        volatile uint8_t Tail;               /*!< [Internal] Free running index of the next free slot */
+    }Queue;                                  /*   Asynchronous request queue */
+    volatile CRYP_ErrorType Errors;          /*!< Processing errors */
+}CRYP_HandleType;
+
+/** @} */
+
+/** @defgroup CRYP_Exported_Macros CRYP Exported Macros
+ * @{ */
+
+/**
+ * @brief CRYP Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the CRYP peripheral instance.
+ */
+#define         CRYP_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief CRYP register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         CRYP_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified CRYP flag.
+ * @param  HANDLE: specifies the CRYP Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg IFEM:    Input FIFO empty
+ *            @arg IFNF:    Input FIFO not full
+ *            @arg OFNE:    Output FIFO not empty
+ *            @arg OFFU:    Output FIFO full
+ *            @arg BUSY:    Processing in progress
+ */
+#define         CRYP_FLAG_STATUS(HANDLE, FLAG_NAME)         \
+    (CRYP_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/** @} */
+
+/** @addtogroup CRYP_Exported_Functions
+ * @{ */
+void            CRYP_vInit              (CRYP_HandleType * pxCRYP,
+                                         const CRYP_InitType * pxConfig);
+void            CRYP_vDeinit            (CRYP_HandleType * pxCRYP);
+
+XPD_ReturnType  CRYP_eSubmit            (CRYP_HandleType * pxCRYP,
+                                         CRYP_RequestType * pxRequest);
+XPD_ReturnType  CRYP_eProcess           (CRYP_HandleType * pxCRYP,
+                                         CRYP_RequestType * pxRequest,
+                                         uint32_t ulTimeout);
+void            CRYP_vAbort             (CRYP_HandleType * pxCRYP);
+
+/**
+ * @brief Determines whether the request queue of the CRYP is empty.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ * @return BUSY if requests are in progress, OK if the queue is empty
+ */
+__STATIC_INLINE XPD_ReturnType CRYP_eGetStatus(CRYP_HandleType * pxCRYP)
+{
+    return (pxCRYP->Queue.Head != pxCRYP->Queue.Tail) ? XPD_BUSY : XPD_OK;
+}
+
+/**
+ * @brief Gets the error state of the CRYP.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ * @return Current CRYP error state
+ */
+__STATIC_INLINE CRYP_ErrorType CRYP_eGetError(CRYP_HandleType * pxCRYP)
+{
+    return pxCRYP->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* CRYP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_CRYP_H_ */
@@ -0,0 +1,327 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dac.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital to Analog Converter Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_DAC_H_
+#define __XPD_DAC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(DAC)
+
+/** @defgroup DAC
+ * @{ */
+
+/** @defgroup DAC_Exported_Types DAC Exported Types
+ * @{ */
+
+/** @brief DAC channel types */
+typedef enum
+{
+    DAC_CHANNEL_1 = 0, /*!< DAC channel 1 */
+#ifdef DAC_CR_EN2
+    DAC_CHANNEL_2 = 1, /*!< DAC channel 2 */
+#endif
+}DAC_ChannelType;
+
+/** @brief DAC conversion trigger sources */
+typedef enum
+{
+    DAC_TRIGGER_NONE      = 0x0, /*!< Conversion starts one APB cycle after the data holding register write */
+    DAC_TRIGGER_TIM6_TRGO = 0x1, /*!< TIM6 TRGO event */
+    DAC_TRIGGER_TIM8_TRGO = 0x3, /*!< TIM8 TRGO event */
+    DAC_TRIGGER_TIM7_TRGO = 0x5, /*!< TIM7 TRGO event */
+    DAC_TRIGGER_TIM5_TRGO = 0x7, /*!< TIM5 TRGO event */
+    DAC_TRIGGER_TIM2_TRGO = 0x9, /*!< TIM2 TRGO event */
+    DAC_TRIGGER_TIM4_TRGO = 0xB, /*!< TIM4 TRGO event */
+    DAC_TRIGGER_EXTI9     = 0xD, /*!< EXTI line 9 event */
+    DAC_TRIGGER_SOFTWARE  = 0xF, /*!< Software trigger by @ref DAC_vSoftwareTrigger */
+}DAC_TriggerType;
+
+/** @brief DAC wave generation types */
+typedef enum
+{
+    DAC_WAVE_NONE     = 0, /*!< The output follows the data holding register */
+    DAC_WAVE_NOISE    = 1, /*!< Pseudo-random noise is added to the data holding register value */
+    DAC_WAVE_TRIANGLE = 2, /*!< Triangle wave is added to the data holding register value */
+}DAC_WaveType;
+
+/** @brief DAC channel setup structure */
+typedef struct
+{
+    DAC_TriggerType Trigger;      /*!< Conversion trigger source */
+    DAC_WaveType    Wave;         /*!< Wave generation mode */
+    uint8_t         Amplitude;    /*!< Wave amplitude: triangle peak = 2^(Amplitude+1) - 1,
+                                       noise uses the LFSR bits [0 .. Amplitude] [0 .. 11] */
+    FunctionalState OutputBuffer; /*!< Output buffer for driving low impedance loads */
+}DAC_Channel_InitType;
+
+/** @brief DAC error types */
+typedef enum
+{
+    DAC_ERROR_NONE     = 0, /*!< No error */
+    DAC_ERROR_UNDERRUN = 1, /*!< DMA underrun: the trigger arrived before the DMA provided the next sample */
+    DAC_ERROR_DMA      = 2, /*!< DMA transfer error */
+}DAC_ErrorType;
+
+/** @brief DAC Handle structure */
+typedef struct
+{
+    DAC_TypeDef * Inst;                      /*!< The address of the peripheral instance used by the handle */
+#ifdef DAC_BB
+    DAC_BitBand_TypeDef * Inst_BB;           /*!< The address of the peripheral instance in the bit-band region */
+#endif
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Produce;      /*!< Stream buffer region consumed, FreeBuffer can be refilled */
+        XPD_HandleCallbackType Error;        /*!< DMA underrun or transfer error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        DMA_HandleType * Channel[2];         /*!< DMA handles for channel data transfers */
+    }DMA;                                    /*   DMA handle references */
+    struct {
+        uint8_t * Buffer;                    /*!< [Internal] Start address of the streamed buffer */
+        uint16_t HalfSize;                   /*!< [Internal] Half size of the streamed buffer in bytes */
+    }Stream[2];                              /*   Stream buffer references */
+    RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
+    volatile DAC_ChannelType ActiveChannel;  /*!< The channel of the current callback */
+    void * volatile FreeBuffer;              /*!< The buffer region which is no longer used by the DMA */
+    volatile DAC_ErrorType Errors;           /*!< Conversion errors */
+}DAC_HandleType;
+
+/** @} */
+
+/** @defgroup DAC_Exported_Macros DAC Exported Macros
+ * @{ */
+
+#ifdef DAC_CR_EN2
+/**
+ * @brief  Packs two channel samples to a dual channel 12-bit right aligned sample.
+ * @param  CH1: specifies the channel 1 sample value.
+ * @param  CH2: specifies the channel 2 sample value.
+ */
+#define         DAC_DUAL_SAMPLE(CH1, CH2)                   \
+    (((uint32_t)(CH2) << 16) | (uint32_t)(CH1))
+#endif
+
+/**
+ * @brief  Enable the specified DAC interrupt.
+ * @param  HANDLE: specifies the DAC Handle.
+ * @param  IT_NAME: specifies the interrupt to enable.
+ *         This parameter can be one of the following values:
+ *            @arg DMAUDRIE1:   Channel 1 DMA underrun
+ *            @arg DMAUDRIE2:   Channel 2 DMA underrun
+ */
+#define         DAC_IT_ENABLE(HANDLE, IT_NAME)              \
+    (DAC_REG_BIT((HANDLE),CR,IT_NAME) = 1)
+
+/**
+ * @brief  Disable the specified DAC interrupt.
+ * @param  HANDLE: specifies the DAC Handle.
+ * @param  IT_NAME: specifies the interrupt to disable.
+ *         This parameter can be one of the following values:
+ *            @arg DMAUDRIE1:   Channel 1 DMA underrun
+ *            @arg DMAUDRIE2:   Channel 2 DMA underrun
+ */
+#define         DAC_IT_DISABLE(HANDLE, IT_NAME)             \
+    (DAC_REG_BIT((HANDLE),CR,IT_NAME) = 0)
+
+/**
+ * @brief  Get the specified DAC flag.
+ * @param  HANDLE: specifies the DAC Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg DMAUDR1:     Channel 1 DMA underrun
+ *            @arg DMAUDR2:     Channel 2 DMA underrun
+ */
+#define         DAC_FLAG_STATUS(HANDLE, FLAG_NAME)          \
+    (DAC_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified DAC flag.
+ * @param  HANDLE: specifies the DAC Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg DMAUDR1:     Channel 1 DMA underrun
+ *            @arg DMAUDR2:     Channel 2 DMA underrun
+ */
+#define         DAC_FLAG_CLEAR(HANDLE, FLAG_NAME)           \
+    ((HANDLE)->Inst->SR.w = DAC_SR_##FLAG_NAME)
+
+#ifdef DAC_BB
+/**
+ * @brief DAC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the DAC peripheral instance.
+ */
+#define         DAC_INST2HANDLE(HANDLE,INSTANCE)            \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->Inst_BB = (DAC_BitBand_TypeDef *)PERIPH_BB(INSTANCE), \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief DAC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         DAC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)     \
+    ((HANDLE)->Inst_BB->REG_NAME.BIT_NAME)
+
+#else
+/**
+ * @brief DAC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the DAC peripheral instance.
+ */
+#define         DAC_INST2HANDLE(HANDLE,INSTANCE)            \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief DAC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         DAC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)     \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+#endif /* DAC_BB */
+
+/** @} */
+
+/** @addtogroup DAC_Exported_Functions
+ * @{ */
+void            DAC_vInit               (DAC_HandleType * pxDAC);
+void            DAC_vDeinit             (DAC_HandleType * pxDAC);
+
+void            DAC_vChannelConfig      (DAC_HandleType * pxDAC,
+                                         DAC_ChannelType eChannel,
+                                         const DAC_Channel_InitType * pxConfig);
+
+void            DAC_vStart              (DAC_HandleType * pxDAC,
+                                         DAC_ChannelType eChannel);
+void            DAC_vStop               (DAC_HandleType * pxDAC,
+                                         DAC_ChannelType eChannel);
+
+XPD_ReturnType  DAC_eStart_DMA          (DAC_HandleType * pxDAC,
+                                         DAC_ChannelType eChannel,
+                                         const uint16_t * pusSamples,
+                                         uint16_t usCount);
+#ifdef DAC_CR_EN2
+XPD_ReturnType  DAC_eStartDual_DMA      (DAC_HandleType * pxDAC,
+                                         const uint32_t * pulSamples,
+                                         uint16_t usCount);
+#endif
+void            DAC_vStop_DMA           (DAC_HandleType * pxDAC,
+                                         DAC_ChannelType eChannel);
+
+void            DAC_vIRQHandler         (DAC_HandleType * pxDAC);
+
+/**
+ * @brief Sets the output value of a DAC channel.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ * @param usValue: the 12-bit right aligned output value
+ */
+__STATIC_INLINE void DAC_vSetValue(DAC_HandleType * pxDAC, DAC_ChannelType eChannel, uint16_t usValue)
+{
+#ifdef DAC_CR_EN2
+    if (eChannel == DAC_CHANNEL_2)
+    {
+        pxDAC->Inst->DHR2.D12R = usValue;
+    }
+    else
+#endif
+    {
+        pxDAC->Inst->DHR1.D12R = usValue;
+    }
+}
+
+#ifdef DAC_CR_EN2
+/**
+ * @brief Sets the output value of both DAC channels with a single register write.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param ulValues: the 12-bit right aligned output values packed by @ref DAC_DUAL_SAMPLE
+ */
+__STATIC_INLINE void DAC_vSetDualValue(DAC_HandleType * pxDAC, uint32_t ulValues)
+{
+    pxDAC->Inst->DHRD.D12R = ulValues;
+}
+#endif
+
+/**
+ * @brief Gets the current output value of a DAC channel.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ * @return The 12-bit output data
+ */
+__STATIC_INLINE uint16_t DAC_usGetValue(DAC_HandleType * pxDAC, DAC_ChannelType eChannel)
+{
+#ifdef DAC_CR_EN2
+    if (eChannel == DAC_CHANNEL_2)
+    {
+        return pxDAC->Inst->DOR2;
+    }
+#endif
+    return pxDAC->Inst->DOR1;
+}
+
+/**
+ * @brief Triggers a conversion on the channels configured with @ref DAC_TRIGGER_SOFTWARE.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @param eChannel: the selected channel
+ */
+__STATIC_INLINE void DAC_vSoftwareTrigger(DAC_HandleType * pxDAC, DAC_ChannelType eChannel)
+{
+    pxDAC->Inst->SWTRIGR.w = DAC_SWTRIGR_SWTRIG1 << eChannel;
+}
+
+/**
+ * @brief Gets the error state of the DAC.
+ * @param pxDAC: pointer to the DAC handle structure
+ * @return Current DAC error state
+ */
+__STATIC_INLINE DAC_ErrorType DAC_eGetError(DAC_HandleType * pxDAC)
+{
+    return pxDAC->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* DAC */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_DAC_H_ */
@@ -0,0 +1,264 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dcmi.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital Camera Interface Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_DCMI_H_
+#define __XPD_DCMI_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(DCMI)
+
+/** @defgroup DCMI
+ * @{ */
+
+/** @defgroup DCMI_Exported_Types DCMI Exported Types
+ * @{ */
+
+/** @brief DCMI capture modes */
+typedef enum
+{
+    DCMI_CAPTURE_CONTINUOUS = 0, /*!< Frames are captured until the capture is stopped */
+    DCMI_CAPTURE_SNAPSHOT   = 1, /*!< A single frame is captured */
+}DCMI_CaptureModeType;
+
+/** @brief DCMI synchronization modes */
+typedef enum
+{
+    DCMI_SYNC_HARDWARE = 0, /*!< HSYNC and VSYNC signals */
+    DCMI_SYNC_EMBEDDED = 1, /*!< Synchronization codes embedded in the data flow */
+}DCMI_SyncType;
+
+/** @brief DCMI parallel data widths */
+typedef enum
+{
+    DCMI_DATAWIDTH_8BIT  = 0, /*!< 8 bits per pixel clock */
+    DCMI_DATAWIDTH_10BIT = 1, /*!< 10 bits per pixel clock */
+    DCMI_DATAWIDTH_12BIT = 2, /*!< 12 bits per pixel clock */
+    DCMI_DATAWIDTH_14BIT = 3, /*!< 14 bits per pixel clock */
+}DCMI_DataWidthType;
+
+/** @brief DCMI frame capture rates */
+typedef enum
+{
+    DCMI_FRAMERATE_ALL     = 0, /*!< All frames are captured */
+    DCMI_FRAMERATE_HALF    = 1, /*!< Every second frame is captured */
+    DCMI_FRAMERATE_QUARTER = 2, /*!< Every fourth frame is captured */
+}DCMI_FrameRateType;
+
+/** @brief DCMI setup structure */
+typedef struct
+{
+    DCMI_SyncType      SyncMode;        /*!< Frame synchronization mode */
+    DCMI_DataWidthType DataWidth;       /*!< Parallel data width */
+    DCMI_FrameRateType FrameRate;       /*!< Frame capture rate */
+    FunctionalState    JPEGMode;        /*!< JPEG (variable frame length) data */
+    EdgeType           PixelClockEdge;  /*!< Pixel clock edge on which the data is captured
+                                             (EDGE_RISING or EDGE_FALLING) */
+    ActiveLevelType    HSyncBlanking;   /*!< HSYNC level during line blanking */
+    ActiveLevelType    VSyncBlanking;   /*!< VSYNC level during frame blanking */
+    struct {
+        uint8_t FrameStart;             /*!< Frame start delimiter code */
+        uint8_t LineStart;              /*!< Line start delimiter code */
+        uint8_t LineEnd;                /*!< Line end delimiter code */
+        uint8_t FrameEnd;               /*!< Frame end delimiter code */
+    }EmbeddedCodes;                     /*   Synchronization codes (embedded synchronization only) */
+}DCMI_InitType;
+
+/** @brief DCMI crop window setup structure */
+typedef struct
+{
+    uint16_t XOffset;   /*!< Horizontal offset in pixel clocks */
+    uint16_t YOffset;   /*!< Vertical offset in lines */
+    uint16_t Width;     /*!< Captured line width in pixel clocks [1 .. 16384]
+                             (e.g. 2 pixel clocks per RGB565 pixel in 8 bit mode) */
+    uint16_t Height;    /*!< Captured lines [1 .. 16384] */
+}DCMI_CropType;
+
+/** @brief DCMI error types */
+typedef enum
+{
+    DCMI_ERROR_NONE     = 0, /*!< No error */
+    DCMI_ERROR_OVERRUN  = 1, /*!< Data overrun, the frame is lost */
+    DCMI_ERROR_SYNC     = 2, /*!< Embedded synchronization error */
+    DCMI_ERROR_DMA      = 4, /*!< DMA transfer error */
+    DCMI_ERROR_SIZE     = 8, /*!< The frame is larger than the buffer */
+}DCMI_ErrorType;
+
+/** @brief DCMI Handle structure */
+typedef struct
+{
+    DCMI_TypeDef * Inst;                     /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Line;         /*!< Line captured callback */
+        XPD_HandleCallbackType VSync;        /*!< Frame synchronization (start of frame) callback */
+        XPD_HandleCallbackType Frame;        /*!< Frame captured callback, Frame can be processed */
+        XPD_HandleCallbackType Error;        /*!< Overrun, synchronization or DMA error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    DMA_HandleType * DMA;                    /*!< DMA handle for the frame data */
+    struct {
+        uint32_t * Buffer[2];                /*!< [Internal] The frame buffers */
+        uint16_t Length;                     /*!< [Internal] Length of a frame buffer in words */
+        uint8_t Active;                      /*!< [Internal] Index of the buffer written by the DMA */
+    }Stream;                                 /*   Frame buffers */
+    uint32_t * volatile Frame;               /*!< The last captured frame, the application should
+                                                  set it to NULL when it's processed */
+    volatile uint32_t FrameLength;           /*!< Length of the last captured frame in bytes */
+    struct {
+        volatile uint32_t Frames;            /*!< Number of captured frames */
+        volatile uint32_t Dropped;           /*!< Number of frames lost or overwritten before processing */
+        uint32_t LastFrames;                 /*!< [Internal] Frame count at the last rate calculation */
+    }Statistics;                             /*   Capture statistics */
+    volatile DCMI_ErrorType Errors;          /*!< Capture errors */
+}DCMI_HandleType;
+
+/** @} */
+
+/** @defgroup DCMI_Exported_Macros DCMI Exported Macros
+ * @{ */
+
+/**
+ * @brief DCMI Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the DCMI peripheral instance.
+ */
+#define         DCMI_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief DCMI register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         DCMI_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Enable the specified DCMI interrupt.
+ * @param  HANDLE: specifies the DCMI Handle.
+ * @param  IT_NAME: specifies the interrupt to enable.
+ *         This parameter can be one of the following values:
+ *            @arg FRAME:   Frame captured
+ *            @arg OVR:     Data overrun
+ *            @arg ERR:     Synchronization error
+ *            @arg VSYNC:   Frame synchronization
+ *            @arg LINE:    Line captured
+ */
+#define         DCMI_IT_ENABLE(HANDLE, IT_NAME)             \
+    (DCMI_REG_BIT((HANDLE),IER,IT_NAME##_IE) = 1)
+
+/**
+ * @brief  Disable the specified DCMI interrupt.
+ * @param  HANDLE: specifies the DCMI Handle.
+ * @param  IT_NAME: specifies the interrupt to disable.
+ *         This parameter can be one of the following values:
+ *            @arg FRAME:   Frame captured
+ *            @arg OVR:     Data overrun
+ *            @arg ERR:     Synchronization error
+ *            @arg VSYNC:   Frame synchronization
+ *            @arg LINE:    Line captured
+ */
+#define         DCMI_IT_DISABLE(HANDLE, IT_NAME)            \
+    (DCMI_REG_BIT((HANDLE),IER,IT_NAME##_IE) = 0)
+
+/**
+ * @brief  Get the specified DCMI flag.
+ * @param  HANDLE: specifies the DCMI Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg FRAME:   Frame captured
+ *            @arg OVR:     Data overrun
+ *            @arg ERR:     Synchronization error
+ *            @arg VSYNC:   Frame synchronization
+ *            @arg LINE:    Line captured
+ */
+#define         DCMI_FLAG_STATUS(HANDLE, FLAG_NAME)         \
+    (DCMI_REG_BIT((HANDLE),RISR,FLAG_NAME##_RIS))
+
+/**
+ * @brief  Clear the specified DCMI flag.
+ * @param  HANDLE: specifies the DCMI Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg FRAME:   Frame captured
+ *            @arg OVR:     Data overrun
+ *            @arg ERR:     Synchronization error
+ *            @arg VSYNC:   Frame synchronization
+ *            @arg LINE:    Line captured
+ */
+#define         DCMI_FLAG_CLEAR(HANDLE, FLAG_NAME)          \
+    ((HANDLE)->Inst->ICR.w = DCMI_ICR_##FLAG_NAME##_ISC)
+
+/** @} */
+
+/** @addtogroup DCMI_Exported_Functions
+ * @{ */
+void            DCMI_vInit              (DCMI_HandleType * pxDCMI,
+                                         const DCMI_InitType * pxConfig);
+void            DCMI_vDeinit            (DCMI_HandleType * pxDCMI);
+
+void            DCMI_vCropConfig        (DCMI_HandleType * pxDCMI,
+                                         const DCMI_CropType * pxCrop);
+void            DCMI_vCropDisable       (DCMI_HandleType * pxDCMI);
+
+XPD_ReturnType  DCMI_eStart_DMA         (DCMI_HandleType * pxDCMI,
+                                         DCMI_CaptureModeType eMode,
+                                         uint32_t * pulFrame0,
+                                         uint32_t * pulFrame1,
+                                         uint32_t ulFrameSize);
+void            DCMI_vStop_DMA          (DCMI_HandleType * pxDCMI);
+
+void            DCMI_vIRQHandler        (DCMI_HandleType * pxDCMI);
+
+uint32_t        DCMI_ulFrameRate_mHz    (DCMI_HandleType * pxDCMI,
+                                         uint32_t ulInterval_ms);
+
+/**
+ * @brief Gets the error state of the DCMI.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ * @return Current DCMI error state
+ */
+__STATIC_INLINE DCMI_ErrorType DCMI_eGetError(DCMI_HandleType * pxDCMI)
+{
+    return pxDCMI->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* DCMI */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_DCMI_H_ */
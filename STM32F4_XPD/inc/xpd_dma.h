@@ -245,6 +245,19 @@ typedef struct
 #define         __XPD_DMA_ITConfig_FE(HANDLE,VALUE)         \
     (DMA_REG_BIT((HANDLE),FCR,FEIE) = (VALUE))
 
+/**
+ * @brief  Defines a DMA interrupt vector handler which is statically bound to its handle,
+ *         and calls the owner peripheral's transfer complete function directly.
+ *         The owner peripheral's own vector is bound with @ref XPD_IRQ_BIND.
+ * @param  VECTOR: specifies the interrupt vector name without the _IRQHandler suffix.
+ * @param  HANDLE: specifies the DMA Handle.
+ * @param  COMPLETE: specifies the owner's DMA transfer complete function.
+ * @param  OWNER: specifies the owner peripheral handle.
+ */
+#define         DMA_IRQ_BIND(VECTOR, HANDLE, COMPLETE, OWNER) \
+    void VECTOR##_IRQHandler(void)                            \
+    { if (DMA_eIRQHandler(HANDLE) != RESET) { COMPLETE(OWNER); } }
+
 /** @} */
 
 /** @addtogroup DMA_Exported_Functions
@@ -264,6 +277,7 @@ XPD_ReturnType  DMA_ePollStatus     (DMA_HandleType * pxDMA, DMA_OperationType e
                                      uint32_t ulTimeout);
 
 void            DMA_vIRQHandler     (DMA_HandleType * pxDMA);
+FlagStatus      DMA_eIRQHandler     (DMA_HandleType * pxDMA);
 
 uint32_t        DMA_ulActiveMemory  (DMA_HandleType * pxDMA);
 void            DMA_vSetSwapMemory  (DMA_HandleType * pxDMA, void * pvAddress);
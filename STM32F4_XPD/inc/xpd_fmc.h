@@ -0,0 +1,237 @@
+/**
+  ******************************************************************************
+  * @file    xpd_fmc.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Flexible Memory Controller Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_FMC_H_
+#define __XPD_FMC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(FSMC_Bank1) && !defined(FMC_Bank1)
+#define FMC_Bank1           FSMC_Bank1
+#define FMC_Bank1E          FSMC_Bank1E
+#endif
+
+#if defined(FMC_Bank1)
+
+/** @defgroup FMC
+ * @{ */
+
+/** @defgroup FMC_SRAM FMC SRAM
+ * @{ */
+
+/** @defgroup FMC_SRAM_Exported_Types FMC SRAM Exported Types
+ * @{ */
+
+/** @brief FMC NOR/PSRAM subbank types */
+typedef enum
+{
+    FMC_SRAM_BANK1 = 0, /*!< Subbank 1 (NE1) */
+    FMC_SRAM_BANK2 = 1, /*!< Subbank 2 (NE2) */
+    FMC_SRAM_BANK3 = 2, /*!< Subbank 3 (NE3) */
+    FMC_SRAM_BANK4 = 3, /*!< Subbank 4 (NE4) */
+}FMC_SRAM_BankType;
+
+/** @brief FMC asynchronous memory types */
+typedef enum
+{
+    FMC_MEMORY_SRAM  = 0, /*!< SRAM */
+    FMC_MEMORY_PSRAM = 1, /*!< PSRAM (CRAM) */
+    FMC_MEMORY_NOR   = 2, /*!< NOR Flash */
+}FMC_MemoryType;
+
+/** @brief FMC memory data bus width types */
+typedef enum
+{
+    FMC_BUSWIDTH_8BIT  = 0, /*!< 8 bit data bus */
+    FMC_BUSWIDTH_16BIT = 1, /*!< 16 bit data bus */
+    FMC_BUSWIDTH_32BIT = 2, /*!< 32 bit data bus */
+}FMC_BusWidthType;
+
+/** @brief FMC asynchronous access timing setup, specified in the memory datasheet units */
+typedef struct
+{
+    uint16_t AddressSetup_ns;   /*!< Address setup time */
+    uint16_t AddressHold_ns;    /*!< Address hold time (only used in multiplexed mode) */
+    uint16_t DataSetup_ns;      /*!< Data phase duration */
+    uint16_t BusTurnaround_ns;  /*!< Bus turnaround time between consecutive accesses */
+}FMC_SRAM_TimingType;
+
+/** @brief FMC asynchronous memory setup structure */
+typedef struct
+{
+    FMC_MemoryType      MemoryType;     /*!< External memory type */
+    FMC_BusWidthType    BusWidth;       /*!< Memory data bus width */
+    FMC_SRAM_TimingType ReadTiming;     /*!< Read (and write, if the extended mode is off) access timing */
+    FMC_SRAM_TimingType WriteTiming;    /*!< Write access timing (only used in extended mode) */
+    FunctionalState     ExtendedMode;   /*!< Separate write timing setup */
+    FunctionalState     WriteEnable;    /*!< Write operations permission */
+}FMC_SRAM_InitType;
+
+/** @} */
+
+/** @defgroup FMC_SRAM_Exported_Macros FMC SRAM Exported Macros
+ * @{ */
+
+/**
+ * @brief  Gets the memory mapped address of an FMC NOR/PSRAM subbank.
+ * @param  BANK: specifies the subbank @ref FMC_SRAM_BankType
+ */
+#define         FMC_SRAM_BANK_ADDRESS(BANK)                 \
+    ((void*)(0x60000000UL + ((uint32_t)(BANK) << 26)))
+
+/** @} */
+
+/** @addtogroup FMC_SRAM_Exported_Functions
+ * @{ */
+void            FMC_vSRAM_Init          (FMC_SRAM_BankType eBank,
+                                         const FMC_SRAM_InitType * pxConfig);
+void            FMC_vSRAM_Deinit        (FMC_SRAM_BankType eBank);
+/** @} */
+
+/** @} */
+
+#ifdef FMC_Bank5_6
+/** @defgroup FMC_SDRAM FMC SDRAM
+ * @{ */
+
+/** @defgroup FMC_SDRAM_Exported_Types FMC SDRAM Exported Types
+ * @{ */
+
+/** @brief FMC SDRAM bank types */
+typedef enum
+{
+    FMC_SDRAM_BANK1 = 0, /*!< SDRAM bank 1 (SDNE0, SDCKE0) */
+    FMC_SDRAM_BANK2 = 1, /*!< SDRAM bank 2 (SDNE1, SDCKE1) */
+}FMC_SDRAM_BankType;
+
+/** @brief FMC SDRAM timing setup, specified in the memory datasheet units */
+typedef struct
+{
+    uint8_t  LoadToActive_clk;      /*!< tMRD: Load mode register to active command delay in clock cycles */
+    uint16_t ExitSelfRefresh_ns;    /*!< tXSR: Exit self-refresh to active command delay */
+    uint16_t SelfRefresh_ns;        /*!< tRAS: Minimum self-refresh period */
+    uint16_t RowCycle_ns;           /*!< tRC: Refresh to active or active to active command delay */
+    uint16_t WriteRecovery_ns;      /*!< tWR: Write recovery time */
+    uint16_t RowPrecharge_ns;       /*!< tRP: Precharge to active command delay */
+    uint16_t RowToColumn_ns;        /*!< tRCD: Active to read/write command delay */
+}FMC_SDRAM_TimingType;
+
+/** @brief FMC SDRAM setup structure */
+typedef struct
+{
+    uint8_t              ColumnBits;        /*!< Column address bits [8 .. 11] */
+    uint8_t              RowBits;           /*!< Row address bits [11 .. 13] */
+    uint8_t              InternalBanks;     /*!< Number of internal banks [2, 4] */
+    uint8_t              CASLatency;        /*!< CAS latency in clock cycles [1 .. 3] */
+    uint8_t              ClockDivider;      /*!< SDCLK = HCLK / ClockDivider [2, 3] */
+    uint8_t              ReadPipeDelay;     /*!< Additional read data delay in HCLK cycles [0 .. 2] */
+    FMC_BusWidthType     BusWidth;          /*!< Memory data bus width */
+    FunctionalState      ReadBurst;         /*!< Read requests are anticipated as bursts */
+    FunctionalState      WriteProtect;      /*!< Write operations are rejected */
+    FMC_SDRAM_TimingType Timing;            /*!< Memory access timing */
+    uint16_t             RefreshPeriod_ms;  /*!< Refresh period of the whole memory array (typically 64 ms) */
+    uint16_t             RefreshRows;       /*!< Number of rows refreshed in the refresh period (typically 4096 or 8192) */
+}FMC_SDRAM_InitType;
+
+/** @} */
+
+/** @defgroup FMC_SDRAM_Exported_Macros FMC SDRAM Exported Macros
+ * @{ */
+
+/**
+ * @brief  Gets the memory mapped address of an FMC SDRAM bank.
+ * @param  BANK: specifies the bank @ref FMC_SDRAM_BankType
+ */
+#define         FMC_SDRAM_BANK_ADDRESS(BANK)                \
+    ((void*)(0xC0000000UL + ((uint32_t)(BANK) << 28)))
+
+/**
+ * @brief  Get the specified FMC SDRAM flag.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg RE:      Refresh error
+ *            @arg BUSY:    Command busy
+ */
+#define         FMC_SDRAM_FLAG_STATUS(FLAG_NAME)            \
+    (FMC_Bank5_6->SDSR.b.FLAG_NAME)
+
+/** @} */
+
+/** @addtogroup FMC_SDRAM_Exported_Functions
+ * @{ */
+XPD_ReturnType  FMC_eSDRAM_Init         (FMC_SDRAM_BankType eBank,
+                                         const FMC_SDRAM_InitType * pxConfig);
+void            FMC_vSDRAM_Deinit       (FMC_SDRAM_BankType eBank);
+
+XPD_ReturnType  FMC_eSDRAM_SelfRefresh  (FMC_SDRAM_BankType eBank,
+                                         FunctionalState eNewState);
+/** @} */
+
+/** @} */
+#endif /* FMC_Bank5_6 */
+
+/** @defgroup FMC_Heap FMC Heap
+ * @{ */
+
+/** @defgroup FMC_Heap_Exported_Macros FMC Heap Exported Macros
+ * @{ */
+
+#ifndef FMC_SECTION_NAME
+/** @brief Name of the linker section placed in external memory */
+#define FMC_SECTION_NAME                ".extram"
+#endif
+
+/**
+ * @brief Places a static variable in the external memory section.
+ *        The section has to be NOLOAD in the linker script, as it is
+ *        only accessible after the memory controller is initialized.
+ */
+#define FMC_SECTION                     __attribute__((section(FMC_SECTION_NAME)))
+
+/** @} */
+
+/** @addtogroup FMC_Heap_Exported_Functions
+ * @{ */
+void            FMC_vHeapInit           (void * pvStart,
+                                         uint32_t ulSize);
+void *          FMC_pvHeapAlloc         (uint32_t ulSize,
+                                         uint32_t ulAlignment);
+uint32_t        FMC_ulHeapFree          (void);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif /* FMC_Bank1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_FMC_H_ */
@@ -172,9 +172,9 @@ __STATIC_INLINE void GPIO_vWritePin(GPIO_TypeDef * pxGPIO, uint8_t ucPin, FlagSt
 __STATIC_INLINE FlagStatus GPIO_eReadPin(GPIO_TypeDef * pxGPIO, uint8_t ucPin)
 {
 #ifdef GPIO_BB
-    return GPIO_BB(pxGPIO)->IDR[ucPin];
+    return (FlagStatus)GPIO_BB(pxGPIO)->IDR[ucPin];
 #else
-    return (pxGPIO->IDR >> ucPin) & 1;
+    return (FlagStatus)((pxGPIO->IDR >> ucPin) & 1);
 #endif
 }
 
@@ -0,0 +1,208 @@
+/**
+  ******************************************************************************
+  * @file    xpd_hash.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Hash Processor Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_HASH_H_
+#define __XPD_HASH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(HASH)
+
+/** @defgroup HASH
+ * @{ */
+
+/** @defgroup HASH_Exported_Types HASH Exported Types
+ * @{ */
+
+/** @brief HASH algorithms */
+typedef enum
+{
+    HASH_ALGORITHM_SHA1   = 0,                                /*!< SHA-1, 20 bytes digest */
+    HASH_ALGORITHM_MD5    = HASH_CR_ALGO_0,                   /*!< MD5, 16 bytes digest */
+#ifdef HASH_CR_ALGO_1
+    HASH_ALGORITHM_SHA224 = HASH_CR_ALGO_1,                   /*!< SHA-224, 28 bytes digest (STM32F43x only) */
+    HASH_ALGORITHM_SHA256 = HASH_CR_ALGO_1 | HASH_CR_ALGO_0,  /*!< SHA-256, 32 bytes digest (STM32F43x only) */
+#endif
+}HASH_AlgorithmType;
+
+/** @brief HASH setup structure */
+typedef struct
+{
+    HASH_AlgorithmType Algorithm; /*!< The hash algorithm */
+    const uint8_t *    Key;       /*!< HMAC key, has to remain valid while used, NULL for plain hashing */
+    uint16_t           KeyLength; /*!< HMAC key length in bytes */
+}HASH_InitType;
+
+/** @brief HASH error types */
+typedef enum
+{
+    HASH_ERROR_NONE    = 0, /*!< No error */
+    HASH_ERROR_DMA     = 1, /*!< DMA transfer error */
+    HASH_ERROR_TIMEOUT = 2, /*!< The digest calculation didn't finish */
+}HASH_ErrorType;
+
+/** @brief HASH message update request structure */
+typedef struct
+{
+    const void *           Data;       /*!< Word aligned message data */
+    uint32_t               Length;     /*!< Data length in bytes, multiple of 4 unless Digest is set */
+    uint8_t *              Digest;     /*!< Digest output which completes the message,
+                                            NULL if the message is continued by the next request */
+    XPD_HandleCallbackType Callback;   /*!< Request completion callback (called with the request pointer) */
+    volatile XPD_ReturnType Result;    /*!< BUSY while queued or in progress, OK or ERROR when completed */
+}HASH_RequestType;
+
+#ifndef HASH_QUEUE_LENGTH
+/** @brief Number of requests which can be queued at once (power of 2) */
+#define HASH_QUEUE_LENGTH       4
+#endif
+
+/** @brief HASH Handle structure */
+typedef struct
+{
+    HASH_TypeDef * Inst;                     /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (DMA) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (DMA) */
+        XPD_HandleCallbackType QueueEmpty;   /*!< All queued requests are completed callback */
+        XPD_HandleCallbackType Error;        /*!< Processing error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        DMA_HandleType * Input;              /*!< DMA handle for feeding the input FIFO (word size) */
+    }DMA;                                    /*   DMA handle references */
+    struct {
+        uint32_t Mode;                       /*!< [Internal] CR register algorithm and mode setting */
+        const uint8_t * Key;                 /*!< [Internal] HMAC key */
+        uint16_t KeyLength;                  /*!< [Internal] HMAC key length */
+    }Config;                                 /*   Active configuration */
+    struct {
+        HASH_RequestType * volatile Items[HASH_QUEUE_LENGTH]; /*!< [Internal] Request ring buffer */
+        volatile uint8_t Head;               /*!< [Internal] Free running index of the active request */
+        volatile uint8_t Tail;               /*!< [Internal] Free running index of the next free slot */
+    }Queue;                                  /*   Asynchronous request queue */
+    volatile uint8_t Message;                /*!< [Internal] Nonzero while a message is being processed */
+    volatile HASH_ErrorType Errors;          /*!< Processing errors */
+}HASH_HandleType;
+
+/** @} */
+
+/** @defgroup HASH_Exported_Macros HASH Exported Macros
+ * @{ */
+
+/**
+ * @brief HASH Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the HASH peripheral instance.
+ */
+#define         HASH_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief HASH register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         HASH_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified HASH flag.
+ * @param  HANDLE: specifies the HASH Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg DINIS:   Data input interrupt status
+ *            @arg DCIS:    Digest calculation completion interrupt status
+ *            @arg DMAS:    DMA interface is enabled or a transfer is ongoing
+ *            @arg BUSY:    The hash core is processing a block of data
+ */
+#define         HASH_FLAG_STATUS(HANDLE, FLAG_NAME)         \
+    (HASH_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified HASH flag.
+ * @param  HANDLE: specifies the HASH Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg DINIS:   Data input interrupt status
+ *            @arg DCIS:    Digest calculation completion interrupt status
+ */
+#define         HASH_FLAG_CLEAR(HANDLE, FLAG_NAME)          \
+    ((HANDLE)->Inst->SR.w = ~HASH_SR_##FLAG_NAME)
+
+/** @} */
+
+/** @addtogroup HASH_Exported_Functions
+ * @{ */
+void            HASH_vInit              (HASH_HandleType * pxHASH,
+                                         const HASH_InitType * pxConfig);
+void            HASH_vDeinit            (HASH_HandleType * pxHASH);
+
+XPD_ReturnType  HASH_eSubmit            (HASH_HandleType * pxHASH,
+                                         HASH_RequestType * pxRequest);
+XPD_ReturnType  HASH_eCompute           (HASH_HandleType * pxHASH,
+                                         const void * pvData,
+                                         uint32_t ulLength,
+                                         uint8_t * pucDigest,
+                                         uint32_t ulTimeout);
+void            HASH_vAbort             (HASH_HandleType * pxHASH);
+
+uint8_t         HASH_ucDigestSize       (HASH_HandleType * pxHASH);
+
+/**
+ * @brief Determines whether the request queue of the HASH is empty.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @return BUSY if requests are in progress, OK if the queue is empty
+ */
+__STATIC_INLINE XPD_ReturnType HASH_eGetStatus(HASH_HandleType * pxHASH)
+{
+    return (pxHASH->Queue.Head != pxHASH->Queue.Tail) ? XPD_BUSY : XPD_OK;
+}
+
+/**
+ * @brief Gets the error state of the HASH.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @return Current HASH error state
+ */
+__STATIC_INLINE HASH_ErrorType HASH_eGetError(HASH_HandleType * pxHASH)
+{
+    return pxHASH->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* HASH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_HASH_H_ */
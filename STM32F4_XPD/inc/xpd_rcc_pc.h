@@ -34,6 +34,20 @@ uint32_t        I2C_ulClockFreq_Hz      (I2C_HandleType * pxI2C);
 
 /** @} */
 
+#elif defined(XPD_I2S_API)
+
+/** @ingroup I2S
+ * @defgroup I2S_Clock_Source I2S Clock Source
+ * @{ */
+
+/** @addtogroup I2S_Clock_Source_Exported_Functions
+ * @{ */
+XPD_ReturnType  I2S_eClockConfig        (const I2S_InitType * pxConfig);
+uint32_t        I2S_ulClockFreq_Hz      (void);
+/** @} */
+
+/** @} */
+
 #elif defined(XPD_RTC_API)
 
 /** @ingroup RTC
@@ -65,6 +79,47 @@ uint32_t        RTC_ulClockFreq_Hz      (void);
 
 /** @} */
 
+#elif defined(XPD_SAI_API)
+
+/** @ingroup SAI
+ * @defgroup SAI_Clock_Source SAI Clock Source
+ * @{ */
+
+/** @defgroup SAI_Clock_Source_Exported_Types SAI Clock Source Exported Types
+ * @{ */
+
+/** @brief SAI clock source types */
+typedef enum
+{
+    SAI_CLOCKSOURCE_PLLSAI = 0, /*!< PLLSAI Q output / PLLSAIDIVQ clock source */
+    SAI_CLOCKSOURCE_PLLI2S = 1, /*!< PLLI2S Q output / PLLI2SDIVQ clock source */
+#ifdef EXTERNAL_CLOCK_VALUE_Hz
+    SAI_CLOCKSOURCE_EXT    = 2, /*!< external clock source */
+#endif
+}SAI_ClockSourceType;
+/** @} */
+
+/** @addtogroup SAI_Clock_Source_Exported_Functions
+ * @{ */
+void            SAI_vClockConfig        (SAI_HandleType * pxSAI, SAI_ClockSourceType eClockSource);
+uint32_t        SAI_ulClockFreq_Hz      (SAI_HandleType * pxSAI);
+/** @} */
+
+/** @} */
+
+#elif defined(XPD_SDMMC_API)
+
+/** @ingroup SDMMC
+ * @defgroup SDMMC_Clock_Source SDMMC Clock Source
+ * @{ */
+
+/** @addtogroup SDMMC_Clock_Source_Exported_Functions
+ * @{ */
+uint32_t        SDMMC_ulClockFreq_Hz    (SDMMC_HandleType * pxSDMMC);
+/** @} */
+
+/** @} */
+
 #elif defined(XPD_TIM_API)
 
 /** @ingroup TIM
@@ -0,0 +1,238 @@
+/**
+  ******************************************************************************
+  * @file    xpd_sai.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers SAI Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_SAI_H_
+#define __XPD_SAI_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(SAI1)
+
+/** @defgroup SAI
+ * @{ */
+
+/** @defgroup SAI_Exported_Types SAI Exported Types
+ * @{ */
+
+/** @brief SAI block operating modes */
+typedef enum
+{
+    SAI_MODE_MASTER_TX = 0,                 /*!< Master transmitter */
+    SAI_MODE_MASTER_RX = SAI_xCR1_MODE_0,   /*!< Master receiver */
+    SAI_MODE_SLAVE_TX  = SAI_xCR1_MODE_1,   /*!< Slave transmitter */
+    SAI_MODE_SLAVE_RX  = SAI_xCR1_MODE,     /*!< Slave receiver */
+}SAI_ModeType;
+
+/** @brief SAI block synchronization */
+typedef enum
+{
+    SAI_SYNC_NONE     = 0,                  /*!< The block uses its own clock generator */
+    SAI_SYNC_INTERNAL = SAI_xCR1_SYNCEN_0,  /*!< The block is clocked by the other block of the SAI */
+}SAI_SyncType;
+
+/** @brief SAI audio standards */
+typedef enum
+{
+    SAI_STANDARD_I2S       = 0, /*!< I2S Philips standard, 2 slots per frame */
+    SAI_STANDARD_MSB       = 1, /*!< Left justified standard, 2 slots per frame */
+    SAI_STANDARD_PCM_SHORT = 2, /*!< PCM / TDM standard with one bit wide frame sync before the first slot */
+    SAI_STANDARD_PCM_LONG  = 3, /*!< PCM / TDM standard with frame sync active during the first slot */
+}SAI_StandardType;
+
+/** @brief SAI data sizes */
+typedef enum
+{
+    SAI_DATASIZE_8BIT  = SAI_xCR1_DS_1,                     /*!< 8 bit data */
+    SAI_DATASIZE_10BIT = SAI_xCR1_DS_1 | SAI_xCR1_DS_0,     /*!< 10 bit data */
+    SAI_DATASIZE_16BIT = SAI_xCR1_DS_2,                     /*!< 16 bit data */
+    SAI_DATASIZE_20BIT = SAI_xCR1_DS_2 | SAI_xCR1_DS_0,     /*!< 20 bit data */
+    SAI_DATASIZE_24BIT = SAI_xCR1_DS_2 | SAI_xCR1_DS_1,     /*!< 24 bit data */
+    SAI_DATASIZE_32BIT = SAI_xCR1_DS,                       /*!< 32 bit data */
+}SAI_DataSizeType;
+
+/** @brief SAI slot sizes */
+typedef enum
+{
+    SAI_SLOTSIZE_DATASIZE = 0,                  /*!< Slot size equals to the data size */
+    SAI_SLOTSIZE_16BIT    = SAI_xSLOTR_SLOTSZ_0,/*!< 16 bit slots */
+    SAI_SLOTSIZE_32BIT    = SAI_xSLOTR_SLOTSZ_1,/*!< 32 bit slots */
+}SAI_SlotSizeType;
+
+/** @brief SAI FIFO thresholds which trigger the DMA requests */
+typedef enum
+{
+    SAI_FIFOTHRESHOLD_EMPTY         = 0, /*!< FIFO empty (TX) / not empty (RX) */
+    SAI_FIFOTHRESHOLD_QUARTER_FULL  = 1, /*!< FIFO 1/4 full */
+    SAI_FIFOTHRESHOLD_HALF_FULL     = 2, /*!< FIFO 1/2 full */
+    SAI_FIFOTHRESHOLD_3QUARTER_FULL = 3, /*!< FIFO 3/4 full */
+    SAI_FIFOTHRESHOLD_FULL          = 4, /*!< FIFO full */
+}SAI_FifoThresholdType;
+
+/** @brief SAI block setup structure */
+typedef struct
+{
+    SAI_ModeType          Mode;          /*!< Operating mode of the block */
+    SAI_SyncType          Sync;          /*!< Clock synchronization of the block */
+    SAI_StandardType      Standard;      /*!< Audio standard (frame synchronization format) */
+    SAI_DataSizeType      DataSize;      /*!< Sample data size */
+    SAI_SlotSizeType      SlotSize;      /*!< Size of each slot in the frame */
+    uint8_t               SlotCount;     /*!< Number of slots in a frame [1 .. 16] */
+    uint16_t              ActiveSlots;   /*!< Bit mask of the slots transferred by the block */
+    SAI_FifoThresholdType FifoThreshold; /*!< FIFO level at which the DMA is requested */
+    uint32_t              AudioFreq;     /*!< Frame rate in Hz (only used in master mode) */
+}SAI_InitType;
+
+/** @brief SAI error types */
+typedef enum
+{
+    SAI_ERROR_NONE      = 0, /*!< No error */
+    SAI_ERROR_OVRUDR    = 1, /*!< FIFO overrun (RX) or underrun (TX) */
+    SAI_ERROR_FRAMESYNC = 2, /*!< Anticipated or late frame synchronization (slave) */
+    SAI_ERROR_CLOCK     = 4, /*!< Wrong clock configuration (master) */
+    SAI_ERROR_DMA       = 8, /*!< DMA transfer error */
+}SAI_ErrorType;
+
+/** @brief SAI block Handle structure */
+typedef struct
+{
+    SAI_Block_TypeDef * Inst;                /*!< The address of the peripheral block used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Transfer;     /*!< Block transferred callback, Block can be refilled / processed */
+        XPD_HandleCallbackType Error;        /*!< Overrun, underrun, synchronization or DMA error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    DMA_HandleType * DMA;                    /*!< DMA handle for data transfer */
+    struct {
+        uint8_t * Buffer;                    /*!< [Internal] Start of the stream buffer */
+        uint16_t HalfLength;                 /*!< [Internal] Half of the buffer length in samples */
+        uint8_t SampleSize;                  /*!< [Internal] Size of a sample in the buffer in bytes */
+    }Stream;                                 /*   DMA stream buffer */
+    void * volatile Block;                   /*!< The buffer half which is available to the application */
+    RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
+    volatile SAI_ErrorType Errors;           /*!< Streaming errors */
+}SAI_HandleType;
+
+/** @} */
+
+/** @defgroup SAI_Exported_Macros SAI Exported Macros
+ * @{ */
+
+/**
+ * @brief SAI Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SAI peripheral instance.
+ * @param BLOCK: specifies the audio block of the SAI: A or B.
+ */
+#define         SAI_INST2HANDLE(HANDLE,INSTANCE,BLOCK)      \
+    ((HANDLE)->Inst    = (INSTANCE##_Block_##BLOCK),        \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief  Get the specified SAI block flag.
+ * @param  HANDLE: specifies the SAI Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg OVRUDR:  Overrun / underrun
+ *            @arg MUTEDET: Mute detection
+ *            @arg WCKCFG:  Wrong clock configuration
+ *            @arg FREQ:    FIFO request
+ *            @arg CNRDY:   Codec not ready
+ *            @arg AFSDET:  Anticipated frame synchronization detection
+ *            @arg LFSDET:  Late frame synchronization detection
+ */
+#define         SAI_FLAG_STATUS(HANDLE, FLAG_NAME)          \
+    (((HANDLE)->Inst->SR & SAI_xSR_##FLAG_NAME) != 0)
+
+/**
+ * @brief  Clear the specified SAI block flag.
+ * @param  HANDLE: specifies the SAI Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg OVRUDR:  Overrun / underrun
+ *            @arg MUTEDET: Mute detection
+ *            @arg WCKCFG:  Wrong clock configuration
+ *            @arg CNRDY:   Codec not ready
+ *            @arg AFSDET:  Anticipated frame synchronization detection
+ *            @arg LFSDET:  Late frame synchronization detection
+ */
+#define         SAI_FLAG_CLEAR(HANDLE, FLAG_NAME)           \
+    ((HANDLE)->Inst->CLRFR = SAI_xCLRFR_C##FLAG_NAME)
+
+/** @} */
+
+/** @addtogroup SAI_Exported_Functions
+ * @{ */
+XPD_ReturnType  SAI_eInit               (SAI_HandleType * pxSAI,
+                                         const SAI_InitType * pxConfig);
+void            SAI_vDeinit             (SAI_HandleType * pxSAI);
+
+XPD_ReturnType  SAI_eStart_DMA          (SAI_HandleType * pxSAI,
+                                         void * pvBuffer,
+                                         uint16_t usLength);
+void            SAI_vStop_DMA           (SAI_HandleType * pxSAI);
+
+void            SAI_vIRQHandler         (SAI_HandleType * pxSAI);
+
+uint32_t        SAI_ulGetAudioFreq      (SAI_HandleType * pxSAI);
+
+void            SAI_vDeinterleave16     (const int16_t * psSlots,
+                                         int16_t * const apsChannels[],
+                                         uint8_t ucChannels,
+                                         uint16_t usFrames);
+void            SAI_vDeinterleave32     (const int32_t * plSlots,
+                                         int32_t * const aplChannels[],
+                                         uint8_t ucChannels,
+                                         uint16_t usFrames);
+
+/**
+ * @brief Gets the error state of the SAI block.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @return Current SAI error state
+ */
+__STATIC_INLINE SAI_ErrorType SAI_eGetError(SAI_HandleType * pxSAI)
+{
+    return pxSAI->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#define XPD_SAI_API
+#include <xpd_rcc_pc.h>
+#undef XPD_SAI_API
+
+#endif /* SAI1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_SAI_H_ */
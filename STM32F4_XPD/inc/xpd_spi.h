@@ -127,10 +127,12 @@ typedef struct
         XPD_HandleCallbackType Error;        /*!< Error callbacks */
 #endif
     }Callbacks;                              /*   Handle Callbacks */
+#ifndef __XPD_SPI_NO_DMA
     struct {
         DMA_HandleType * Transmit;           /*!< DMA handle for data transmission */
         DMA_HandleType * Receive;            /*!< DMA handle for data reception */
     }DMA;                                    /*   DMA handle references */
+#endif /* __XPD_SPI_NO_DMA */
     DataStreamType RxStream;                 /*!< Data reception stream */
     DataStreamType TxStream;                 /*!< Data transmission stream */
     RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
@@ -308,6 +310,7 @@ void            SPI_vTransmitReceive_IT (SPI_HandleType * pxSPI,
 void            SPI_vIRQHandler         (SPI_HandleType * pxSPI);
 
 
+#ifndef __XPD_SPI_NO_DMA
 XPD_ReturnType  SPI_eTransmit_DMA       (SPI_HandleType * pxSPI,
                                          void * pvTxData,
                                          uint16_t usLength);
@@ -322,6 +325,10 @@ XPD_ReturnType  SPI_eSendReceive_DMA    (SPI_HandleType * pxSPI,
                                          uint16_t usLength);
 
 void            SPI_vStop_DMA           (SPI_HandleType * pxSPI);
+
+void            SPI_vTransmitComplete_DMA(SPI_HandleType * pxSPI);
+void            SPI_vReceiveComplete_DMA(SPI_HandleType * pxSPI);
+#endif /* __XPD_SPI_NO_DMA */
 /** @} */
 
 /** @} */
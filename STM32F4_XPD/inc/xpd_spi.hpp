@@ -0,0 +1,301 @@
+/**
+  ******************************************************************************
+  * @file    xpd_spi.hpp
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers SPI C++ Layer
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_SPI_HPP_
+#define __XPD_SPI_HPP_
+
+#include <xpd_common.hpp>
+#include <xpd_spi.h>
+
+/** @addtogroup XPD_Cpp
+ * @{ */
+
+namespace xpd
+{
+
+/**
+ * @brief SPI with compile-time instance, reset and clock control position and DMA bindings.
+ *        The C driver functions operate on the static handle, while the interrupt handler
+ *        processes the stream elements inline with constant register addresses.
+ *        The stream ends are also finished inline when the event set has a handler for them,
+ *        which is then called directly. @ref SPI_vIRQHandler is only called for the
+ *        remaining stream ends, CRC handling and errors.
+ * @tparam BASE: the SPI instance base address
+ * @tparam POS: the SPI reset and clock control position
+ * @tparam EVENTS: event set with optional static on_transmit, on_receive, on_error handlers
+ * @tparam TXDMA: DMA handle for data transmission
+ * @tparam RXDMA: DMA handle for data reception
+ *
+ * @code
+ * using flash_bus = XPD_SPI(SPI1, xpd::no_events, &xSpiTxDma, &xSpiRxDma);
+ *
+ * flash_bus::call<SPI_vInit>(&xFlashBusConfig);
+ * extern "C" void SPI1_IRQHandler(void) { flash_bus::irq(); }
+ * @endcode
+ */
+template<uintptr_t BASE, RCC_PositionType POS, class EVENTS = no_events,
+         DMA_HandleType * TXDMA = nullptr, DMA_HandleType * RXDMA = nullptr>
+class spi
+{
+public:
+    /** @brief The C driver handle of the instance */
+    static inline SPI_HandleType handle = {};
+
+    /**
+     * @brief Gets the peripheral instance.
+     * @return The constant SPI instance address
+     */
+    static SPI_TypeDef * inst()
+    {
+        return reinterpret_cast<SPI_TypeDef *>(BASE);
+    }
+
+    /** @brief Control and status register bits with compile-time access method */
+    template<uint8_t POSITION>
+    using cr1_bit = reg_bit<BASE + offsetof(SPI_TypeDef, CR1), POSITION>;
+    template<uint8_t POSITION>
+    using cr2_bit = reg_bit<BASE + offsetof(SPI_TypeDef, CR2), POSITION>;
+    template<uint8_t POSITION>
+    using sr_bit  = reg_bit<BASE + offsetof(SPI_TypeDef, SR),  POSITION>;
+
+    /**
+     * @brief Binds the instance, DMA handles and event handlers to the C driver handle.
+     *        The event handlers are bound for the DMA and C interrupt handler paths.
+     *        Shall be called before any other function.
+     */
+    static void bind()
+    {
+        handle.Inst         = inst();
+#ifdef SPI_BB
+        handle.Inst_BB      = SPI_BB(inst());
+#endif
+        handle.CtrlPos      = POS;
+#ifndef __XPD_SPI_NO_DMA
+        handle.DMA.Transmit = TXDMA;
+        handle.DMA.Receive  = RXDMA;
+#endif
+
+        XPD_CPP_EVENT_BIND(EVENTS, on_transmit, handle.Callbacks.Transmit);
+        XPD_CPP_EVENT_BIND(EVENTS, on_receive,  handle.Callbacks.Receive);
+#if defined(__XPD_SPI_ERROR_DETECT) || defined(__XPD_DMA_ERROR_DETECT)
+        XPD_CPP_EVENT_BIND(EVENTS, on_error,    handle.Callbacks.Error);
+#endif
+    }
+
+    /**
+     * @brief Calls a C driver function with the instance's handle.
+     * @tparam FUNCTION: the SPI driver function
+     * @param args: the further arguments of the function
+     * @return The result of the function
+     */
+    template<auto FUNCTION, class... ARGS>
+    static auto call(ARGS... args)
+    {
+        return FUNCTION(&handle, args...);
+    }
+
+    /**
+     * @brief Starts interrupt-driven data transmission.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     */
+    static void transmit_it(void * data, uint16_t length)
+    {
+        SPI_vTransmit_IT(&handle, data, length);
+    }
+
+    /**
+     * @brief Starts interrupt-driven data reception.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     */
+    static void receive_it(void * data, uint16_t length)
+    {
+        SPI_vReceive_IT(&handle, data, length);
+    }
+
+    /**
+     * @brief Starts interrupt-driven full duplex data transfer.
+     * @param txdata: pointer to the transmit data buffer
+     * @param rxdata: pointer to the receive data buffer
+     * @param length: amount of data transfers
+     */
+    static void transmit_receive_it(void * txdata, void * rxdata, uint16_t length)
+    {
+        SPI_vTransmitReceive_IT(&handle, txdata, rxdata, length);
+    }
+
+#ifndef __XPD_SPI_NO_DMA
+    /**
+     * @brief Starts DMA-managed data transmission.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     * @return BUSY if DMA is in use, OK if transfer is started
+     */
+    static XPD_ReturnType transmit_dma(void * data, uint16_t length)
+    {
+        static_assert(TXDMA != nullptr, "No transmit DMA is bound to the SPI.");
+        return SPI_eTransmit_DMA(&handle, data, length);
+    }
+
+    /**
+     * @brief Starts DMA-managed data reception.
+     * @param data: pointer to the data buffer
+     * @param length: amount of data transfers
+     * @return BUSY if DMA is in use, OK if transfer is started
+     */
+    static XPD_ReturnType receive_dma(void * data, uint16_t length)
+    {
+        static_assert(RXDMA != nullptr, "No receive DMA is bound to the SPI.");
+        return SPI_eReceive_DMA(&handle, data, length);
+    }
+
+    /**
+     * @brief Transmit DMA interrupt handler, which calls the transfer completion
+     *        of the instance directly instead of through the DMA handle callback.
+     */
+    static void tx_dma_irq()
+    {
+        static_assert(TXDMA != nullptr, "No transmit DMA is bound to the SPI.");
+        if (DMA_eIRQHandler(TXDMA) != RESET)
+        {
+            SPI_vTransmitComplete_DMA(&handle);
+        }
+    }
+
+    /**
+     * @brief Receive DMA interrupt handler, which calls the transfer completion
+     *        of the instance directly instead of through the DMA handle callback.
+     */
+    static void rx_dma_irq()
+    {
+        static_assert(RXDMA != nullptr, "No receive DMA is bound to the SPI.");
+        if (DMA_eIRQHandler(RXDMA) != RESET)
+        {
+            SPI_vReceiveComplete_DMA(&handle);
+        }
+    }
+#endif /* __XPD_SPI_NO_DMA */
+
+    /**
+     * @brief SPI interrupt handler, moves the stream elements inline and
+     *        finishes the streams inline if the event set handles their completion,
+     *        otherwise passes the last elements and all other events to the C driver.
+     */
+    static void irq()
+    {
+        const uint32_t sr  = inst()->SR.w;
+        const uint32_t cr2 = inst()->CR2.w;
+#ifdef __XPD_SPI_ERROR_DETECT
+        /* the CRC phase is started before the last data element */
+        const bool fast = handle.CRCSize == 0;
+#else
+        constexpr bool fast = true;
+#endif
+
+        if (((sr & (SPI_SR_RXNE | SPI_SR_OVR)) == SPI_SR_RXNE) && ((cr2 & SPI_CR2_RXNEIE) != 0) && fast)
+        {
+            if (handle.RxStream.length > 1)
+            {
+                read_to_stream(&inst()->DR, handle.RxStream);
+                return;
+            }
+            if constexpr (has_on_receive<EVENTS>::value)
+            {
+                read_to_stream(&inst()->DR, handle.RxStream);
+
+                /* if master mode, and either simplex, or half duplex communication */
+                if ((inst()->CR1.w & (SPI_CR1_MSTR | SPI_CR1_BIDIMODE | SPI_CR1_RXONLY)) > SPI_CR1_MSTR)
+                {
+                    cr1_bit<SPI_CR1_SPE_Pos>::write(false);
+                }
+
+                /* disable RXNE and ERR interrupt */
+                cr2_bit<SPI_CR2_RXNEIE_Pos>::write(false);
+                cr2_bit<SPI_CR2_ERRIE_Pos>::write(false);
+
+                EVENTS::on_receive();
+                return;
+            }
+        }
+        if (((sr & SPI_SR_TXE) != 0) && ((cr2 & SPI_CR2_TXEIE) != 0))
+        {
+            if (handle.TxStream.length > 1)
+            {
+                write_from_stream(&inst()->DR, handle.TxStream);
+                return;
+            }
+            if constexpr (has_on_transmit<EVENTS>::value)
+            {
+                write_from_stream(&inst()->DR, handle.TxStream);
+
+#ifdef __XPD_SPI_ERROR_DETECT
+                /* enable CRC transmission */
+                if (handle.CRCSize > 0)
+                {
+                    cr1_bit<SPI_CR1_CRCNEXT_Pos>::write(true);
+                }
+#endif
+                cr2_bit<SPI_CR2_TXEIE_Pos>::write(false);
+
+                /* clear overrun flag in 2 lines communication mode because received data is not read */
+                if (!cr1_bit<SPI_CR1_BIDIMODE_Pos>::read())
+                {
+                    /* nothing to receive, empty previously received data from data register */
+                    if (handle.RxStream.length == 0)
+                    {
+                        while (sr_bit<SPI_SR_RXNE_Pos>::read())
+                        {
+                            if (handle.RxStream.size == 1)
+                            {
+                                (void) *reinterpret_cast<volatile uint8_t *>(&inst()->DR);
+                            }
+                            else
+                            {
+                                (void) *reinterpret_cast<volatile uint16_t *>(&inst()->DR);
+                            }
+                        }
+                    }
+                    sr_bit<SPI_SR_OVR_Pos>::write(false);
+                }
+
+                EVENTS::on_transmit();
+                return;
+            }
+        }
+        SPI_vIRQHandler(&handle);
+    }
+};
+
+} /* namespace xpd */
+
+/**
+ * @brief SPI template instantiation by the instance name.
+ * @param INSTANCE: specifies the SPI peripheral instance.
+ * @param ...: optional event set and DMA handles
+ */
+#define XPD_SPI(INSTANCE, ...)      \
+    xpd::spi<INSTANCE##_BASE, RCC_POS_##INSTANCE, ##__VA_ARGS__>
+
+/** @} */
+
+#endif /* __XPD_SPI_HPP_ */
@@ -33,6 +33,22 @@ extern "C"
 /** @defgroup XPD_Utils XPD Utilities
  * @{ */
 
+/** @defgroup XPD_Exported_Types XPD Exported Types
+ * @{ */
+
+/** @brief XPD cycle measurement statistics */
+typedef struct
+{
+    uint32_t Start;     /*!< [Internal] Cycle counter value at the measurement start */
+    uint32_t Last;      /*!< Cycles of the last measurement */
+    uint32_t Min;       /*!< Minimal measured cycles */
+    uint32_t Max;       /*!< Maximal measured cycles */
+    uint32_t Count;     /*!< Number of measurements */
+    uint64_t Total;     /*!< Sum of the measured cycles */
+}XPD_CycleStatType;
+
+/** @} */
+
 /** @defgroup XPD_Exported_Macros XPD Exported Macros
  * @{ */
 
@@ -52,6 +68,15 @@ extern "C"
 #define XPD_EXIT_CRITICAL(HANDLE)
 #endif
 
+/**
+ * @brief Measures the execution cycles of a statement.
+ * @param STAT: pointer to the cycle statistics
+ * @param STATEMENT: the measured code
+ */
+#define XPD_CYCLES_MEASURE(STAT, STATEMENT)     \
+    do { XPD_vCycleStatStart(STAT); STATEMENT;  \
+         XPD_vCycleStatStop(STAT); } while (0)
+
 /** @} */
 
 /** @addtogroup XPD_Exported_Functions
@@ -66,6 +91,18 @@ XPD_ReturnType  XPD_eWaitForMatch       (volatile uint32_t * pulVarAddress, uint
                                          uint32_t            ulMatch,       uint32_t * pulTimeout);
 XPD_ReturnType  XPD_eWaitForDiff        (volatile uint32_t * pulVarAddress, uint32_t ulBitSelector,
                                          uint32_t            ulMatch,       uint32_t * pulTimeout);
+XPD_ReturnType  XPD_eWaitForResult      (volatile XPD_ReturnType * peResult, uint32_t * pulTimeout);
+/** @} */
+
+/** @addtogroup XPD_Exported_Functions_Cycles
+ * @{ */
+void            XPD_vInitCycleCounter   (void);
+uint32_t        XPD_ulGetCycles         (void);
+uint32_t        XPD_ulCyclesSince       (uint32_t ulStart);
+
+void            XPD_vCycleStatReset     (XPD_CycleStatType * pxStat);
+void            XPD_vCycleStatStart     (XPD_CycleStatType * pxStat);
+void            XPD_vCycleStatStop      (XPD_CycleStatType * pxStat);
 /** @} */
 
 /** @addtogroup XPD_Exported_Functions_Stream
@@ -602,7 +602,8 @@ XPD_ReturnType CAN_eReceive(
  * @param pxCAN: pointer to the CAN handle structure
  * @param pxFrame: pointer to the frame to put the received frame data to
  * @param ucFIFONumber: the selected receive FIFO [0 .. 1]
- * @return BUSY if the FIFO is already in use, OK otherwise
+ * @return ERROR if FIFO 1 is selected while its interrupt handling is disabled by
+ *         __XPD_CAN_NO_FIFO1, BUSY if the FIFO is already in use, OK otherwise
  */
 XPD_ReturnType CAN_eReceive_IT(
         CAN_HandleType *    pxCAN,
@@ -612,6 +613,14 @@ XPD_ReturnType CAN_eReceive_IT(
     XPD_ReturnType eResult = XPD_BUSY;
     uint8_t ucRecState = CAN_STATE_RECEIVE0 << ucFIFONumber;
 
+#ifdef __XPD_CAN_NO_FIFO1
+    /* FIFO 1 has no interrupt handler */
+    if (ucFIFONumber != 0)
+    {
+        eResult = XPD_ERROR;
+    }
+    else
+#endif /* __XPD_CAN_NO_FIFO1 */
     /* check if FIFO is not in use */
     if ((pxCAN->State & ucRecState) == 0)
     {
@@ -661,6 +670,7 @@ void CAN_vIRQHandlerRX0(CAN_HandleType * pxCAN)
     }
 }
 
+#ifndef __XPD_CAN_NO_FIFO1
 /**
  * @brief CAN receive FIFO 1 interrupt handler that provides handle callbacks.
  * @param pxCAN: pointer to the CAN handle structure
@@ -693,6 +703,7 @@ void CAN_vIRQHandlerRX1(CAN_HandleType * pxCAN)
         XPD_SAFE_CALLBACK(pxCAN->Callbacks.Receive[1], pxCAN);
     }
 }
+#endif /* __XPD_CAN_NO_FIFO1 */
 
 /** @} */
 
@@ -0,0 +1,622 @@
+/**
+  ******************************************************************************
+  * @file    xpd_cryp.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Cryptographic Processor Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_cryp.h>
+#include <xpd_utils.h>
+
+#if defined(CRYP)
+
+/** @addtogroup CRYP
+ * @{ */
+
+#define CRYP_AES_BLOCK_SIZE         16
+
+/* Maximum time of the key preparation and GCM setup phases */
+#define CRYP_SETUP_TIMEOUT          1
+
+#define CRYP_QUEUE_MASK             (CRYP_QUEUE_LENGTH - 1)
+
+#define CRYP_ACTIVE_REQUEST(HANDLE)     \
+    ((HANDLE)->Queue.Items[(HANDLE)->Queue.Head & CRYP_QUEUE_MASK])
+
+static void CRYP_prvStartRequest(CRYP_HandleType * pxCRYP);
+
+/* Key and IV registers are big endian, not affected by the data swapping */
+static uint32_t CRYP_prvLoadWord(const uint8_t * pucData)
+{
+    return ((uint32_t)pucData[0] << 24) | ((uint32_t)pucData[1] << 16)
+         | ((uint32_t)pucData[2] <<  8) |  (uint32_t)pucData[3];
+}
+
+static void CRYP_prvSetKey(CRYP_HandleType * pxCRYP)
+{
+    volatile uint32_t * pulKey = &pxCRYP->Inst->K0LR;
+    const uint8_t * pucKey = pxCRYP->Key.Data;
+    uint32_t i;
+
+    /* The key is aligned to the end of the key registers */
+    for (i = 4 - 2 * (pxCRYP->Key.Size >> CRYP_CR_KEYSIZE_Pos); i < 8; i++)
+    {
+        pulKey[i] = CRYP_prvLoadWord(pucKey);
+        pucKey += sizeof(uint32_t);
+    }
+}
+
+static void CRYP_prvSetIV(CRYP_HandleType * pxCRYP, const CRYP_RequestType * pxRequest)
+{
+    volatile uint32_t * pulIV = &pxCRYP->Inst->IV0LR;
+
+    pulIV[0] = CRYP_prvLoadWord(&pxRequest->IV[0]);
+    pulIV[1] = CRYP_prvLoadWord(&pxRequest->IV[4]);
+    pulIV[2] = CRYP_prvLoadWord(&pxRequest->IV[8]);
+#ifdef CRYP_CR_GCM_CCMPH
+    if (pxRequest->Mode == CRYP_MODE_AES_GCM)
+    {
+        /* The first payload block uses the counter value 2 */
+        pulIV[3] = 2;
+    }
+    else
+#endif
+    {
+        pulIV[3] = CRYP_prvLoadWord(&pxRequest->IV[12]);
+    }
+}
+
+#ifdef CRYP_CR_GCM_CCMPH
+/* Computes the hash subkey and feeds the zero padded additional authenticated data */
+static XPD_ReturnType CRYP_prvGcmHeader(
+        CRYP_HandleType *           pxCRYP,
+        const CRYP_RequestType *    pxRequest,
+        uint32_t                    ulCR)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = CRYP_SETUP_TIMEOUT;
+    const uint8_t * pucHeader = pxRequest->Header;
+    uint32_t i, ulPadded;
+
+    /* Init phase: the processor clears CRYPEN when the subkey is ready */
+    pxCRYP->Inst->CR.w = ulCR | CRYP_CR_CRYPEN;
+    eResult = XPD_eWaitForMatch(&pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN, 0, &ulTimeout);
+
+    if ((eResult == XPD_OK) && (pxRequest->HeaderLength > 0))
+    {
+        pxCRYP->Inst->CR.w = ulCR | CRYP_CR_GCM_CCMPH_0 | CRYP_CR_CRYPEN;
+
+        ulPadded = (pxRequest->HeaderLength + CRYP_AES_BLOCK_SIZE - 1)
+                 & ~(CRYP_AES_BLOCK_SIZE - 1);
+
+        for (i = 0; (i < ulPadded) && (eResult == XPD_OK); i += sizeof(uint32_t))
+        {
+            uint32_t ulWord = 0, j;
+
+            /* Memory byte order, the input is swapped by the processor */
+            for (j = 0; j < sizeof(uint32_t); j++)
+            {
+                if ((i + j) < pxRequest->HeaderLength)
+                {
+                    ulWord |= (uint32_t)pucHeader[i + j] << (8 * j);
+                }
+            }
+
+            eResult = XPD_eWaitForMatch(&pxCRYP->Inst->SR.w,
+                    CRYP_SR_IFNF, CRYP_SR_IFNF, &ulTimeout);
+            pxCRYP->Inst->DR = ulWord;
+        }
+
+        if (eResult == XPD_OK)
+        {
+            eResult = XPD_eWaitForMatch(&pxCRYP->Inst->SR.w,
+                    CRYP_SR_IFEM | CRYP_SR_BUSY, CRYP_SR_IFEM, &ulTimeout);
+        }
+    }
+
+    /* Payload phase is entered with the processor disabled */
+    pxCRYP->Inst->CR.w = ulCR | CRYP_CR_GCM_CCMPH_1;
+
+    return eResult;
+}
+
+/* Feeds the bit lengths and reads out the authentication tag */
+static XPD_ReturnType CRYP_prvGcmFinal(CRYP_HandleType * pxCRYP, const CRYP_RequestType * pxRequest)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = CRYP_SETUP_TIMEOUT;
+    uint32_t ulCR = pxCRYP->Inst->CR.w & ~(CRYP_CR_CRYPEN | CRYP_CR_ALGODIR);
+    uint32_t i;
+
+    pxCRYP->Inst->CR.w = ulCR;
+
+    /* The final phase is always performed in encryption direction */
+    pxCRYP->Inst->CR.w = ulCR | CRYP_CR_GCM_CCMPH | CRYP_CR_CRYPEN;
+
+    /* 64 bit lengths in bits, reversed to cancel the input swapping */
+    pxCRYP->Inst->DR = 0;
+    pxCRYP->Inst->DR = __REV(pxRequest->HeaderLength * 8);
+    pxCRYP->Inst->DR = 0;
+    pxCRYP->Inst->DR = __REV(pxRequest->Length * 8);
+
+    eResult = XPD_eWaitForMatch(&pxCRYP->Inst->SR.w, CRYP_SR_OFNE, CRYP_SR_OFNE, &ulTimeout);
+
+    for (i = 0; (i < CRYP_AES_BLOCK_SIZE) && (eResult == XPD_OK); i += sizeof(uint32_t))
+    {
+        uint32_t ulWord = pxCRYP->Inst->DOUT;
+
+        pxRequest->Tag[i + 0] = (uint8_t)(ulWord);
+        pxRequest->Tag[i + 1] = (uint8_t)(ulWord >> 8);
+        pxRequest->Tag[i + 2] = (uint8_t)(ulWord >> 16);
+        pxRequest->Tag[i + 3] = (uint8_t)(ulWord >> 24);
+    }
+
+    return eResult;
+}
+#endif
+
+/* Loads the key and IV and performs the mode specific setup */
+static XPD_ReturnType CRYP_prvSetup(
+        CRYP_HandleType *           pxCRYP,
+        const CRYP_RequestType *    pxRequest,
+        uint32_t                    ulCR)
+{
+    XPD_ReturnType eResult = XPD_OK;
+
+    CRYP_prvSetKey(pxCRYP);
+
+    /* ECB and CBC decryption uses the last round key as starting point */
+    if ((pxRequest->Operation == CRYP_OPERATION_DECRYPT) &&
+        ((pxRequest->Mode == CRYP_MODE_AES_ECB) || (pxRequest->Mode == CRYP_MODE_AES_CBC)))
+    {
+        uint32_t ulTimeout = CRYP_SETUP_TIMEOUT;
+
+        pxCRYP->Inst->CR.w = (ulCR & ~CRYP_CR_ALGOMODE)
+                | CRYP_CR_ALGOMODE_AES_KEY | CRYP_CR_CRYPEN;
+
+        eResult = XPD_eWaitForMatch(&pxCRYP->Inst->SR.w, CRYP_SR_BUSY, 0, &ulTimeout);
+
+        pxCRYP->Inst->CR.w = ulCR;
+    }
+
+    if (pxRequest->Mode != CRYP_MODE_AES_ECB)
+    {
+        CRYP_prvSetIV(pxCRYP, pxRequest);
+    }
+
+#ifdef CRYP_CR_GCM_CCMPH
+    if ((eResult == XPD_OK) && (pxRequest->Mode == CRYP_MODE_AES_GCM))
+    {
+        eResult = CRYP_prvGcmHeader(pxCRYP, pxRequest, ulCR);
+    }
+#endif
+
+    return eResult;
+}
+
+/* Disables the processor and its DMA streams */
+static void CRYP_prvStopData(CRYP_HandleType * pxCRYP)
+{
+    if (pxCRYP->Inst->DMACR.w != 0)
+    {
+        pxCRYP->Inst->DMACR.w = 0;
+
+        DMA_vStop_IT(pxCRYP->DMA.Input);
+        DMA_vStop_IT(pxCRYP->DMA.Output);
+    }
+    CLEAR_BIT(pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN);
+}
+
+/* Finishes the active request and starts the next one */
+static void CRYP_prvCompleteRequest(CRYP_HandleType * pxCRYP, XPD_ReturnType eResult)
+{
+    CRYP_RequestType * pxRequest = CRYP_ACTIVE_REQUEST(pxCRYP);
+
+    pxCRYP->Queue.Head++;
+    pxRequest->Result = eResult;
+
+    /* Continue with the next request before notifying, so that
+     * requests submitted from the callbacks are only queued */
+    if (pxCRYP->Queue.Head != pxCRYP->Queue.Tail)
+    {
+        CRYP_prvStartRequest(pxCRYP);
+    }
+
+    if (eResult != XPD_OK)
+    {
+        XPD_SAFE_CALLBACK(pxCRYP->Callbacks.Error, pxCRYP);
+    }
+
+    XPD_SAFE_CALLBACK(pxRequest->Callback, pxRequest);
+
+    if (pxCRYP->Queue.Head == pxCRYP->Queue.Tail)
+    {
+        XPD_SAFE_CALLBACK(pxCRYP->Callbacks.QueueEmpty, pxCRYP);
+    }
+}
+
+/* Processes the zero padded final partial block of the request */
+static XPD_ReturnType CRYP_prvPartialBlock(CRYP_HandleType * pxCRYP, const CRYP_RequestType * pxRequest)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = CRYP_SETUP_TIMEOUT;
+    uint32_t ulOffset = pxRequest->Length & ~(CRYP_AES_BLOCK_SIZE - 1);
+    uint32_t ulRemaining = pxRequest->Length - ulOffset;
+    const uint8_t * pucInput = (const uint8_t *)pxRequest->Input + ulOffset;
+    uint8_t * pucOutput = (uint8_t *)pxRequest->Output + ulOffset;
+    uint32_t i, j;
+
+    SET_BIT(pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN);
+
+    for (i = 0; i < CRYP_AES_BLOCK_SIZE; i += sizeof(uint32_t))
+    {
+        uint32_t ulWord = 0;
+
+        /* Memory byte order, the input is swapped by the processor */
+        for (j = 0; j < sizeof(uint32_t); j++)
+        {
+            if ((i + j) < ulRemaining)
+            {
+                ulWord |= (uint32_t)pucInput[i + j] << (8 * j);
+            }
+        }
+        pxCRYP->Inst->DR = ulWord;
+    }
+
+    eResult = XPD_eWaitForMatch(&pxCRYP->Inst->SR.w, CRYP_SR_OFNE, CRYP_SR_OFNE, &ulTimeout);
+
+    /* Only the valid bytes of the output block are stored */
+    for (i = 0; (i < CRYP_AES_BLOCK_SIZE) && (eResult == XPD_OK); i += sizeof(uint32_t))
+    {
+        uint32_t ulWord = pxCRYP->Inst->DOUT;
+
+        for (j = 0; j < sizeof(uint32_t); j++)
+        {
+            if ((i + j) < ulRemaining)
+            {
+                pucOutput[i + j] = (uint8_t)(ulWord >> (8 * j));
+            }
+        }
+    }
+
+    CLEAR_BIT(pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN);
+
+    return eResult;
+}
+
+/* Processes the final partial block and the GCM final phase, then completes the request */
+static void CRYP_prvFinishRequest(CRYP_HandleType * pxCRYP)
+{
+    CRYP_RequestType * pxRequest = CRYP_ACTIVE_REQUEST(pxCRYP);
+    XPD_ReturnType eResult = XPD_OK;
+
+    if ((pxRequest->Length % CRYP_AES_BLOCK_SIZE) != 0)
+    {
+        eResult = CRYP_prvPartialBlock(pxCRYP, pxRequest);
+    }
+
+#ifdef CRYP_CR_GCM_CCMPH
+    if ((eResult == XPD_OK) && (pxRequest->Mode == CRYP_MODE_AES_GCM))
+    {
+        eResult = CRYP_prvGcmFinal(pxCRYP, pxRequest);
+
+        CLEAR_BIT(pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN);
+    }
+#endif
+
+    if (eResult != XPD_OK)
+    {
+        pxCRYP->Errors |= CRYP_ERROR_TIMEOUT;
+        eResult = XPD_ERROR;
+    }
+
+    CRYP_prvCompleteRequest(pxCRYP, eResult);
+}
+
+static void CRYP_prvDmaRedirect(void * pxDMA)
+{
+    CRYP_HandleType * pxCRYP = (CRYP_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The output stream completes last */
+    CRYP_prvStopData(pxCRYP);
+
+    CRYP_prvFinishRequest(pxCRYP);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void CRYP_prvDmaErrorRedirect(void * pxDMA)
+{
+    CRYP_HandleType * pxCRYP = (CRYP_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxCRYP->Errors |= CRYP_ERROR_DMA;
+
+    CRYP_prvStopData(pxCRYP);
+
+    CRYP_prvCompleteRequest(pxCRYP, XPD_ERROR);
+}
+#endif
+
+/* Streams the complete blocks of the request data through the processor */
+static XPD_ReturnType CRYP_prvStartData(CRYP_HandleType * pxCRYP, CRYP_RequestType * pxRequest)
+{
+    DMA_HandleType * pxDMAin  = pxCRYP->DMA.Input;
+    DMA_HandleType * pxDMAout = pxCRYP->DMA.Output;
+    uint16_t usWords = (pxRequest->Length & ~(CRYP_AES_BLOCK_SIZE - 1)) / sizeof(uint32_t);
+    XPD_ReturnType eResult;
+
+    /* Set the callback owner */
+    pxDMAin->Owner  = pxCRYP;
+    pxDMAout->Owner = pxCRYP;
+
+    /* Set the DMA transfer callbacks, completion is signalled by the output */
+    pxDMAin->Callbacks.Complete  = NULL;
+    pxDMAout->Callbacks.Complete = CRYP_prvDmaRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+    pxDMAin->Callbacks.Error     = CRYP_prvDmaErrorRedirect;
+    pxDMAout->Callbacks.Error    = CRYP_prvDmaErrorRedirect;
+#endif
+
+    eResult = DMA_eStart_IT(pxDMAout, (void*)&pxCRYP->Inst->DOUT, pxRequest->Output, usWords);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = DMA_eStart_IT(pxDMAin, (void*)&pxCRYP->Inst->DR, (void*)pxRequest->Input, usWords);
+
+        if (eResult == XPD_OK)
+        {
+            pxCRYP->Inst->DMACR.w = CRYP_DMACR_DIEN | CRYP_DMACR_DOEN;
+
+            SET_BIT(pxCRYP->Inst->CR.w, CRYP_CR_CRYPEN);
+        }
+        else
+        {
+            DMA_vStop_IT(pxDMAout);
+        }
+    }
+    return eResult;
+}
+
+/* Configures the processor for the active request and starts the data streams */
+static void CRYP_prvStartRequest(CRYP_HandleType * pxCRYP)
+{
+    CRYP_RequestType * pxRequest = CRYP_ACTIVE_REQUEST(pxCRYP);
+    XPD_ReturnType eResult = XPD_OK;
+    uint32_t ulCR = pxRequest->Mode | CRYP_CR_DATATYPE_1 | pxCRYP->Key.Size;
+
+    if (pxRequest->Operation == CRYP_OPERATION_DECRYPT)
+    {
+        ulCR |= CRYP_CR_ALGODIR;
+    }
+
+    /* FIFOs can only be flushed while the processor is disabled */
+    pxCRYP->Inst->CR.w = ulCR;
+    pxCRYP->Inst->CR.w = ulCR | CRYP_CR_FFLUSH;
+
+    /* Without IV the chaining state of the previous request is continued */
+    if ((pxRequest->IV != NULL) || (pxRequest->Mode == CRYP_MODE_AES_ECB))
+    {
+        eResult = CRYP_prvSetup(pxCRYP, pxRequest, ulCR);
+
+        if (eResult != XPD_OK)
+        {
+            pxCRYP->Errors |= CRYP_ERROR_TIMEOUT;
+        }
+    }
+
+    if (eResult == XPD_OK)
+    {
+        if (pxRequest->Length >= CRYP_AES_BLOCK_SIZE)
+        {
+            eResult = CRYP_prvStartData(pxCRYP, pxRequest);
+
+            if (eResult != XPD_OK)
+            {
+                pxCRYP->Errors |= CRYP_ERROR_DMA;
+            }
+        }
+        else
+        {
+            /* A single partial block, or GCM authentication only */
+            CRYP_prvFinishRequest(pxCRYP);
+            return;
+        }
+    }
+
+    if (eResult != XPD_OK)
+    {
+        CRYP_prvStopData(pxCRYP);
+        CRYP_prvCompleteRequest(pxCRYP, XPD_ERROR);
+    }
+}
+
+/** @defgroup CRYP_Exported_Functions CRYP Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the CRYP peripheral with the AES key.
+ * @note  The DMA handles have to be initialized for word transfers between
+ *        the FIFOs and memory, the input with memory to peripheral direction.
+ *        The output DMA interrupt must not have lower priority than the input's.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ * @param pxConfig: CRYP setup configuration
+ */
+void CRYP_vInit(CRYP_HandleType * pxCRYP, const CRYP_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_CRYP);
+
+    pxCRYP->Key.Data    = pxConfig->Key;
+    pxCRYP->Key.Size    = (uint32_t)pxConfig->KeySize << CRYP_CR_KEYSIZE_Pos;
+    pxCRYP->Queue.Head  = pxCRYP->Queue.Tail = 0;
+    pxCRYP->Errors      = CRYP_ERROR_NONE;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxCRYP->Callbacks.DepInit, pxCRYP);
+
+    pxCRYP->Inst->DMACR.w = 0;
+    pxCRYP->Inst->IMSCR.w = 0;
+    pxCRYP->Inst->CR.w    = CRYP_CR_FFLUSH;
+}
+
+/**
+ * @brief Restores the CRYP peripheral to its default inactive state.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ */
+void CRYP_vDeinit(CRYP_HandleType * pxCRYP)
+{
+    CRYP_vAbort(pxCRYP);
+
+    pxCRYP->Inst->CR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxCRYP->Callbacks.DepDeinit, pxCRYP);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_CRYP);
+}
+
+/**
+ * @brief Queues a processing request, which is started immediately if the CRYP is idle.
+ *        Back-to-back requests are chained from the DMA completion, and
+ *        a long message can be split to multiple CBC or CTR requests by leaving
+ *        the IV of the subsequent parts NULL.
+ *        CTR and GCM decryption requests can end with a partial block, which is zero padded
+ *        and processed by the CPU. A CTR chain cannot be continued after a partial block.
+ * @note  The request structure and its buffers are used until the request's Result is set,
+ *        and must remain valid until then.
+ *        When requests are submitted from different interrupt priorities, XPD_ENTER_CRITICAL
+ *        has to mask the CRYP DMA interrupts.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ * @param pxRequest: pointer to the processing request
+ * @return ERROR if the request is invalid, BUSY if the queue is full, OK if the request is queued
+ */
+XPD_ReturnType CRYP_eSubmit(CRYP_HandleType * pxCRYP, CRYP_RequestType * pxRequest)
+{
+    XPD_ReturnType eResult = XPD_BUSY;
+    boolean_t xEmptyValid = FALSE;
+    boolean_t xPartialValid = (pxRequest->Mode == CRYP_MODE_AES_CTR) ? TRUE : FALSE;
+
+#ifdef CRYP_CR_GCM_CCMPH
+    if (pxRequest->Mode == CRYP_MODE_AES_GCM)
+    {
+        /* The authentication state cannot be continued */
+        if ((pxRequest->IV == NULL) || (pxRequest->Tag == NULL))
+        {
+            return XPD_ERROR;
+        }
+        xEmptyValid = TRUE;
+
+        /* Without the number of padding bytes setting (not available on this device)
+         * the encrypted padding would be included in the authentication tag */
+        if (pxRequest->Operation == CRYP_OPERATION_DECRYPT)
+        {
+            xPartialValid = TRUE;
+        }
+    }
+#endif
+
+    if ((pxCRYP->Key.Data == NULL)
+     || (((pxRequest->Length % CRYP_AES_BLOCK_SIZE) != 0) && (xPartialValid == FALSE))
+     || ((pxRequest->Length / sizeof(uint32_t)) > 0xFFFF)
+     || ((pxRequest->Length == 0) && (xEmptyValid == FALSE)))
+    {
+        return XPD_ERROR;
+    }
+
+    XPD_ENTER_CRITICAL(pxCRYP);
+
+    if ((uint8_t)(pxCRYP->Queue.Tail - pxCRYP->Queue.Head) < CRYP_QUEUE_LENGTH)
+    {
+        boolean_t xIdle = (pxCRYP->Queue.Head == pxCRYP->Queue.Tail) ? TRUE : FALSE;
+
+        pxRequest->Result = XPD_BUSY;
+        pxCRYP->Queue.Items[pxCRYP->Queue.Tail & CRYP_QUEUE_MASK] = pxRequest;
+        pxCRYP->Queue.Tail++;
+
+        /* Start processing if no request is in progress */
+        if (xIdle != FALSE)
+        {
+            CRYP_prvStartRequest(pxCRYP);
+        }
+        eResult = XPD_OK;
+    }
+
+    XPD_EXIT_CRITICAL(pxCRYP);
+
+    return eResult;
+}
+
+/**
+ * @brief Submits a single request and waits for its completion.
+ * @note  The request's completion callback is not used.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ * @param pxRequest: pointer to the processing request
+ * @param ulTimeout: the timeout in ms for the processing
+ * @return ERROR if the request is invalid or failed, BUSY if the queue is full,
+ *         TIMEOUT if the processing didn't finish in time, OK if completed
+ */
+XPD_ReturnType CRYP_eProcess(CRYP_HandleType * pxCRYP, CRYP_RequestType * pxRequest, uint32_t ulTimeout)
+{
+    XPD_ReturnType eResult;
+
+    pxRequest->Callback = NULL;
+
+    eResult = CRYP_eSubmit(pxCRYP, pxRequest);
+
+    if (eResult == XPD_OK)
+    {
+        /* Wait until the request's result is set */
+        eResult = XPD_eWaitForResult(&pxRequest->Result, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            eResult = pxRequest->Result;
+        }
+        else
+        {
+            CRYP_vAbort(pxCRYP);
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the active processing and removes all queued requests with ERROR result.
+ * @note  The request callbacks are not called.
+ * @param pxCRYP: pointer to the CRYP handle structure
+ */
+void CRYP_vAbort(CRYP_HandleType * pxCRYP)
+{
+    XPD_ENTER_CRITICAL(pxCRYP);
+
+    CRYP_prvStopData(pxCRYP);
+
+    while (pxCRYP->Queue.Head != pxCRYP->Queue.Tail)
+    {
+        CRYP_ACTIVE_REQUEST(pxCRYP)->Result = XPD_ERROR;
+        pxCRYP->Queue.Head++;
+    }
+
+    XPD_EXIT_CRITICAL(pxCRYP);
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* CRYP */
@@ -0,0 +1,405 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dcmi.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital Camera Interface Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_dcmi.h>
+#include <xpd_utils.h>
+
+#if defined(DCMI)
+
+/** @addtogroup DCMI
+ * @{ */
+
+#define DCMI_ALL_FLAGS          (DCMI_ICR_FRAME_ISC | DCMI_ICR_OVR_ISC | DCMI_ICR_ERR_ISC \
+                               | DCMI_ICR_VSYNC_ISC | DCMI_ICR_LINE_ISC)
+
+/* Raw continuous frames are delimited by the DMA transfers,
+ * JPEG and snapshot frames by the frame capture interrupt */
+#define DCMI_DMA_DELIMITED(HANDLE)  \
+    (((HANDLE)->Inst->CR.w & (DCMI_CR_CM | DCMI_CR_JPEG)) == 0)
+
+/* Publishes the captured frame to the application */
+static void DCMI_prvFrameDone(DCMI_HandleType * pxDCMI, uint32_t * pulFrame, uint32_t ulLength)
+{
+    /* The previous frame is overwritten before the application has processed it */
+    if (pxDCMI->Frame != NULL)
+    {
+        pxDCMI->Statistics.Dropped++;
+    }
+
+    pxDCMI->Frame       = pulFrame;
+    pxDCMI->FrameLength = ulLength;
+    pxDCMI->Statistics.Frames++;
+
+    XPD_SAFE_CALLBACK(pxDCMI->Callbacks.Frame, pxDCMI);
+}
+
+/* Restarts the frame transfer to the active buffer, the capture resumes with the next frame */
+static void DCMI_prvRestart(DCMI_HandleType * pxDCMI)
+{
+    DCMI_REG_BIT(pxDCMI, CR, CAPTURE) = 0;
+
+    DMA_vStop(pxDCMI->DMA);
+    (void) DMA_eStart_IT(pxDCMI->DMA, (void*)&pxDCMI->Inst->DR.w,
+            pxDCMI->Stream.Buffer[pxDCMI->Stream.Active], pxDCMI->Stream.Length);
+    if (pxDCMI->Stream.Buffer[1] != NULL)
+    {
+        DMA_vSetSwapMemory(pxDCMI->DMA, pxDCMI->Stream.Buffer[1 - pxDCMI->Stream.Active]);
+    }
+
+    DCMI_REG_BIT(pxDCMI, CR, CAPTURE) = 1;
+}
+
+/* Handles the end of a JPEG or snapshot frame */
+static void DCMI_prvFrameEnd(DCMI_HandleType * pxDCMI)
+{
+    uint8_t ucDone = pxDCMI->Stream.Active;
+    uint16_t usLeft = DMA_usGetStatus(pxDCMI->DMA);
+
+    DMA_vStop_IT(pxDCMI->DMA);
+
+    /* The variable length frame filled the whole buffer, it's probably truncated */
+    if ((usLeft == 0) && (DCMI_REG_BIT(pxDCMI, CR, JPEG) != 0))
+    {
+        pxDCMI->Errors |= DCMI_ERROR_SIZE;
+    }
+
+    /* Continue capturing to the other buffer */
+    if (DCMI_REG_BIT(pxDCMI, CR, CM) == DCMI_CAPTURE_CONTINUOUS)
+    {
+        if (pxDCMI->Stream.Buffer[1] != NULL)
+        {
+            pxDCMI->Stream.Active = 1 - ucDone;
+        }
+        (void) DMA_eStart_IT(pxDCMI->DMA, (void*)&pxDCMI->Inst->DR.w,
+                pxDCMI->Stream.Buffer[pxDCMI->Stream.Active], pxDCMI->Stream.Length);
+    }
+
+    DCMI_prvFrameDone(pxDCMI, pxDCMI->Stream.Buffer[ucDone],
+            (pxDCMI->Stream.Length - usLeft) * sizeof(uint32_t));
+}
+
+static void DCMI_prvDmaRedirect(void * pxDMA)
+{
+    DCMI_HandleType * pxDCMI = (DCMI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+    uint8_t ucDone = pxDCMI->Stream.Active;
+
+    /* In double buffer mode the DMA has already switched to the other buffer */
+    pxDCMI->Stream.Active = DMA_ulActiveMemory(pxDMA);
+
+    DCMI_prvFrameDone(pxDCMI, pxDCMI->Stream.Buffer[ucDone],
+            pxDCMI->Stream.Length * sizeof(uint32_t));
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void DCMI_prvDmaErrorRedirect(void * pxDMA)
+{
+    DCMI_HandleType * pxDCMI = (DCMI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* Update error code */
+    pxDCMI->Errors |= DCMI_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxDCMI->Callbacks.Error, pxDCMI);
+}
+#endif
+
+/** @defgroup DCMI_Exported_Functions DCMI Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the DCMI peripheral using the setup configuration.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ * @param pxConfig: DCMI setup configuration
+ */
+void DCMI_vInit(DCMI_HandleType * pxDCMI, const DCMI_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_DCMI);
+
+    pxDCMI->Inst->CR.w =
+              ((pxConfig->SyncMode == DCMI_SYNC_EMBEDDED) ? DCMI_CR_ESS : 0)
+            | ((pxConfig->PixelClockEdge == EDGE_RISING) ? DCMI_CR_PCKPOL : 0)
+            | ((pxConfig->HSyncBlanking == ACTIVE_HIGH) ? DCMI_CR_HSPOL : 0)
+            | ((pxConfig->VSyncBlanking == ACTIVE_HIGH) ? DCMI_CR_VSPOL : 0)
+            | ((pxConfig->JPEGMode != DISABLE) ? DCMI_CR_JPEG : 0)
+            | (pxConfig->FrameRate * DCMI_CR_FCRC_0)
+            | (pxConfig->DataWidth * DCMI_CR_EDM_0);
+
+    if (pxConfig->SyncMode == DCMI_SYNC_EMBEDDED)
+    {
+        pxDCMI->Inst->ESCR.w =
+                  ((uint32_t)pxConfig->EmbeddedCodes.FrameStart << DCMI_ESCR_FSC_Pos)
+                | ((uint32_t)pxConfig->EmbeddedCodes.LineStart  << DCMI_ESCR_LSC_Pos)
+                | ((uint32_t)pxConfig->EmbeddedCodes.LineEnd    << DCMI_ESCR_LEC_Pos)
+                | ((uint32_t)pxConfig->EmbeddedCodes.FrameEnd   << DCMI_ESCR_FEC_Pos);
+
+        /* All bits of the codes are compared */
+        pxDCMI->Inst->ESUR.w = 0xFFFFFFFF;
+    }
+
+    pxDCMI->Inst->IER.w = 0;
+    pxDCMI->Inst->ICR.w = DCMI_ALL_FLAGS;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxDCMI->Callbacks.DepInit, pxDCMI);
+
+    DCMI_REG_BIT(pxDCMI, CR, ENABLE) = 1;
+
+    pxDCMI->Frame              = NULL;
+    pxDCMI->FrameLength        = 0;
+    pxDCMI->Statistics.Frames  = 0;
+    pxDCMI->Statistics.Dropped = 0;
+    pxDCMI->Statistics.LastFrames = 0;
+    pxDCMI->Errors             = DCMI_ERROR_NONE;
+}
+
+/**
+ * @brief Restores the DCMI peripheral to its default inactive state.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ */
+void DCMI_vDeinit(DCMI_HandleType * pxDCMI)
+{
+    DCMI_vStop_DMA(pxDCMI);
+
+    pxDCMI->Inst->CR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxDCMI->Callbacks.DepDeinit, pxDCMI);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_DCMI);
+}
+
+/**
+ * @brief Sets up a crop window, only the data inside it is captured.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ * @param pxCrop: crop window configuration
+ */
+void DCMI_vCropConfig(DCMI_HandleType * pxDCMI, const DCMI_CropType * pxCrop)
+{
+    pxDCMI->Inst->CWSTRTR.w = ((uint32_t)pxCrop->XOffset << DCMI_CWSTRT_HOFFCNT_Pos)
+                            | ((uint32_t)pxCrop->YOffset << DCMI_CWSTRT_VST_Pos);
+    pxDCMI->Inst->CWSIZER.w = ((uint32_t)(pxCrop->Width  - 1) << DCMI_CWSIZE_CAPCNT_Pos)
+                            | ((uint32_t)(pxCrop->Height - 1) << DCMI_CWSIZE_VLINE_Pos);
+
+    DCMI_REG_BIT(pxDCMI, CR, CROP) = 1;
+}
+
+/**
+ * @brief Disables the crop window, the full frames are captured.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ */
+void DCMI_vCropDisable(DCMI_HandleType * pxDCMI)
+{
+    DCMI_REG_BIT(pxDCMI, CR, CROP) = 0;
+}
+
+/**
+ * @brief Starts capturing frames with DMA. The Frame callback is called for each captured frame,
+ *        with Frame pointing to the buffer and FrameLength to the captured length.
+ *        The capture starts at the beginning of the next frame.
+ *
+ *        In continuous mode two frame buffers allow processing one frame
+ *        while the next one is captured:
+ *        @arg For raw frames the DMA stream has to be set up in DMA_MODE_DBUFFER mode,
+ *             and the frame size has to match the captured frame exactly.
+ *        @arg For JPEG frames the DMA stream has to be set up in DMA_MODE_NORMAL mode,
+ *             and the buffers are swapped at the end of each frame.
+ *
+ *        The DMA stream has to transfer words from the peripheral.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ * @param eMode: the capture mode
+ * @param pulFrame0: pointer to the first frame buffer
+ * @param pulFrame1: pointer to the second frame buffer (continuous mode only, can be NULL)
+ * @param ulFrameSize: size of a frame buffer in bytes [4 .. 262140]
+ * @return ERROR if the frame size is invalid, BUSY if the DMA stream is in use,
+ *         OK if the capture is started
+ */
+XPD_ReturnType DCMI_eStart_DMA(
+        DCMI_HandleType *       pxDCMI,
+        DCMI_CaptureModeType    eMode,
+        uint32_t *              pulFrame0,
+        uint32_t *              pulFrame1,
+        uint32_t                ulFrameSize)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulLength = ulFrameSize / sizeof(uint32_t);
+    uint32_t ulITs = DCMI_IER_OVR_IE | DCMI_IER_ERR_IE;
+
+    if ((ulLength == 0) || (ulLength > 0xFFFF))
+    {
+        return XPD_ERROR;
+    }
+
+    DCMI_REG_BIT(pxDCMI, CR, CAPTURE) = 0;
+    DCMI_REG_BIT(pxDCMI, CR, CM) = eMode;
+
+    pxDCMI->Stream.Buffer[0] = pulFrame0;
+    pxDCMI->Stream.Buffer[1] = (eMode == DCMI_CAPTURE_CONTINUOUS) ? pulFrame1 : NULL;
+    pxDCMI->Stream.Length    = ulLength;
+    pxDCMI->Stream.Active    = 0;
+    pxDCMI->Frame            = NULL;
+    pxDCMI->FrameLength      = 0;
+    pxDCMI->Errors           = DCMI_ERROR_NONE;
+
+    /* Set the callback owner */
+    pxDCMI->DMA->Owner = pxDCMI;
+
+    /* Set the DMA transfer callbacks */
+    pxDCMI->DMA->Callbacks.Complete     = DCMI_DMA_DELIMITED(pxDCMI) ? DCMI_prvDmaRedirect : NULL;
+    pxDCMI->DMA->Callbacks.HalfComplete = NULL;
+#ifdef __XPD_DMA_ERROR_DETECT
+    pxDCMI->DMA->Callbacks.Error        = DCMI_prvDmaErrorRedirect;
+#endif
+
+    eResult = DMA_eStart_IT(pxDCMI->DMA, (void*)&pxDCMI->Inst->DR.w, pulFrame0, ulLength);
+
+    if (eResult == XPD_OK)
+    {
+        /* The second buffer is filled after the first one */
+        if (pxDCMI->Stream.Buffer[1] != NULL)
+        {
+            DMA_vSetSwapMemory(pxDCMI->DMA, pxDCMI->Stream.Buffer[1]);
+        }
+
+        if (!DCMI_DMA_DELIMITED(pxDCMI))
+        {
+            ulITs |= DCMI_IER_FRAME_IE;
+        }
+        if (pxDCMI->Callbacks.Line != NULL)
+        {
+            ulITs |= DCMI_IER_LINE_IE;
+        }
+        if (pxDCMI->Callbacks.VSync != NULL)
+        {
+            ulITs |= DCMI_IER_VSYNC_IE;
+        }
+
+        pxDCMI->Inst->ICR.w = DCMI_ALL_FLAGS;
+        pxDCMI->Inst->IER.w = ulITs;
+
+        DCMI_REG_BIT(pxDCMI, CR, CAPTURE) = 1;
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the frame capture and its DMA transfer.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ */
+void DCMI_vStop_DMA(DCMI_HandleType * pxDCMI)
+{
+    DCMI_REG_BIT(pxDCMI, CR, CAPTURE) = 0;
+
+    pxDCMI->Inst->IER.w = 0;
+
+    if (pxDCMI->DMA != NULL)
+    {
+        DMA_vStop_IT(pxDCMI->DMA);
+    }
+}
+
+/**
+ * @brief DCMI interrupt handler that provides handle callbacks.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ */
+void DCMI_vIRQHandler(DCMI_HandleType * pxDCMI)
+{
+    uint32_t ulMIS = pxDCMI->Inst->MISR.w;
+
+    /* Embedded synchronization error */
+    if ((ulMIS & DCMI_MIS_ERR_MIS) != 0)
+    {
+        DCMI_FLAG_CLEAR(pxDCMI, ERR);
+
+        pxDCMI->Errors |= DCMI_ERROR_SYNC;
+
+        XPD_SAFE_CALLBACK(pxDCMI->Callbacks.Error, pxDCMI);
+    }
+
+    /* Data overrun, the current frame is lost */
+    if ((ulMIS & DCMI_MIS_OVR_MIS) != 0)
+    {
+        DCMI_FLAG_CLEAR(pxDCMI, OVR);
+
+        pxDCMI->Errors |= DCMI_ERROR_OVERRUN;
+        pxDCMI->Statistics.Dropped++;
+
+        /* Realign the DMA to the frame start */
+        if (DCMI_DMA_DELIMITED(pxDCMI))
+        {
+            DCMI_prvRestart(pxDCMI);
+        }
+
+        XPD_SAFE_CALLBACK(pxDCMI->Callbacks.Error, pxDCMI);
+    }
+
+    /* Line captured */
+    if ((ulMIS & DCMI_MIS_LINE_MIS) != 0)
+    {
+        DCMI_FLAG_CLEAR(pxDCMI, LINE);
+
+        XPD_SAFE_CALLBACK(pxDCMI->Callbacks.Line, pxDCMI);
+    }
+
+    /* Frame synchronization */
+    if ((ulMIS & DCMI_MIS_VSYNC_MIS) != 0)
+    {
+        DCMI_FLAG_CLEAR(pxDCMI, VSYNC);
+
+        XPD_SAFE_CALLBACK(pxDCMI->Callbacks.VSync, pxDCMI);
+    }
+
+    /* Frame captured */
+    if ((ulMIS & DCMI_MIS_FRAME_MIS) != 0)
+    {
+        DCMI_FLAG_CLEAR(pxDCMI, FRAME);
+
+        DCMI_prvFrameEnd(pxDCMI);
+    }
+}
+
+/**
+ * @brief Calculates the average frame rate since the previous call.
+ * @param pxDCMI: pointer to the DCMI handle structure
+ * @param ulInterval_ms: the time elapsed since the previous call in ms
+ * @return The captured frames per 1000 seconds
+ */
+uint32_t DCMI_ulFrameRate_mHz(DCMI_HandleType * pxDCMI, uint32_t ulInterval_ms)
+{
+    uint32_t ulFrames = pxDCMI->Statistics.Frames;
+    uint32_t ulRate = 0;
+
+    if (ulInterval_ms != 0)
+    {
+        ulRate = (uint32_t)(((uint64_t)(ulFrames - pxDCMI->Statistics.LastFrames) * 1000000)
+                / ulInterval_ms);
+    }
+    pxDCMI->Statistics.LastFrames = ulFrames;
+
+    return ulRate;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* DCMI */
@@ -23,7 +23,7 @@
 
 #include <xpd_exti.h>
 
-XPD_ValueCallbackType EXTI_xPinCallbacks[16] = {
+XPD_ValueCallbackType EXTI_xPinCallbacks[16] XPD_FAST_DATA = {
         NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
         NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
 };
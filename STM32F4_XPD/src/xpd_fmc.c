@@ -0,0 +1,367 @@
+/**
+  ******************************************************************************
+  * @file    xpd_fmc.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Flexible Memory Controller Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_fmc.h>
+#include <xpd_utils.h>
+
+#if defined(FMC_Bank1)
+
+/** @addtogroup FMC
+ * @{ */
+
+/* The NOR/PSRAM register layout is common to FMC and FSMC */
+#define FMC_BCR_MBKEN               0x00000001U
+#define FMC_BCR_MTYP_Pos            2
+#define FMC_BCR_MWID_Pos            4
+#define FMC_BCR_FACCEN              0x00000040U
+#define FMC_BCR_WREN                0x00001000U
+#define FMC_BCR_EXTMOD              0x00004000U
+#define FMC_BCR_CONFIG_MSK          0x0008FF7FU
+
+#define FMC_BTR_ADDHLD_Pos          4
+#define FMC_BTR_DATAST_Pos          8
+#define FMC_BTR_BUSTURN_Pos         16
+#define FMC_BTR_TIMING_MSK          0x300FFFFFU
+
+#define FMC_BCR_RESET_VALUE(BANK)   (((BANK) == FMC_SRAM_BANK1) ? 0x000030DBU : 0x000030D2U)
+#define FMC_BTR_RESET_VALUE         0x0FFFFFFFU
+
+/* Converts a duration to clock cycles, rounding up and saturating to the field range */
+static uint32_t FMC_prvCycles(uint32_t ulTime_ns, uint32_t ulClock_Hz, uint32_t ulMin, uint32_t ulMax)
+{
+    uint32_t ulCycles = (uint32_t)(((uint64_t)ulTime_ns * ulClock_Hz + 999999999UL) / 1000000000UL);
+
+    if (ulCycles < ulMin)
+    {
+        ulCycles = ulMin;
+    }
+    else if (ulCycles > ulMax)
+    {
+        ulCycles = ulMax;
+    }
+    return ulCycles;
+}
+
+/* Calculates the timing register value of an asynchronous access */
+static uint32_t FMC_prvSRAM_Timing(const FMC_SRAM_TimingType * pxTiming, uint32_t ulHCLK_Hz)
+{
+    return (FMC_prvCycles(pxTiming->AddressSetup_ns,  ulHCLK_Hz, 0, 15))
+         | (FMC_prvCycles(pxTiming->AddressHold_ns,   ulHCLK_Hz, 1, 15)  << FMC_BTR_ADDHLD_Pos)
+         | (FMC_prvCycles(pxTiming->DataSetup_ns,     ulHCLK_Hz, 1, 255) << FMC_BTR_DATAST_Pos)
+         | (FMC_prvCycles(pxTiming->BusTurnaround_ns, ulHCLK_Hz, 0, 15)  << FMC_BTR_BUSTURN_Pos);
+}
+
+/** @defgroup FMC_SRAM_Exported_Functions FMC SRAM Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes an FMC NOR/PSRAM subbank for asynchronous access.
+ * @note  The access timings are calculated from the current HCLK frequency,
+ *        therefore this function shall be called after the clock setup.
+ *        The GPIO configuration of the memory interface is not performed here.
+ * @param eBank: the selected subbank
+ * @param pxConfig: pointer to the memory setup configuration
+ */
+void FMC_vSRAM_Init(FMC_SRAM_BankType eBank, const FMC_SRAM_InitType * pxConfig)
+{
+    uint32_t ulHCLK_Hz = RCC_ulClockFreq_Hz(HCLK);
+    uint32_t ulBCR;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_FMC);
+
+    /* Disable the bank while it's being configured */
+    FMC_Bank1->BCTR[eBank].BCR.w &= ~FMC_BCR_MBKEN;
+
+    ulBCR = FMC_Bank1->BCTR[eBank].BCR.w & ~FMC_BCR_CONFIG_MSK;
+    ulBCR |= ((uint32_t)pxConfig->MemoryType << FMC_BCR_MTYP_Pos)
+           | ((uint32_t)pxConfig->BusWidth   << FMC_BCR_MWID_Pos);
+
+    if (pxConfig->MemoryType == FMC_MEMORY_NOR)
+    {
+        ulBCR |= FMC_BCR_FACCEN;
+    }
+    if (pxConfig->WriteEnable != DISABLE)
+    {
+        ulBCR |= FMC_BCR_WREN;
+    }
+
+    FMC_Bank1->BCTR[eBank].BTR.w = (FMC_Bank1->BCTR[eBank].BTR.w & ~FMC_BTR_TIMING_MSK)
+            | FMC_prvSRAM_Timing(&pxConfig->ReadTiming, ulHCLK_Hz);
+
+    if (pxConfig->ExtendedMode != DISABLE)
+    {
+        ulBCR |= FMC_BCR_EXTMOD;
+
+        FMC_Bank1E->BWTR[eBank * 2].w = (FMC_Bank1E->BWTR[eBank * 2].w & ~FMC_BTR_TIMING_MSK)
+                | FMC_prvSRAM_Timing(&pxConfig->WriteTiming, ulHCLK_Hz);
+    }
+
+    FMC_Bank1->BCTR[eBank].BCR.w = ulBCR | FMC_BCR_MBKEN;
+}
+
+/**
+ * @brief Restores an FMC NOR/PSRAM subbank to its default inactive state.
+ * @param eBank: the selected subbank
+ */
+void FMC_vSRAM_Deinit(FMC_SRAM_BankType eBank)
+{
+    FMC_Bank1->BCTR[eBank].BCR.w = FMC_BCR_RESET_VALUE(eBank);
+    FMC_Bank1->BCTR[eBank].BTR.w = FMC_BTR_RESET_VALUE;
+    FMC_Bank1E->BWTR[eBank * 2].w = FMC_BTR_RESET_VALUE;
+}
+
+/** @} */
+
+#ifdef FMC_Bank5_6
+
+#define FMC_SDRAM_TIMEOUT           5
+
+#define FMC_SDRAM_CMD_NORMAL        0
+#define FMC_SDRAM_CMD_CLK_ENABLE    1
+#define FMC_SDRAM_CMD_PALL          2
+#define FMC_SDRAM_CMD_AUTOREFRESH   3
+#define FMC_SDRAM_CMD_LOAD_MODE     4
+#define FMC_SDRAM_CMD_SELFREFRESH   5
+
+#define FMC_SDRAM_AUTOREFRESH_COUNT 8
+
+/* SDRAM mode register: burst length 1, sequential, single location write access */
+#define FMC_SDRAM_MODE_REG(CAS)     (((uint32_t)(CAS) << 4) | 0x200)
+
+/* The refresh counter has to be reduced to compensate the latency of pending accesses */
+#define FMC_SDRAM_REFRESH_MARGIN    20
+#define FMC_SDRAM_REFRESH_MIN       41
+
+/* Issues an SDRAM command and waits until it's accepted */
+static XPD_ReturnType FMC_prvSDRAM_Command(
+        FMC_SDRAM_BankType  eBank,
+        uint32_t            ulMode,
+        uint32_t            ulRefreshCount,
+        uint32_t            ulModeRegister)
+{
+    uint32_t ulTimeout = FMC_SDRAM_TIMEOUT;
+
+    FMC_Bank5_6->SDCMR.w = (ulMode                 << FMC_SDCMR_MODE_Pos)
+                         | ((FMC_SDCMR_CTB1 >> eBank) & (FMC_SDCMR_CTB1 | FMC_SDCMR_CTB2))
+                         | ((ulRefreshCount - 1)   << FMC_SDCMR_NRFS_Pos)
+                         | (ulModeRegister         << FMC_SDCMR_MRD_Pos);
+
+    return XPD_eWaitForMatch(&FMC_Bank5_6->SDSR.w, FMC_SDSR_BUSY, 0, &ulTimeout);
+}
+
+/** @defgroup FMC_SDRAM_Exported_Functions FMC SDRAM Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes an FMC SDRAM bank, performs the memory initialization sequence
+ *        and sets up the refresh rate.
+ * @note  The access timings are calculated from the current HCLK frequency,
+ *        therefore this function shall be called after the clock setup.
+ *        The GPIO configuration of the memory interface is not performed here.
+ * @param eBank: the selected SDRAM bank
+ * @param pxConfig: pointer to the memory setup configuration
+ * @return TIMEOUT if the memory doesn't accept a command, OK if the memory is ready for use
+ */
+XPD_ReturnType FMC_eSDRAM_Init(FMC_SDRAM_BankType eBank, const FMC_SDRAM_InitType * pxConfig)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulSDCLK_Hz = RCC_ulClockFreq_Hz(HCLK) / pxConfig->ClockDivider;
+    uint32_t ulCommon, ulSDCR, ulSDTR, ulRefresh;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_FMC);
+
+    /* Clock, burst and pipe settings are only taken from the bank 1 register */
+    ulCommon = ((uint32_t)pxConfig->ClockDivider  << FMC_SDCR1_SDCLK_Pos)
+             | ((uint32_t)pxConfig->ReadBurst     << FMC_SDCR1_RBURST_Pos)
+             | ((uint32_t)pxConfig->ReadPipeDelay << FMC_SDCR1_RPIPE_Pos);
+
+    ulSDCR = ((uint32_t)(pxConfig->ColumnBits - 8)   << FMC_SDCR1_NC_Pos)
+           | ((uint32_t)(pxConfig->RowBits - 11)     << FMC_SDCR1_NR_Pos)
+           | ((uint32_t)pxConfig->BusWidth           << FMC_SDCR1_MWID_Pos)
+           | ((uint32_t)(pxConfig->InternalBanks / 4) << FMC_SDCR1_NB_Pos)
+           | ((uint32_t)pxConfig->CASLatency         << FMC_SDCR1_CAS_Pos)
+           | ((uint32_t)pxConfig->WriteProtect       << FMC_SDCR1_WP_Pos);
+
+    /* Timing fields are programmed as cycles - 1 */
+    ulSDTR = ((uint32_t)(pxConfig->Timing.LoadToActive_clk - 1) << FMC_SDTR1_TMRD_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.ExitSelfRefresh_ns, ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TXSR_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.SelfRefresh_ns,     ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TRAS_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.RowCycle_ns,        ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TRC_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.WriteRecovery_ns,   ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TWR_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.RowPrecharge_ns,    ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TRP_Pos)
+           | ((FMC_prvCycles(pxConfig->Timing.RowToColumn_ns,     ulSDCLK_Hz, 1, 16) - 1) << FMC_SDTR1_TRCD_Pos);
+
+    if (eBank == FMC_SDRAM_BANK1)
+    {
+        FMC_Bank5_6->SDCR[0].w = ulSDCR | ulCommon;
+        FMC_Bank5_6->SDTR[0].w = ulSDTR;
+    }
+    else
+    {
+        /* Row cycle and precharge delays are also only taken from the bank 1 register */
+        MODIFY_REG(FMC_Bank5_6->SDCR[0].w, FMC_SDCR1_SDCLK | FMC_SDCR1_RBURST | FMC_SDCR1_RPIPE, ulCommon);
+        MODIFY_REG(FMC_Bank5_6->SDTR[0].w, FMC_SDTR1_TRC | FMC_SDTR1_TRP,
+                ulSDTR & (FMC_SDTR1_TRC | FMC_SDTR1_TRP));
+
+        FMC_Bank5_6->SDCR[1].w = ulSDCR;
+        FMC_Bank5_6->SDTR[1].w = ulSDTR;
+    }
+
+    /* Power-up sequence: start SDCLK, wait at least 100 us */
+    eResult = FMC_prvSDRAM_Command(eBank, FMC_SDRAM_CMD_CLK_ENABLE, 1, 0);
+    if (eResult != XPD_OK)
+    {
+        return eResult;
+    }
+    XPD_vDelay_ms(1);
+
+    eResult = FMC_prvSDRAM_Command(eBank, FMC_SDRAM_CMD_PALL, 1, 0);
+    if (eResult != XPD_OK)
+    {
+        return eResult;
+    }
+
+    eResult = FMC_prvSDRAM_Command(eBank, FMC_SDRAM_CMD_AUTOREFRESH,
+            FMC_SDRAM_AUTOREFRESH_COUNT, 0);
+    if (eResult != XPD_OK)
+    {
+        return eResult;
+    }
+
+    eResult = FMC_prvSDRAM_Command(eBank, FMC_SDRAM_CMD_LOAD_MODE, 1,
+            FMC_SDRAM_MODE_REG(pxConfig->CASLatency));
+    if (eResult != XPD_OK)
+    {
+        return eResult;
+    }
+
+    /* Refresh rate = refresh period / rows * SDCLK - margin */
+    ulRefresh = (uint32_t)(((uint64_t)pxConfig->RefreshPeriod_ms * ulSDCLK_Hz)
+            / (1000UL * pxConfig->RefreshRows)) - FMC_SDRAM_REFRESH_MARGIN;
+    if (ulRefresh < FMC_SDRAM_REFRESH_MIN)
+    {
+        ulRefresh = FMC_SDRAM_REFRESH_MIN;
+    }
+    else if (ulRefresh > (FMC_SDRTR_COUNT >> FMC_SDRTR_COUNT_Pos))
+    {
+        ulRefresh = FMC_SDRTR_COUNT >> FMC_SDRTR_COUNT_Pos;
+    }
+
+    /* The refresh timer is common to both banks */
+    MODIFY_REG(FMC_Bank5_6->SDRTR.w, FMC_SDRTR_COUNT, ulRefresh << FMC_SDRTR_COUNT_Pos);
+
+    return eResult;
+}
+
+/**
+ * @brief Restores an FMC SDRAM bank to its default inactive state.
+ * @param eBank: the selected SDRAM bank
+ */
+void FMC_vSDRAM_Deinit(FMC_SDRAM_BankType eBank)
+{
+    FMC_Bank5_6->SDCR[eBank].w = 0x000002D0;
+    FMC_Bank5_6->SDTR[eBank].w = 0x0FFFFFFF;
+}
+
+/**
+ * @brief Puts the SDRAM bank to self-refresh mode, where the memory content is
+ *        retained without the controller's activity, or restores normal mode.
+ * @param eBank: the selected SDRAM bank
+ * @param eNewState: ENABLE to enter, DISABLE to exit self-refresh mode
+ * @return TIMEOUT if the memory doesn't accept the command, OK if successful
+ */
+XPD_ReturnType FMC_eSDRAM_SelfRefresh(FMC_SDRAM_BankType eBank, FunctionalState eNewState)
+{
+    return FMC_prvSDRAM_Command(eBank,
+            (eNewState != DISABLE) ? FMC_SDRAM_CMD_SELFREFRESH : FMC_SDRAM_CMD_NORMAL, 1, 0);
+}
+
+/** @} */
+
+#endif /* FMC_Bank5_6 */
+
+static uint8_t * FMC_pucHeapNext = NULL;
+static uint8_t * FMC_pucHeapEnd  = NULL;
+
+/** @defgroup FMC_Heap_Exported_Functions FMC Heap Exported Functions
+ * @{ */
+
+/**
+ * @brief Assigns an initialized external memory area for allocation of large buffers
+ *        (e.g. frame buffers, sample buffers) that are kept for the whole runtime.
+ * @param pvStart: start address of the available memory area
+ * @param ulSize: size of the available memory area in bytes
+ */
+void FMC_vHeapInit(void * pvStart, uint32_t ulSize)
+{
+    FMC_pucHeapNext = pvStart;
+    FMC_pucHeapEnd  = FMC_pucHeapNext + ulSize;
+}
+
+/**
+ * @brief Allocates a buffer from the external memory area. The allocated buffers cannot be freed.
+ * @param ulSize: requested buffer size in bytes
+ * @param ulAlignment: the required buffer address alignment in bytes (power of 2)
+ * @return Address of the allocated buffer, or NULL if there isn't enough free memory
+ */
+void * FMC_pvHeapAlloc(uint32_t ulSize, uint32_t ulAlignment)
+{
+    void * pvBuffer = NULL;
+    uint8_t * pucStart;
+
+    if (ulAlignment == 0)
+    {
+        ulAlignment = sizeof(uint32_t);
+    }
+
+    XPD_ENTER_CRITICAL(NULL);
+
+    pucStart = (uint8_t*)(((uint32_t)FMC_pucHeapNext + ulAlignment - 1) & ~(ulAlignment - 1));
+
+    if ((FMC_pucHeapNext != NULL) && (pucStart <= FMC_pucHeapEnd) &&
+        (ulSize <= (uint32_t)(FMC_pucHeapEnd - pucStart)))
+    {
+        FMC_pucHeapNext = pucStart + ulSize;
+        pvBuffer = pucStart;
+    }
+
+    XPD_EXIT_CRITICAL(NULL);
+
+    return pvBuffer;
+}
+
+/**
+ * @brief Gets the remaining free memory of the external memory area.
+ * @return The amount of unallocated bytes
+ */
+uint32_t FMC_ulHeapFree(void)
+{
+    return (uint32_t)(FMC_pucHeapEnd - FMC_pucHeapNext);
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* FMC_Bank1 */
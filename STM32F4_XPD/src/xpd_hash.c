@@ -0,0 +1,462 @@
+/**
+  ******************************************************************************
+  * @file    xpd_hash.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Hash Processor Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_hash.h>
+#include <xpd_utils.h>
+
+#if defined(HASH)
+
+/** @addtogroup HASH
+ * @{ */
+
+#define HASH_HMAC_LONG_KEY_SIZE     64
+
+/* Maximum time of a digest calculation after the last data is written */
+#define HASH_DIGEST_TIMEOUT         1
+
+#define HASH_QUEUE_MASK             (HASH_QUEUE_LENGTH - 1)
+
+#define HASH_ACTIVE_REQUEST(HANDLE)     \
+    ((HANDLE)->Queue.Items[(HANDLE)->Queue.Head & HASH_QUEUE_MASK])
+
+static void HASH_prvStartRequest(HASH_HandleType * pxHASH);
+
+/* Writes the HMAC key by the CPU and waits for its processing */
+static XPD_ReturnType HASH_prvFeedKey(HASH_HandleType * pxHASH)
+{
+    const uint8_t * pucKey = pxHASH->Config.Key;
+    uint32_t ulTimeout = HASH_DIGEST_TIMEOUT;
+    uint32_t i;
+
+    pxHASH->Inst->STR.w = 8 * (pxHASH->Config.KeyLength % sizeof(uint32_t));
+
+    for (i = 0; i < pxHASH->Config.KeyLength; i += sizeof(uint32_t))
+    {
+        uint32_t ulWord = 0, j;
+
+        /* Memory byte order, the input is swapped by the processor */
+        for (j = 0; (j < sizeof(uint32_t)) && ((i + j) < pxHASH->Config.KeyLength); j++)
+        {
+            ulWord |= (uint32_t)pucKey[i + j] << (8 * j);
+        }
+        pxHASH->Inst->DIN = ulWord;
+    }
+
+    HASH_FLAG_CLEAR(pxHASH, DCIS);
+    HASH_REG_BIT(pxHASH, STR, DCAL) = 1;
+
+    return XPD_eWaitForMatch(&pxHASH->Inst->SR.w, HASH_SR_BUSY, 0, &ulTimeout);
+}
+
+/* Waits for the end of the message processing and reads out the digest */
+static XPD_ReturnType HASH_prvFinish(HASH_HandleType * pxHASH, uint8_t * pucDigest)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    uint32_t ulTimeout = HASH_DIGEST_TIMEOUT;
+    volatile uint32_t * pulHR = pxHASH->Inst->HR;
+    uint32_t i, ulSize = HASH_ucDigestSize(pxHASH);
+
+    /* HMAC outer hash over the key and the inner digest */
+    if ((pxHASH->Inst->CR.w & HASH_CR_MODE) != 0)
+    {
+        eResult = XPD_eWaitForMatch(&pxHASH->Inst->SR.w, HASH_SR_BUSY, 0, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            eResult = HASH_prvFeedKey(pxHASH);
+        }
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = XPD_eWaitForMatch(&pxHASH->Inst->SR.w, HASH_SR_DCIS, HASH_SR_DCIS, &ulTimeout);
+    }
+
+#ifdef HASH_CR_ALGO_1
+    /* The extended digest registers are needed beyond 160 bits */
+    if (ulSize > sizeof(pxHASH->Inst->HR))
+    {
+        pulHR = HASH_DIGEST->HR;
+    }
+#endif
+
+    for (i = 0; (i < ulSize) && (eResult == XPD_OK); i += sizeof(uint32_t))
+    {
+        uint32_t ulWord = pulHR[i / sizeof(uint32_t)];
+
+        pucDigest[i + 0] = (uint8_t)(ulWord >> 24);
+        pucDigest[i + 1] = (uint8_t)(ulWord >> 16);
+        pucDigest[i + 2] = (uint8_t)(ulWord >> 8);
+        pucDigest[i + 3] = (uint8_t)(ulWord);
+    }
+
+    pxHASH->Message = 0;
+
+    if (eResult != XPD_OK)
+    {
+        pxHASH->Errors |= HASH_ERROR_TIMEOUT;
+        eResult = XPD_ERROR;
+    }
+    return eResult;
+}
+
+/* Disables the DMA interface */
+static void HASH_prvStopData(HASH_HandleType * pxHASH)
+{
+    if (HASH_REG_BIT(pxHASH, CR, DMAE) != 0)
+    {
+        HASH_REG_BIT(pxHASH, CR, DMAE) = 0;
+
+        DMA_vStop_IT(pxHASH->DMA.Input);
+    }
+}
+
+/* Finishes the active request and starts the next one */
+static void HASH_prvCompleteRequest(HASH_HandleType * pxHASH, XPD_ReturnType eResult)
+{
+    HASH_RequestType * pxRequest = HASH_ACTIVE_REQUEST(pxHASH);
+
+    pxHASH->Queue.Head++;
+    pxRequest->Result = eResult;
+
+    /* A failed message cannot be continued */
+    if (eResult != XPD_OK)
+    {
+        pxHASH->Message = 0;
+    }
+
+    /* Continue with the next request before notifying, so that
+     * requests submitted from the callbacks are only queued */
+    if (pxHASH->Queue.Head != pxHASH->Queue.Tail)
+    {
+        HASH_prvStartRequest(pxHASH);
+    }
+
+    if (eResult != XPD_OK)
+    {
+        XPD_SAFE_CALLBACK(pxHASH->Callbacks.Error, pxHASH);
+    }
+
+    XPD_SAFE_CALLBACK(pxRequest->Callback, pxRequest);
+
+    if (pxHASH->Queue.Head == pxHASH->Queue.Tail)
+    {
+        XPD_SAFE_CALLBACK(pxHASH->Callbacks.QueueEmpty, pxHASH);
+    }
+}
+
+static void HASH_prvDmaRedirect(void * pxDMA)
+{
+    HASH_HandleType * pxHASH = (HASH_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+    HASH_RequestType * pxRequest = HASH_ACTIVE_REQUEST(pxHASH);
+    XPD_ReturnType eResult = XPD_OK;
+
+    HASH_prvStopData(pxHASH);
+
+    /* The digest calculation is started automatically after the last word */
+    if (pxRequest->Digest != NULL)
+    {
+        eResult = HASH_prvFinish(pxHASH, pxRequest->Digest);
+    }
+
+    HASH_prvCompleteRequest(pxHASH, eResult);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void HASH_prvDmaErrorRedirect(void * pxDMA)
+{
+    HASH_HandleType * pxHASH = (HASH_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxHASH->Errors |= HASH_ERROR_DMA;
+
+    HASH_prvStopData(pxHASH);
+
+    HASH_prvCompleteRequest(pxHASH, XPD_ERROR);
+}
+#endif
+
+/* Initializes the message if necessary and streams the request data */
+static void HASH_prvStartRequest(HASH_HandleType * pxHASH)
+{
+    HASH_RequestType * pxRequest = HASH_ACTIVE_REQUEST(pxHASH);
+    XPD_ReturnType eResult = XPD_OK;
+
+    if (pxHASH->Message == 0)
+    {
+        pxHASH->Inst->CR.w = pxHASH->Config.Mode | HASH_CR_INIT;
+        pxHASH->Message = 1;
+
+        if ((pxHASH->Config.Mode & HASH_CR_MODE) != 0)
+        {
+            eResult = HASH_prvFeedKey(pxHASH);
+
+            if (eResult != XPD_OK)
+            {
+                pxHASH->Errors |= HASH_ERROR_TIMEOUT;
+            }
+        }
+    }
+
+    if (eResult == XPD_OK)
+    {
+        if (pxRequest->Length > 0)
+        {
+            DMA_HandleType * pxDMA = pxHASH->DMA.Input;
+            uint32_t ulCR = pxHASH->Inst->CR.w & ~(HASH_CR_INIT | HASH_CR_MDMAT);
+
+            if (pxRequest->Digest != NULL)
+            {
+                /* Valid bits of the last word */
+                pxHASH->Inst->STR.w = 8 * (pxRequest->Length % sizeof(uint32_t));
+                HASH_FLAG_CLEAR(pxHASH, DCIS);
+            }
+            else
+            {
+                /* Further DMA transfers will follow */
+                ulCR |= HASH_CR_MDMAT;
+            }
+
+            /* Set the callback owner */
+            pxDMA->Owner = pxHASH;
+
+            /* Set the DMA transfer callbacks */
+            pxDMA->Callbacks.Complete = HASH_prvDmaRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+            pxDMA->Callbacks.Error    = HASH_prvDmaErrorRedirect;
+#endif
+
+            eResult = DMA_eStart_IT(pxDMA, (void*)&pxHASH->Inst->DIN, (void*)pxRequest->Data,
+                    (pxRequest->Length + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+
+            if (eResult == XPD_OK)
+            {
+                pxHASH->Inst->CR.w = ulCR | HASH_CR_DMAE;
+                return;
+            }
+            pxHASH->Errors |= HASH_ERROR_DMA;
+        }
+        else if (pxRequest->Digest != NULL)
+        {
+            /* Close the message without further data */
+            pxHASH->Inst->STR.w = 0;
+            HASH_FLAG_CLEAR(pxHASH, DCIS);
+            HASH_REG_BIT(pxHASH, STR, DCAL) = 1;
+
+            eResult = HASH_prvFinish(pxHASH, pxRequest->Digest);
+        }
+    }
+
+    HASH_prvCompleteRequest(pxHASH, (eResult == XPD_OK) ? XPD_OK : XPD_ERROR);
+}
+
+/** @defgroup HASH_Exported_Functions HASH Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the HASH peripheral with the algorithm and the optional HMAC key.
+ * @note  The DMA handle has to be initialized for word transfers from memory to peripheral.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @param pxConfig: HASH setup configuration
+ */
+void HASH_vInit(HASH_HandleType * pxHASH, const HASH_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_HASH);
+
+    /* Byte data type, the message is processed in memory byte order */
+    pxHASH->Config.Mode      = pxConfig->Algorithm | HASH_CR_DATATYPE_1;
+    pxHASH->Config.Key       = pxConfig->Key;
+    pxHASH->Config.KeyLength = pxConfig->KeyLength;
+
+    if (pxConfig->Key != NULL)
+    {
+        pxHASH->Config.Mode |= HASH_CR_MODE;
+
+        if (pxConfig->KeyLength > HASH_HMAC_LONG_KEY_SIZE)
+        {
+            pxHASH->Config.Mode |= HASH_CR_LKEY;
+        }
+    }
+
+    pxHASH->Queue.Head = pxHASH->Queue.Tail = 0;
+    pxHASH->Message    = 0;
+    pxHASH->Errors     = HASH_ERROR_NONE;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxHASH->Callbacks.DepInit, pxHASH);
+
+    pxHASH->Inst->IMR.w = 0;
+}
+
+/**
+ * @brief Restores the HASH peripheral to its default inactive state.
+ * @param pxHASH: pointer to the HASH handle structure
+ */
+void HASH_vDeinit(HASH_HandleType * pxHASH)
+{
+    HASH_vAbort(pxHASH);
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxHASH->Callbacks.DepDeinit, pxHASH);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_HASH);
+}
+
+/**
+ * @brief Queues a message update request, which is started immediately if the HASH is idle.
+ *        Long messages are processed incrementally by splitting them to multiple requests,
+ *        the digest is calculated when a request with Digest output is completed.
+ *        Back-to-back requests are chained from the DMA completion.
+ * @note  The request structure and its buffers are used until the request's Result is set,
+ *        and must remain valid until then.
+ *        When requests are submitted from different interrupt priorities, XPD_ENTER_CRITICAL
+ *        has to mask the HASH DMA interrupt.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @param pxRequest: pointer to the message update request
+ * @return ERROR if the request is invalid, BUSY if the queue is full, OK if the request is queued
+ */
+XPD_ReturnType HASH_eSubmit(HASH_HandleType * pxHASH, HASH_RequestType * pxRequest)
+{
+    XPD_ReturnType eResult = XPD_BUSY;
+
+    /* Only the last part of the message may end with a partial word */
+    if (((pxRequest->Digest == NULL) && ((pxRequest->Length % sizeof(uint32_t)) != 0))
+     || (((pxRequest->Length + sizeof(uint32_t) - 1) / sizeof(uint32_t)) > 0xFFFF))
+    {
+        return XPD_ERROR;
+    }
+
+    XPD_ENTER_CRITICAL(pxHASH);
+
+    if ((uint8_t)(pxHASH->Queue.Tail - pxHASH->Queue.Head) < HASH_QUEUE_LENGTH)
+    {
+        boolean_t xIdle = (pxHASH->Queue.Head == pxHASH->Queue.Tail) ? TRUE : FALSE;
+
+        pxRequest->Result = XPD_BUSY;
+        pxHASH->Queue.Items[pxHASH->Queue.Tail & HASH_QUEUE_MASK] = pxRequest;
+        pxHASH->Queue.Tail++;
+
+        /* Start processing if no request is in progress */
+        if (xIdle != FALSE)
+        {
+            HASH_prvStartRequest(pxHASH);
+        }
+        eResult = XPD_OK;
+    }
+
+    XPD_EXIT_CRITICAL(pxHASH);
+
+    return eResult;
+}
+
+/**
+ * @brief Calculates the digest of a message and waits for the completion.
+ * @note  If a message is in progress, the data is appended to it.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @param pvData: word aligned pointer to the message
+ * @param ulLength: length of the message in bytes
+ * @param pucDigest: pointer to the digest output
+ * @param ulTimeout: the timeout in ms for the processing
+ * @return ERROR if the request is invalid or failed, BUSY if the queue is full,
+ *         TIMEOUT if the processing didn't finish in time, OK if completed
+ */
+XPD_ReturnType HASH_eCompute(
+        HASH_HandleType *   pxHASH,
+        const void *        pvData,
+        uint32_t            ulLength,
+        uint8_t *           pucDigest,
+        uint32_t            ulTimeout)
+{
+    HASH_RequestType xRequest = {
+        .Data     = pvData,
+        .Length   = ulLength,
+        .Digest   = pucDigest,
+        .Callback = NULL,
+    };
+    XPD_ReturnType eResult = HASH_eSubmit(pxHASH, &xRequest);
+
+    if (eResult == XPD_OK)
+    {
+        /* Wait until the request's result is set */
+        eResult = XPD_eWaitForResult(&xRequest.Result, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            eResult = xRequest.Result;
+        }
+        else
+        {
+            HASH_vAbort(pxHASH);
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the active processing and removes all queued requests with ERROR result.
+ * @note  The request callbacks are not called.
+ * @param pxHASH: pointer to the HASH handle structure
+ */
+void HASH_vAbort(HASH_HandleType * pxHASH)
+{
+    XPD_ENTER_CRITICAL(pxHASH);
+
+    HASH_prvStopData(pxHASH);
+
+    while (pxHASH->Queue.Head != pxHASH->Queue.Tail)
+    {
+        HASH_ACTIVE_REQUEST(pxHASH)->Result = XPD_ERROR;
+        pxHASH->Queue.Head++;
+    }
+    pxHASH->Message = 0;
+
+    XPD_EXIT_CRITICAL(pxHASH);
+}
+
+/**
+ * @brief Gets the digest size of the configured algorithm.
+ * @param pxHASH: pointer to the HASH handle structure
+ * @return The digest size in bytes
+ */
+uint8_t HASH_ucDigestSize(HASH_HandleType * pxHASH)
+{
+    switch (pxHASH->Config.Mode & HASH_CR_ALGO)
+    {
+        case HASH_ALGORITHM_MD5:
+            return 16;
+#ifdef HASH_CR_ALGO_1
+        case HASH_ALGORITHM_SHA224:
+            return 28;
+        case HASH_ALGORITHM_SHA256:
+            return 32;
+#endif
+        default:
+            return 20;
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* HASH */
@@ -0,0 +1,429 @@
+/**
+  ******************************************************************************
+  * @file    xpd_i2s.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers I2S Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_i2s.h>
+#include <xpd_utils.h>
+
+#if defined(SPI_I2SCFGR_I2SMOD)
+
+/** @addtogroup I2S
+ * @{ */
+
+/* Valid range of the (2 * I2SDIV + ODD) prescaler */
+#define I2S_PRESCALER_MIN           4
+#define I2S_PRESCALER_MAX           511
+
+/* Gets the instance which performs the transmission */
+static SPI_TypeDef * I2S_prvTxInst(I2S_HandleType * pxI2S)
+{
+    return ((pxI2S->Inst->I2SCFGR.w & SPI_I2SCFGR_I2SCFG_0) == 0) ? pxI2S->Inst : pxI2S->Ext;
+}
+
+/* Gets the instance which performs the reception */
+static SPI_TypeDef * I2S_prvRxInst(I2S_HandleType * pxI2S)
+{
+    return ((pxI2S->Inst->I2SCFGR.w & SPI_I2SCFGR_I2SCFG_0) != 0) ? pxI2S->Inst : pxI2S->Ext;
+}
+
+static void I2S_prvDmaTransmitHalfRedirect(void * pxDMA)
+{
+    I2S_HandleType * pxI2S = (I2S_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The first half of the buffer is consumed */
+    pxI2S->TxBlock = pxI2S->TxStream.Buffer;
+
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.Transmit, pxI2S);
+}
+
+static void I2S_prvDmaTransmitRedirect(void * pxDMA)
+{
+    I2S_HandleType * pxI2S = (I2S_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is consumed */
+        pxI2S->TxBlock = pxI2S->TxStream.Buffer + pxI2S->TxStream.HalfLength;
+    }
+    else
+    {
+        /* The whole buffer is consumed, end of the single transfer */
+        pxI2S->TxBlock = pxI2S->TxStream.Buffer;
+
+        CLEAR_BIT(I2S_prvTxInst(pxI2S)->CR2.w, SPI_CR2_TXDMAEN);
+    }
+
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.Transmit, pxI2S);
+}
+
+static void I2S_prvDmaReceiveHalfRedirect(void * pxDMA)
+{
+    I2S_HandleType * pxI2S = (I2S_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The first half of the buffer is filled */
+    pxI2S->RxBlock = pxI2S->RxStream.Buffer;
+
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.Receive, pxI2S);
+}
+
+static void I2S_prvDmaReceiveRedirect(void * pxDMA)
+{
+    I2S_HandleType * pxI2S = (I2S_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is filled */
+        pxI2S->RxBlock = pxI2S->RxStream.Buffer + pxI2S->RxStream.HalfLength;
+    }
+    else
+    {
+        /* The whole buffer is filled, end of the single transfer */
+        pxI2S->RxBlock = pxI2S->RxStream.Buffer;
+
+        CLEAR_BIT(I2S_prvRxInst(pxI2S)->CR2.w, SPI_CR2_RXDMAEN);
+    }
+
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.Receive, pxI2S);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void I2S_prvDmaErrorRedirect(void * pxDMA)
+{
+    I2S_HandleType * pxI2S = (I2S_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* Update error code */
+    pxI2S->Errors |= I2S_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.Error, pxI2S);
+}
+#endif
+
+/* Starts the DMA stream of an instance's data register */
+static XPD_ReturnType I2S_prvStart_DMA(
+        I2S_HandleType *    pxI2S,
+        SPI_TypeDef *       pxInst,
+        DMA_HandleType *    pxDMA,
+        void *              pvBuffer,
+        uint16_t            usLength)
+{
+    XPD_ReturnType eResult = DMA_eStart_IT(pxDMA, (void*)&pxInst->DR, pvBuffer, usLength);
+
+    if (eResult == XPD_OK)
+    {
+        /* Set the callback owner */
+        pxDMA->Owner = pxI2S;
+
+#ifdef __XPD_DMA_ERROR_DETECT
+        pxDMA->Callbacks.Error = I2S_prvDmaErrorRedirect;
+#endif
+
+        /* In circular mode each buffer half is a block */
+        if (DMA_eCircularMode(pxDMA) != 0)
+        {
+            DMA_IT_ENABLE(pxDMA, HT);
+        }
+    }
+    return eResult;
+}
+
+/* Clears the error flags of an instance and collects them */
+static void I2S_prvCheckErrors(I2S_HandleType * pxI2S, SPI_TypeDef * pxInst)
+{
+    uint32_t ulSR = pxInst->SR.w;
+
+    if ((ulSR & SPI_SR_OVR) != 0)
+    {
+        /* Overrun is cleared by reading DR, then SR */
+        (void) pxInst->DR;
+        (void) pxInst->SR.w;
+
+        pxI2S->Errors |= I2S_ERROR_OVERRUN;
+    }
+
+    /* Underrun and frame errors are cleared by the SR read */
+    if ((ulSR & SPI_SR_UDR) != 0)
+    {
+        pxI2S->Errors |= I2S_ERROR_UNDERRUN;
+    }
+    if ((ulSR & SPI_SR_FRE) != 0)
+    {
+        pxI2S->Errors |= I2S_ERROR_FRAME;
+    }
+}
+
+/** @defgroup I2S_Exported_Functions I2S Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the I2S peripheral using the setup configuration.
+ *        In master modes the prescaler is set to the closest match of the sample rate
+ *        using the current I2S clock (see @ref I2S_eClockConfig).
+ *        If the full-duplex extension is bound to the handle, it is configured as a slave
+ *        in the opposite direction of the main instance.
+ * @param pxI2S: pointer to the I2S handle structure
+ * @param pxConfig: I2S setup configuration
+ * @return ERROR if the sample rate cannot be produced, OK if successful
+ */
+XPD_ReturnType I2S_eInit(I2S_HandleType * pxI2S, const I2S_InitType * pxConfig)
+{
+    uint32_t ulCFGR = SPI_I2SCFGR_I2SMOD | pxConfig->Mode | pxConfig->Standard | pxConfig->Frame;
+    uint32_t ulPR = 2;
+
+    if (pxConfig->Polarity != ACTIVE_HIGH)
+    {
+        ulCFGR |= SPI_I2SCFGR_CKPOL;
+    }
+
+    if ((pxConfig->Mode & SPI_I2SCFGR_I2SCFG_1) != 0)
+    {
+        uint32_t ulSampleClock = I2S_CLOCK_RATIO(pxConfig->MasterClock, pxConfig->Frame)
+                               * pxConfig->AudioFreq;
+        uint32_t ulDiv = (I2S_ulClockFreq_Hz() + ulSampleClock / 2) / ulSampleClock;
+
+        if ((ulDiv < I2S_PRESCALER_MIN) || (ulDiv > I2S_PRESCALER_MAX))
+        {
+            return XPD_ERROR;
+        }
+
+        ulPR = (ulDiv >> 1) | ((ulDiv & 1) << SPI_I2SPR_ODD_Pos);
+
+        if (pxConfig->MasterClock != DISABLE)
+        {
+            ulPR |= SPI_I2SPR_MCKOE;
+        }
+    }
+
+    /* enable clock */
+    RCC_vClockEnable(pxI2S->CtrlPos);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.DepInit, pxI2S);
+
+    pxI2S->Inst->I2SCFGR.w = 0;
+    pxI2S->Inst->CR2.w     = 0;
+    pxI2S->Inst->I2SPR.w   = ulPR;
+    pxI2S->Inst->I2SCFGR.w = ulCFGR;
+
+    if (pxI2S->Ext != NULL)
+    {
+        /* The extension is always a slave of the opposite direction */
+        ulCFGR &= ~SPI_I2SCFGR_I2SCFG;
+        if ((pxConfig->Mode & SPI_I2SCFGR_I2SCFG_0) == 0)
+        {
+            ulCFGR |= I2S_MODE_SLAVE_RX;
+        }
+
+        pxI2S->Ext->I2SCFGR.w = 0;
+        pxI2S->Ext->CR2.w     = 0;
+        pxI2S->Ext->I2SPR.w   = 2;
+        pxI2S->Ext->I2SCFGR.w = ulCFGR;
+    }
+
+    pxI2S->TxBlock = NULL;
+    pxI2S->RxBlock = NULL;
+    pxI2S->Errors  = I2S_ERROR_NONE;
+
+    return XPD_OK;
+}
+
+/**
+ * @brief Restores the I2S peripheral to its default inactive state.
+ * @param pxI2S: pointer to the I2S handle structure
+ */
+void I2S_vDeinit(I2S_HandleType * pxI2S)
+{
+    I2S_vStop_DMA(pxI2S);
+
+    pxI2S->Inst->I2SCFGR.w = 0;
+    if (pxI2S->Ext != NULL)
+    {
+        pxI2S->Ext->I2SCFGR.w = 0;
+    }
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxI2S->Callbacks.DepDeinit, pxI2S);
+
+    /* disable clock */
+    RCC_vClockDisable(pxI2S->CtrlPos);
+}
+
+/**
+ * @brief Starts continuous audio streaming with DMA.
+ *        When the DMA streams are in circular mode, the buffers are double buffered:
+ *        the Transmit and Receive callbacks are called at each consumed / filled half,
+ *        with TxBlock and RxBlock pointing to the half that is available to the application.
+ * @note  The data register is 16 bits wide, 24 and 32 bit samples take two half-words
+ *        with the most significant half first.
+ *        The I2S interrupt has to be enabled to report underruns and overruns.
+ * @param pxI2S: pointer to the I2S handle structure
+ * @param pvTxBuffer: pointer to the transmit buffer, NULL if not used
+ * @param pvRxBuffer: pointer to the receive buffer, NULL if not used
+ * @param usLength: length of each buffer in half-words (even in circular mode)
+ * @return BUSY if a DMA stream is in use, OK if the streaming is started
+ */
+XPD_ReturnType I2S_eStart_DMA(
+        I2S_HandleType *    pxI2S,
+        void *              pvTxBuffer,
+        void *              pvRxBuffer,
+        uint16_t            usLength)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    SPI_TypeDef * pxTxInst = I2S_prvTxInst(pxI2S);
+    SPI_TypeDef * pxRxInst = I2S_prvRxInst(pxI2S);
+
+    if ((pxTxInst == NULL) || (pvTxBuffer == NULL))
+    {
+        pxTxInst = NULL;
+    }
+    if ((pxRxInst == NULL) || (pvRxBuffer == NULL))
+    {
+        pxRxInst = NULL;
+    }
+
+    pxI2S->Errors = I2S_ERROR_NONE;
+
+    if (pxRxInst != NULL)
+    {
+        pxI2S->RxStream.Buffer     = pvRxBuffer;
+        pxI2S->RxStream.HalfLength = usLength / 2;
+        pxI2S->RxBlock             = NULL;
+
+        pxI2S->DMA.Receive->Callbacks.Complete     = I2S_prvDmaReceiveRedirect;
+        pxI2S->DMA.Receive->Callbacks.HalfComplete = I2S_prvDmaReceiveHalfRedirect;
+
+        /* Discard any stale data */
+        (void) pxRxInst->DR;
+        (void) pxRxInst->SR.w;
+
+        eResult = I2S_prvStart_DMA(pxI2S, pxRxInst, pxI2S->DMA.Receive, pvRxBuffer, usLength);
+    }
+
+    if ((eResult == XPD_OK) && (pxTxInst != NULL))
+    {
+        pxI2S->TxStream.Buffer     = pvTxBuffer;
+        pxI2S->TxStream.HalfLength = usLength / 2;
+        pxI2S->TxBlock             = NULL;
+
+        pxI2S->DMA.Transmit->Callbacks.Complete     = I2S_prvDmaTransmitRedirect;
+        pxI2S->DMA.Transmit->Callbacks.HalfComplete = I2S_prvDmaTransmitHalfRedirect;
+
+        eResult = I2S_prvStart_DMA(pxI2S, pxTxInst, pxI2S->DMA.Transmit, pvTxBuffer, usLength);
+
+        if ((eResult != XPD_OK) && (pxRxInst != NULL))
+        {
+            DMA_vStop_IT(pxI2S->DMA.Receive);
+        }
+    }
+
+    if (eResult == XPD_OK)
+    {
+        if (pxRxInst != NULL)
+        {
+            pxRxInst->CR2.w = SPI_CR2_RXDMAEN | SPI_CR2_ERRIE;
+        }
+        if (pxTxInst != NULL)
+        {
+            pxTxInst->CR2.w = SPI_CR2_TXDMAEN | SPI_CR2_ERRIE;
+        }
+
+        /* The extension has to be ready before the main instance starts the clock */
+        if (pxI2S->Ext != NULL)
+        {
+            SET_BIT(pxI2S->Ext->I2SCFGR.w, SPI_I2SCFGR_I2SE);
+        }
+        SET_BIT(pxI2S->Inst->I2SCFGR.w, SPI_I2SCFGR_I2SE);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the audio streaming.
+ * @param pxI2S: pointer to the I2S handle structure
+ */
+void I2S_vStop_DMA(I2S_HandleType * pxI2S)
+{
+    CLEAR_BIT(pxI2S->Inst->I2SCFGR.w, SPI_I2SCFGR_I2SE);
+    pxI2S->Inst->CR2.w = 0;
+
+    if (pxI2S->Ext != NULL)
+    {
+        CLEAR_BIT(pxI2S->Ext->I2SCFGR.w, SPI_I2SCFGR_I2SE);
+        pxI2S->Ext->CR2.w = 0;
+    }
+
+    if (pxI2S->DMA.Transmit != NULL)
+    {
+        DMA_vStop_IT(pxI2S->DMA.Transmit);
+    }
+    if (pxI2S->DMA.Receive != NULL)
+    {
+        DMA_vStop_IT(pxI2S->DMA.Receive);
+    }
+}
+
+/**
+ * @brief I2S interrupt handler that reports underrun, overrun and frame errors
+ *        of the main and the extension instances.
+ * @note  After an overrun the channel alignment of the receive buffer can be lost,
+ *        the Error callback may restart the streaming to recover it.
+ * @param pxI2S: pointer to the I2S handle structure
+ */
+void I2S_vIRQHandler(I2S_HandleType * pxI2S)
+{
+    I2S_ErrorType ePrevErrors = pxI2S->Errors;
+
+    I2S_prvCheckErrors(pxI2S, pxI2S->Inst);
+
+    if (pxI2S->Ext != NULL)
+    {
+        I2S_prvCheckErrors(pxI2S, pxI2S->Ext);
+    }
+
+    if (pxI2S->Errors != ePrevErrors)
+    {
+        XPD_SAFE_CALLBACK(pxI2S->Callbacks.Error, pxI2S);
+    }
+}
+
+/**
+ * @brief Calculates the actual sample rate of the I2S master.
+ * @param pxI2S: pointer to the I2S handle structure
+ * @return The sample rate in Hz, or 0 if the I2S is a slave
+ */
+uint32_t I2S_ulGetAudioFreq(I2S_HandleType * pxI2S)
+{
+    uint32_t ulFreq = 0;
+
+    if ((pxI2S->Inst->I2SCFGR.w & SPI_I2SCFGR_I2SCFG_1) != 0)
+    {
+        uint32_t ulDiv = 2 * pxI2S->Inst->I2SPR.b.I2SDIV + pxI2S->Inst->I2SPR.b.ODD;
+        uint32_t ulRatio = I2S_CLOCK_RATIO(pxI2S->Inst->I2SPR.b.MCKOE, pxI2S->Inst->I2SCFGR.w);
+
+        ulFreq = I2S_ulClockFreq_Hz() / (ulRatio * ulDiv);
+    }
+    return ulFreq;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* SPI_I2SCFGR_I2SMOD */
@@ -0,0 +1,253 @@
+/**
+  ******************************************************************************
+  * @file    xpd_pool.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Buffer Pool Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_pool.h>
+
+/** @addtogroup POOL
+ * @{ */
+
+/* Block header, the data follows it directly */
+typedef struct
+{
+    POOL_ClassType * Class;                 /* The owner size class */
+    union {
+        void * Next;                        /* Free list link while the block is free */
+        volatile uint32_t RefCount;         /* Number of owners while the block is allocated */
+    }Link;
+}POOL_BlockType;
+
+#define POOL_BLOCK_STRIDE(CLASS)    (POOL_HEADER_SIZE + (((CLASS)->BlockSize + 3) & ~3))
+
+#define POOL_BLOCK2DATA(BLOCK)      ((void*)((uint8_t*)(BLOCK) + POOL_HEADER_SIZE))
+#define POOL_DATA2BLOCK(DATA)       ((POOL_BlockType*)((uint8_t*)(DATA) - POOL_HEADER_SIZE))
+
+#if (__CORTEX_M >= 3U)
+/* The exclusive monitor is cleared on exception entry and return,
+ * so an interrupting pool operation makes the store fail and the operation retry */
+#define POOL_EXCLUSIVE_BEGIN()
+#define POOL_LOAD(ADDR)             __LDREXW(ADDR)
+#define POOL_STORE(ADDR, VALUE)     (__STREXW((VALUE), (ADDR)) == 0)
+#define POOL_CANCEL()               __CLREX()
+#define POOL_EXCLUSIVE_END()
+#else
+/* Without exclusive access instructions the interrupts are masked for the operation */
+#define POOL_EXCLUSIVE_BEGIN()      uint32_t ulPRIMASK = __get_PRIMASK(); __disable_irq()
+#define POOL_LOAD(ADDR)             (*(ADDR))
+#define POOL_STORE(ADDR, VALUE)     ((*(ADDR) = (VALUE)), TRUE)
+#define POOL_CANCEL()
+#define POOL_EXCLUSIVE_END()        __set_PRIMASK(ulPRIMASK)
+#endif
+
+/* Takes the first block from the free list of the class */
+static POOL_BlockType * POOL_prvPop(POOL_ClassType * pxClass)
+{
+    POOL_BlockType * pxBlock;
+    POOL_EXCLUSIVE_BEGIN();
+
+    do
+    {
+        pxBlock = (POOL_BlockType*) POOL_LOAD((volatile uint32_t*)&pxClass->Free);
+
+        if (pxBlock == NULL)
+        {
+            POOL_CANCEL();
+            break;
+        }
+    }
+    while (!POOL_STORE((volatile uint32_t*)&pxClass->Free, (uint32_t)pxBlock->Link.Next));
+
+    POOL_EXCLUSIVE_END();
+    return pxBlock;
+}
+
+/* Puts the block to the front of the free list of its class */
+static void POOL_prvPush(POOL_BlockType * pxBlock)
+{
+    POOL_ClassType * pxClass = pxBlock->Class;
+    POOL_EXCLUSIVE_BEGIN();
+
+    do
+    {
+        pxBlock->Link.Next = (void*) POOL_LOAD((volatile uint32_t*)&pxClass->Free);
+    }
+    while (!POOL_STORE((volatile uint32_t*)&pxClass->Free, (uint32_t)pxBlock));
+
+    POOL_EXCLUSIVE_END();
+}
+
+/* Atomically adds to the counter and returns its new value */
+static uint32_t POOL_prvAdd(volatile uint32_t * pulCounter, int32_t lValue)
+{
+    uint32_t ulResult;
+    POOL_EXCLUSIVE_BEGIN();
+
+    do
+    {
+        ulResult = POOL_LOAD(pulCounter) + lValue;
+    }
+    while (!POOL_STORE(pulCounter, ulResult));
+
+    POOL_EXCLUSIVE_END();
+    return ulResult;
+}
+
+/* Atomically raises the mark to the value */
+static void POOL_prvRaise(volatile uint32_t * pulMark, uint32_t ulValue)
+{
+    POOL_EXCLUSIVE_BEGIN();
+
+    do
+    {
+        if (POOL_LOAD(pulMark) >= ulValue)
+        {
+            POOL_CANCEL();
+            break;
+        }
+    }
+    while (!POOL_STORE(pulMark, ulValue));
+
+    POOL_EXCLUSIVE_END();
+}
+
+/** @defgroup POOL_Exported_Functions POOL Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the buffer pool, all blocks of the size classes are free.
+ * @param pxPool: pointer to the POOL handle structure
+ * @param axClasses: the size classes in ascending block size order
+ *                   with their Memory, BlockSize and BlockCount set
+ * @param ucCount: the number of size classes
+ */
+void POOL_vInit(POOL_HandleType * pxPool, POOL_ClassType * axClasses, uint8_t ucCount)
+{
+    uint8_t ucClass;
+
+    pxPool->Classes  = axClasses;
+    pxPool->Count    = ucCount;
+    pxPool->Failures = 0;
+
+    for (ucClass = 0; ucClass < ucCount; ucClass++)
+    {
+        POOL_ClassType * pxClass = &axClasses[ucClass];
+        uint8_t * pucBlock = pxClass->Memory;
+        uint16_t usBlock;
+
+        pxClass->Free      = NULL;
+        pxClass->Used      = 0;
+        pxClass->HighWater = 0;
+        pxClass->Failures  = 0;
+
+        /* link the blocks in memory order */
+        pucBlock += POOL_BLOCK_STRIDE(pxClass) * pxClass->BlockCount;
+        for (usBlock = 0; usBlock < pxClass->BlockCount; usBlock++)
+        {
+            POOL_BlockType * pxBlock;
+
+            pucBlock -= POOL_BLOCK_STRIDE(pxClass);
+            pxBlock = (POOL_BlockType*) pucBlock;
+
+            pxBlock->Class     = pxClass;
+            pxBlock->Link.Next = pxClass->Free;
+            pxClass->Free      = pxBlock;
+        }
+    }
+}
+
+/**
+ * @brief Allocates a buffer from the smallest size class which fits the requested size,
+ *        and has a free block. The caller becomes the single owner of the buffer.
+ * @note  This function can be called from interrupt context.
+ * @param pxPool: pointer to the POOL handle structure
+ * @param usSize: the requested buffer size in bytes
+ * @return Pointer to the buffer data, or NULL if no suitable block is available
+ */
+void * POOL_pvAlloc(POOL_HandleType * pxPool, uint16_t usSize)
+{
+    uint8_t ucClass;
+
+    for (ucClass = 0; ucClass < pxPool->Count; ucClass++)
+    {
+        POOL_ClassType * pxClass = &pxPool->Classes[ucClass];
+
+        if (pxClass->BlockSize >= usSize)
+        {
+            POOL_BlockType * pxBlock = POOL_prvPop(pxClass);
+
+            if (pxBlock != NULL)
+            {
+                pxBlock->Link.RefCount = 1;
+
+                POOL_prvRaise(&pxClass->HighWater, POOL_prvAdd(&pxClass->Used, 1));
+
+                return POOL_BLOCK2DATA(pxBlock);
+            }
+
+            /* fall back to the next larger class */
+            (void) POOL_prvAdd(&pxClass->Failures, 1);
+        }
+    }
+
+    (void) POOL_prvAdd(&pxPool->Failures, 1);
+    return NULL;
+}
+
+/**
+ * @brief Adds an owner to the buffer, e.g. when it is handed over to another layer
+ *        while the current owner keeps using it.
+ * @param pvBuffer: pointer to the buffer data
+ */
+void POOL_vRetain(void * pvBuffer)
+{
+    (void) POOL_prvAdd(&POOL_DATA2BLOCK(pvBuffer)->Link.RefCount, 1);
+}
+
+/**
+ * @brief Removes an owner of the buffer, the last owner returns it to the pool.
+ * @note  This function can be called from interrupt context.
+ * @param pvBuffer: pointer to the buffer data
+ */
+void POOL_vRelease(void * pvBuffer)
+{
+    POOL_BlockType * pxBlock = POOL_DATA2BLOCK(pvBuffer);
+
+    if (POOL_prvAdd(&pxBlock->Link.RefCount, -1) == 0)
+    {
+        (void) POOL_prvAdd(&pxBlock->Class->Used, -1);
+
+        POOL_prvPush(pxBlock);
+    }
+}
+
+/**
+ * @brief Gets the usable size of the buffer.
+ * @param pvBuffer: pointer to the buffer data
+ * @return The block size of the buffer's size class
+ */
+uint16_t POOL_usGetSize(void * pvBuffer)
+{
+    return POOL_DATA2BLOCK(pvBuffer)->Class->BlockSize;
+}
+
+/** @} */
+
+/** @} */
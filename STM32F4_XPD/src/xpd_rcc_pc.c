@@ -22,8 +22,11 @@
   */
 #include <xpd_rcc.h>
 #include <xpd_i2c.h>
+#include <xpd_i2s.h>
 #include <xpd_pwr.h>
 #include <xpd_rtc.h>
+#include <xpd_sai.h>
+#include <xpd_sdmmc.h>
 #include <xpd_tim.h>
 #include <xpd_usart.h>
 #include <xpd_utils.h>
@@ -152,6 +155,228 @@ uint32_t XPD_RTC_ulClockFreq_Hz(void)
 
 /** @} */
 
+/* Returns the PLL input frequency, which is shared by all PLLs */
+static uint32_t RCC_prvPllInputFreq_Hz(void)
+{
+#ifdef HSE_VALUE_Hz
+    if (RCC_REG_BIT(PLLCFGR,PLLSRC) != 0)
+    {
+        return HSE_VALUE_Hz / RCC->PLLCFGR.b.PLLM;
+    }
+    else
+#endif
+    {
+        return HSI_VALUE_Hz / RCC->PLLCFGR.b.PLLM;
+    }
+}
+
+#if defined(SPI_I2SCFGR_I2SMOD)
+
+/* PLLI2S VCO limits */
+#define PLLI2S_VCO_MIN_Hz       100000000
+#define PLLI2S_VCO_MAX_Hz       432000000
+
+/** @ingroup I2S_Clock_Source
+ * @defgroup I2S_Clock_Source_Exported_Functions I2S Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Configures the PLLI2S to provide the I2S clock with the smallest sample rate
+ *        error for the master configuration. The PLLI2S input divider is shared
+ *        with the main PLL, so the main PLL has to be configured beforehand.
+ * @param pxConfig: I2S setup configuration (the AudioFreq, MasterClock and Frame are used)
+ * @return ERROR if no valid PLLI2S setting is found,
+ *         TIMEOUT if the PLLI2S doesn't lock,
+ *         OK if the I2S clock is configured
+ */
+XPD_ReturnType I2S_eClockConfig(const I2S_InitType * pxConfig)
+{
+    XPD_ReturnType eResult = XPD_ERROR;
+    uint32_t ulInput = RCC_prvPllInputFreq_Hz();
+    uint32_t ulSampleClock = I2S_CLOCK_RATIO(pxConfig->MasterClock, pxConfig->Frame)
+                           * pxConfig->AudioFreq;
+    uint32_t ulBestN = 0, ulBestR = 0;
+    uint64_t ullBestErr = 0, ullBestClk = 1;
+    uint32_t r, n;
+
+    for (r = 2; r <= 7; r++)
+    {
+        for (n = 50; n <= 432; n++)
+        {
+            uint32_t ulVCO = ulInput * n;
+            uint32_t ulClk, ulDiv;
+            uint64_t ullErr;
+
+            if ((ulVCO < PLLI2S_VCO_MIN_Hz) || (ulVCO > PLLI2S_VCO_MAX_Hz))
+            {
+                continue;
+            }
+
+            ulClk = ulVCO / r;
+            ulDiv = (ulClk + ulSampleClock / 2) / ulSampleClock;
+
+            if ((ulDiv < 4) || (ulDiv > 511))
+            {
+                continue;
+            }
+
+            /* Relative error |clk - div * fs| / clk, compared by cross multiplication */
+            ullErr = (ulClk > (ulDiv * ulSampleClock)) ?
+                    (ulClk - ulDiv * ulSampleClock) : (ulDiv * ulSampleClock - ulClk);
+
+            if ((ulBestN == 0) || ((ullErr * ullBestClk) < (ullBestErr * ulClk)))
+            {
+                ullBestErr = ullErr;
+                ullBestClk = ulClk;
+                ulBestN = n;
+                ulBestR = r;
+            }
+        }
+    }
+
+    if (ulBestN != 0)
+    {
+        uint32_t ulTimeout = RCC_PLL_TIMEOUT;
+
+        /* The PLLI2S has to be disabled while it's reconfigured */
+        RCC_REG_BIT(CR,PLLI2SON) = 0;
+
+        eResult = XPD_eWaitForMatch(&RCC->CR.w,
+                RCC_CR_PLLI2SRDY, 0, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            RCC->PLLI2SCFGR.b.PLLI2SN = ulBestN;
+            RCC->PLLI2SCFGR.b.PLLI2SR = ulBestR;
+
+            RCC_REG_BIT(CR,PLLI2SON) = 1;
+
+            eResult = XPD_eWaitForMatch(&RCC->CR.w,
+                    RCC_CR_PLLI2SRDY, RCC_CR_PLLI2SRDY, &ulTimeout);
+
+            /* Select PLLI2S as the I2S clock source */
+            RCC_REG_BIT(CFGR,I2SSRC) = 0;
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Returns the input clock frequency of the I2S peripherals.
+ * @return The clock frequency of the I2S in Hz
+ */
+uint32_t I2S_ulClockFreq_Hz(void)
+{
+#if defined(EXTERNAL_CLOCK_VALUE_Hz)
+    if (RCC_REG_BIT(CFGR,I2SSRC) != 0)
+    {
+        return EXTERNAL_CLOCK_VALUE_Hz;
+    }
+    else
+#endif
+    {
+        return RCC_prvPllInputFreq_Hz() * RCC->PLLI2SCFGR.b.PLLI2SN
+                / RCC->PLLI2SCFGR.b.PLLI2SR;
+    }
+}
+
+/** @} */
+
+#endif /* SPI_I2SCFGR_I2SMOD */
+
+#if defined(SAI1)
+
+/** @ingroup SAI_Clock_Source
+ * @defgroup SAI_Clock_Source_Exported_Functions SAI Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the SAI block.
+ *        The selected PLL's Q output and the DCKCFGR divider have to be configured separately.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @param eClockSource: the new source clock which should be configured
+ */
+void SAI_vClockConfig(SAI_HandleType * pxSAI, SAI_ClockSourceType eClockSource)
+{
+    if (pxSAI->Inst == SAI1_Block_A)
+    {
+        RCC->DCKCFGR.b.SAI1ASRC = eClockSource;
+    }
+    else
+    {
+        RCC->DCKCFGR.b.SAI1BSRC = eClockSource;
+    }
+}
+
+/**
+ * @brief Returns the input clock frequency of the SAI block.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @return The clock frequency of the SAI block in Hz
+ */
+uint32_t SAI_ulClockFreq_Hz(SAI_HandleType * pxSAI)
+{
+    uint32_t ulSource = (pxSAI->Inst == SAI1_Block_A) ?
+            RCC->DCKCFGR.b.SAI1ASRC : RCC->DCKCFGR.b.SAI1BSRC;
+
+    switch (ulSource)
+    {
+        case SAI_CLOCKSOURCE_PLLSAI:
+            return RCC_prvPllInputFreq_Hz() * RCC->PLLSAICFGR.b.PLLSAIN
+                    / (RCC->PLLSAICFGR.b.PLLSAIQ * (RCC->DCKCFGR.b.PLLSAIDIVQ + 1));
+
+        case SAI_CLOCKSOURCE_PLLI2S:
+            return RCC_prvPllInputFreq_Hz() * RCC->PLLI2SCFGR.b.PLLI2SN
+                    / (RCC->PLLI2SCFGR.b.PLLI2SQ * (RCC->DCKCFGR.b.PLLI2SDIVQ + 1));
+
+#if defined(EXTERNAL_CLOCK_VALUE_Hz)
+        case SAI_CLOCKSOURCE_EXT:
+            return EXTERNAL_CLOCK_VALUE_Hz;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/** @} */
+
+#endif /* SAI1 */
+
+#if defined(SDIO)
+
+/** @ingroup SDMMC_Clock_Source
+ * @defgroup SDMMC_Clock_Source_Exported_Functions SDMMC Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Returns the input clock frequency of the SDMMC.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @return The clock frequency of the SDMMC in Hz
+ */
+uint32_t SDMMC_ulClockFreq_Hz(SDMMC_HandleType * pxSDMMC)
+{
+    /* The 48 MHz clock is the PLL Q output */
+    uint32_t m, n, q;
+    m = RCC->PLLCFGR.b.PLLM;
+    n = RCC->PLLCFGR.b.PLLN;
+    q = RCC->PLLCFGR.b.PLLQ;
+
+#ifdef HSE_VALUE_Hz
+    if (RCC_REG_BIT(PLLCFGR,PLLSRC) != 0)
+    {
+        return HSE_VALUE_Hz / m * n / q;
+    }
+    else
+#endif
+    {
+        return HSI_VALUE_Hz / m * n / q;
+    }
+}
+
+/** @} */
+
+#endif /* SDIO */
+
 /** @ingroup TIM_Clock_Source
  * @defgroup TIM_Clock_Source_Exported_Functions TIM Clock Source Exported Functions
  * @{ */
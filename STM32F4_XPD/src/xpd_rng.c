@@ -0,0 +1,174 @@
+/**
+  ******************************************************************************
+  * @file    xpd_rng.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Random Number Generator Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_rng.h>
+#include <xpd_utils.h>
+
+#if defined(RNG)
+
+/** @addtogroup RNG
+ * @{ */
+
+/** @defgroup RNG_Exported_Functions RNG Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the RNG peripheral and starts filling the entropy pool
+ *        in the background from the data ready interrupt.
+ * @note  The RNG interrupt shall be enabled in the DepInit callback.
+ * @param pxRNG: pointer to the RNG handle structure
+ * @param pulPool: pointer to the entropy pool storage
+ * @param usPoolSize: size of the entropy pool in bytes (power of 2, at least 4)
+ */
+void RNG_vInit(RNG_HandleType * pxRNG, uint32_t * pulPool, uint16_t usPoolSize)
+{
+    pxRNG->Pool.Buffer = (uint8_t*)pulPool;
+    pxRNG->Pool.Mask   = usPoolSize - 1;
+    pxRNG->Pool.Head   = 0;
+    pxRNG->Pool.Tail   = 0;
+    pxRNG->Recoveries  = 0;
+    pxRNG->Errors      = RNG_ERROR_NONE;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_RNG);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxRNG->Callbacks.DepInit, pxRNG);
+
+    pxRNG->Inst->CR.w = RNG_CR_RNGEN | RNG_CR_IE;
+}
+
+/**
+ * @brief Restores the RNG peripheral to its default inactive state.
+ * @param pxRNG: pointer to the RNG handle structure
+ */
+void RNG_vDeinit(RNG_HandleType * pxRNG)
+{
+    pxRNG->Inst->CR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxRNG->Callbacks.DepDeinit, pxRNG);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_RNG);
+}
+
+/**
+ * @brief Reads random bytes from the entropy pool without waiting.
+ * @param pxRNG: pointer to the RNG handle structure
+ * @param pvData: pointer to the output buffer
+ * @param usLength: the requested amount of random bytes
+ * @return The amount of random bytes copied to the output buffer
+ */
+uint16_t RNG_usRead(RNG_HandleType * pxRNG, void * pvData, uint16_t usLength)
+{
+    uint8_t * pucData = pvData;
+    uint16_t usTail, usCount;
+
+    XPD_ENTER_CRITICAL(pxRNG);
+
+    usTail  = pxRNG->Pool.Tail;
+    usCount = pxRNG->Pool.Head - usTail;
+
+    if (usCount > usLength)
+    {
+        usCount = usLength;
+    }
+
+    for (usLength = 0; usLength < usCount; usLength++)
+    {
+        *pucData++ = pxRNG->Pool.Buffer[(usTail + usLength) & pxRNG->Pool.Mask];
+    }
+
+    /* The consumed bytes are released at once */
+    pxRNG->Pool.Tail = usTail + usCount;
+
+    XPD_EXIT_CRITICAL(pxRNG);
+
+    /* Resume refilling the pool */
+    if (usCount > 0)
+    {
+        RNG_REG_BIT(pxRNG, CR, IE) = 1;
+    }
+
+    return usCount;
+}
+
+/**
+ * @brief RNG interrupt handler that fills the entropy pool and recovers from errors.
+ * @param pxRNG: pointer to the RNG handle structure
+ */
+void RNG_vIRQHandler(RNG_HandleType * pxRNG)
+{
+    uint32_t ulSR = pxRNG->Inst->SR.w;
+
+    if ((ulSR & RNG_SR_SEIS) != 0)
+    {
+        RNG_FLAG_CLEAR(pxRNG, SEIS);
+
+        /* Restart the generator, the pending data is discarded */
+        RNG_REG_BIT(pxRNG, CR, RNGEN) = 0;
+        RNG_REG_BIT(pxRNG, CR, RNGEN) = 1;
+
+        pxRNG->Recoveries++;
+        pxRNG->Errors |= RNG_ERROR_SEED;
+
+        XPD_SAFE_CALLBACK(pxRNG->Callbacks.Error, pxRNG);
+    }
+    else
+    {
+        if ((ulSR & RNG_SR_CEIS) != 0)
+        {
+            /* The generator continues automatically once the clock is correct */
+            RNG_FLAG_CLEAR(pxRNG, CEIS);
+
+            pxRNG->Errors |= RNG_ERROR_CLOCK;
+
+            XPD_SAFE_CALLBACK(pxRNG->Callbacks.Error, pxRNG);
+        }
+
+        if ((ulSR & (RNG_SR_DRDY | RNG_SR_SECS)) == RNG_SR_DRDY)
+        {
+            uint16_t usHead = pxRNG->Pool.Head;
+
+            /* A whole word has to fit in the free space */
+            if ((uint16_t)(usHead - pxRNG->Pool.Tail) <= (pxRNG->Pool.Mask + 1 - sizeof(uint32_t)))
+            {
+                /* Head is always word aligned */
+                *(uint32_t*)&pxRNG->Pool.Buffer[usHead & pxRNG->Pool.Mask] = pxRNG->Inst->DR;
+
+                pxRNG->Pool.Head = usHead + sizeof(uint32_t);
+            }
+            else
+            {
+                /* Pool is full, stop until the next read */
+                RNG_REG_BIT(pxRNG, CR, IE) = 0;
+            }
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* RNG */
@@ -0,0 +1,449 @@
+/**
+  ******************************************************************************
+  * @file    xpd_sai.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers SAI Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_sai.h>
+#include <xpd_utils.h>
+
+#if defined(SAI1)
+
+/** @addtogroup SAI
+ * @{ */
+
+/* The block is disabled at the end of the current frame */
+#define SAI_DISABLE_TIMEOUT         10
+
+/* Master clock to frame synchronization ratio when the master clock divider is used */
+#define SAI_MCLK_RATIO              256
+
+#define SAI_ERROR_FLAGS     (SAI_xSR_OVRUDR | SAI_xSR_WCKCFG | SAI_xSR_AFSDET | SAI_xSR_LFSDET)
+#define SAI_ALL_FLAGS       (SAI_xCLRFR_COVRUDR | SAI_xCLRFR_CMUTEDET | SAI_xCLRFR_CWCKCFG | \
+                             SAI_xCLRFR_CCNRDY | SAI_xCLRFR_CAFSDET | SAI_xCLRFR_CLFSDET)
+
+/* Data size in bits, indexed by the DS field */
+static const uint8_t sai_aucDataBits[] = { 0, 0, 8, 10, 16, 20, 24, 32 };
+
+/* Disables the block and waits until the current frame is finished */
+static XPD_ReturnType SAI_prvDisable(SAI_HandleType * pxSAI)
+{
+    uint32_t ulTimeout = SAI_DISABLE_TIMEOUT;
+
+    CLEAR_BIT(pxSAI->Inst->CR1, SAI_xCR1_SAIEN);
+
+    return XPD_eWaitForMatch(&pxSAI->Inst->CR1, SAI_xCR1_SAIEN, 0, &ulTimeout);
+}
+
+static void SAI_prvDmaHalfRedirect(void * pxDMA)
+{
+    SAI_HandleType * pxSAI = (SAI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The first half of the buffer is transferred */
+    pxSAI->Block = pxSAI->Stream.Buffer;
+
+    XPD_SAFE_CALLBACK(pxSAI->Callbacks.Transfer, pxSAI);
+}
+
+static void SAI_prvDmaRedirect(void * pxDMA)
+{
+    SAI_HandleType * pxSAI = (SAI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is transferred */
+        pxSAI->Block = pxSAI->Stream.Buffer
+                     + pxSAI->Stream.HalfLength * pxSAI->Stream.SampleSize;
+    }
+    else
+    {
+        /* The whole buffer is transferred, end of the single transfer */
+        pxSAI->Block = pxSAI->Stream.Buffer;
+
+        CLEAR_BIT(pxSAI->Inst->CR1, SAI_xCR1_DMAEN);
+    }
+
+    XPD_SAFE_CALLBACK(pxSAI->Callbacks.Transfer, pxSAI);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void SAI_prvDmaErrorRedirect(void * pxDMA)
+{
+    SAI_HandleType * pxSAI = (SAI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* Update error code */
+    pxSAI->Errors |= SAI_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxSAI->Callbacks.Error, pxSAI);
+}
+#endif
+
+/** @defgroup SAI_Exported_Functions SAI Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the SAI block using the setup configuration.
+ *        In master mode the frame length has to be a power of two, and the master clock
+ *        divider is set to the closest match of the frame rate (256 * AudioFreq master clock)
+ *        using the current SAI clock (see @ref SAI_vClockConfig).
+ *        The receivers sample on the rising, the transmitters drive on the falling clock edge.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @param pxConfig: SAI block setup configuration
+ * @return ERROR if the frame configuration is invalid,
+ *         TIMEOUT if the block couldn't be disabled,
+ *         OK if successful
+ */
+XPD_ReturnType SAI_eInit(SAI_HandleType * pxSAI, const SAI_InitType * pxConfig)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulDataBits = sai_aucDataBits[pxConfig->DataSize >> SAI_xCR1_DS_Pos];
+    uint32_t ulSlotBits, ulFrameBits, ulFRCR;
+    /* Transmitters drive the data on the falling edge, receivers sample it on the rising edge */
+    uint32_t ulCR1 = pxConfig->Mode | pxConfig->Sync | pxConfig->DataSize | SAI_xCR1_CKSTR;
+
+    switch (pxConfig->SlotSize)
+    {
+        case SAI_SLOTSIZE_16BIT:
+            ulSlotBits = 16;
+            break;
+        case SAI_SLOTSIZE_32BIT:
+            ulSlotBits = 32;
+            break;
+        default:
+            ulSlotBits = ulDataBits;
+            break;
+    }
+    ulFrameBits = ulSlotBits * pxConfig->SlotCount;
+
+    if ((ulSlotBits < ulDataBits) || (pxConfig->SlotCount == 0) || (pxConfig->SlotCount > 16)
+        || (ulFrameBits < 8) || (ulFrameBits > 256))
+    {
+        return XPD_ERROR;
+    }
+
+    if ((pxConfig->Mode & SAI_xCR1_MODE_1) == 0)
+    {
+        uint32_t ulClock = SAI_ulClockFreq_Hz(pxSAI);
+        uint32_t ulMCLK = SAI_MCLK_RATIO * pxConfig->AudioFreq;
+        uint32_t ulDiv, ulBestDiv = 0, ulBestErr = ~0;
+
+        /* The bit clock is derived from the master clock by the frame length */
+        if ((ulFrameBits & (ulFrameBits - 1)) != 0)
+        {
+            return XPD_ERROR;
+        }
+
+        /* MCKDIV = 0 divides by 1, otherwise by 2 * MCKDIV */
+        for (ulDiv = 0; ulDiv <= (SAI_xCR1_MCKDIV >> SAI_xCR1_MCKDIV_Pos); ulDiv++)
+        {
+            uint32_t ulFreq = ulClock / ((ulDiv == 0) ? 1 : (2 * ulDiv));
+            uint32_t ulErr = (ulFreq > ulMCLK) ? (ulFreq - ulMCLK) : (ulMCLK - ulFreq);
+
+            if (ulErr < ulBestErr)
+            {
+                ulBestErr = ulErr;
+                ulBestDiv = ulDiv;
+            }
+        }
+        ulCR1 |= ulBestDiv << SAI_xCR1_MCKDIV_Pos;
+    }
+
+    /* Frame synchronization format */
+    ulFRCR = (ulFrameBits - 1) << SAI_xFRCR_FRL_Pos;
+    switch (pxConfig->Standard)
+    {
+        case SAI_STANDARD_I2S:
+            ulFRCR |= SAI_xFRCR_FSDEF | SAI_xFRCR_FSOFF
+                    | (((ulFrameBits / 2) - 1) << SAI_xFRCR_FSALL_Pos);
+            break;
+        case SAI_STANDARD_MSB:
+            ulFRCR |= SAI_xFRCR_FSDEF | SAI_xFRCR_FSPOL
+                    | (((ulFrameBits / 2) - 1) << SAI_xFRCR_FSALL_Pos);
+            break;
+        case SAI_STANDARD_PCM_SHORT:
+            ulFRCR |= SAI_xFRCR_FSPOL | SAI_xFRCR_FSOFF;
+            break;
+        default:
+            ulFRCR |= SAI_xFRCR_FSPOL | ((ulSlotBits - 1) << SAI_xFRCR_FSALL_Pos);
+            break;
+    }
+
+    /* enable clock */
+    RCC_vClockEnable(pxSAI->CtrlPos);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxSAI->Callbacks.DepInit, pxSAI);
+
+    eResult = SAI_prvDisable(pxSAI);
+
+    if (eResult == XPD_OK)
+    {
+        pxSAI->Inst->CR1   = ulCR1;
+        pxSAI->Inst->CR2   = pxConfig->FifoThreshold | SAI_xCR2_FFLUSH;
+        pxSAI->Inst->FRCR  = ulFRCR;
+        pxSAI->Inst->SLOTR = pxConfig->SlotSize
+                           | ((pxConfig->SlotCount - 1) << SAI_xSLOTR_NBSLOT_Pos)
+                           | ((uint32_t)pxConfig->ActiveSlots << SAI_xSLOTR_SLOTEN_Pos);
+
+        /* Error interrupts, frame synchronization errors are only detected in slave mode */
+        pxSAI->Inst->CLRFR = SAI_ALL_FLAGS;
+        pxSAI->Inst->IMR   = SAI_xIMR_OVRUDRIE | SAI_xIMR_WCKCFGIE
+                           | SAI_xIMR_AFSDETIE | SAI_xIMR_LFSDETIE;
+
+        /* DMA transfer unit */
+        pxSAI->Stream.SampleSize = (ulDataBits > 16) ? 4 : ((ulDataBits > 8) ? 2 : 1);
+        pxSAI->Block  = NULL;
+        pxSAI->Errors = SAI_ERROR_NONE;
+    }
+    return eResult;
+}
+
+/**
+ * @brief Restores the SAI block to its default inactive state.
+ *        The peripheral clock is only disabled when the other block of the SAI is unused.
+ * @param pxSAI: pointer to the SAI handle structure
+ */
+void SAI_vDeinit(SAI_HandleType * pxSAI)
+{
+    /* The two blocks are at offset 0x04 and 0x24 from the SAI base */
+    uint32_t ulBase = (uint32_t)pxSAI->Inst & ~0x3FFUL;
+    SAI_Block_TypeDef * pxOther = (SAI_Block_TypeDef *)
+            (ulBase + (0x28 - ((uint32_t)pxSAI->Inst - ulBase)));
+
+    SAI_vStop_DMA(pxSAI);
+
+    pxSAI->Inst->IMR = 0;
+    pxSAI->Inst->CLRFR = SAI_ALL_FLAGS;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxSAI->Callbacks.DepDeinit, pxSAI);
+
+    /* disable clock */
+    if ((pxOther->CR1 & SAI_xCR1_SAIEN) == 0)
+    {
+        RCC_vClockDisable(pxSAI->CtrlPos);
+    }
+}
+
+/**
+ * @brief Starts continuous audio streaming with DMA.
+ *        When the DMA stream is in circular mode, the buffer is double buffered:
+ *        the Transfer callback is called at each transferred half,
+ *        with Block pointing to the half that is available to the application.
+ *        The buffer contains the active slots of each frame interleaved,
+ *        see @ref SAI_vDeinterleave16 and @ref SAI_vDeinterleave32 for separating the channels.
+ * @note  The DMA peripheral data size has to match the sample size: byte for 8 bit,
+ *        half-word for 10 and 16 bit, word for larger data sizes.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @param pvBuffer: pointer to the sample buffer
+ * @param usLength: length of the buffer in samples (even in circular mode)
+ * @return BUSY if the DMA stream is in use, OK if the streaming is started
+ */
+XPD_ReturnType SAI_eStart_DMA(SAI_HandleType * pxSAI, void * pvBuffer, uint16_t usLength)
+{
+    XPD_ReturnType eResult;
+
+    pxSAI->Stream.Buffer     = pvBuffer;
+    pxSAI->Stream.HalfLength = usLength / 2;
+    pxSAI->Block             = NULL;
+    pxSAI->Errors            = SAI_ERROR_NONE;
+
+    /* Set the callback owner */
+    pxSAI->DMA->Owner = pxSAI;
+
+    /* Set the DMA transfer callbacks */
+    pxSAI->DMA->Callbacks.Complete     = SAI_prvDmaRedirect;
+    pxSAI->DMA->Callbacks.HalfComplete = SAI_prvDmaHalfRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+    pxSAI->DMA->Callbacks.Error        = SAI_prvDmaErrorRedirect;
+#endif
+
+    eResult = DMA_eStart_IT(pxSAI->DMA, (void*)&pxSAI->Inst->DR, pvBuffer, usLength);
+
+    if (eResult == XPD_OK)
+    {
+        /* In circular mode each buffer half is a block */
+        if (DMA_eCircularMode(pxSAI->DMA) != 0)
+        {
+            DMA_IT_ENABLE(pxSAI->DMA, HT);
+        }
+
+        pxSAI->Inst->CLRFR = SAI_ALL_FLAGS;
+
+        /* The transmit FIFO is filled by the DMA before the block is enabled */
+        SET_BIT(pxSAI->Inst->CR1, SAI_xCR1_DMAEN);
+        SET_BIT(pxSAI->Inst->CR1, SAI_xCR1_SAIEN);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the audio streaming at the end of the current frame.
+ * @param pxSAI: pointer to the SAI handle structure
+ */
+void SAI_vStop_DMA(SAI_HandleType * pxSAI)
+{
+    CLEAR_BIT(pxSAI->Inst->CR1, SAI_xCR1_DMAEN);
+
+    (void) SAI_prvDisable(pxSAI);
+
+    if (pxSAI->DMA != NULL)
+    {
+        DMA_vStop_IT(pxSAI->DMA);
+    }
+
+    SET_BIT(pxSAI->Inst->CR2, SAI_xCR2_FFLUSH);
+}
+
+/**
+ * @brief SAI block interrupt handler that reports FIFO overruns / underruns,
+ *        frame synchronization errors and wrong clock configuration.
+ * @param pxSAI: pointer to the SAI handle structure
+ */
+void SAI_vIRQHandler(SAI_HandleType * pxSAI)
+{
+    uint32_t ulSR = pxSAI->Inst->SR & pxSAI->Inst->IMR & SAI_ERROR_FLAGS;
+
+    if (ulSR != 0)
+    {
+        /* The flags of SR and CLRFR are at the same positions */
+        pxSAI->Inst->CLRFR = ulSR;
+
+        if ((ulSR & SAI_xSR_OVRUDR) != 0)
+        {
+            pxSAI->Errors |= SAI_ERROR_OVRUDR;
+        }
+        if ((ulSR & (SAI_xSR_AFSDET | SAI_xSR_LFSDET)) != 0)
+        {
+            pxSAI->Errors |= SAI_ERROR_FRAMESYNC;
+        }
+        if ((ulSR & SAI_xSR_WCKCFG) != 0)
+        {
+            pxSAI->Errors |= SAI_ERROR_CLOCK;
+        }
+
+        XPD_SAFE_CALLBACK(pxSAI->Callbacks.Error, pxSAI);
+    }
+}
+
+/**
+ * @brief Calculates the actual frame rate of the SAI master block.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @return The frame rate in Hz, or 0 if the block is a slave
+ */
+uint32_t SAI_ulGetAudioFreq(SAI_HandleType * pxSAI)
+{
+    uint32_t ulFreq = 0;
+
+    if ((pxSAI->Inst->CR1 & SAI_xCR1_MODE_1) == 0)
+    {
+        uint32_t ulDiv = (pxSAI->Inst->CR1 & SAI_xCR1_MCKDIV) >> SAI_xCR1_MCKDIV_Pos;
+
+        ulDiv = (ulDiv == 0) ? 1 : (2 * ulDiv);
+
+        ulFreq = SAI_ulClockFreq_Hz(pxSAI) / (ulDiv * SAI_MCLK_RATIO);
+    }
+    return ulFreq;
+}
+
+/**
+ * @brief Separates interleaved 16 bit slot data into per-channel arrays.
+ * @param psSlots: pointer to the interleaved samples (a received block)
+ * @param apsChannels: array of channel output buffers, each with usFrames capacity
+ * @param ucChannels: number of active slots in each frame
+ * @param usFrames: number of frames to process
+ */
+void SAI_vDeinterleave16(
+        const int16_t *     psSlots,
+        int16_t * const     apsChannels[],
+        uint8_t             ucChannels,
+        uint16_t            usFrames)
+{
+    uint8_t ucCh;
+
+    for (ucCh = 0; ucCh < ucChannels; ucCh++)
+    {
+        const int16_t * psIn = &psSlots[ucCh];
+        int16_t * psOut = apsChannels[ucCh];
+        uint16_t usCount = usFrames;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+        /* Pack two samples of the channel into a single word store */
+        if (((uint32_t)psOut & 3) == 0)
+        {
+            for (; usCount >= 2; usCount -= 2)
+            {
+                *((uint32_t*)psOut) = __PKHBT((uint16_t)psIn[0], (uint16_t)psIn[ucChannels], 16);
+                psIn  += 2 * ucChannels;
+                psOut += 2;
+            }
+        }
+#endif
+        for (; usCount > 0; usCount--)
+        {
+            *psOut++ = *psIn;
+            psIn += ucChannels;
+        }
+    }
+}
+
+/**
+ * @brief Separates interleaved 32 bit slot data into per-channel arrays.
+ * @param plSlots: pointer to the interleaved samples (a received block)
+ * @param aplChannels: array of channel output buffers, each with usFrames capacity
+ * @param ucChannels: number of active slots in each frame
+ * @param usFrames: number of frames to process
+ */
+void SAI_vDeinterleave32(
+        const int32_t *     plSlots,
+        int32_t * const     aplChannels[],
+        uint8_t             ucChannels,
+        uint16_t            usFrames)
+{
+    uint8_t ucCh;
+
+    for (ucCh = 0; ucCh < ucChannels; ucCh++)
+    {
+        const int32_t * plIn = &plSlots[ucCh];
+        int32_t * plOut = aplChannels[ucCh];
+        uint16_t usCount = usFrames;
+
+        /* Unrolled to keep the loop overhead off the load-store pairs */
+        for (; usCount >= 4; usCount -= 4)
+        {
+            plOut[0] = plIn[0];
+            plOut[1] = plIn[ucChannels];
+            plOut[2] = plIn[2 * ucChannels];
+            plOut[3] = plIn[3 * ucChannels];
+            plIn  += 4 * ucChannels;
+            plOut += 4;
+        }
+        for (; usCount > 0; usCount--)
+        {
+            *plOut++ = *plIn;
+            plIn += ucChannels;
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* SAI1 */
@@ -0,0 +1,350 @@
+/**
+  ******************************************************************************
+  * @file    xpd_wdg.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Watchdog Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_wdg.h>
+#include <xpd_utils.h>
+
+#if defined(IWDG)
+
+/** @addtogroup IWDG
+ * @{ */
+
+#define IWDG_KEY_START              0xCCCC
+#define IWDG_KEY_ACCESS             0x5555
+
+/* The register updates take up to 5 LSI periods with the largest prescaler */
+#define IWDG_UPDATE_TIMEOUT         48
+
+#ifdef IWDG_WINR_WIN
+#define IWDG_SR_UPDATES             (IWDG_SR_PVU | IWDG_SR_RVU | IWDG_SR_WVU)
+#else
+#define IWDG_SR_UPDATES             (IWDG_SR_PVU | IWDG_SR_RVU)
+#endif
+
+/** @defgroup IWDG_Exported_Functions IWDG Exported Functions
+ * @{ */
+
+/**
+ * @brief Starts the independent watchdog using the setup configuration.
+ * @note  The watchdog can only be stopped by system reset.
+ * @param pxConfig: IWDG setup configuration
+ * @return TIMEOUT if the new configuration wasn't applied in time, OK otherwise
+ */
+XPD_ReturnType IWDG_eInit(const IWDG_InitType * pxConfig)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = IWDG_UPDATE_TIMEOUT;
+
+    /* the LSI is started by hardware */
+    IWDG->KR = IWDG_KEY_START;
+
+    /* enable write access to the configuration */
+    IWDG->KR = IWDG_KEY_ACCESS;
+
+    IWDG->PR.w = pxConfig->Prescaler;
+    IWDG->RLR  = pxConfig->Reload;
+#ifdef IWDG_WINR_WIN
+    IWDG->WINR = pxConfig->Window;
+#endif
+
+    /* the values are transferred to the LSI domain */
+    eResult = XPD_eWaitForMatch(&IWDG->SR.w, IWDG_SR_UPDATES, 0, &ulTimeout);
+
+    /* reload the counter and protect the configuration */
+    IWDG_vRefresh();
+
+    return eResult;
+}
+
+/**
+ * @brief Calculates the time between two independent watchdog refreshes that causes reset.
+ * @return The watchdog timeout in ms, based on the nominal LSI frequency
+ */
+uint32_t IWDG_ulTimeout_ms(void)
+{
+    uint32_t ulTicks = (IWDG->RLR + 1) << (IWDG->PR.w + 2);
+
+    return ulTicks * 1000 / LSI_VALUE_Hz;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* IWDG */
+
+#if defined(WWDG)
+
+/** @addtogroup WWDG
+ * @{ */
+
+/* The reset occurs when the counter falls below this value */
+#define WWDG_COUNTER_MIN            0x40
+
+/** @defgroup WWDG_Exported_Functions WWDG Exported Functions
+ * @{ */
+
+/**
+ * @brief Starts the window watchdog using the setup configuration.
+ * @note  The watchdog can only be stopped by system reset.
+ * @param pxWWDG: pointer to the WWDG handle structure
+ * @param pxConfig: WWDG setup configuration
+ */
+void WWDG_vInit(WWDG_HandleType * pxWWDG, const WWDG_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_WWDG);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxWWDG->Callbacks.DepInit, pxWWDG);
+
+    pxWWDG->Counter = pxConfig->Counter;
+
+    pxWWDG->Inst->SR.w  = 0;
+    pxWWDG->Inst->CFR.w = (pxConfig->Prescaler << WWDG_CFR_WDGTB_Pos)
+            | (pxConfig->EarlyWakeup << WWDG_CFR_EWI_Pos)
+            | pxConfig->Window;
+
+    pxWWDG->Inst->CR.w  = WWDG_CR_WDGA | pxConfig->Counter;
+}
+
+/**
+ * @brief Calculates the time between two window watchdog refreshes that causes reset.
+ * @param pxWWDG: pointer to the WWDG handle structure
+ * @return The watchdog timeout in ms
+ */
+uint32_t WWDG_ulTimeout_ms(WWDG_HandleType * pxWWDG)
+{
+    uint32_t ulTicks = ((uint32_t)pxWWDG->Counter - WWDG_COUNTER_MIN + 1)
+            * (4096 << WWDG_REG_BIT(pxWWDG, CFR, WDGTB));
+
+    return ulTicks / (RCC_ulClockFreq_Hz(PCLK1) / 1000);
+}
+
+/**
+ * @brief WWDG interrupt handler that provides the EarlyWakeup callback.
+ * @note  The callback has one counter period to capture diagnostics (see @ref WDG_vSnapshot)
+ *        before the reset, unless it refreshes the watchdog.
+ * @param pxWWDG: pointer to the WWDG handle structure
+ */
+void WWDG_vIRQHandler(WWDG_HandleType * pxWWDG)
+{
+    if (WWDG_REG_BIT(pxWWDG, SR, EWIF) != 0)
+    {
+        pxWWDG->Inst->SR.w = 0;
+
+        XPD_SAFE_CALLBACK(pxWWDG->Callbacks.EarlyWakeup, pxWWDG);
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* WWDG */
+
+/** @addtogroup WDG
+ * @{ */
+
+/** @defgroup WDG_Exported_Functions WDG Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the watchdog service, which only refreshes the hardware watchdog
+ *        while all registered checkpoints check in within their deadlines.
+ * @param pxWDG: pointer to the WDG handle structure
+ * @param axCheckpoints: checkpoint storage
+ * @param ucCount: number of checkpoints [1 .. @ref WDG_MAX_CHECKPOINTS]
+ * @param usTimeout: the hardware watchdog timeout in service periods
+ */
+void WDG_vInit(WDG_HandleType * pxWDG, WDG_CheckpointType * axCheckpoints,
+        uint8_t ucCount, uint16_t usTimeout)
+{
+    pxWDG->Checkpoints  = axCheckpoints;
+    pxWDG->Count        = ucCount;
+    pxWDG->Registered   = 0;
+    pxWDG->Late         = 0;
+    pxWDG->Periods      = 0;
+    pxWDG->Timeout      = usTimeout;
+    pxWDG->SinceRefresh = 0;
+    pxWDG->MinMargin    = usTimeout;
+}
+
+/**
+ * @brief Adds a checkpoint to the liveness supervision.
+ * @param pxWDG: pointer to the WDG handle structure
+ * @param ucCheckpoint: index of the checkpoint
+ * @param usDeadline: maximal number of service periods between two check-ins
+ */
+void WDG_vRegister(WDG_HandleType * pxWDG, uint8_t ucCheckpoint, uint16_t usDeadline)
+{
+    WDG_CheckpointType * pxCheckpoint = &pxWDG->Checkpoints[ucCheckpoint];
+
+    XPD_ENTER_CRITICAL(pxWDG);
+
+    pxCheckpoint->Deadline = usDeadline;
+    pxCheckpoint->Elapsed  = 0;
+    pxCheckpoint->MinSlack = usDeadline;
+
+    SET_BIT(pxWDG->Registered, 1UL << ucCheckpoint);
+
+    XPD_EXIT_CRITICAL(pxWDG);
+}
+
+/**
+ * @brief Removes a checkpoint from the liveness supervision.
+ * @param pxWDG: pointer to the WDG handle structure
+ * @param ucCheckpoint: index of the checkpoint
+ */
+void WDG_vUnregister(WDG_HandleType * pxWDG, uint8_t ucCheckpoint)
+{
+    XPD_ENTER_CRITICAL(pxWDG);
+
+    CLEAR_BIT(pxWDG->Registered, 1UL << ucCheckpoint);
+
+    XPD_EXIT_CRITICAL(pxWDG);
+}
+
+/**
+ * @brief Reports the liveness of a checkpoint, and logs its remaining slack.
+ * @param pxWDG: pointer to the WDG handle structure
+ * @param ucCheckpoint: index of the checkpoint
+ */
+void WDG_vCheckIn(WDG_HandleType * pxWDG, uint8_t ucCheckpoint)
+{
+    WDG_CheckpointType * pxCheckpoint = &pxWDG->Checkpoints[ucCheckpoint];
+    uint16_t usSlack = 0;
+
+    XPD_ENTER_CRITICAL(pxWDG);
+
+    if (pxCheckpoint->Elapsed < pxCheckpoint->Deadline)
+    {
+        usSlack = pxCheckpoint->Deadline - pxCheckpoint->Elapsed;
+    }
+    if (usSlack < pxCheckpoint->MinSlack)
+    {
+        pxCheckpoint->MinSlack = usSlack;
+    }
+    pxCheckpoint->Elapsed = 0;
+
+    XPD_EXIT_CRITICAL(pxWDG);
+}
+
+/**
+ * @brief Periodic watchdog service, refreshes the hardware watchdog
+ *        if none of the registered checkpoints are late.
+ * @note  The first period a checkpoint becomes late the Stall callback is called.
+ * @param pxWDG: pointer to the WDG handle structure
+ */
+void WDG_vService(WDG_HandleType * pxWDG)
+{
+    uint32_t ulLate = 0, ulNewLate;
+    uint8_t ucCheckpoint;
+
+    XPD_ENTER_CRITICAL(pxWDG);
+
+    for (ucCheckpoint = 0; ucCheckpoint < pxWDG->Count; ucCheckpoint++)
+    {
+        WDG_CheckpointType * pxCheckpoint = &pxWDG->Checkpoints[ucCheckpoint];
+
+        if ((pxWDG->Registered & (1UL << ucCheckpoint)) == 0)
+        {
+            continue;
+        }
+        if (pxCheckpoint->Elapsed < 0xFFFF)
+        {
+            pxCheckpoint->Elapsed++;
+        }
+        if (pxCheckpoint->Elapsed > pxCheckpoint->Deadline)
+        {
+            ulLate |= 1UL << ucCheckpoint;
+        }
+    }
+
+    XPD_EXIT_CRITICAL(pxWDG);
+
+    pxWDG->Periods++;
+    if (pxWDG->SinceRefresh < 0xFFFF)
+    {
+        pxWDG->SinceRefresh++;
+    }
+
+    ulNewLate = ulLate & ~pxWDG->Late;
+    pxWDG->Late = ulLate;
+
+    if (ulLate == 0)
+    {
+        /* log the closest approach to the hardware expiry */
+        uint16_t usMargin = 0;
+
+        if (pxWDG->SinceRefresh < pxWDG->Timeout)
+        {
+            usMargin = pxWDG->Timeout - pxWDG->SinceRefresh;
+        }
+        if (usMargin < pxWDG->MinMargin)
+        {
+            pxWDG->MinMargin = usMargin;
+        }
+        pxWDG->SinceRefresh = 0;
+
+        XPD_SAFE_CALLBACK(pxWDG->Callbacks.Refresh, pxWDG);
+    }
+    else if (ulNewLate != 0)
+    {
+        XPD_SAFE_CALLBACK(pxWDG->Callbacks.Stall, pxWDG);
+    }
+}
+
+/**
+ * @brief Captures the supervision state into the handle's Snapshot.
+ * @note  Intended to be called from the WWDG EarlyWakeup callback,
+ *        the application is responsible for preserving the snapshot over the reset.
+ * @param pxWDG: pointer to the WDG handle structure
+ */
+void WDG_vSnapshot(WDG_HandleType * pxWDG)
+{
+    uint32_t ulWorst = 0;
+    uint8_t ucCheckpoint;
+
+    pxWDG->Snapshot.Late         = pxWDG->Late;
+    pxWDG->Snapshot.Periods      = pxWDG->Periods;
+    pxWDG->Snapshot.SinceRefresh = pxWDG->SinceRefresh;
+    pxWDG->Snapshot.Slowest      = 0;
+
+    for (ucCheckpoint = 0; ucCheckpoint < pxWDG->Count; ucCheckpoint++)
+    {
+        WDG_CheckpointType * pxCheckpoint = &pxWDG->Checkpoints[ucCheckpoint];
+
+        /* compare the elapsed periods relative to the deadlines in 8.8 fixed point */
+        uint32_t ulRatio = ((uint32_t)pxCheckpoint->Elapsed << 8) / (pxCheckpoint->Deadline + 1);
+
+        if (((pxWDG->Registered & (1UL << ucCheckpoint)) != 0) && (ulRatio >= ulWorst))
+        {
+            ulWorst = ulRatio;
+            pxWDG->Snapshot.Slowest = ucCheckpoint;
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
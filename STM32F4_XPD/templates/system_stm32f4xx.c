@@ -40,6 +40,20 @@ uint32_t SystemCoreClock;
  */
 void SystemInit(void)
 {
+#ifdef __XPD_CCMRAM_INIT
+    {
+        /* Copy the initial values of the CCM RAM variables */
+        extern uint32_t _siccmram, _sccmram, _eccmram;
+        const uint32_t * pulSrc = &_siccmram;
+        uint32_t * pulDest;
+
+        for (pulDest = &_sccmram; pulDest < &_eccmram; pulDest++)
+        {
+            *pulDest = *pulSrc++;
+        }
+    }
+#endif
+
     /* Reset all peripherals */
     XPD_vDeinit();
 
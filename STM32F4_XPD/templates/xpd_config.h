@@ -29,16 +29,35 @@
 /* TODO step 2: enable desired used XPD modules error handling */
 /* #define __XPD_DMA_ERROR_DETECT */
 
-/* TODO step 3: specify power supplies */
+/* TODO step 3: disable unused XPD module features to reduce code size */
+/* #define __XPD_CAN_NO_FIFO1
+#define __XPD_SPI_NO_DMA
+#define __XPD_TIM_NO_DMA
+#define __XPD_USART_NO_CTS
+#define __XPD_USART_NO_DMA
+#define __XPD_USART_NO_IRDA
+#define __XPD_USART_NO_LIN
+#define __XPD_USART_NO_MULTISLAVE
+#define __XPD_USART_NO_SMARTCARD
+#define __XPD_USART_NO_WAKEUP */
+
+/* TODO step 4: specify power supplies */
 #define VDD_VALUE_mV                   3000 /* Value of VDD in mV */
 #define VDDA_VALUE_mV                  3000 /* Value of VDD Analog in mV */
 
-/* TODO step 4: specify oscillator parameters */
+/* TODO step 5: specify oscillator parameters */
 /* #define HSE_VALUE_Hz 80000000
  * #define LSE_VALUE_Hz 32768 */
 
-/* TODO step 5: specify vector table location */
+/* TODO step 6: specify vector table location */
 /* #define VECT_TAB_SRAM
 #define VECT_TAB_OFFSET  0x0  *//* Vector Table base offset field. This value must be a multiple of 0x200. */
 
+/* TODO step 7: include the RTOS port to make the RTOS module transfers sleep instead of polling */
+/* #include <xpd_rtos_port.h> */
+
+/* TODO step 8: place interrupt-hot data in the CCM RAM (requires the xpd_ccmram.ld linker script template) */
+/* #define __XPD_CCMRAM_INIT
+#define XPD_FAST_DATA __ccmram */
+
 #endif /* __XPD_CONFIG_H_ */
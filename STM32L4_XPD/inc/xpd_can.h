@@ -409,7 +409,9 @@ XPD_ReturnType  CAN_eReceive_IT         (CAN_HandleType * pxCAN, CAN_FrameType *
                                          uint8_t ucFIFONumber);
 
 void            CAN_vIRQHandlerRX0      (CAN_HandleType * pxCAN);
+#ifndef __XPD_CAN_NO_FIFO1
 void            CAN_vIRQHandlerRX1      (CAN_HandleType * pxCAN);
+#endif /* __XPD_CAN_NO_FIFO1 */
 /** @} */
 
 /** @} */
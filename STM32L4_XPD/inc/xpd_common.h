@@ -172,6 +172,22 @@ typedef void ( *XPD_HandleCallbackType )    ( void * Handle );
 #define XPD_SAFE_CALLBACK(CALLBACK, ...)        \
     do{ if ((CALLBACK) != NULL) (void) CALLBACK(__VA_ARGS__); }while(0)
 
+/**
+ * @brief  Defines an interrupt vector handler which is statically bound to a peripheral handle,
+ *         so the driver interrupt handler is called with a constant handle address.
+ *         DMA streams are bound with @ref DMA_IRQ_BIND instead.
+ * @param  VECTOR: the interrupt vector name without the _IRQHandler suffix
+ * @param  IRQ_HANDLER: the driver interrupt handler function
+ * @param  HANDLE: pointer to the peripheral handle
+ *
+ * @code
+ * XPD_IRQ_BIND(USART2, USART_vIRQHandler, &xConsole);
+ * XPD_IRQ_BIND(CAN1_RX0, CAN_vIRQHandlerRX0, &xCanBus);
+ * @endcode
+ */
+#define XPD_IRQ_BIND(VECTOR, IRQ_HANDLER, HANDLE)   \
+    void VECTOR##_IRQHandler(void) { IRQ_HANDLER(HANDLE); }
+
 /** @} */
 
 /** @} */
@@ -220,6 +236,19 @@ typedef void ( *XPD_HandleCallbackType )    ( void * Handle );
 
 #include <xpd_config.h>
 
+/**
+ * @brief  Places a variable in the SRAM2 (.sram2 section of the linker script).
+ *         SRAM2 is a separate zero-wait-state bank, so the interrupt-hot data
+ *         (handles, callback tables, trace rings) placed here is not delayed by DMA transfers to SRAM1.
+ * @note   The initial values are copied by SystemInit() if __XPD_SRAM2_INIT is defined.
+ */
+#define __sram2                                 __attribute__((section(".sram2")))
+
+#ifndef XPD_FAST_DATA
+/** @brief Placement of the interrupt-hot data owned by the drivers (e.g. EXTI_xPinCallbacks) */
+#define XPD_FAST_DATA
+#endif
+
 #ifdef __cplusplus
 }
 #endif
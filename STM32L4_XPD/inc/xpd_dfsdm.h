@@ -0,0 +1,247 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dfsdm.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital Filter for Sigma-Delta Modulators Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_DFSDM_H_
+#define __XPD_DFSDM_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(DFSDM1_Filter0)
+
+/** @defgroup DFSDM
+ * @{ */
+
+/** @defgroup DFSDM_Exported_Types DFSDM Exported Types
+ * @{ */
+
+/** @brief DFSDM serial interface types */
+typedef enum
+{
+    DFSDM_SERIAL_SPI_RISING         = 0,                    /*!< SPI, data sampled on rising edge */
+    DFSDM_SERIAL_SPI_FALLING        = DFSDM_CHCFGR1_SITP_0, /*!< SPI, data sampled on falling edge */
+    DFSDM_SERIAL_MANCHESTER_RISING  = DFSDM_CHCFGR1_SITP_1, /*!< Manchester coded, rising edge is logic 0 */
+    DFSDM_SERIAL_MANCHESTER_FALLING = DFSDM_CHCFGR1_SITP,   /*!< Manchester coded, rising edge is logic 1 */
+}DFSDM_SerialType;
+
+/** @brief DFSDM channel SPI clock selection */
+typedef enum
+{
+    DFSDM_SPICLOCK_EXTERNAL         = 0,                        /*!< External CKINy input */
+    DFSDM_SPICLOCK_OUTPUT           = DFSDM_CHCFGR1_SPICKSEL_0, /*!< Internal CKOUT clock */
+    DFSDM_SPICLOCK_OUTPUT_DIV2_FALL = DFSDM_CHCFGR1_SPICKSEL_1, /*!< CKOUT / 2, sampling on every second falling edge */
+    DFSDM_SPICLOCK_OUTPUT_DIV2_RISE = DFSDM_CHCFGR1_SPICKSEL,   /*!< CKOUT / 2, sampling on every second rising edge */
+}DFSDM_SpiClockType;
+
+/** @brief DFSDM input channel setup structure */
+typedef struct
+{
+    DFSDM_SerialType   Interface;       /*!< Serial interface type and sampling edge */
+    DFSDM_SpiClockType SpiClock;        /*!< Serial clock selection (SPI interfaces only) */
+    FunctionalState    InputFromNext;   /*!< Take the serial inputs from the pins of the next channel
+                                             (two PDM microphones sharing a data line) */
+    int32_t            Offset;          /*!< 24 bit offset subtracted from the conversion results */
+    uint8_t            RightShift;      /*!< Right shift of the conversion results [0 .. 31] */
+}DFSDM_ChannelInitType;
+
+/** @brief DFSDM sinc filter orders */
+typedef enum
+{
+    DFSDM_FILTER_FASTSINC = 0, /*!< FastSinc filter */
+    DFSDM_FILTER_SINC1    = 1, /*!< Sinc1 filter */
+    DFSDM_FILTER_SINC2    = 2, /*!< Sinc2 filter */
+    DFSDM_FILTER_SINC3    = 3, /*!< Sinc3 filter */
+    DFSDM_FILTER_SINC4    = 4, /*!< Sinc4 filter */
+    DFSDM_FILTER_SINC5    = 5, /*!< Sinc5 filter */
+}DFSDM_FilterOrderType;
+
+/** @brief DFSDM filter setup structure */
+typedef struct
+{
+    uint8_t               Channel;                  /*!< Regular conversion input channel [0 .. 7] */
+    DFSDM_FilterOrderType Order;                    /*!< Sinc filter order */
+    uint16_t              Oversampling;             /*!< Sinc filter decimation ratio [1 .. 1024] */
+    uint16_t              IntegratorOversampling;   /*!< Integrator averaging length [1 .. 256] */
+    FunctionalState       FastMode;                 /*!< Fast continuous conversion mode
+                                                         (the filter settling is only waited at start) */
+    FunctionalState       SyncWithFilter0;          /*!< Start the regular conversion together with filter 0 */
+}DFSDM_InitType;
+
+/** @brief DFSDM analog watchdog setup structure */
+typedef struct
+{
+    uint8_t ChannelMask;    /*!< Bit mask of the guarded input channels */
+    int32_t HighThreshold;  /*!< 24 bit high threshold of the conversion results */
+    int32_t LowThreshold;   /*!< 24 bit low threshold of the conversion results */
+}DFSDM_WatchdogInitType;
+
+/** @brief DFSDM error types */
+typedef enum
+{
+    DFSDM_ERROR_NONE     = 0, /*!< No error */
+    DFSDM_ERROR_OVERRUN  = 1, /*!< Regular conversion data overrun */
+    DFSDM_ERROR_DMA      = 2, /*!< DMA transfer error */
+}DFSDM_ErrorType;
+
+/** @brief DFSDM filter Handle structure */
+typedef struct
+{
+    DFSDM_Filter_TypeDef * Inst;             /*!< The address of the filter instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Conversion;   /*!< Block of conversions complete callback, Block can be processed */
+        XPD_HandleCallbackType Watchdog;     /*!< Analog watchdog threshold crossed callback */
+        XPD_HandleCallbackType Error;        /*!< Overrun or DMA error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    DMA_HandleType * DMA;                    /*!< DMA handle for the regular conversion data */
+    struct {
+        uint32_t * Buffer;                   /*!< [Internal] Start of the stream buffer */
+        uint16_t HalfLength;                 /*!< [Internal] Half of the buffer length in conversions */
+    }Stream;                                 /*   DMA stream buffer */
+    uint32_t * volatile Block;               /*!< The buffer half which is available to the application */
+    volatile uint16_t WatchdogEvents;        /*!< Channels that crossed the low [7:0] and high [15:8] thresholds */
+    volatile DFSDM_ErrorType Errors;         /*!< Conversion errors */
+}DFSDM_HandleType;
+
+/** @} */
+
+/** @defgroup DFSDM_Exported_Macros DFSDM Exported Macros
+ * @{ */
+
+/**
+ * @brief DFSDM Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the DFSDM filter instance.
+ */
+#define         DFSDM_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief DFSDM register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         DFSDM_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified DFSDM filter flag.
+ * @param  HANDLE: specifies the DFSDM Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg JEOCF:   End of injected conversion
+ *            @arg REOCF:   End of regular conversion
+ *            @arg JOVRF:   Injected conversion overrun
+ *            @arg ROVRF:   Regular conversion overrun
+ *            @arg AWDF:    Analog watchdog
+ *            @arg JCIP:    Injected conversion in progress
+ *            @arg RCIP:    Regular conversion in progress
+ *            @arg CKABF:   Clock absence (channel bit mask, filter 0 only)
+ *            @arg SCDF:    Short circuit detector (channel bit mask, filter 0 only)
+ */
+#define         DFSDM_FLAG_STATUS(HANDLE, FLAG_NAME)        \
+    (DFSDM_REG_BIT((HANDLE),FLTISR,FLAG_NAME))
+
+/**
+ * @brief  Converts a raw regular data register value to a signed conversion result.
+ * @param  RAW: the FLTRDATAR value transferred by the DMA
+ */
+#define         DFSDM_RESULT(RAW)                           \
+    (((int32_t)(RAW)) >> DFSDM_FLTRDATAR_RDATA_Pos)
+
+/**
+ * @brief  Gets the input channel of a raw regular data register value.
+ * @param  RAW: the FLTRDATAR value transferred by the DMA
+ */
+#define         DFSDM_RESULT_CHANNEL(RAW)                   \
+    ((RAW) & DFSDM_FLTRDATAR_RDATACH)
+
+/** @} */
+
+/** @addtogroup DFSDM_Exported_Functions
+ * @{ */
+XPD_ReturnType  DFSDM_eInterfaceInit    (uint32_t ulClockOut_Hz);
+void            DFSDM_vInterfaceDeinit  (void);
+
+void            DFSDM_vChannelInit      (DFSDM_Channel_TypeDef * pxChannel,
+                                         const DFSDM_ChannelInitType * pxConfig);
+void            DFSDM_vChannelDeinit    (DFSDM_Channel_TypeDef * pxChannel);
+
+XPD_ReturnType  DFSDM_eFilterCalc       (DFSDM_InitType * pxConfig,
+                                         uint32_t ulBitRate,
+                                         uint32_t ulOutputRate,
+                                         uint8_t * pucRightShift);
+
+void            DFSDM_vInit             (DFSDM_HandleType * pxDFSDM,
+                                         const DFSDM_InitType * pxConfig);
+void            DFSDM_vDeinit           (DFSDM_HandleType * pxDFSDM);
+
+XPD_ReturnType  DFSDM_eStart_DMA        (DFSDM_HandleType * pxDFSDM,
+                                         uint32_t * pulBuffer,
+                                         uint16_t usLength);
+void            DFSDM_vStop_DMA         (DFSDM_HandleType * pxDFSDM);
+
+void            DFSDM_vIRQHandler       (DFSDM_HandleType * pxDFSDM);
+
+void            DFSDM_vExtremesStart    (DFSDM_HandleType * pxDFSDM,
+                                         uint8_t ucChannelMask);
+void            DFSDM_vGetExtremes      (DFSDM_HandleType * pxDFSDM,
+                                         int32_t * plMax,
+                                         int32_t * plMin);
+
+void            DFSDM_vWatchdogInit     (DFSDM_HandleType * pxDFSDM,
+                                         const DFSDM_WatchdogInitType * pxConfig);
+void            DFSDM_vWatchdogDeinit   (DFSDM_HandleType * pxDFSDM);
+
+/**
+ * @brief Gets the error state of the DFSDM filter.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @return Current DFSDM error state
+ */
+__STATIC_INLINE DFSDM_ErrorType DFSDM_eGetError(DFSDM_HandleType * pxDFSDM)
+{
+    return pxDFSDM->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#define XPD_DFSDM_API
+#include <xpd_rcc_pc.h>
+#undef XPD_DFSDM_API
+
+#endif /* DFSDM1_Filter0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_DFSDM_H_ */
@@ -4,7 +4,7 @@
   * @author  Benedek Kupper
   * @version 0.1
   * @date    2018-01-28
-  * @brief   STM32 eXtensible Peripheral Drivers CEC Module
+  * @brief   STM32 eXtensible Peripheral Drivers I2S Module
   *
   * Copyright (c) 2018 Benedek Kupper
   *
@@ -0,0 +1,169 @@
+/**
+  ******************************************************************************
+  * @file    xpd_lptim.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Low Power Timer Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_LPTIM_H_
+#define __XPD_LPTIM_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(LPTIM1)
+
+/** @defgroup LPTIM
+ * @{ */
+
+/** @defgroup LPTIM_Exported_Types LPTIM Exported Types
+ * @{ */
+
+/** @brief LPTIM counter sources */
+typedef enum
+{
+    LPTIM_COUNTER_INTERNAL     = 0,                    /*!< The counter is clocked by the kernel clock */
+    LPTIM_COUNTER_INPUT1       = LPTIM_CFGR_COUNTMODE, /*!< The counter counts the IN1 edges,
+                                                            sampled and filtered by the kernel clock */
+    LPTIM_COUNTER_INPUT1_ASYNC = LPTIM_CFGR_CKSEL,     /*!< The counter is clocked directly by IN1,
+                                                            pulses are counted without any kernel clock */
+}LPTIM_CounterSourceType;
+
+/** @brief LPTIM setup structure */
+typedef struct
+{
+    ClockDividerType        Prescaler;      /*!< Counter clock prescaler [CLK_DIV1 .. CLK_DIV128] */
+    LPTIM_CounterSourceType CounterSource;  /*!< Counter clock source */
+    EdgeType                InputEdge;      /*!< Counted edges of IN1 (external counter sources only) */
+    uint8_t                 InputFilter;    /*!< IN1 digital filter: 0 - off, 1 - 2, 2 - 4, 3 - 8
+                                                 consecutive samples (LPTIM_COUNTER_INPUT1 only) */
+}LPTIM_InitType;
+
+/** @brief LPTIM Handle structure */
+typedef struct
+{
+    LPTIM_TypeDef * Inst;                    /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs) */
+        XPD_HandleCallbackType Compare;      /*!< Compare match callback */
+        XPD_HandleCallbackType Overflow;     /*!< Counter period elapsed callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
+    volatile uint32_t Overflows;             /*!< Elapsed counter periods since the start */
+    volatile boolean_t CompareBusy;          /*!< [Internal] Compare register write is in progress */
+}LPTIM_HandleType;
+
+/** @} */
+
+/** @defgroup LPTIM_Exported_Macros LPTIM Exported Macros
+ * @{ */
+
+/**
+ * @brief LPTIM Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the LPTIM peripheral instance.
+ */
+#define         LPTIM_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief LPTIM register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         LPTIM_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified LPTIM flag.
+ * @param  HANDLE: specifies the LPTIM Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg CMPM:    Compare match
+ *            @arg ARRM:    Autoreload match
+ *            @arg EXTTRIG: External trigger edge
+ *            @arg CMPOK:   Compare register update finished
+ *            @arg ARROK:   Autoreload register update finished
+ *            @arg UP:      Counter direction change down to up
+ *            @arg DOWN:    Counter direction change up to down
+ */
+#define         LPTIM_FLAG_STATUS(HANDLE, FLAG_NAME)        \
+    (LPTIM_REG_BIT((HANDLE),ISR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified LPTIM flag.
+ * @param  HANDLE: specifies the LPTIM Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg CMPM:    Compare match
+ *            @arg ARRM:    Autoreload match
+ *            @arg EXTTRIG: External trigger edge
+ *            @arg CMPOK:   Compare register update finished
+ *            @arg ARROK:   Autoreload register update finished
+ *            @arg UP:      Counter direction change down to up
+ *            @arg DOWN:    Counter direction change up to down
+ */
+#define         LPTIM_FLAG_CLEAR(HANDLE, FLAG_NAME)         \
+    ((HANDLE)->Inst->ICR.w = LPTIM_ICR_##FLAG_NAME##CF)
+
+/** @} */
+
+/** @addtogroup LPTIM_Exported_Functions
+ * @{ */
+void            LPTIM_vInit             (LPTIM_HandleType * pxLPTIM,
+                                         const LPTIM_InitType * pxConfig);
+void            LPTIM_vDeinit           (LPTIM_HandleType * pxLPTIM);
+
+XPD_ReturnType  LPTIM_eStart_IT         (LPTIM_HandleType * pxLPTIM,
+                                         uint16_t usPeriod);
+void            LPTIM_vStop_IT          (LPTIM_HandleType * pxLPTIM);
+
+XPD_ReturnType  LPTIM_eSetCompare       (LPTIM_HandleType * pxLPTIM,
+                                         uint16_t usCompare);
+XPD_ReturnType  LPTIM_eSetWakeup        (LPTIM_HandleType * pxLPTIM,
+                                         uint16_t usTicks);
+
+uint16_t        LPTIM_usGetCounter      (LPTIM_HandleType * pxLPTIM);
+uint32_t        LPTIM_ulGetCounter      (LPTIM_HandleType * pxLPTIM);
+uint32_t        LPTIM_ulCounterFreq_Hz  (LPTIM_HandleType * pxLPTIM);
+
+void            LPTIM_vIRQHandler       (LPTIM_HandleType * pxLPTIM);
+
+/** @} */
+
+/** @} */
+
+#define XPD_LPTIM_API
+#include <xpd_rcc_pc.h>
+#undef XPD_LPTIM_API
+
+#endif /* LPTIM1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_LPTIM_H_ */
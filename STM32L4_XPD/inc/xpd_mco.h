@@ -95,10 +95,13 @@ __STATIC_INLINE void MCO_vInit(
 {
     static const GPIO_InitType xMCOPinCfg = {
         .Mode = GPIO_MODE_ALTERNATE,
-        .AlternateMap = GPIO_MCO_AF0,
-        .Output.Speed = VERY_HIGH,
-        .Output.Type = GPIO_OUTPUT_PUSHPULL,
         .Pull = GPIO_PULL_FLOAT,
+        .Output = { .Type = GPIO_OUTPUT_PUSHPULL, .Speed = VERY_HIGH },
+        .ExtI = { .Edge = EDGE_NONE, .Reaction = REACTION_NONE },
+        .AlternateMap = GPIO_MCO_AF0,
+#ifdef PWR_CR3_APC
+        .PowerDownPull = GPIO_PULL_FLOAT,
+#endif
     };
 
     {
@@ -135,8 +138,10 @@ __STATIC_INLINE void LSCO_vInit(LSCO_ClockSourceType eLSCOSource)
 {
     const GPIO_InitType xLSCOPinCfg = {
         .Mode = GPIO_MODE_ANALOG,
-        .AlternateMap = 0,
         .Pull = GPIO_PULL_FLOAT,
+        .Output = { .Type = GPIO_OUTPUT_PUSHPULL, .Speed = LOW },
+        .ExtI = { .Edge = EDGE_NONE, .Reaction = REACTION_NONE },
+        .AlternateMap = 0,
         .PowerDownPull = GPIO_PULL_FLOAT,
     };
     uint32_t ulCR1 = PWR->CR1.w;
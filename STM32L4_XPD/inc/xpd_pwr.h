@@ -308,7 +308,7 @@ XPD_ReturnType  PWR_eVoltageScaleConfig     (PWR_RegVoltScaleType eScaling);
  */
 __STATIC_INLINE PWR_RegVoltScaleType PWR_eGetVoltageScale(void)
 {
-    return PWR->CR1.b.VOS;
+    return (PWR_RegVoltScaleType)PWR->CR1.b.VOS;
 }
 
 /** @} */
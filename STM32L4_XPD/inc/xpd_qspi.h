@@ -0,0 +1,300 @@
+/**
+  ******************************************************************************
+  * @file    xpd_qspi.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Quad-SPI Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_QSPI_H_
+#define __XPD_QSPI_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(QUADSPI)
+
+/** @defgroup QSPI
+ * @{ */
+
+/** @defgroup QSPI_Exported_Types QSPI Exported Types
+ * @{ */
+
+/** @brief QSPI clock mode types */
+typedef enum
+{
+    QSPI_CLOCKMODE_0 = 0, /*!< CLK stays low while nCS is high */
+    QSPI_CLOCKMODE_3 = 1, /*!< CLK stays high while nCS is high */
+}QSPI_ClockModeType;
+
+/** @brief QSPI phase line count types */
+typedef enum
+{
+    QSPI_LINES_NONE = 0, /*!< The phase is skipped */
+    QSPI_LINES_1    = 1, /*!< The phase is transferred on a single line */
+    QSPI_LINES_2    = 2, /*!< The phase is transferred on two lines */
+    QSPI_LINES_4    = 3, /*!< The phase is transferred on four lines */
+}QSPI_LinesType;
+
+/** @brief QSPI address and alternate bytes size types */
+typedef enum
+{
+    QSPI_SIZE_8BIT  = 0, /*!< 8 bit field */
+    QSPI_SIZE_16BIT = 1, /*!< 16 bit field */
+    QSPI_SIZE_24BIT = 2, /*!< 24 bit field */
+    QSPI_SIZE_32BIT = 3, /*!< 32 bit field */
+}QSPI_SizeType;
+
+/** @brief QSPI status polling match mode types */
+typedef enum
+{
+    QSPI_MATCH_AND = 0, /*!< All unmasked status bits have to match */
+    QSPI_MATCH_OR  = 1, /*!< Any unmasked status bit has to match */
+}QSPI_MatchModeType;
+
+/** @brief QSPI error types */
+typedef enum
+{
+    QSPI_ERROR_NONE     = 0, /*!< No error */
+    QSPI_ERROR_TRANSFER = 1, /*!< Invalid address is accessed in indirect mode */
+    QSPI_ERROR_DMA      = 2, /*!< DMA transfer error */
+}QSPI_ErrorType;
+
+/** @brief QSPI setup structure */
+typedef struct
+{
+    uint8_t            Prescaler;       /*!< The QSPI bus clock is HCLK / (Prescaler + 1) */
+    uint8_t            FlashSize;       /*!< The flash memory size is 2 ^ (FlashSize + 1) bytes */
+    uint8_t            CSHighTime;      /*!< Minimum chip select high time in bus clock cycles [1 .. 8] */
+    uint8_t            FifoThreshold;   /*!< FIFO threshold for DMA requests in bytes [1 .. 16] */
+    QSPI_ClockModeType ClockMode;       /*!< Clock level while the chip select is inactive */
+    FunctionalState    SampleShift;     /*!< Input sampling is shifted by half a clock cycle */
+}QSPI_InitType;
+
+/** @brief QSPI command structure */
+typedef struct
+{
+    uint8_t            Instruction;     /*!< Instruction code */
+    QSPI_LinesType     InstructionLines;/*!< Lines used for the instruction */
+    QSPI_LinesType     AddressLines;    /*!< Lines used for the address */
+    QSPI_SizeType      AddressSize;     /*!< Size of the address */
+    QSPI_LinesType     AltBytesLines;   /*!< Lines used for the alternate bytes */
+    QSPI_SizeType      AltBytesSize;    /*!< Size of the alternate bytes */
+    uint32_t           AltBytes;        /*!< Alternate bytes content */
+    uint8_t            DummyCycles;     /*!< Number of dummy cycles before the data phase [0 .. 31] */
+    QSPI_LinesType     DataLines;       /*!< Lines used for the data */
+    FunctionalState    DDR;             /*!< Address, alternate bytes and data are sampled on both clock edges */
+    FunctionalState    SendInstrOnce;   /*!< The instruction is only sent for the first access in memory-mapped mode */
+}QSPI_CommandType;
+
+/** @brief QSPI automatic status polling structure */
+typedef struct
+{
+    uint32_t           Match;           /*!< The expected status value */
+    uint32_t           Mask;            /*!< The status bits which are compared */
+    uint16_t           Interval;        /*!< Number of bus clock cycles between two status reads */
+    uint8_t            StatusBytes;     /*!< Size of the status in bytes [1 .. 4] */
+    QSPI_MatchModeType MatchMode;       /*!< Status bits evaluation method */
+}QSPI_PollingType;
+
+/** @brief QSPI Handle structure */
+typedef struct
+{
+    QUADSPI_TypeDef * Inst;                  /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType Transmit;     /*!< Indirect data transmission complete callback */
+        XPD_HandleCallbackType Receive;      /*!< Indirect data reception complete callback */
+        XPD_HandleCallbackType StatusMatch;  /*!< Automatic status polling match callback */
+        XPD_HandleCallbackType Error;        /*!< Transfer error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    DMA_HandleType * DMA;                    /*!< DMA handle reference for indirect transfers */
+    volatile QSPI_ErrorType Errors;          /*!< Transfer errors */
+}QSPI_HandleType;
+
+/** @} */
+
+/** @defgroup QSPI_Exported_Macros QSPI Exported Macros
+ * @{ */
+
+/** @brief Start address of the memory-mapped flash region */
+#define         QSPI_MEMORY_BASE                            \
+    ((void *)QSPI_BASE)
+
+/**
+ * @brief QSPI Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the QSPI peripheral instance.
+ */
+#define         QSPI_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief QSPI register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         QSPI_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Enable the specified QSPI interrupt.
+ * @param  HANDLE: specifies the QSPI Handle.
+ * @param  IT_NAME: specifies the interrupt to enable.
+ *         This parameter can be one of the following values:
+ *            @arg TE:      Transfer error
+ *            @arg TC:      Transfer complete
+ *            @arg FT:      FIFO threshold
+ *            @arg SM:      Status match
+ *            @arg TO:      Timeout
+ */
+#define         QSPI_IT_ENABLE(HANDLE, IT_NAME)             \
+    (QSPI_REG_BIT((HANDLE),CR,IT_NAME##IE) = 1)
+
+/**
+ * @brief  Disable the specified QSPI interrupt.
+ * @param  HANDLE: specifies the QSPI Handle.
+ * @param  IT_NAME: specifies the interrupt to disable.
+ *         This parameter can be one of the following values:
+ *            @arg TE:      Transfer error
+ *            @arg TC:      Transfer complete
+ *            @arg FT:      FIFO threshold
+ *            @arg SM:      Status match
+ *            @arg TO:      Timeout
+ */
+#define         QSPI_IT_DISABLE(HANDLE, IT_NAME)            \
+    (QSPI_REG_BIT((HANDLE),CR,IT_NAME##IE) = 0)
+
+/**
+ * @brief  Get the specified QSPI flag.
+ * @param  HANDLE: specifies the QSPI Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg TEF:     Transfer error
+ *            @arg TCF:     Transfer complete
+ *            @arg FTF:     FIFO threshold
+ *            @arg SMF:     Status match
+ *            @arg TOF:     Timeout
+ *            @arg BUSY:    Busy
+ */
+#define         QSPI_FLAG_STATUS(HANDLE, FLAG_NAME)         \
+    (QSPI_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified QSPI flag.
+ * @param  HANDLE: specifies the QSPI Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg TEF:     Transfer error
+ *            @arg TCF:     Transfer complete
+ *            @arg SMF:     Status match
+ *            @arg TOF:     Timeout
+ */
+#define         QSPI_FLAG_CLEAR(HANDLE, FLAG_NAME)          \
+    ((HANDLE)->Inst->FCR.w = QUADSPI_FCR_C##FLAG_NAME)
+
+/** @} */
+
+/** @addtogroup QSPI_Exported_Functions
+ * @{ */
+void            QSPI_vInit              (QSPI_HandleType * pxQSPI,
+                                         const QSPI_InitType * pxConfig);
+void            QSPI_vDeinit            (QSPI_HandleType * pxQSPI);
+
+XPD_ReturnType  QSPI_eCommand           (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint32_t ulAddress,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  QSPI_eTransmit          (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint32_t ulAddress,
+                                         const void * pvData,
+                                         uint32_t ulLength,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  QSPI_eReceive           (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint32_t ulAddress,
+                                         void * pvData,
+                                         uint32_t ulLength,
+                                         uint32_t ulTimeout);
+
+XPD_ReturnType  QSPI_eTransmit_DMA      (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint32_t ulAddress,
+                                         const void * pvData,
+                                         uint16_t usLength);
+XPD_ReturnType  QSPI_eReceive_DMA       (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint32_t ulAddress,
+                                         void * pvData,
+                                         uint16_t usLength);
+
+XPD_ReturnType  QSPI_eAutoPolling       (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         const QSPI_PollingType * pxPolling,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  QSPI_eAutoPolling_IT    (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         const QSPI_PollingType * pxPolling);
+
+XPD_ReturnType  QSPI_eMemoryMapped      (QSPI_HandleType * pxQSPI,
+                                         const QSPI_CommandType * pxCommand,
+                                         uint16_t usTimeoutCycles);
+
+void            QSPI_vAbort             (QSPI_HandleType * pxQSPI);
+
+void            QSPI_vIRQHandler        (QSPI_HandleType * pxQSPI);
+
+/**
+ * @brief Determines whether the QSPI is performing an operation.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @return BUSY if an operation is ongoing, OK if the QSPI is idle
+ */
+__STATIC_INLINE XPD_ReturnType QSPI_eGetStatus(QSPI_HandleType * pxQSPI)
+{
+    return (QSPI_FLAG_STATUS(pxQSPI, BUSY) != 0) ? XPD_BUSY : XPD_OK;
+}
+
+/**
+ * @brief Gets the error state of the QSPI.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @return Current QSPI error state
+ */
+__STATIC_INLINE QSPI_ErrorType QSPI_eGetError(QSPI_HandleType * pxQSPI)
+{
+    return pxQSPI->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* QUADSPI */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_QSPI_H_ */
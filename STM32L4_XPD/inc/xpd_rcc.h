@@ -173,6 +173,10 @@ void            RCC_vClockDisable       (RCC_PositionType PeriphPos);
 void            RCC_vSleepClockEnable   (RCC_PositionType PeriphPos);
 void            RCC_vSleepClockDisable  (RCC_PositionType PeriphPos);
 void            RCC_vReset              (RCC_PositionType PeriphPos);
+
+void            RCC_vClockEnableMulti   (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
+void            RCC_vClockDisableMulti  (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
+void            RCC_vResetMulti         (const RCC_PositionType aePeriphPos[], uint8_t ucCount);
 /** @} */
 
 /** @} */
@@ -338,7 +338,7 @@ void                RCC_vResetAPB2          (void);
  */
 __STATIC_INLINE RCC_ResetSourceType RCC_eGetResetSource(void)
 {
-    return (RCC->CSR.w & (~RCC_CSR_RMVF)) >> 24;
+    return (RCC_ResetSourceType)((RCC->CSR.w & (~RCC_CSR_RMVF)) >> 24);
 }
 
 /**
@@ -85,6 +85,31 @@ uint32_t        ADC_ulClockFreq_Hz  (void);
 
 /** @} */
 
+#elif defined(XPD_DFSDM_API)
+
+/** @ingroup DFSDM
+ * @defgroup DFSDM_Clock_Source DFSDM Clock Source
+ * @{ */
+
+/** @defgroup DFSDM_Clock_Source_Exported_Types DFSDM Clock Source Exported Types
+ * @{ */
+
+/** @brief DFSDM clock source types */
+typedef enum
+{
+    DFSDM_CLOCKSOURCE_PCLK2  = 0, /*!< PCLK2 clock source */
+    DFSDM_CLOCKSOURCE_SYSCLK = 1, /*!< SYSCLK clock source */
+}DFSDM_ClockSourceType;
+/** @} */
+
+/** @addtogroup DFSDM_Clock_Source_Exported_Functions
+ * @{ */
+void            DFSDM_vClockConfig  (DFSDM_ClockSourceType eClockSource);
+uint32_t        DFSDM_ulClockFreq_Hz(void);
+/** @} */
+
+/** @} */
+
 #elif defined(XPD_I2C_API)
 
 /** @ingroup I2C
@@ -111,6 +136,63 @@ uint32_t        I2C_ulClockFreq_Hz  (I2C_HandleType * pxI2C);
 
 /** @} */
 
+#elif defined(XPD_LPTIM_API)
+
+/** @ingroup LPTIM
+ * @defgroup LPTIM_Clock_Source LPTIM Clock Source
+ * @{ */
+
+/** @defgroup LPTIM_Clock_Source_Exported_Types LPTIM Clock Source Exported Types
+ * @{ */
+
+/** @brief LPTIM clock source types */
+typedef enum
+{
+    LPTIM_CLOCKSOURCE_PCLK1 = 0, /*!< PCLK1 clock source */
+    LPTIM_CLOCKSOURCE_LSI   = 1, /*!< LSI clock source */
+    LPTIM_CLOCKSOURCE_HSI   = 2, /*!< HSI clock source */
+    LPTIM_CLOCKSOURCE_LSE   = 3, /*!< LSE clock source */
+}LPTIM_ClockSourceType;
+/** @} */
+
+/** @addtogroup LPTIM_Clock_Source_Exported_Functions
+ * @{ */
+void            LPTIM_vClockConfig  (LPTIM_HandleType * pxLPTIM, LPTIM_ClockSourceType eClockSource);
+uint32_t        LPTIM_ulClockFreq_Hz(LPTIM_HandleType * pxLPTIM);
+/** @} */
+
+/** @} */
+
+#elif defined(XPD_RNG_API)
+
+/** @ingroup RNG
+ * @defgroup RNG_Clock_Source RNG Clock Source
+ * @{ */
+
+/** @defgroup RNG_Clock_Source_Exported_Types RNG Clock Source Exported Types
+ * @{ */
+
+/** @brief RNG clock source types */
+typedef enum
+{
+#ifdef RCC_HSI48_SUPPORT
+    RNG_CLOCKSOURCE_HSI48   = 0, /*!< 48MHz HSI clock source */
+#else
+    RNG_CLOCKSOURCE_NONE    = 0, /*!< No clock source */
+#endif
+    RNG_CLOCKSOURCE_PLLSAI1 = 1, /*!< PLLSAI1 Q output clock source */
+    RNG_CLOCKSOURCE_PLL     = 2, /*!< PLL Q output clock source */
+    RNG_CLOCKSOURCE_MSI     = 3, /*!< MSI clock source */
+}RNG_ClockSourceType;
+/** @} */
+
+/** @addtogroup RNG_Clock_Source_Exported_Functions
+ * @{ */
+void            RNG_vClockConfig    (RNG_ClockSourceType eClockSource);
+/** @} */
+
+/** @} */
+
 #elif defined(XPD_RTC_API)
 
 /** @ingroup RTC
@@ -142,6 +224,68 @@ uint32_t        RTC_ulClockFreq_Hz  (void);
 
 /** @} */
 
+#elif defined(XPD_SAI_API)
+
+/** @ingroup SAI
+ * @defgroup SAI_Clock_Source SAI Clock Source
+ * @{ */
+
+/** @defgroup SAI_Clock_Source_Exported_Types SAI Clock Source Exported Types
+ * @{ */
+
+/** @brief SAI clock source types */
+typedef enum
+{
+    SAI_CLOCKSOURCE_PLLSAI1 = 0, /*!< PLLSAI1 P output clock source */
+#ifdef RCC_PLLSAI2_SUPPORT
+    SAI_CLOCKSOURCE_PLLSAI2 = 1, /*!< PLLSAI2 P output clock source */
+#endif
+    SAI_CLOCKSOURCE_PLL     = 2, /*!< PLL P output clock source */
+#ifdef EXTERNAL_CLOCK_VALUE_Hz
+    SAI_CLOCKSOURCE_EXT     = 3, /*!< external clock source */
+#endif
+}SAI_ClockSourceType;
+/** @} */
+
+/** @addtogroup SAI_Clock_Source_Exported_Functions
+ * @{ */
+void            SAI_vClockConfig    (SAI_HandleType * pxSAI, SAI_ClockSourceType eClockSource);
+uint32_t        SAI_ulClockFreq_Hz  (SAI_HandleType * pxSAI);
+/** @} */
+
+/** @} */
+
+#elif defined(XPD_SDMMC_API)
+
+/** @ingroup SDMMC
+ * @defgroup SDMMC_Clock_Source SDMMC Clock Source
+ * @{ */
+
+/** @defgroup SDMMC_Clock_Source_Exported_Types SDMMC Clock Source Exported Types
+ * @{ */
+
+/** @brief SDMMC clock source types */
+typedef enum
+{
+#ifdef RCC_HSI48_SUPPORT
+    SDMMC_CLOCKSOURCE_HSI48   = 0, /*!< 48MHz HSI clock source */
+#else
+    SDMMC_CLOCKSOURCE_NONE    = 0, /*!< No clock source */
+#endif
+    SDMMC_CLOCKSOURCE_PLLSAI1 = 1, /*!< PLLSAI1 Q output clock source */
+    SDMMC_CLOCKSOURCE_PLL     = 2, /*!< PLL Q output clock source */
+    SDMMC_CLOCKSOURCE_MSI     = 3, /*!< MSI clock source */
+}SDMMC_ClockSourceType;
+/** @} */
+
+/** @addtogroup SDMMC_Clock_Source_Exported_Functions
+ * @{ */
+void            SDMMC_vClockConfig  (SDMMC_ClockSourceType eClockSource);
+uint32_t        SDMMC_ulClockFreq_Hz(SDMMC_HandleType * pxSDMMC);
+/** @} */
+
+/** @} */
+
 #elif defined(XPD_TIM_API)
 
 /** @ingroup TIM
@@ -0,0 +1,165 @@
+/**
+  ******************************************************************************
+  * @file    xpd_rng.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Random Number Generator Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_RNG_H_
+#define __XPD_RNG_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(RNG)
+
+/** @defgroup RNG
+ * @{ */
+
+/** @defgroup RNG_Exported_Types RNG Exported Types
+ * @{ */
+
+/** @brief RNG error types */
+typedef enum
+{
+    RNG_ERROR_NONE  = 0, /*!< No error */
+    RNG_ERROR_CLOCK = 1, /*!< The RNG clock was too slow compared to HCLK */
+    RNG_ERROR_SEED  = 2, /*!< Seed error, the generator has been reinitialized */
+}RNG_ErrorType;
+
+/** @brief RNG Handle structure */
+typedef struct
+{
+    RNG_TypeDef * Inst;                      /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (IRQs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (IRQs) */
+        XPD_HandleCallbackType Error;        /*!< Clock or seed error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        uint8_t * Buffer;                    /*!< [Internal] Word aligned entropy pool storage */
+        uint16_t Mask;                       /*!< [Internal] Pool size - 1 */
+        volatile uint16_t Head;              /*!< [Internal] Free-running count of produced bytes */
+        volatile uint16_t Tail;              /*!< [Internal] Free-running count of consumed bytes */
+    }Pool;                                   /*   Entropy pool */
+    volatile uint16_t Recoveries;            /*!< Number of reinitializations after seed error */
+    volatile RNG_ErrorType Errors;           /*!< Generator errors */
+}RNG_HandleType;
+
+/** @} */
+
+/** @defgroup RNG_Exported_Macros RNG Exported Macros
+ * @{ */
+
+/**
+ * @brief RNG Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the RNG peripheral instance.
+ */
+#define         RNG_INST2HANDLE(HANDLE,INSTANCE)            \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief RNG register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         RNG_REG_BIT(HANDLE, REG_NAME, BIT_NAME)     \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/**
+ * @brief  Get the specified RNG flag.
+ * @param  HANDLE: specifies the RNG Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg DRDY:    Data ready
+ *            @arg CECS:    Clock error current status
+ *            @arg SECS:    Seed error current status
+ *            @arg CEIS:    Clock error interrupt status
+ *            @arg SEIS:    Seed error interrupt status
+ */
+#define         RNG_FLAG_STATUS(HANDLE, FLAG_NAME)          \
+    (RNG_REG_BIT((HANDLE),SR,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified RNG flag.
+ * @param  HANDLE: specifies the RNG Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg CEIS:    Clock error interrupt status
+ *            @arg SEIS:    Seed error interrupt status
+ */
+#define         RNG_FLAG_CLEAR(HANDLE, FLAG_NAME)           \
+    ((HANDLE)->Inst->SR.w = ~RNG_SR_##FLAG_NAME)
+
+/** @} */
+
+/** @addtogroup RNG_Exported_Functions
+ * @{ */
+void            RNG_vInit               (RNG_HandleType * pxRNG,
+                                         uint32_t * pulPool,
+                                         uint16_t usPoolSize);
+void            RNG_vDeinit             (RNG_HandleType * pxRNG);
+
+uint16_t        RNG_usRead              (RNG_HandleType * pxRNG,
+                                         void * pvData,
+                                         uint16_t usLength);
+
+void            RNG_vIRQHandler         (RNG_HandleType * pxRNG);
+
+/**
+ * @brief Gets the amount of random bytes available in the entropy pool.
+ * @param pxRNG: pointer to the RNG handle structure
+ * @return The number of bytes that can be read without waiting
+ */
+__STATIC_INLINE uint16_t RNG_usAvailable(RNG_HandleType * pxRNG)
+{
+    return pxRNG->Pool.Head - pxRNG->Pool.Tail;
+}
+
+/**
+ * @brief Gets the error state of the RNG.
+ * @param pxRNG: pointer to the RNG handle structure
+ * @return Current RNG error state
+ */
+__STATIC_INLINE RNG_ErrorType RNG_eGetError(RNG_HandleType * pxRNG)
+{
+    return pxRNG->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#define XPD_RNG_API
+#include <xpd_rcc_pc.h>
+#undef XPD_RNG_API
+
+#endif /* RNG */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_RNG_H_ */
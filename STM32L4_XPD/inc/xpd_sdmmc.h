@@ -0,0 +1,331 @@
+/**
+  ******************************************************************************
+  * @file    xpd_sdmmc.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers SD/MMC Host Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_SDMMC_H_
+#define __XPD_SDMMC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_dma.h>
+#include <xpd_rcc.h>
+
+#if defined(SDMMC1)
+
+/** @defgroup SDMMC
+ * @{ */
+
+/** @defgroup SDMMC_Exported_Types SDMMC Exported Types
+ * @{ */
+
+/** @brief SDMMC data bus width types */
+typedef enum
+{
+    SDMMC_BUS_1BIT = 0, /*!< Default bus mode: SDMMC_D0 is used */
+    SDMMC_BUS_4BIT = 1, /*!< 4-wide bus mode: SDMMC_D[3:0] are used */
+}SDMMC_BusWidthType;
+
+/** @brief SD card types */
+typedef enum
+{
+    SDMMC_CARD_NONE = 0, /*!< No card is identified */
+    SDMMC_CARD_SDSC = 1, /*!< Standard capacity card (byte addressing) */
+    SDMMC_CARD_SDHC = 2, /*!< High or extended capacity card (block addressing) */
+}SDMMC_CardType;
+
+/** @brief SDMMC transfer operation types */
+typedef enum
+{
+    SDMMC_OPERATION_READ  = 0, /*!< Blocks are read from the card */
+    SDMMC_OPERATION_WRITE = 1, /*!< Blocks are written to the card */
+}SDMMC_OperationType;
+
+/** @brief SDMMC error types */
+typedef enum
+{
+    SDMMC_ERROR_NONE        = 0x000, /*!< No error */
+    SDMMC_ERROR_CMD_CRC     = 0x001, /*!< Command response CRC check failed */
+    SDMMC_ERROR_DATA_CRC    = 0x002, /*!< Data block CRC check failed */
+    SDMMC_ERROR_CMD_TIMEOUT = 0x004, /*!< Command response timeout */
+    SDMMC_ERROR_DATA_TIMEOUT= 0x008, /*!< Data transfer timeout */
+    SDMMC_ERROR_UNDERRUN    = 0x010, /*!< Transmit FIFO underrun */
+    SDMMC_ERROR_OVERRUN     = 0x020, /*!< Receive FIFO overrun */
+    SDMMC_ERROR_START_BIT   = 0x040, /*!< Start bit not detected on all data lines */
+    SDMMC_ERROR_CARD_STATUS = 0x080, /*!< The card reported an error in its status */
+    SDMMC_ERROR_UNSUPPORTED = 0x100, /*!< The card is not supported or not responding */
+    SDMMC_ERROR_DMA         = 0x200, /*!< DMA transfer error */
+}SDMMC_ErrorType;
+
+/** @brief SDMMC setup structure */
+typedef struct
+{
+    SDMMC_BusWidthType BusWidth;    /*!< Data bus width to use after card identification */
+    FunctionalState    HighSpeed;   /*!< Switch the card to high speed mode (50 MHz) if supported */
+    FunctionalState    PowerSave;   /*!< The bus clock is only output when the bus is active */
+    FunctionalState    FlowControl; /*!< Hardware flow control stops the bus clock instead of FIFO errors */
+}SDMMC_InitType;
+
+/** @brief SD card identification structure */
+typedef struct
+{
+    SDMMC_CardType Type;            /*!< The identified card type */
+    uint16_t       RCA;             /*!< Relative card address */
+    uint32_t       BlockCount;      /*!< The number of 512 byte blocks on the card */
+    uint32_t       CID[4];          /*!< Card identification register */
+    uint32_t       CSD[4];          /*!< Card specific data register */
+}SDMMC_CardInfoType;
+
+/** @brief SDMMC block transfer request structure */
+typedef struct
+{
+    void *                 Buffer;     /*!< Word aligned data buffer of BlockCount * 512 bytes */
+    uint32_t               Address;    /*!< Card block address of the first block */
+    uint16_t               BlockCount; /*!< Number of blocks to transfer [1 .. 511] */
+    SDMMC_OperationType    Operation;  /*!< Direction of the transfer */
+    XPD_HandleCallbackType Callback;   /*!< Request completion callback (called with the request pointer) */
+    volatile XPD_ReturnType Result;    /*!< BUSY while queued or in progress, OK or ERROR when completed */
+}SDMMC_RequestType;
+
+#ifndef SDMMC_QUEUE_LENGTH
+/** @brief Number of requests which can be queued at once (power of 2) */
+#define SDMMC_QUEUE_LENGTH      4
+#endif
+
+/** @brief SDMMC Handle structure */
+typedef struct
+{
+    SDMMC_TypeDef * Inst;                    /*!< The address of the peripheral instance used by the handle */
+#ifdef SDMMC_BB
+    SDMMC_BitBand_TypeDef * Inst_BB;         /*!< The address of the peripheral instance in the bit-band region */
+#endif
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType DepDeinit;    /*!< Callback to restore module dependencies (GPIOs, IRQs, DMAs) */
+        XPD_HandleCallbackType QueueEmpty;   /*!< All queued requests are completed callback */
+        XPD_HandleCallbackType Error;        /*!< Transfer error callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    struct {
+        DMA_HandleType * Transmit;           /*!< DMA handle for block writes (word size) */
+        DMA_HandleType * Receive;            /*!< DMA handle for block reads (word size) */
+    }DMA;                                    /*   DMA handle references */
+    SDMMC_CardInfoType Card;                 /*!< Identified card information */
+    struct {
+        SDMMC_RequestType * volatile Items[SDMMC_QUEUE_LENGTH]; /*!< [Internal] Request ring buffer */
+        volatile uint8_t Head;               /*!< [Internal] Free running index of the active request */
+        volatile uint8_t Tail;               /*!< [Internal] Free running index of the next free slot */
+    }Queue;                                  /*   Asynchronous request queue */
+    volatile uint8_t State;                  /*!< [Internal] Asynchronous transfer state */
+    volatile uint8_t Pending;                /*!< [Internal] Pending completion events of the active transfer */
+    RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
+    volatile SDMMC_ErrorType Errors;         /*!< Transfer errors */
+}SDMMC_HandleType;
+
+/** @} */
+
+/** @defgroup SDMMC_Exported_Macros SDMMC Exported Macros
+ * @{ */
+
+#ifdef SDMMC_BB
+/**
+ * @brief SDMMC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SDMMC peripheral instance.
+ */
+#define         SDMMC_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->Inst_BB = (SDMMC_BitBand_TypeDef *)PERIPH_BB(INSTANCE), \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief SDMMC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         SDMMC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst_BB->REG_NAME.BIT_NAME)
+
+#else
+/**
+ * @brief SDMMC Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the SDMMC peripheral instance.
+ */
+#define         SDMMC_INST2HANDLE(HANDLE,INSTANCE)          \
+    ((HANDLE)->Inst    = (INSTANCE),                        \
+     (HANDLE)->CtrlPos = RCC_POS_##INSTANCE)
+
+/**
+ * @brief SDMMC register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         SDMMC_REG_BIT(HANDLE, REG_NAME, BIT_NAME)   \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+#endif /* SDMMC_BB */
+
+/**
+ * @brief  Enable the specified SDMMC interrupt.
+ * @param  HANDLE: specifies the SDMMC Handle.
+ * @param  IT_NAME: specifies the interrupt to enable.
+ *         This parameter can be one of the following values:
+ *            @arg CCRCFAIL:    Command response CRC fail
+ *            @arg DCRCFAIL:    Data block CRC fail
+ *            @arg CTIMEOUT:    Command response timeout
+ *            @arg DTIMEOUT:    Data timeout
+ *            @arg TXUNDERR:    Transmit FIFO underrun
+ *            @arg RXOVERR:     Receive FIFO overrun
+ *            @arg CMDREND:     Command response received
+ *            @arg CMDSENT:     Command sent
+ *            @arg DATAEND:     Data end
+ *            @arg DBCKEND:     Data block end
+ */
+#define         SDMMC_IT_ENABLE(HANDLE, IT_NAME)            \
+    (SDMMC_REG_BIT((HANDLE),MASK,IT_NAME##IE) = 1)
+
+/**
+ * @brief  Disable the specified SDMMC interrupt.
+ * @param  HANDLE: specifies the SDMMC Handle.
+ * @param  IT_NAME: specifies the interrupt to disable.
+ *         This parameter can be one of the following values:
+ *            @arg CCRCFAIL:    Command response CRC fail
+ *            @arg DCRCFAIL:    Data block CRC fail
+ *            @arg CTIMEOUT:    Command response timeout
+ *            @arg DTIMEOUT:    Data timeout
+ *            @arg TXUNDERR:    Transmit FIFO underrun
+ *            @arg RXOVERR:     Receive FIFO overrun
+ *            @arg CMDREND:     Command response received
+ *            @arg CMDSENT:     Command sent
+ *            @arg DATAEND:     Data end
+ *            @arg DBCKEND:     Data block end
+ */
+#define         SDMMC_IT_DISABLE(HANDLE, IT_NAME)           \
+    (SDMMC_REG_BIT((HANDLE),MASK,IT_NAME##IE) = 0)
+
+/**
+ * @brief  Get the specified SDMMC flag.
+ * @param  HANDLE: specifies the SDMMC Handle.
+ * @param  FLAG_NAME: specifies the flag to return.
+ *         This parameter can be one of the following values:
+ *            @arg CCRCFAIL:    Command response CRC fail
+ *            @arg DCRCFAIL:    Data block CRC fail
+ *            @arg CTIMEOUT:    Command response timeout
+ *            @arg DTIMEOUT:    Data timeout
+ *            @arg TXUNDERR:    Transmit FIFO underrun
+ *            @arg RXOVERR:     Receive FIFO overrun
+ *            @arg CMDREND:     Command response received
+ *            @arg CMDSENT:     Command sent
+ *            @arg DATAEND:     Data end
+ *            @arg DBCKEND:     Data block end
+ *            @arg CMDACT:      Command transfer in progress
+ *            @arg TXACT:       Data transmit in progress
+ *            @arg RXACT:       Data receive in progress
+ *            @arg RXDAVL:      Data available in receive FIFO
+ */
+#define         SDMMC_FLAG_STATUS(HANDLE, FLAG_NAME)        \
+    (SDMMC_REG_BIT((HANDLE),STA,FLAG_NAME))
+
+/**
+ * @brief  Clear the specified SDMMC flag.
+ * @param  HANDLE: specifies the SDMMC Handle.
+ * @param  FLAG_NAME: specifies the flag to clear.
+ *         This parameter can be one of the following values:
+ *            @arg CCRCFAIL:    Command response CRC fail
+ *            @arg DCRCFAIL:    Data block CRC fail
+ *            @arg CTIMEOUT:    Command response timeout
+ *            @arg DTIMEOUT:    Data timeout
+ *            @arg TXUNDERR:    Transmit FIFO underrun
+ *            @arg RXOVERR:     Receive FIFO overrun
+ *            @arg CMDREND:     Command response received
+ *            @arg CMDSENT:     Command sent
+ *            @arg DATAEND:     Data end
+ *            @arg DBCKEND:     Data block end
+ */
+#define         SDMMC_FLAG_CLEAR(HANDLE, FLAG_NAME)         \
+    ((HANDLE)->Inst->ICR.w = SDMMC_ICR_##FLAG_NAME##C)
+
+/** @} */
+
+/** @addtogroup SDMMC_Exported_Functions
+ * @{ */
+XPD_ReturnType  SDMMC_eInit             (SDMMC_HandleType * pxSDMMC,
+                                         const SDMMC_InitType * pxConfig);
+void            SDMMC_vDeinit           (SDMMC_HandleType * pxSDMMC);
+
+XPD_ReturnType  SDMMC_eSubmit           (SDMMC_HandleType * pxSDMMC,
+                                         SDMMC_RequestType * pxRequest);
+XPD_ReturnType  SDMMC_eReadBlocks       (SDMMC_HandleType * pxSDMMC,
+                                         void * pvData,
+                                         uint32_t ulAddress,
+                                         uint16_t usBlockCount,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  SDMMC_eWriteBlocks      (SDMMC_HandleType * pxSDMMC,
+                                         void * pvData,
+                                         uint32_t ulAddress,
+                                         uint16_t usBlockCount,
+                                         uint32_t ulTimeout);
+XPD_ReturnType  SDMMC_eGetCardStatus    (SDMMC_HandleType * pxSDMMC,
+                                         uint32_t * pulStatus);
+void            SDMMC_vAbort            (SDMMC_HandleType * pxSDMMC);
+
+void            SDMMC_vIRQHandler       (SDMMC_HandleType * pxSDMMC);
+
+/**
+ * @brief Determines whether the request queue of the SDMMC is empty.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @return BUSY if requests are in progress, OK if the queue is empty
+ */
+__STATIC_INLINE XPD_ReturnType SDMMC_eGetStatus(SDMMC_HandleType * pxSDMMC)
+{
+    return (pxSDMMC->Queue.Head != pxSDMMC->Queue.Tail) ? XPD_BUSY : XPD_OK;
+}
+
+/**
+ * @brief Gets the error state of the SDMMC.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @return Current SDMMC error state
+ */
+__STATIC_INLINE SDMMC_ErrorType SDMMC_eGetError(SDMMC_HandleType * pxSDMMC)
+{
+    return pxSDMMC->Errors;
+}
+
+/** @} */
+
+/** @} */
+
+#define XPD_SDMMC_API
+#include <xpd_rcc_pc.h>
+#undef XPD_SDMMC_API
+
+#endif /* SDMMC1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_SDMMC_H_ */
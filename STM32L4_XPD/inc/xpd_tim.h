@@ -116,11 +116,13 @@ typedef struct
         XPD_HandleCallbackType Error;        /*!< DMA error callback */
 #endif
     }Callbacks;                              /*   Handle Callbacks */
+#ifndef __XPD_TIM_NO_DMA
     struct {
         DMA_HandleType * Update;             /*!< DMA handle for update transfer */
         DMA_HandleType * Channel[4];         /*!< DMA handles for channel transfers */
         DMA_HandleType * Burst;              /*!< DMA handle for burst transfers */
     }DMA;                                    /*   DMA handle references */
+#endif /* __XPD_TIM_NO_DMA */
     RCC_PositionType CtrlPos;                /*!< Relative position for reset and clock control */
     volatile TIM_ChannelType ActiveChannel;  /*!< The currently active timer channel */
 }TIM_HandleType;
@@ -403,8 +405,10 @@ void            TIM_vCounterStop_IT     (TIM_HandleType * pxTIM);
 
 void            TIM_vIRQHandler_UP      (TIM_HandleType * pxTIM);
 
+#ifndef __XPD_TIM_NO_DMA
 XPD_ReturnType  TIM_eCounterStart_DMA   (TIM_HandleType * pxTIM, void * pvAddress, uint16_t usLength);
 void            TIM_vCounterStop_DMA    (TIM_HandleType * pxTIM);
+#endif /* __XPD_TIM_NO_DMA */
 
 
 void            TIM_vChannelStart       (TIM_HandleType * pxTIM, TIM_ChannelType eChannel);
@@ -415,9 +419,11 @@ void            TIM_vChannelStop_IT     (TIM_HandleType * pxTIM, TIM_ChannelType
 
 void            TIM_vIRQHandler_CC      (TIM_HandleType * pxTIM);
 
+#ifndef __XPD_TIM_NO_DMA
 XPD_ReturnType  TIM_eChannelStart_DMA   (TIM_HandleType * pxTIM, TIM_ChannelType eChannel,
                                          void * pvAddress, uint16_t usLength);
 void            TIM_vChannelStop_DMA    (TIM_HandleType * pxTIM, TIM_ChannelType eChannel);
+#endif /* __XPD_TIM_NO_DMA */
 
 
 /**
@@ -539,9 +545,11 @@ typedef struct
 
 /** @addtogroup TIM_Burst_Exported_Functions
  * @{ */
+#ifndef __XPD_TIM_NO_DMA
 XPD_ReturnType  TIM_eBurstStart_DMA     (TIM_HandleType * pxTIM, const TIM_BurstInitType * pxConfig,
                                              void * pvAddress, uint16_t usLength);
 void            TIM_vBurstStop_DMA      (TIM_HandleType * pxTIM, TIM_EventType Source);
+#endif /* __XPD_TIM_NO_DMA */
 /** @} */
 
 /** @} */
@@ -592,6 +600,19 @@ typedef struct
     FunctionalState RunOffState;     /*!< Off-state selection for Run mode */
 }TIM_DriveInitType;
 
+#ifdef TIM1_OR2_BKCMP1E
+/** @brief TIM internal break sources */
+typedef enum
+{
+    TIM_BREAKSOURCE_NONE  = 0,                  /*!< Only the break input pin */
+    TIM_BREAKSOURCE_COMP1 = TIM1_OR2_BKCMP1E,   /*!< COMP1 output */
+    TIM_BREAKSOURCE_COMP2 = TIM1_OR2_BKCMP2E,   /*!< COMP2 output */
+#ifdef TIM1_OR2_BKDF1BK0E
+    TIM_BREAKSOURCE_DFSDM = TIM1_OR2_BKDF1BK0E, /*!< DFSDM break output (0 for break, 1 for break 2) */
+#endif
+}TIM_BreakSourceType;
+#endif
+
 /** @brief TIM Break setup structure */
 typedef struct
 {
@@ -600,6 +621,10 @@ typedef struct
 #ifdef TIM_BDTR_BKF
     uint8_t                    Filter;   /*!< Break input capture filter */
 #endif
+#ifdef TIM1_OR2_BKCMP1E
+    uint16_t                   InternalSources; /*!< Combination of @ref TIM_BreakSourceType,
+                                                     which also trigger the break */
+#endif
 }TIM_BreakInitType;
 
 /** @brief TIM OCxREF clear configuration selection */
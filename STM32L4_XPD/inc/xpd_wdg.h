@@ -0,0 +1,272 @@
+/**
+  ******************************************************************************
+  * @file    xpd_wdg.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Watchdog Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_WDG_H_
+#define __XPD_WDG_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_rcc.h>
+
+#if defined(IWDG)
+
+/** @defgroup IWDG
+ * @{ */
+
+/** @defgroup IWDG_Exported_Types IWDG Exported Types
+ * @{ */
+
+/** @brief IWDG LSI clock prescalers */
+typedef enum
+{
+    IWDG_PRESCALER_4   = 0, /*!< LSI is divided by 4 */
+    IWDG_PRESCALER_8   = 1, /*!< LSI is divided by 8 */
+    IWDG_PRESCALER_16  = 2, /*!< LSI is divided by 16 */
+    IWDG_PRESCALER_32  = 3, /*!< LSI is divided by 32 */
+    IWDG_PRESCALER_64  = 4, /*!< LSI is divided by 64 */
+    IWDG_PRESCALER_128 = 5, /*!< LSI is divided by 128 */
+    IWDG_PRESCALER_256 = 6, /*!< LSI is divided by 256 */
+}IWDG_PrescalerType;
+
+/** @brief IWDG setup structure */
+typedef struct
+{
+    IWDG_PrescalerType Prescaler; /*!< Counter clock prescaler */
+    uint16_t           Reload;    /*!< Counter reload value [0 .. 0xFFF] */
+#ifdef IWDG_WINR_WIN
+    uint16_t           Window;    /*!< Refresh is only allowed below this counter value [0 .. 0xFFF],
+                                       0xFFF disables the window */
+#endif
+}IWDG_InitType;
+
+/** @} */
+
+/** @addtogroup IWDG_Exported_Functions
+ * @{ */
+XPD_ReturnType  IWDG_eInit              (const IWDG_InitType * pxConfig);
+
+uint32_t        IWDG_ulTimeout_ms       (void);
+
+/**
+ * @brief Reloads the independent watchdog counter.
+ */
+__STATIC_INLINE void IWDG_vRefresh(void)
+{
+    IWDG->KR = 0xAAAA;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* IWDG */
+
+#if defined(WWDG)
+
+/** @defgroup WWDG
+ * @{ */
+
+/** @defgroup WWDG_Exported_Types WWDG Exported Types
+ * @{ */
+
+/** @brief WWDG PCLK1 / 4096 clock prescalers */
+typedef enum
+{
+    WWDG_PRESCALER_1 = 0, /*!< Counter clock is PCLK1 / 4096 */
+    WWDG_PRESCALER_2 = 1, /*!< Counter clock is PCLK1 / 4096 / 2 */
+    WWDG_PRESCALER_4 = 2, /*!< Counter clock is PCLK1 / 4096 / 4 */
+    WWDG_PRESCALER_8 = 3, /*!< Counter clock is PCLK1 / 4096 / 8 */
+}WWDG_PrescalerType;
+
+/** @brief WWDG setup structure */
+typedef struct
+{
+    WWDG_PrescalerType Prescaler;   /*!< Counter clock prescaler */
+    uint8_t            Window;      /*!< Refresh is only allowed below this counter value [0x40 .. 0x7F] */
+    uint8_t            Counter;     /*!< Counter reload value [0x40 .. 0x7F] */
+    FunctionalState    EarlyWakeup; /*!< Early wakeup interrupt one count before the reset */
+}WWDG_InitType;
+
+/** @brief WWDG Handle structure */
+typedef struct
+{
+    WWDG_TypeDef * Inst;                     /*!< The address of the peripheral instance used by the handle */
+    struct {
+        XPD_HandleCallbackType DepInit;      /*!< Callback to initialize module dependencies (IRQs) */
+        XPD_HandleCallbackType EarlyWakeup;  /*!< Imminent reset callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    uint8_t Counter;                         /*!< [Internal] Counter reload value */
+}WWDG_HandleType;
+
+/** @} */
+
+/** @defgroup WWDG_Exported_Macros WWDG Exported Macros
+ * @{ */
+
+/**
+ * @brief WWDG Instance to handle binder macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param INSTANCE: specifies the WWDG peripheral instance.
+ */
+#define         WWDG_INST2HANDLE(HANDLE,INSTANCE)           \
+    ((HANDLE)->Inst    = (INSTANCE))
+
+/**
+ * @brief WWDG register bit accessing macro
+ * @param HANDLE: specifies the peripheral handle.
+ * @param REG_NAME: specifies the register name.
+ * @param BIT_NAME: specifies the register bit name.
+ */
+#define         WWDG_REG_BIT(HANDLE, REG_NAME, BIT_NAME)    \
+    ((HANDLE)->Inst->REG_NAME.b.BIT_NAME)
+
+/** @} */
+
+/** @addtogroup WWDG_Exported_Functions
+ * @{ */
+void            WWDG_vInit              (WWDG_HandleType * pxWWDG,
+                                         const WWDG_InitType * pxConfig);
+
+uint32_t        WWDG_ulTimeout_ms       (WWDG_HandleType * pxWWDG);
+
+void            WWDG_vIRQHandler        (WWDG_HandleType * pxWWDG);
+
+/**
+ * @brief Reloads the window watchdog counter.
+ * @note  Refreshing above the window value triggers a reset.
+ * @param pxWWDG: pointer to the WWDG handle structure
+ */
+__STATIC_INLINE void WWDG_vRefresh(WWDG_HandleType * pxWWDG)
+{
+    pxWWDG->Inst->CR.w = pxWWDG->Counter;
+}
+
+/**
+ * @brief Gets the current value of the window watchdog counter.
+ * @param pxWWDG: pointer to the WWDG handle structure
+ * @return The counter value, the reset occurs when it falls below 0x40
+ */
+__STATIC_INLINE uint8_t WWDG_ucGetCounter(WWDG_HandleType * pxWWDG)
+{
+    return WWDG_REG_BIT(pxWWDG, CR, T);
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* WWDG */
+
+/** @defgroup WDG
+ * @{ */
+
+/** @defgroup WDG_Exported_Types WDG Exported Types
+ * @{ */
+
+/** @brief WDG liveness checkpoint structure */
+typedef struct
+{
+    uint16_t Deadline;                       /*!< Maximal number of service periods between check-ins */
+    uint16_t Elapsed;                        /*!< [Internal] Service periods since the last check-in */
+    uint16_t MinSlack;                       /*!< Smallest number of remaining periods seen at check-in */
+}WDG_CheckpointType;
+
+/** @brief WDG diagnostic snapshot structure */
+typedef struct
+{
+    uint32_t Late;                           /*!< Checkpoints which missed their deadline */
+    uint32_t Periods;                        /*!< Service period count at capture */
+    uint16_t SinceRefresh;                   /*!< Service periods since the last hardware refresh */
+    uint8_t  Slowest;                        /*!< The checkpoint with the most elapsed periods
+                                                  relative to its deadline */
+}WDG_SnapshotType;
+
+/** @brief WDG service Handle structure */
+typedef struct
+{
+    WDG_CheckpointType * Checkpoints;        /*!< Checkpoint storage */
+    struct {
+        XPD_HandleCallbackType Refresh;      /*!< Hardware watchdog refresh callback */
+        XPD_HandleCallbackType Stall;        /*!< Checkpoint missed its deadline callback */
+    }Callbacks;                              /*   Handle Callbacks */
+    uint32_t Registered;                     /*!< [Internal] Active checkpoints */
+    volatile uint32_t Late;                  /*!< Checkpoints which missed their deadline */
+    uint32_t Periods;                        /*!< Number of elapsed service periods */
+    uint16_t Timeout;                        /*!< Hardware watchdog expiry time in service periods */
+    uint16_t SinceRefresh;                   /*!< [Internal] Service periods since the last refresh */
+    uint16_t MinMargin;                      /*!< Smallest margin between refresh and expiry in periods */
+    uint8_t Count;                           /*!< Number of checkpoints */
+    WDG_SnapshotType Snapshot;               /*!< Last captured diagnostic snapshot */
+}WDG_HandleType;
+
+/** @} */
+
+/** @defgroup WDG_Exported_Macros WDG Exported Macros
+ * @{ */
+
+/** @brief Maximal number of checkpoints of a service */
+#define WDG_MAX_CHECKPOINTS     32
+
+/** @} */
+
+/** @addtogroup WDG_Exported_Functions
+ * @{ */
+void            WDG_vInit               (WDG_HandleType * pxWDG,
+                                         WDG_CheckpointType * axCheckpoints,
+                                         uint8_t ucCount,
+                                         uint16_t usTimeout);
+
+void            WDG_vRegister           (WDG_HandleType * pxWDG,
+                                         uint8_t ucCheckpoint,
+                                         uint16_t usDeadline);
+void            WDG_vUnregister         (WDG_HandleType * pxWDG,
+                                         uint8_t ucCheckpoint);
+
+void            WDG_vCheckIn            (WDG_HandleType * pxWDG,
+                                         uint8_t ucCheckpoint);
+void            WDG_vService            (WDG_HandleType * pxWDG);
+
+void            WDG_vSnapshot           (WDG_HandleType * pxWDG);
+
+/**
+ * @brief Gets the checkpoints which currently block the hardware refresh.
+ * @param pxWDG: pointer to the WDG handle structure
+ * @return Bit mask of the late checkpoints
+ */
+__STATIC_INLINE uint32_t WDG_ulGetLate(WDG_HandleType * pxWDG)
+{
+    return pxWDG->Late;
+}
+
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_WDG_H_ */
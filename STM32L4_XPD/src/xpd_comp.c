@@ -0,0 +1,129 @@
+/**
+  ******************************************************************************
+  * @file    xpd_comp.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Comparator Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_comp.h>
+#include <xpd_utils.h>
+
+#if defined(COMP1)
+
+/** @addtogroup COMP
+ * @{ */
+
+/* EXTI line of COMP1 */
+#define COMP_EXTI_LINE_BASE     21
+
+/** @defgroup COMP_Exported_Functions COMP Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the comparator using the setup configuration.
+ *        The comparator has to be enabled separately.
+ * @note  The comparator outputs are routed to the timer break inputs
+ *        by @ref TIM_vBreakConfig, using the InternalSources setting.
+ * @param pxCOMP: pointer to the COMP handle structure
+ * @param pxConfig: COMP setup configuration
+ */
+void COMP_vInit(COMP_HandleType * pxCOMP, const COMP_InitType * pxConfig)
+{
+    uint32_t ulCSR = (pxConfig->InvertingInput << COMP_CSR_INMSEL_Pos)
+            | ((uint32_t)pxConfig->NonInvertingInput << COMP_CSR_INPSEL_Pos)
+            | (pxConfig->InvertedOutput << COMP_CSR_POLARITY_Pos)
+            | ((uint32_t)pxConfig->Blanking << COMP_CSR_BLANKING_Pos)
+            | (pxConfig->Hysteresis << COMP_CSR_HYST_Pos)
+            | (pxConfig->PowerMode << COMP_CSR_PWRMODE_Pos)
+            | (pxConfig->WindowMode << COMP_CSR_WINMODE_Pos);
+
+    /* VREFINT based references are provided by the scaler */
+    if (pxConfig->InvertingInput <= COMP_INVERTING_VREFINT)
+    {
+        ulCSR |= COMP_CSR_SCALEN;
+
+        if (pxConfig->InvertingInput < COMP_INVERTING_VREFINT)
+        {
+            ulCSR |= COMP_CSR_BRGEN;
+        }
+    }
+
+    /* the comparators are clocked through SYSCFG */
+    RCC_vClockEnable(RCC_POS_SYSCFG);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxCOMP->Callbacks.DepInit, pxCOMP);
+
+    pxCOMP->Inst->CSR.w = ulCSR;
+}
+
+/**
+ * @brief Restores the comparator to its default inactive state.
+ * @note  A locked comparator is only released by system reset.
+ * @param pxCOMP: pointer to the COMP handle structure
+ */
+void COMP_vDeinit(COMP_HandleType * pxCOMP)
+{
+    pxCOMP->Inst->CSR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxCOMP->Callbacks.DepDeinit, pxCOMP);
+}
+
+/**
+ * @brief Determines the EXTI line of the comparator's output.
+ * @param pxCOMP: pointer to the COMP handle structure
+ * @return The EXTI line number
+ */
+uint8_t COMP_ucExtiLine(COMP_HandleType * pxCOMP)
+{
+    return COMP_EXTI_LINE_BASE + ((uint32_t)pxCOMP->Inst - COMP1_BASE) / sizeof(COMP_TypeDef);
+}
+
+/**
+ * @brief Configures the EXTI line of the comparator's output.
+ * @note  The EXTI line allows the comparator to wake up the device from Stop mode.
+ * @param pxCOMP: pointer to the COMP handle structure
+ * @param pxConfig: EXTI setup configuration of the output edges
+ */
+void COMP_vExtiConfig(COMP_HandleType * pxCOMP, const EXTI_InitType * pxConfig)
+{
+    EXTI_vInit(COMP_ucExtiLine(pxCOMP), pxConfig);
+}
+
+/**
+ * @brief COMP EXTI line interrupt handler that provides the Trigger callback.
+ * @param pxCOMP: pointer to the COMP handle structure
+ */
+void COMP_vIRQHandler(COMP_HandleType * pxCOMP)
+{
+    uint8_t ucLine = COMP_ucExtiLine(pxCOMP);
+
+    if (EXTI_eGetFlag(ucLine) != RESET)
+    {
+        EXTI_vClearFlag(ucLine);
+
+        XPD_SAFE_CALLBACK(pxCOMP->Callbacks.Trigger, pxCOMP);
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* COMP1 */
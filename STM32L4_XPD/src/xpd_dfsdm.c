@@ -0,0 +1,468 @@
+/**
+  ******************************************************************************
+  * @file    xpd_dfsdm.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Digital Filter for Sigma-Delta Modulators Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_dfsdm.h>
+#include <xpd_utils.h>
+
+#if defined(DFSDM1_Filter0)
+
+/** @addtogroup DFSDM
+ * @{ */
+
+/* The global interface settings are located in the first channel's registers */
+#define DFSDM_GLOBAL()          (DFSDM1_Channel0)
+
+/* Output serial clock divider range */
+#define DFSDM_CKOUT_DIV_MIN     2
+#define DFSDM_CKOUT_DIV_MAX     256
+
+/* Filter ratio limits */
+#define DFSDM_FOSR_MAX          1024
+#define DFSDM_IOSR_MAX          256
+
+/* Largest magnitude of the 32 bit filter and integrator output */
+#define DFSDM_ACCU_MAX          0x7FFFFFFFUL
+
+/* Largest magnitude of the 24 bit data register */
+#define DFSDM_DATA_MAX          0x7FFFFFUL
+
+/* Calculates the sinc filter gain (output magnitude of a full scale 1 bit input) */
+static uint64_t DFSDM_prvFilterGain(DFSDM_FilterOrderType eOrder, uint32_t ulFOSR)
+{
+    uint64_t ullGain = 1;
+    uint8_t ucOrder = eOrder;
+
+    if (eOrder == DFSDM_FILTER_FASTSINC)
+    {
+        /* FastSinc has a gain of 2 * FOSR^2 */
+        ullGain = 2;
+        ucOrder = 2;
+    }
+    for (; ucOrder > 0; ucOrder--)
+    {
+        ullGain *= ulFOSR;
+    }
+    return ullGain;
+}
+
+static void DFSDM_prvDmaHalfRedirect(void * pxDMA)
+{
+    DFSDM_HandleType * pxDFSDM = (DFSDM_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The first half of the buffer is filled */
+    pxDFSDM->Block = pxDFSDM->Stream.Buffer;
+
+    XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.Conversion, pxDFSDM);
+}
+
+static void DFSDM_prvDmaRedirect(void * pxDMA)
+{
+    DFSDM_HandleType * pxDFSDM = (DFSDM_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    if (DMA_eCircularMode(pxDMA) != 0)
+    {
+        /* The second half of the buffer is filled */
+        pxDFSDM->Block = pxDFSDM->Stream.Buffer + pxDFSDM->Stream.HalfLength;
+    }
+    else
+    {
+        /* The whole buffer is filled, end of the single transfer */
+        pxDFSDM->Block = pxDFSDM->Stream.Buffer;
+
+        DFSDM_REG_BIT(pxDFSDM, FLTCR1, DFEN) = 0;
+    }
+
+    XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.Conversion, pxDFSDM);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void DFSDM_prvDmaErrorRedirect(void * pxDMA)
+{
+    DFSDM_HandleType * pxDFSDM = (DFSDM_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* Update error code */
+    pxDFSDM->Errors |= DFSDM_ERROR_DMA;
+
+    XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.Error, pxDFSDM);
+}
+#endif
+
+/** @defgroup DFSDM_Exported_Functions DFSDM Exported Functions
+ * @{ */
+
+/**
+ * @brief Enables the DFSDM interface and sets up the output serial clock (CKOUT)
+ *        from the DFSDM kernel clock (see @ref DFSDM_vClockConfig).
+ *        This function has to be called before the channels and filters are used.
+ * @param ulClockOut_Hz: the requested output serial clock frequency (e.g. PDM microphone clock),
+ *        or 0 if the clock output isn't used
+ * @return ERROR if the frequency can't be produced, OK if successful
+ */
+XPD_ReturnType DFSDM_eInterfaceInit(uint32_t ulClockOut_Hz)
+{
+    uint32_t ulDiv = 0;
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_DFSDM1);
+
+    if (ulClockOut_Hz != 0)
+    {
+        ulDiv = (DFSDM_ulClockFreq_Hz() + ulClockOut_Hz / 2) / ulClockOut_Hz;
+
+        if ((ulDiv < DFSDM_CKOUT_DIV_MIN) || (ulDiv > DFSDM_CKOUT_DIV_MAX))
+        {
+            return XPD_ERROR;
+        }
+    }
+
+    /* The output clock can only be configured while the interface is disabled */
+    CLEAR_BIT(DFSDM_GLOBAL()->CHCFGR1.w, DFSDM_CHCFGR1_DFSDMEN);
+
+    MODIFY_REG(DFSDM_GLOBAL()->CHCFGR1.w,
+            DFSDM_CHCFGR1_CKOUTDIV | DFSDM_CHCFGR1_CKOUTSRC,
+            (ulDiv > 0) ? ((ulDiv - 1) << DFSDM_CHCFGR1_CKOUTDIV_Pos) : 0);
+
+    SET_BIT(DFSDM_GLOBAL()->CHCFGR1.w, DFSDM_CHCFGR1_DFSDMEN);
+
+    return XPD_OK;
+}
+
+/**
+ * @brief Disables the DFSDM interface, including all channels and filters.
+ */
+void DFSDM_vInterfaceDeinit(void)
+{
+    CLEAR_BIT(DFSDM_GLOBAL()->CHCFGR1.w, DFSDM_CHCFGR1_DFSDMEN);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_DFSDM1);
+}
+
+/**
+ * @brief Initializes a DFSDM input channel using the setup configuration.
+ * @param pxChannel: the DFSDM channel instance
+ * @param pxConfig: DFSDM channel setup configuration
+ */
+void DFSDM_vChannelInit(DFSDM_Channel_TypeDef * pxChannel, const DFSDM_ChannelInitType * pxConfig)
+{
+    /* The channel can only be configured while it's disabled */
+    CLEAR_BIT(pxChannel->CHCFGR1.w, DFSDM_CHCFGR1_CHEN);
+
+    MODIFY_REG(pxChannel->CHCFGR1.w,
+            DFSDM_CHCFGR1_SITP | DFSDM_CHCFGR1_SPICKSEL | DFSDM_CHCFGR1_CHINSEL
+            | DFSDM_CHCFGR1_DATMPX | DFSDM_CHCFGR1_DATPACK
+            | DFSDM_CHCFGR1_SCDEN | DFSDM_CHCFGR1_CKABEN,
+            pxConfig->Interface | pxConfig->SpiClock
+            | ((pxConfig->InputFromNext != DISABLE) ? DFSDM_CHCFGR1_CHINSEL : 0));
+
+    pxChannel->CHCFGR2.w = ((uint32_t)pxConfig->Offset << DFSDM_CHCFGR2_OFFSET_Pos)
+                         | ((uint32_t)pxConfig->RightShift << DFSDM_CHCFGR2_DTRBS_Pos);
+
+    SET_BIT(pxChannel->CHCFGR1.w, DFSDM_CHCFGR1_CHEN);
+}
+
+/**
+ * @brief Disables a DFSDM input channel.
+ * @param pxChannel: the DFSDM channel instance
+ */
+void DFSDM_vChannelDeinit(DFSDM_Channel_TypeDef * pxChannel)
+{
+    CLEAR_BIT(pxChannel->CHCFGR1.w, DFSDM_CHCFGR1_CHEN);
+}
+
+/**
+ * @brief Calculates the filter ratios which produce the requested output data rate
+ *        from the serial bit rate, and the channel right shift that fits a full scale
+ *        1 bit (PDM) input into the 24 bit result.
+ *        The sinc filter takes the largest possible share of the decimation,
+ *        the integrator the remainder.
+ * @param pxConfig: DFSDM filter setup configuration, the Order has to be set,
+ *        the Oversampling and IntegratorOversampling fields are calculated
+ * @param ulBitRate: the serial input bit rate
+ * @param ulOutputRate: the requested output data rate
+ * @param pucRightShift: the calculated channel right shift (can be NULL)
+ * @return ERROR if the ratio can't be realized, OK if successful
+ */
+XPD_ReturnType DFSDM_eFilterCalc(
+        DFSDM_InitType *    pxConfig,
+        uint32_t            ulBitRate,
+        uint32_t            ulOutputRate,
+        uint8_t *           pucRightShift)
+{
+    uint32_t ulRatio = (ulBitRate + ulOutputRate / 2) / ulOutputRate;
+    uint32_t ulFOSR = (ulRatio < DFSDM_FOSR_MAX) ? ulRatio : DFSDM_FOSR_MAX;
+
+    for (; ulFOSR > 0; ulFOSR--)
+    {
+        uint32_t ulIOSR = ulRatio / ulFOSR;
+        uint64_t ullGain;
+
+        if (((ulIOSR * ulFOSR) != ulRatio) || (ulIOSR > DFSDM_IOSR_MAX))
+        {
+            continue;
+        }
+
+        ullGain = DFSDM_prvFilterGain(pxConfig->Order, ulFOSR) * ulIOSR;
+
+        if (ullGain <= DFSDM_ACCU_MAX)
+        {
+            pxConfig->Oversampling           = ulFOSR;
+            pxConfig->IntegratorOversampling = ulIOSR;
+
+            if (pucRightShift != NULL)
+            {
+                uint8_t ucShift = 0;
+
+                while ((ullGain >> ucShift) > DFSDM_DATA_MAX)
+                {
+                    ucShift++;
+                }
+                *pucRightShift = ucShift;
+            }
+            return XPD_OK;
+        }
+    }
+    return XPD_ERROR;
+}
+
+/**
+ * @brief Initializes the DFSDM filter using the setup configuration.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @param pxConfig: DFSDM filter setup configuration
+ */
+void DFSDM_vInit(DFSDM_HandleType * pxDFSDM, const DFSDM_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_DFSDM1);
+
+    /* The filter can only be configured while it's disabled */
+    DFSDM_REG_BIT(pxDFSDM, FLTCR1, DFEN) = 0;
+
+    pxDFSDM->Inst->FLTFCR.w = ((uint32_t)pxConfig->Order << DFSDM_FLTFCR_FORD_Pos)
+                            | ((uint32_t)(pxConfig->Oversampling - 1) << DFSDM_FLTFCR_FOSR_Pos)
+                            | ((uint32_t)(pxConfig->IntegratorOversampling - 1) << DFSDM_FLTFCR_IOSR_Pos);
+
+    pxDFSDM->Inst->FLTCR1.w = ((uint32_t)pxConfig->Channel << DFSDM_FLTCR1_RCH_Pos)
+                            | ((pxConfig->FastMode != DISABLE) ? DFSDM_FLTCR1_FAST : 0)
+                            | ((pxConfig->SyncWithFilter0 != DISABLE) ? DFSDM_FLTCR1_RSYNC : 0);
+
+    pxDFSDM->Inst->FLTCR2.w = 0;
+    pxDFSDM->Inst->FLTICR.w = DFSDM_FLTICR_CLRROVRF | DFSDM_FLTICR_CLRJOVRF;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.DepInit, pxDFSDM);
+
+    pxDFSDM->Block          = NULL;
+    pxDFSDM->WatchdogEvents = 0;
+    pxDFSDM->Errors         = DFSDM_ERROR_NONE;
+}
+
+/**
+ * @brief Restores the DFSDM filter to its default inactive state.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ */
+void DFSDM_vDeinit(DFSDM_HandleType * pxDFSDM)
+{
+    DFSDM_vStop_DMA(pxDFSDM);
+
+    pxDFSDM->Inst->FLTCR1.w = 0;
+    pxDFSDM->Inst->FLTCR2.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.DepDeinit, pxDFSDM);
+}
+
+/**
+ * @brief Starts continuous regular conversions with DMA.
+ *        When the DMA stream is in circular mode, the buffer is double buffered:
+ *        the Conversion callback is called at each filled half,
+ *        with Block pointing to the half that is available to the application.
+ *        If the filter is synchronized with filter 0, the conversions start
+ *        when filter 0 is started, so filter 0 has to be started last.
+ * @note  The raw data register values are transferred as words,
+ *        see @ref DFSDM_RESULT for extracting the signed result.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @param pulBuffer: pointer to the conversion buffer
+ * @param usLength: length of the buffer in conversions (even in circular mode)
+ * @return BUSY if the DMA stream is in use, OK if the conversions are started
+ */
+XPD_ReturnType DFSDM_eStart_DMA(DFSDM_HandleType * pxDFSDM, uint32_t * pulBuffer, uint16_t usLength)
+{
+    XPD_ReturnType eResult;
+
+    pxDFSDM->Stream.Buffer     = pulBuffer;
+    pxDFSDM->Stream.HalfLength = usLength / 2;
+    pxDFSDM->Block             = NULL;
+    pxDFSDM->Errors            = DFSDM_ERROR_NONE;
+
+    /* Set the callback owner */
+    pxDFSDM->DMA->Owner = pxDFSDM;
+
+    /* Set the DMA transfer callbacks */
+    pxDFSDM->DMA->Callbacks.Complete     = DFSDM_prvDmaRedirect;
+    pxDFSDM->DMA->Callbacks.HalfComplete = DFSDM_prvDmaHalfRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+    pxDFSDM->DMA->Callbacks.Error        = DFSDM_prvDmaErrorRedirect;
+#endif
+
+    eResult = DMA_eStart_IT(pxDFSDM->DMA, (void*)&pxDFSDM->Inst->FLTRDATAR.w, pulBuffer, usLength);
+
+    if (eResult == XPD_OK)
+    {
+        /* In circular mode each buffer half is a block */
+        if (DMA_eCircularMode(pxDFSDM->DMA) != 0)
+        {
+            DMA_IT_ENABLE(pxDFSDM->DMA, HT);
+        }
+
+        /* The DMA request can only be enabled while the filter is disabled */
+        DFSDM_REG_BIT(pxDFSDM, FLTCR1, DFEN) = 0;
+        SET_BIT(pxDFSDM->Inst->FLTCR1.w, DFSDM_FLTCR1_RCONT | DFSDM_FLTCR1_RDMAEN);
+
+        pxDFSDM->Inst->FLTICR.w = DFSDM_FLTICR_CLRROVRF;
+        DFSDM_REG_BIT(pxDFSDM, FLTCR2, ROVRIE) = 1;
+
+        DFSDM_REG_BIT(pxDFSDM, FLTCR1, DFEN) = 1;
+
+        /* Synchronized filters are started by filter 0 */
+        if (DFSDM_REG_BIT(pxDFSDM, FLTCR1, RSYNC) == 0)
+        {
+            DFSDM_REG_BIT(pxDFSDM, FLTCR1, RSWSTART) = 1;
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the regular conversions.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ */
+void DFSDM_vStop_DMA(DFSDM_HandleType * pxDFSDM)
+{
+    DFSDM_REG_BIT(pxDFSDM, FLTCR1, DFEN) = 0;
+
+    CLEAR_BIT(pxDFSDM->Inst->FLTCR1.w, DFSDM_FLTCR1_RCONT | DFSDM_FLTCR1_RDMAEN);
+    DFSDM_REG_BIT(pxDFSDM, FLTCR2, ROVRIE) = 0;
+
+    if (pxDFSDM->DMA != NULL)
+    {
+        DMA_vStop_IT(pxDFSDM->DMA);
+    }
+}
+
+/**
+ * @brief DFSDM filter interrupt handler that reports regular overruns
+ *        and analog watchdog threshold crossings.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ */
+void DFSDM_vIRQHandler(DFSDM_HandleType * pxDFSDM)
+{
+    uint32_t ulISR = pxDFSDM->Inst->FLTISR.w;
+    uint32_t ulCR2 = pxDFSDM->Inst->FLTCR2.w;
+
+    /* Regular data overrun */
+    if (((ulISR & DFSDM_FLTISR_ROVRF) != 0) && ((ulCR2 & DFSDM_FLTCR2_ROVRIE) != 0))
+    {
+        pxDFSDM->Inst->FLTICR.w = DFSDM_FLTICR_CLRROVRF;
+
+        pxDFSDM->Errors |= DFSDM_ERROR_OVERRUN;
+
+        XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.Error, pxDFSDM);
+    }
+
+    /* Analog watchdog */
+    if (((ulISR & DFSDM_FLTISR_AWDF) != 0) && ((ulCR2 & DFSDM_FLTCR2_AWDIE) != 0))
+    {
+        uint32_t ulAWSR = pxDFSDM->Inst->FLTAWSR.w;
+
+        /* The status flags and clear flags are at the same positions */
+        pxDFSDM->Inst->FLTAWCFR.w = ulAWSR;
+
+        pxDFSDM->WatchdogEvents = ulAWSR;
+
+        XPD_SAFE_CALLBACK(pxDFSDM->Callbacks.Watchdog, pxDFSDM);
+    }
+}
+
+/**
+ * @brief Resets and starts the extremes detector on the selected channels.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @param ucChannelMask: bit mask of the monitored input channels
+ */
+void DFSDM_vExtremesStart(DFSDM_HandleType * pxDFSDM, uint8_t ucChannelMask)
+{
+    pxDFSDM->Inst->FLTCR2.b.EXCH = ucChannelMask;
+
+    /* Reading the values resets the detector */
+    (void) pxDFSDM->Inst->FLTEXMAX.w;
+    (void) pxDFSDM->Inst->FLTEXMIN.w;
+}
+
+/**
+ * @brief Reads the extreme values measured since the last read, and restarts the detection.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @param plMax: the largest conversion result
+ * @param plMin: the smallest conversion result
+ */
+void DFSDM_vGetExtremes(DFSDM_HandleType * pxDFSDM, int32_t * plMax, int32_t * plMin)
+{
+    *plMax = ((int32_t)pxDFSDM->Inst->FLTEXMAX.w) >> DFSDM_FLTEXMAX_EXMAX_Pos;
+    *plMin = ((int32_t)pxDFSDM->Inst->FLTEXMIN.w) >> DFSDM_FLTEXMIN_EXMIN_Pos;
+}
+
+/**
+ * @brief Sets up the analog watchdog on the filter's conversion results.
+ *        The Watchdog callback is called when a threshold is crossed,
+ *        with WatchdogEvents indicating the channels and thresholds.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ * @param pxConfig: DFSDM analog watchdog setup configuration
+ */
+void DFSDM_vWatchdogInit(DFSDM_HandleType * pxDFSDM, const DFSDM_WatchdogInitType * pxConfig)
+{
+    /* Compare the final filter output (not the channel's watchdog filter) */
+    DFSDM_REG_BIT(pxDFSDM, FLTCR1, AWFSEL) = 0;
+
+    pxDFSDM->Inst->FLTAWHTR.w = ((uint32_t)pxConfig->HighThreshold << DFSDM_FLTAWHTR_AWHT_Pos);
+    pxDFSDM->Inst->FLTAWLTR.w = ((uint32_t)pxConfig->LowThreshold  << DFSDM_FLTAWLTR_AWLT_Pos);
+
+    pxDFSDM->Inst->FLTAWCFR.w = DFSDM_FLTAWCFR_CLRAWHTF | DFSDM_FLTAWCFR_CLRAWLTF;
+    pxDFSDM->WatchdogEvents = 0;
+
+    pxDFSDM->Inst->FLTCR2.b.AWDCH = pxConfig->ChannelMask;
+    DFSDM_REG_BIT(pxDFSDM, FLTCR2, AWDIE) = 1;
+}
+
+/**
+ * @brief Disables the analog watchdog of the filter.
+ * @param pxDFSDM: pointer to the DFSDM handle structure
+ */
+void DFSDM_vWatchdogDeinit(DFSDM_HandleType * pxDFSDM)
+{
+    DFSDM_REG_BIT(pxDFSDM, FLTCR2, AWDIE) = 0;
+    pxDFSDM->Inst->FLTCR2.b.AWDCH = 0;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* DFSDM1_Filter0 */
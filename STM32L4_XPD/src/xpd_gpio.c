@@ -217,9 +217,9 @@ void GPIO_vInitPin(GPIO_TypeDef * pxGPIO, uint8_t ucPin, const GPIO_InitType * p
     pwr_pxPullPinConfig[GPIO_PORT_OFFSET(pxGPIO)].PDC[ucPin] = pxConfig->PowerDownPull >> 1;
 #else
     MODIFY_REG(pwr_pxPullConfig[GPIO_PORT_OFFSET(pxGPIO)].PUCR, 1  << ucPin,
-                               (uin32_t)pxConfig->PowerDownPull  << ucPin);
+                               (uint32_t)pxConfig->PowerDownPull  << ucPin);
     MODIFY_REG(pwr_pxPullConfig[GPIO_PORT_OFFSET(pxGPIO)].PDCR, 1  << ucPin,
-                         ((uin32_t)pxConfig->PowerDownPull >> 1) << ucPin);
+                         ((uint32_t)pxConfig->PowerDownPull >> 1) << ucPin);
 #endif
 #endif
 
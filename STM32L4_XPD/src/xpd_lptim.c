@@ -0,0 +1,302 @@
+/**
+  ******************************************************************************
+  * @file    xpd_lptim.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Low Power Timer Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_lptim.h>
+#include <xpd_utils.h>
+
+#if defined(LPTIM1)
+
+/** @addtogroup LPTIM
+ * @{ */
+
+#define LPTIM_WRITE_TIMEOUT     2
+
+/** @defgroup LPTIM_Exported_Functions LPTIM Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the LPTIM peripheral using the setup configuration.
+ * @note  The LPTIM keeps counting in Stop mode when its kernel clock is LSI or LSE
+ *        (only LPTIM1 is available in Stop 2), or when it counts IN1 asynchronously.
+ *        To wake up the device the LPTIM interrupt shall be enabled in the DepInit callback,
+ *        the EXTI line of the LPTIM (32 for LPTIM1, 33 for LPTIM2) is an internal wakeup line.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @param pxConfig: LPTIM setup configuration
+ */
+void LPTIM_vInit(LPTIM_HandleType * pxLPTIM, const LPTIM_InitType * pxConfig)
+{
+    uint32_t ulCFGR = pxConfig->CounterSource
+            | (pxConfig->Prescaler << LPTIM_CFGR_PRESC_Pos);
+
+    /* enable clock */
+    RCC_vClockEnable(pxLPTIM->CtrlPos);
+
+    /* the configuration is only writable while the timer is disabled */
+    pxLPTIM->Inst->CR.w = 0;
+
+    if (pxConfig->CounterSource != LPTIM_COUNTER_INTERNAL)
+    {
+        ulCFGR |= (pxConfig->InputEdge - EDGE_RISING) << LPTIM_CFGR_CKPOL_Pos;
+    }
+    if (pxConfig->CounterSource == LPTIM_COUNTER_INPUT1)
+    {
+        ulCFGR |= pxConfig->InputFilter << LPTIM_CFGR_CKFLT_Pos;
+    }
+    pxLPTIM->Inst->CFGR.w = ulCFGR;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxLPTIM->Callbacks.DepInit, pxLPTIM);
+}
+
+/**
+ * @brief Restores the LPTIM peripheral to its default inactive state.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ */
+void LPTIM_vDeinit(LPTIM_HandleType * pxLPTIM)
+{
+    pxLPTIM->Inst->CR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxLPTIM->Callbacks.DepDeinit, pxLPTIM);
+
+    /* disable clock */
+    RCC_vClockDisable(pxLPTIM->CtrlPos);
+}
+
+/**
+ * @brief Starts the LPTIM in continuous counting mode with interrupts.
+ *        The period elapsed interrupt is always enabled to extend the counter
+ *        to 32 bits, the compare match interrupt is enabled if the Compare callback is set.
+ * @note  When IN1 clocks the counter asynchronously, the register updates
+ *        are only completed on the next input edges, therefore they are not waited for.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @param usPeriod: the counter period - 1 (autoreload value),
+ *        0xFFFF makes @ref LPTIM_ulGetCounter a wrapping 32 bit counter
+ * @return TIMEOUT if the period setting failed, OK otherwise
+ */
+XPD_ReturnType LPTIM_eStart_IT(LPTIM_HandleType * pxLPTIM, uint16_t usPeriod)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    uint32_t ulIER = LPTIM_IER_ARRMIE;
+
+    if (pxLPTIM->Callbacks.Compare != NULL)
+    {
+        ulIER |= LPTIM_IER_CMPMIE;
+    }
+
+    pxLPTIM->Overflows   = 0;
+    pxLPTIM->CompareBusy = FALSE;
+
+    /* the interrupt enable register is only writable while the timer is disabled */
+    pxLPTIM->Inst->CR.w  = 0;
+    pxLPTIM->Inst->IER.w = ulIER;
+
+    /* the period and compare registers are only writable while the timer is enabled */
+    LPTIM_REG_BIT(pxLPTIM, CR, ENABLE) = 1;
+
+    pxLPTIM->Inst->ICR.w = LPTIM_ICR_ARRMCF | LPTIM_ICR_CMPMCF
+                         | LPTIM_ICR_ARROKCF | LPTIM_ICR_CMPOKCF;
+    pxLPTIM->Inst->ARR = usPeriod;
+
+    if (LPTIM_REG_BIT(pxLPTIM, CFGR, CKSEL) == 0)
+    {
+        uint32_t ulTimeout = LPTIM_WRITE_TIMEOUT;
+
+        eResult = XPD_eWaitForMatch(&pxLPTIM->Inst->ISR.w,
+                LPTIM_ISR_ARROK, LPTIM_ISR_ARROK, &ulTimeout);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        LPTIM_REG_BIT(pxLPTIM, CR, CNTSTRT) = 1;
+    }
+    return eResult;
+}
+
+/**
+ * @brief Stops the LPTIM counter and disables its interrupts.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ */
+void LPTIM_vStop_IT(LPTIM_HandleType * pxLPTIM)
+{
+    /* disabling the timer also resets the counter */
+    pxLPTIM->Inst->CR.w  = 0;
+    pxLPTIM->Inst->IER.w = 0;
+}
+
+/**
+ * @brief Sets a new compare value for the running LPTIM.
+ * @note  The compare value shall be lower than the counter period.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @param usCompare: the new compare value
+ * @return BUSY if the previous compare update is still in progress, OK otherwise
+ */
+XPD_ReturnType LPTIM_eSetCompare(LPTIM_HandleType * pxLPTIM, uint16_t usCompare)
+{
+    if (pxLPTIM->CompareBusy != FALSE)
+    {
+        /* a new value can only be written when the previous one is taken over */
+        if (LPTIM_FLAG_STATUS(pxLPTIM, CMPOK) == 0)
+        {
+            return XPD_BUSY;
+        }
+        LPTIM_FLAG_CLEAR(pxLPTIM, CMPOK);
+    }
+
+    pxLPTIM->Inst->CMP   = usCompare;
+    pxLPTIM->CompareBusy = TRUE;
+
+    return XPD_OK;
+}
+
+/**
+ * @brief Schedules a compare match the specified amount of counter ticks from now,
+ *        which wakes up the device from low power modes.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @param usTicks: the amount of ticks until the compare match, at most the counter period
+ * @return BUSY if the previous compare update is still in progress, OK otherwise
+ */
+XPD_ReturnType LPTIM_eSetWakeup(LPTIM_HandleType * pxLPTIM, uint16_t usTicks)
+{
+    uint32_t ulPeriod  = pxLPTIM->Inst->ARR;
+    uint32_t ulCompare = (uint32_t)LPTIM_usGetCounter(pxLPTIM) + usTicks;
+
+    if (ulCompare > ulPeriod)
+    {
+        ulCompare -= ulPeriod + 1;
+    }
+
+    /* the compare value has to stay below the period, the match is delayed by one tick */
+    if (ulCompare == ulPeriod)
+    {
+        ulCompare = 0;
+    }
+
+    return LPTIM_eSetCompare(pxLPTIM, ulCompare);
+}
+
+/**
+ * @brief Reads the current counter value of the LPTIM.
+ * @note  The counter is read until two consecutive reads match,
+ *        since it may be clocked asynchronously to the APB bus.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @return The current 16 bit counter value
+ */
+uint16_t LPTIM_usGetCounter(LPTIM_HandleType * pxLPTIM)
+{
+    uint16_t usCounter;
+
+    do {
+        usCounter = pxLPTIM->Inst->CNT.w;
+    } while (usCounter != (uint16_t)pxLPTIM->Inst->CNT.w);
+
+    return usCounter;
+}
+
+/**
+ * @brief Reads the counter value of the LPTIM extended by the elapsed periods,
+ *        to be used as a low power timebase or a pulse count.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @return The amount of counted ticks since the start
+ */
+uint32_t LPTIM_ulGetCounter(LPTIM_HandleType * pxLPTIM)
+{
+    uint32_t ulPeriod = pxLPTIM->Inst->ARR;
+    uint32_t ulOverflows;
+    uint16_t usCounter;
+    boolean_t bPending;
+
+    /* The flag is read before the counter, and the reading is repeated if the flag
+     * or the overflow count changed meanwhile, so the counter value is consistent with both */
+    do {
+        ulOverflows = pxLPTIM->Overflows;
+        bPending    = LPTIM_FLAG_STATUS(pxLPTIM, ARRM);
+        usCounter   = LPTIM_usGetCounter(pxLPTIM);
+    } while ((ulOverflows != pxLPTIM->Overflows)
+          || (bPending != LPTIM_FLAG_STATUS(pxLPTIM, ARRM)));
+
+    /* ARRM is raised when the counter reaches the period value,
+     * the counter only wraps around on the following tick */
+    if (usCounter == ulPeriod)
+    {
+        if (bPending == 0)
+        {
+            /* the interrupt has already counted the upcoming wraparound */
+            ulOverflows--;
+        }
+    }
+    else if (bPending != 0)
+    {
+        /* the wraparound is not yet counted by the interrupt */
+        ulOverflows++;
+    }
+
+    return ulOverflows * (ulPeriod + 1) + usCounter;
+}
+
+/**
+ * @brief Determines the counting frequency of the LPTIM.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @return The counter tick frequency, or 0 if the counter is clocked by IN1
+ */
+uint32_t LPTIM_ulCounterFreq_Hz(LPTIM_HandleType * pxLPTIM)
+{
+    uint32_t ulFreq = 0;
+
+    if ((pxLPTIM->Inst->CFGR.w & (LPTIM_CFGR_CKSEL | LPTIM_CFGR_COUNTMODE)) == 0)
+    {
+        ulFreq = LPTIM_ulClockFreq_Hz(pxLPTIM) >> LPTIM_REG_BIT(pxLPTIM, CFGR, PRESC);
+    }
+    return ulFreq;
+}
+
+/**
+ * @brief LPTIM interrupt handler that extends the counter and provides the callbacks.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ */
+void LPTIM_vIRQHandler(LPTIM_HandleType * pxLPTIM)
+{
+    uint32_t ulISR = pxLPTIM->Inst->ISR.w & pxLPTIM->Inst->IER.w;
+
+    /* the period is handled first so the compare callback reads a consistent counter */
+    if ((ulISR & LPTIM_ISR_ARRM) != 0)
+    {
+        LPTIM_FLAG_CLEAR(pxLPTIM, ARRM);
+
+        pxLPTIM->Overflows++;
+
+        XPD_SAFE_CALLBACK(pxLPTIM->Callbacks.Overflow, pxLPTIM);
+    }
+
+    if ((ulISR & LPTIM_ISR_CMPM) != 0)
+    {
+        LPTIM_FLAG_CLEAR(pxLPTIM, CMPM);
+
+        XPD_SAFE_CALLBACK(pxLPTIM->Callbacks.Compare, pxLPTIM);
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* LPTIM1 */
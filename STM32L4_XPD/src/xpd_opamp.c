@@ -0,0 +1,154 @@
+/**
+  ******************************************************************************
+  * @file    xpd_opamp.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Operational Amplifier Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_opamp.h>
+#include <xpd_utils.h>
+
+#if defined(OPAMP1)
+
+/** @addtogroup OPAMP
+ * @{ */
+
+#define OPAMP_TRIMMING_DELAY_MS     1
+#define OPAMP_TRIMMING_MAX          0x1F
+
+/* Inverting input is not connected externally in PGA and follower modes */
+#define OPAMP_VMSEL_INTERNAL        2
+
+/* Searches the offset trimming value where the calibration output toggles */
+static void OPAMP_prvTrim(OPAMP_HandleType * pxOPAMP, volatile uint32_t * pulTrim, uint32_t ulTrimPos)
+{
+    uint32_t ulTrim = (OPAMP_TRIMMING_MAX + 1) / 2;
+    uint32_t ulDelta = ulTrim / 2;
+
+    while (ulDelta > 0)
+    {
+        MODIFY_REG(*pulTrim, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+        XPD_vDelay_ms(OPAMP_TRIMMING_DELAY_MS);
+
+        if (OPAMP_REG_BIT(pxOPAMP, CSR, CALOUT) != 0)
+        {
+            ulTrim -= ulDelta;
+        }
+        else
+        {
+            ulTrim += ulDelta;
+        }
+        ulDelta >>= 1;
+    }
+
+    /* The last step decides between the two neighboring values */
+    MODIFY_REG(*pulTrim, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+    XPD_vDelay_ms(OPAMP_TRIMMING_DELAY_MS);
+
+    if ((OPAMP_REG_BIT(pxOPAMP, CSR, CALOUT) == 0) && (ulTrim < OPAMP_TRIMMING_MAX))
+    {
+        ulTrim++;
+        MODIFY_REG(*pulTrim, OPAMP_TRIMMING_MAX << ulTrimPos, ulTrim << ulTrimPos);
+    }
+}
+
+/** @defgroup OPAMP_Exported_Functions OPAMP Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the operational amplifier using the setup configuration.
+ *        The amplifier has to be enabled separately.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ * @param pxConfig: OPAMP setup configuration
+ */
+void OPAMP_vInit(OPAMP_HandleType * pxOPAMP, const OPAMP_InitType * pxConfig)
+{
+    uint32_t ulVMSEL = OPAMP_VMSEL_INTERNAL;
+
+    if (pxConfig->Mode == OPAMP_MODE_STANDALONE)
+    {
+        ulVMSEL = pxConfig->InvertingInput;
+    }
+
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_OPAMP);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxOPAMP->Callbacks.DepInit, pxOPAMP);
+
+    /* keep the user trimming selection of a previous calibration */
+    pxOPAMP->Inst->CSR.w = (pxOPAMP->Inst->CSR.w & OPAMP_CSR_USERTRIM)
+            | (pxConfig->Mode << OPAMP_CSR_OPAMODE_Pos)
+            | ((uint32_t)pxConfig->NonInvertingInput << OPAMP_CSR_VPSEL_Pos)
+            | (ulVMSEL << OPAMP_CSR_VMSEL_Pos)
+            | (pxConfig->PgaGain << OPAMP_CSR_PGGAIN_Pos)
+            | (pxConfig->LowPower << OPAMP_CSR_OPALPM_Pos);
+
+    MODIFY_REG(OPAMP1->CSR.w, OPAMP1_CSR_OPARANGE,
+            pxConfig->HighRange << OPAMP1_CSR_OPARANGE_Pos);
+}
+
+/**
+ * @brief Restores the operational amplifier to its default inactive state.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+void OPAMP_vDeinit(OPAMP_HandleType * pxOPAMP)
+{
+    /* the common range setting is kept */
+    CLEAR_BIT(pxOPAMP->Inst->CSR.w, ~OPAMP1_CSR_OPARANGE);
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxOPAMP->Callbacks.DepDeinit, pxOPAMP);
+}
+
+/**
+ * @brief Calibrates the offset of the operational amplifier in its current power mode,
+ *        and applies the found user trimming values.
+ * @note  The calibration takes about 12 ms, during which the output is invalid.
+ * @param pxOPAMP: pointer to the OPAMP handle structure
+ */
+void OPAMP_vCalibrate(OPAMP_HandleType * pxOPAMP)
+{
+    uint32_t ulCSR = pxOPAMP->Inst->CSR.w;
+    volatile uint32_t * pulTrim = &pxOPAMP->Inst->OTR.w;
+
+    /* low power mode has separate trimming values */
+    if ((ulCSR & OPAMP_CSR_OPALPM) != 0)
+    {
+        pulTrim = &pxOPAMP->Inst->LPOTR.w;
+    }
+
+    SET_BIT(pxOPAMP->Inst->CSR.w, OPAMP_CSR_OPAMPxEN | OPAMP_CSR_CALON | OPAMP_CSR_USERTRIM);
+
+    /* NMOS differential pair */
+    OPAMP_REG_BIT(pxOPAMP, CSR, CALSEL) = 0;
+    OPAMP_prvTrim(pxOPAMP, pulTrim, OPAMP_OTR_TRIMOFFSETN_Pos);
+
+    /* PMOS differential pair */
+    OPAMP_REG_BIT(pxOPAMP, CSR, CALSEL) = 1;
+    OPAMP_prvTrim(pxOPAMP, pulTrim, OPAMP_OTR_TRIMOFFSETP_Pos);
+
+    /* Restore the operating configuration with the user trimming values */
+    pxOPAMP->Inst->CSR.w = ulCSR | OPAMP_CSR_USERTRIM;
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* OPAMP1 */
@@ -0,0 +1,588 @@
+/**
+  ******************************************************************************
+  * @file    xpd_qspi.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Quad-SPI Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_qspi.h>
+#include <xpd_utils.h>
+
+#if defined(QUADSPI)
+
+/** @addtogroup QSPI
+ * @{ */
+
+#define QSPI_ABORT_TIMEOUT          100
+
+#define QSPI_FMODE_INDIRECT_WRITE   0
+#define QSPI_FMODE_INDIRECT_READ    1
+#define QSPI_FMODE_AUTO_POLLING     2
+#define QSPI_FMODE_MEMORY_MAPPED    3
+
+#define QSPI_FCR_ALL                (QUADSPI_FCR_CTEF | QUADSPI_FCR_CTCF | \
+                                     QUADSPI_FCR_CSMF | QUADSPI_FCR_CTOF)
+#define QSPI_CR_ALL_IT              (QUADSPI_CR_TEIE | QUADSPI_CR_TCIE | QUADSPI_CR_FTIE | \
+                                     QUADSPI_CR_SMIE | QUADSPI_CR_TOIE)
+
+#define QSPI_DR_BYTE(HANDLE)        (*(__IO uint8_t *)&(HANDLE)->Inst->DR)
+
+/* Writes the communication configuration, which starts the operation */
+static void QSPI_prvConfigCommand(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        uint32_t                    ulFMODE)
+{
+    uint32_t ulCCR =
+              ((uint32_t)pxCommand->Instruction      << QUADSPI_CCR_INSTRUCTION_Pos)
+            | ((uint32_t)pxCommand->InstructionLines << QUADSPI_CCR_IMODE_Pos)
+            | ((uint32_t)pxCommand->AddressLines     << QUADSPI_CCR_ADMODE_Pos)
+            | ((uint32_t)pxCommand->AddressSize      << QUADSPI_CCR_ADSIZE_Pos)
+            | ((uint32_t)pxCommand->AltBytesLines    << QUADSPI_CCR_ABMODE_Pos)
+            | ((uint32_t)pxCommand->AltBytesSize     << QUADSPI_CCR_ABSIZE_Pos)
+            | ((uint32_t)pxCommand->DummyCycles      << QUADSPI_CCR_DCYC_Pos)
+            | ((uint32_t)pxCommand->DataLines        << QUADSPI_CCR_DMODE_Pos)
+            | (ulFMODE                               << QUADSPI_CCR_FMODE_Pos)
+            | ((uint32_t)pxCommand->SendInstrOnce    << QUADSPI_CCR_SIOO_Pos)
+            | ((uint32_t)pxCommand->DDR              << QUADSPI_CCR_DDRM_Pos);
+
+    if (pxCommand->AltBytesLines != QSPI_LINES_NONE)
+    {
+        pxQSPI->Inst->ABR = pxCommand->AltBytes;
+    }
+
+    pxQSPI->Inst->CCR.w = ulCCR;
+
+    /* Writing the address starts the operation when there is an address phase */
+    if ((pxCommand->AddressLines != QSPI_LINES_NONE) && (ulFMODE != QSPI_FMODE_MEMORY_MAPPED))
+    {
+        pxQSPI->Inst->AR = ulAddress;
+    }
+}
+
+/* Waits for the completion of an indirect operation */
+static XPD_ReturnType QSPI_prvWaitForComplete(QSPI_HandleType * pxQSPI, uint32_t * pulTimeout)
+{
+    XPD_ReturnType eResult = XPD_eWaitForMatch(&pxQSPI->Inst->SR.w,
+            QUADSPI_SR_TCF, QUADSPI_SR_TCF, pulTimeout);
+
+    if (eResult == XPD_OK)
+    {
+        QSPI_FLAG_CLEAR(pxQSPI, TCF);
+    }
+    else
+    {
+        QSPI_vAbort(pxQSPI);
+    }
+    return eResult;
+}
+
+static void QSPI_prvDmaReceiveRedirect(void * pxDMA)
+{
+    QSPI_HandleType * pxQSPI = (QSPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    /* The last data has been read from the FIFO */
+    CLEAR_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_DMAEN | QUADSPI_CR_TEIE);
+    QSPI_FLAG_CLEAR(pxQSPI, TCF);
+
+    XPD_SAFE_CALLBACK(pxQSPI->Callbacks.Receive, pxQSPI);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void QSPI_prvDmaErrorRedirect(void * pxDMA)
+{
+    QSPI_HandleType * pxQSPI = (QSPI_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxQSPI->Errors |= QSPI_ERROR_DMA;
+
+    QSPI_vAbort(pxQSPI);
+
+    XPD_SAFE_CALLBACK(pxQSPI->Callbacks.Error, pxQSPI);
+}
+#endif
+
+/* Sets up the DMA for an indirect data transfer */
+static XPD_ReturnType QSPI_prvStartDMA(
+        QSPI_HandleType *   pxQSPI,
+        void *              pvData,
+        uint16_t            usLength,
+        uint32_t            ulDirection)
+{
+    XPD_ReturnType eResult;
+
+    /* The single DMA request serves both directions */
+    DMA_REG_BIT(pxQSPI->DMA, CCR, EN)  = 0;
+    DMA_REG_BIT(pxQSPI->DMA, CCR, DIR) = ulDirection;
+
+    /* The length is converted to the configured DMA data size */
+    eResult = DMA_eStart_IT(pxQSPI->DMA, (void*)&pxQSPI->Inst->DR, pvData,
+            usLength >> pxQSPI->DMA->Inst->CCR.b.PSIZE);
+
+    if (eResult == XPD_OK)
+    {
+        /* Set the callback owner */
+        pxQSPI->DMA->Owner = pxQSPI;
+
+        /* Set the DMA transfer callbacks */
+        pxQSPI->DMA->Callbacks.Complete     = (ulDirection == 0) ? QSPI_prvDmaReceiveRedirect : NULL;
+#ifdef __XPD_DMA_ERROR_DETECT
+        pxQSPI->DMA->Callbacks.Error        = QSPI_prvDmaErrorRedirect;
+#endif
+    }
+    return eResult;
+}
+
+/** @defgroup QSPI_Exported_Functions QSPI Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the QSPI peripheral using the setup configuration.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxConfig: QSPI setup configuration
+ */
+void QSPI_vInit(QSPI_HandleType * pxQSPI, const QSPI_InitType * pxConfig)
+{
+    /* enable clock */
+    RCC_vClockEnable(RCC_POS_QSPI);
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxQSPI->Callbacks.DepInit, pxQSPI);
+
+    pxQSPI->Inst->CR.w  = 0;
+    pxQSPI->Inst->FCR.w = QSPI_FCR_ALL;
+
+    pxQSPI->Inst->DCR.w =
+              ((uint32_t)pxConfig->FlashSize        << QUADSPI_DCR_FSIZE_Pos)
+            | ((uint32_t)(pxConfig->CSHighTime - 1) << QUADSPI_DCR_CSHT_Pos)
+            | ((uint32_t)pxConfig->ClockMode        << QUADSPI_DCR_CKMODE_Pos);
+
+    pxQSPI->Inst->CR.w =
+              ((uint32_t)pxConfig->Prescaler           << QUADSPI_CR_PRESCALER_Pos)
+            | ((uint32_t)(pxConfig->FifoThreshold - 1) << QUADSPI_CR_FTHRES_Pos)
+            | ((uint32_t)pxConfig->SampleShift         << QUADSPI_CR_SSHIFT_Pos)
+            | QUADSPI_CR_EN;
+
+    pxQSPI->Errors = QSPI_ERROR_NONE;
+}
+
+/**
+ * @brief Restores the QSPI peripheral to its default inactive state.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ */
+void QSPI_vDeinit(QSPI_HandleType * pxQSPI)
+{
+    QSPI_vAbort(pxQSPI);
+
+    pxQSPI->Inst->CR.w = 0;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxQSPI->Callbacks.DepDeinit, pxQSPI);
+
+    /* disable clock */
+    RCC_vClockDisable(RCC_POS_QSPI);
+}
+
+/**
+ * @brief Sends a command without data phase and waits for its completion.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the command configuration (without data lines)
+ * @param ulAddress: the address to send if the command has an address phase
+ * @param ulTimeout: the timeout in ms for the operation
+ * @return BUSY if the QSPI is in use, TIMEOUT if timed out, OK if successful
+ */
+XPD_ReturnType QSPI_eCommand(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        uint32_t                    ulTimeout)
+{
+    if (QSPI_eGetStatus(pxQSPI) != XPD_OK)
+    {
+        return XPD_BUSY;
+    }
+
+    QSPI_FLAG_CLEAR(pxQSPI, TCF);
+    QSPI_prvConfigCommand(pxQSPI, pxCommand, ulAddress, QSPI_FMODE_INDIRECT_WRITE);
+
+    return QSPI_prvWaitForComplete(pxQSPI, &ulTimeout);
+}
+
+/**
+ * @brief Sends a command and transmits data through the FIFO by polling.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the command configuration
+ * @param ulAddress: the address to send if the command has an address phase
+ * @param pvData: pointer to the data to transmit
+ * @param ulLength: amount of bytes to transmit
+ * @param ulTimeout: the timeout in ms for the operation
+ * @return BUSY if the QSPI is in use, TIMEOUT if timed out, OK if successful
+ */
+XPD_ReturnType QSPI_eTransmit(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        const void *                pvData,
+        uint32_t                    ulLength,
+        uint32_t                    ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    const uint8_t * pucData = pvData;
+
+    if (QSPI_eGetStatus(pxQSPI) != XPD_OK)
+    {
+        return XPD_BUSY;
+    }
+
+    QSPI_FLAG_CLEAR(pxQSPI, TCF);
+    pxQSPI->Inst->DLR = ulLength - 1;
+    QSPI_prvConfigCommand(pxQSPI, pxCommand, ulAddress, QSPI_FMODE_INDIRECT_WRITE);
+
+    for (; (ulLength > 0) && (eResult == XPD_OK); ulLength--)
+    {
+        eResult = XPD_eWaitForMatch(&pxQSPI->Inst->SR.w,
+                QUADSPI_SR_FTF, QUADSPI_SR_FTF, &ulTimeout);
+
+        QSPI_DR_BYTE(pxQSPI) = *pucData++;
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = QSPI_prvWaitForComplete(pxQSPI, &ulTimeout);
+    }
+    else
+    {
+        QSPI_vAbort(pxQSPI);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Sends a command and receives data through the FIFO by polling.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the command configuration
+ * @param ulAddress: the address to send if the command has an address phase
+ * @param pvData: pointer to the receive buffer
+ * @param ulLength: amount of bytes to receive
+ * @param ulTimeout: the timeout in ms for the operation
+ * @return BUSY if the QSPI is in use, TIMEOUT if timed out, OK if successful
+ */
+XPD_ReturnType QSPI_eReceive(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        void *                      pvData,
+        uint32_t                    ulLength,
+        uint32_t                    ulTimeout)
+{
+    XPD_ReturnType eResult = XPD_OK;
+    uint8_t * pucData = pvData;
+
+    if (QSPI_eGetStatus(pxQSPI) != XPD_OK)
+    {
+        return XPD_BUSY;
+    }
+
+    QSPI_FLAG_CLEAR(pxQSPI, TCF);
+    pxQSPI->Inst->DLR = ulLength - 1;
+    QSPI_prvConfigCommand(pxQSPI, pxCommand, ulAddress, QSPI_FMODE_INDIRECT_READ);
+
+    for (; (ulLength > 0) && (eResult == XPD_OK); ulLength--)
+    {
+        /* Either the threshold is reached or the last bytes are received */
+        eResult = XPD_eWaitForDiff(&pxQSPI->Inst->SR.w,
+                QUADSPI_SR_FTF | QUADSPI_SR_TCF, 0, &ulTimeout);
+
+        *pucData++ = QSPI_DR_BYTE(pxQSPI);
+    }
+
+    if (eResult == XPD_OK)
+    {
+        eResult = QSPI_prvWaitForComplete(pxQSPI, &ulTimeout);
+    }
+    else
+    {
+        QSPI_vAbort(pxQSPI);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Sends a command and transmits data using DMA.
+ * @note  The Transmit callback is called when the data is shifted out on the bus.
+ *        The length must be a multiple of the DMA data size.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the command configuration
+ * @param ulAddress: the address to send if the command has an address phase
+ * @param pvData: pointer to the data to transmit
+ * @param usLength: amount of bytes to transmit
+ * @return BUSY if the QSPI or DMA is in use, OK if the transfer is started
+ */
+XPD_ReturnType QSPI_eTransmit_DMA(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        const void *                pvData,
+        uint16_t                    usLength)
+{
+    XPD_ReturnType eResult = QSPI_eGetStatus(pxQSPI);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = QSPI_prvStartDMA(pxQSPI, (void*)pvData, usLength, 1);
+    }
+    if (eResult == XPD_OK)
+    {
+        pxQSPI->Errors = QSPI_ERROR_NONE;
+        pxQSPI->Inst->FCR.w = QSPI_FCR_ALL;
+        pxQSPI->Inst->DLR = usLength - 1;
+
+        /* Completion is signalled by the QSPI when the FIFO is emptied on the bus */
+        SET_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_TEIE | QUADSPI_CR_TCIE | QUADSPI_CR_DMAEN);
+
+        QSPI_prvConfigCommand(pxQSPI, pxCommand, ulAddress, QSPI_FMODE_INDIRECT_WRITE);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Sends a command and receives data using DMA.
+ * @note  The Receive callback is called when the DMA has read all data from the FIFO.
+ *        The length must be a multiple of the DMA data size.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the command configuration
+ * @param ulAddress: the address to send if the command has an address phase
+ * @param pvData: pointer to the receive buffer
+ * @param usLength: amount of bytes to receive
+ * @return BUSY if the QSPI or DMA is in use, OK if the transfer is started
+ */
+XPD_ReturnType QSPI_eReceive_DMA(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint32_t                    ulAddress,
+        void *                      pvData,
+        uint16_t                    usLength)
+{
+    XPD_ReturnType eResult = QSPI_eGetStatus(pxQSPI);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = QSPI_prvStartDMA(pxQSPI, pvData, usLength, 0);
+    }
+    if (eResult == XPD_OK)
+    {
+        pxQSPI->Errors = QSPI_ERROR_NONE;
+        pxQSPI->Inst->FCR.w = QSPI_FCR_ALL;
+        pxQSPI->Inst->DLR = usLength - 1;
+
+        SET_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_TEIE | QUADSPI_CR_DMAEN);
+
+        QSPI_prvConfigCommand(pxQSPI, pxCommand, ulAddress, QSPI_FMODE_INDIRECT_READ);
+    }
+    return eResult;
+}
+
+/* Sets up the automatic status polling registers */
+static void QSPI_prvConfigPolling(QSPI_HandleType * pxQSPI, const QSPI_PollingType * pxPolling)
+{
+    pxQSPI->Inst->PSMAR = pxPolling->Match;
+    pxQSPI->Inst->PSMKR = pxPolling->Mask;
+    pxQSPI->Inst->PIR   = pxPolling->Interval;
+    pxQSPI->Inst->DLR   = pxPolling->StatusBytes - 1;
+
+    /* Polling stops automatically at the first match */
+    QSPI_REG_BIT(pxQSPI, CR, PMM)  = pxPolling->MatchMode;
+    QSPI_REG_BIT(pxQSPI, CR, APMS) = 1;
+
+    QSPI_FLAG_CLEAR(pxQSPI, SMF);
+}
+
+/**
+ * @brief Periodically reads the flash status by hardware and waits until it matches.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the status read command configuration
+ * @param pxPolling: the status polling configuration
+ * @param ulTimeout: the timeout in ms for the operation
+ * @return BUSY if the QSPI is in use, TIMEOUT if timed out, OK if the status matched
+ */
+XPD_ReturnType QSPI_eAutoPolling(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        const QSPI_PollingType *    pxPolling,
+        uint32_t                    ulTimeout)
+{
+    XPD_ReturnType eResult = QSPI_eGetStatus(pxQSPI);
+
+    if (eResult == XPD_OK)
+    {
+        QSPI_prvConfigPolling(pxQSPI, pxPolling);
+        QSPI_prvConfigCommand(pxQSPI, pxCommand, 0, QSPI_FMODE_AUTO_POLLING);
+
+        eResult = XPD_eWaitForMatch(&pxQSPI->Inst->SR.w,
+                QUADSPI_SR_SMF, QUADSPI_SR_SMF, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            QSPI_FLAG_CLEAR(pxQSPI, SMF);
+        }
+        else
+        {
+            QSPI_vAbort(pxQSPI);
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Starts periodic flash status reading by hardware,
+ *        the StatusMatch callback is called when the status matches.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the status read command configuration
+ * @param pxPolling: the status polling configuration
+ * @return BUSY if the QSPI is in use, OK if polling is started
+ */
+XPD_ReturnType QSPI_eAutoPolling_IT(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        const QSPI_PollingType *    pxPolling)
+{
+    XPD_ReturnType eResult = QSPI_eGetStatus(pxQSPI);
+
+    if (eResult == XPD_OK)
+    {
+        pxQSPI->Errors = QSPI_ERROR_NONE;
+
+        QSPI_prvConfigPolling(pxQSPI, pxPolling);
+
+        SET_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_TEIE | QUADSPI_CR_SMIE);
+
+        QSPI_prvConfigCommand(pxQSPI, pxCommand, 0, QSPI_FMODE_AUTO_POLLING);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Maps the external flash to the QSPI_MEMORY_BASE address region,
+ *        where it can be read and executed in place.
+ * @note  With the timeout counter disabled the chip select stays active after an access,
+ *        so the QSPI keeps prefetching the following data. This gives the highest throughput
+ *        for sequential reads and code execution. A nonzero timeout releases the flash after
+ *        the given idle time to reduce its power consumption.
+ *        The memory-mapped mode can only be left by @ref QSPI_vAbort.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ * @param pxCommand: the read command configuration
+ * @param usTimeoutCycles: bus clock cycles before the chip select is released, 0 to disable
+ * @return BUSY if the QSPI is in use, OK if memory-mapped mode is active
+ */
+XPD_ReturnType QSPI_eMemoryMapped(
+        QSPI_HandleType *           pxQSPI,
+        const QSPI_CommandType *    pxCommand,
+        uint16_t                    usTimeoutCycles)
+{
+    XPD_ReturnType eResult = QSPI_eGetStatus(pxQSPI);
+
+    if (eResult == XPD_OK)
+    {
+        if (usTimeoutCycles != 0)
+        {
+            pxQSPI->Inst->LPTR = usTimeoutCycles;
+            QSPI_REG_BIT(pxQSPI, CR, TCEN) = 1;
+        }
+        else
+        {
+            QSPI_REG_BIT(pxQSPI, CR, TCEN) = 0;
+        }
+
+        QSPI_prvConfigCommand(pxQSPI, pxCommand, 0, QSPI_FMODE_MEMORY_MAPPED);
+    }
+    return eResult;
+}
+
+/**
+ * @brief Aborts the ongoing QSPI operation, including memory-mapped mode and automatic polling.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ */
+void QSPI_vAbort(QSPI_HandleType * pxQSPI)
+{
+    uint32_t ulTimeout = QSPI_ABORT_TIMEOUT;
+
+    CLEAR_BIT(pxQSPI->Inst->CR.w, QSPI_CR_ALL_IT);
+
+    if (QSPI_REG_BIT(pxQSPI, CR, DMAEN) != 0)
+    {
+        QSPI_REG_BIT(pxQSPI, CR, DMAEN) = 0;
+
+        DMA_vStop_IT(pxQSPI->DMA);
+    }
+
+    if (QSPI_eGetStatus(pxQSPI) != XPD_OK)
+    {
+        QSPI_REG_BIT(pxQSPI, CR, ABORT) = 1;
+
+        /* The abort bit is cleared by hardware when the operation is stopped */
+        (void) XPD_eWaitForMatch(&pxQSPI->Inst->CR.w, QUADSPI_CR_ABORT, 0, &ulTimeout);
+    }
+
+    pxQSPI->Inst->FCR.w = QSPI_FCR_ALL;
+}
+
+/**
+ * @brief QSPI interrupt handler that provides handle callbacks.
+ * @param pxQSPI: pointer to the QSPI handle structure
+ */
+void QSPI_vIRQHandler(QSPI_HandleType * pxQSPI)
+{
+    uint32_t ulCR = pxQSPI->Inst->CR.w;
+    uint32_t ulSR = pxQSPI->Inst->SR.w;
+
+    /* Transfer error */
+    if (((ulSR & QUADSPI_SR_TEF) != 0) && ((ulCR & QUADSPI_CR_TEIE) != 0))
+    {
+        pxQSPI->Errors |= QSPI_ERROR_TRANSFER;
+
+        QSPI_vAbort(pxQSPI);
+
+        XPD_SAFE_CALLBACK(pxQSPI->Callbacks.Error, pxQSPI);
+    }
+    else
+    {
+        /* Indirect write complete */
+        if (((ulSR & QUADSPI_SR_TCF) != 0) && ((ulCR & QUADSPI_CR_TCIE) != 0))
+        {
+            CLEAR_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_DMAEN | QUADSPI_CR_TCIE | QUADSPI_CR_TEIE);
+            QSPI_FLAG_CLEAR(pxQSPI, TCF);
+
+            XPD_SAFE_CALLBACK(pxQSPI->Callbacks.Transmit, pxQSPI);
+        }
+
+        /* Automatic polling status match */
+        if (((ulSR & QUADSPI_SR_SMF) != 0) && ((ulCR & QUADSPI_CR_SMIE) != 0))
+        {
+            CLEAR_BIT(pxQSPI->Inst->CR.w, QUADSPI_CR_SMIE | QUADSPI_CR_TEIE);
+            QSPI_FLAG_CLEAR(pxQSPI, SMF);
+
+            XPD_SAFE_CALLBACK(pxQSPI->Callbacks.StatusMatch, pxQSPI);
+        }
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* QUADSPI */
@@ -23,32 +23,40 @@
 #include <xpd_rcc.h>
 #include <xpd_adc.h>
 #include <xpd_cec.h>
+#include <xpd_dfsdm.h>
 #include <xpd_i2c.h>
 #include <xpd_i2s.h>
+#include <xpd_lptim.h>
 #include <xpd_pwr.h>
+#include <xpd_rng.h>
 #include <xpd_rtc.h>
+#include <xpd_sai.h>
+#include <xpd_sdmmc.h>
 #include <xpd_tim.h>
 #include <xpd_usart.h>
 #include <xpd_usb.h>
 #include <xpd_utils.h>
 
 #ifdef RCC_PLLP_DIV_2_31_SUPPORT
-#define RCC_PLLP_FREQ(PLL_NAME) \
-    (RCC_ulOscFreq_Hz(XPD_RCC_GetPLLSource()) * RCC->PLL_NAME##CFGR.b.PLL_NAME##N \
-    / (RCC->PLLCFGR.b.PLLM * RCC->PLL_NAME##CFGR.b.PLL_NAME##PDIV))
+#define RCC_PLLP_DIV(PLL_NAME) \
+    ((RCC->PLL_NAME##CFGR.b.PLL_NAME##PDIV != 0) ? RCC->PLL_NAME##CFGR.b.PLL_NAME##PDIV : \
+    ((RCC->PLL_NAME##CFGR.b.PLL_NAME##P == 0) ? 7 : 17))
 #else
-#define RCC_PLLP_FREQ(PLL_NAME) \
-    (RCC_ulOscFreq_Hz(XPD_RCC_GetPLLSource()) * RCC->PLL_NAME##CFGR.b.PLL_NAME##N \
-    / (RCC->PLLCFGR.b.PLLM * ((RCC->PLL_NAME##CFGR.b.PLL_NAME##P == 0) ? 7 : 17)))
+#define RCC_PLLP_DIV(PLL_NAME) \
+    ((RCC->PLL_NAME##CFGR.b.PLL_NAME##P == 0) ? 7 : 17)
 #endif
 
+#define RCC_PLLP_FREQ(PLL_NAME) \
+    (RCC_ulOscFreq_Hz(RCC->PLLCFGR.b.PLLSRC - 1) * RCC->PLL_NAME##CFGR.b.PLL_NAME##N \
+    / ((RCC->PLLCFGR.b.PLLM + 1) * RCC_PLLP_DIV(PLL_NAME)))
+
 #define RCC_PLLR_FREQ(PLL_NAME) \
     (RCC_ulOscFreq_Hz(RCC->PLLCFGR.b.PLLSRC - 1) * RCC->PLL_NAME##CFGR.b.PLL_NAME##N \
-    / (RCC->PLLCFGR.b.PLLM * (2 * (RCC->PLL_NAME##CFGR.b.PLL_NAME##R + 1))))
+    / ((RCC->PLLCFGR.b.PLLM + 1) * (2 * (RCC->PLL_NAME##CFGR.b.PLL_NAME##R + 1))))
 
 #define RCC_PLLQ_FREQ(PLL_NAME) \
     (RCC_ulOscFreq_Hz(RCC->PLLCFGR.b.PLLSRC - 1) * RCC->PLL_NAME##CFGR.b.PLL_NAME##N \
-    / (RCC->PLLCFGR.b.PLLM * (2 * (RCC->PLL_NAME##CFGR.b.PLL_NAME##Q + 1))))
+    / ((RCC->PLLCFGR.b.PLLM + 1) * (2 * (RCC->PLL_NAME##CFGR.b.PLL_NAME##Q + 1))))
 
 /** @ingroup ADC_Clock_Source
  * @defgroup ADC_Clock_Source_Exported_Functions ADC Clock Source Exported Functions
@@ -138,6 +146,41 @@ uint32_t ADC_ulClockFreq_Hz(void)
 
 /** @} */
 
+#if defined(DFSDM1_Filter0)
+
+/** @ingroup DFSDM_Clock_Source
+ * @defgroup DFSDM_Clock_Source_Exported_Functions DFSDM Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the DFSDM.
+ * @param eClockSource: the new source clock which should be configured
+ */
+void DFSDM_vClockConfig(DFSDM_ClockSourceType eClockSource)
+{
+    RCC_REG_BIT(CCIPR,DFSDM1SEL) = eClockSource;
+}
+
+/**
+ * @brief Returns the kernel clock frequency of the DFSDM.
+ * @return The clock frequency of the DFSDM in Hz
+ */
+uint32_t DFSDM_ulClockFreq_Hz(void)
+{
+    if (RCC_REG_BIT(CCIPR,DFSDM1SEL) == DFSDM_CLOCKSOURCE_SYSCLK)
+    {
+        return RCC_ulClockFreq_Hz(SYSCLK);
+    }
+    else
+    {
+        return RCC_ulClockFreq_Hz(PCLK2);
+    }
+}
+
+/** @} */
+
+#endif /* DFSDM1_Filter0 */
+
 /** @ingroup I2C_Clock_Source
  * @defgroup I2C_Clock_Source_Exported_Functions I2C Clock Source Exported Functions
  * @{ */
@@ -225,6 +268,59 @@ uint32_t I2C_ulClockFreq_Hz(I2C_HandleType * pxI2C)
 
 /** @} */
 
+/** @ingroup LPTIM_Clock_Source
+ * @defgroup LPTIM_Clock_Source_Exported_Functions LPTIM Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the selected LPTIM.
+ * @note  Only the LSI and LSE clock sources are available in Stop 2 mode.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @param eClockSource: the new source clock which should be configured
+ */
+void LPTIM_vClockConfig(LPTIM_HandleType * pxLPTIM, LPTIM_ClockSourceType eClockSource)
+{
+    if (pxLPTIM->Inst == LPTIM1)
+    {
+        RCC->CCIPR.b.LPTIM1SEL = eClockSource;
+    }
+    else
+    {
+        RCC->CCIPR.b.LPTIM2SEL = eClockSource;
+    }
+}
+
+/**
+ * @brief Returns the input clock frequency of the LPTIM.
+ * @param pxLPTIM: pointer to the LPTIM handle structure
+ * @return The clock frequency of the LPTIM in Hz
+ */
+uint32_t LPTIM_ulClockFreq_Hz(LPTIM_HandleType * pxLPTIM)
+{
+    LPTIM_ClockSourceType eSource = (pxLPTIM->Inst == LPTIM1) ?
+            RCC->CCIPR.b.LPTIM1SEL : RCC->CCIPR.b.LPTIM2SEL;
+
+    /* get the value for the configured source */
+    switch (eSource)
+    {
+        case LPTIM_CLOCKSOURCE_LSI:
+            return LSI_VALUE_Hz;
+
+        case LPTIM_CLOCKSOURCE_HSI:
+            return HSI_VALUE_Hz;
+
+#ifdef LSE_VALUE_Hz
+        case LPTIM_CLOCKSOURCE_LSE:
+            return LSE_VALUE_Hz;
+#endif
+
+        default:
+            return RCC_ulClockFreq_Hz(PCLK1);
+    }
+}
+
+/** @} */
+
 /** @ingroup RTC_Clock_Source
  * @defgroup RTC_Clock_Source_Exported_Functions RTC Clock Source Exported Functions
  * @{ */
@@ -472,6 +568,197 @@ uint32_t USART_ulClockFreq_Hz(USART_HandleType * pxUSART)
 
 /** @} */
 
+#if defined(SAI1)
+
+/** @ingroup SAI_Clock_Source
+ * @defgroup SAI_Clock_Source_Exported_Functions SAI Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the SAI (shared by both blocks).
+ * @param pxSAI: pointer to the SAI handle structure
+ * @param eClockSource: the new source clock which should be configured
+ */
+void SAI_vClockConfig(SAI_HandleType * pxSAI, SAI_ClockSourceType eClockSource)
+{
+#ifdef SAI2
+    if (pxSAI->CtrlPos == RCC_POS_SAI2)
+    {
+        RCC->CCIPR.b.SAI2SEL = eClockSource;
+    }
+    else
+#endif
+    {
+        RCC->CCIPR.b.SAI1SEL = eClockSource;
+    }
+
+    switch (eClockSource)
+    {
+    case SAI_CLOCKSOURCE_PLLSAI1:
+        /* Enable PLLSAI1 P output */
+        RCC_REG_BIT(PLLSAI1CFGR, PLLSAI1PEN) = 1;
+        break;
+
+#ifdef RCC_PLLSAI2_SUPPORT
+    case SAI_CLOCKSOURCE_PLLSAI2:
+        /* Enable PLLSAI2 P output */
+        RCC_REG_BIT(PLLSAI2CFGR, PLLSAI2PEN) = 1;
+        break;
+#endif
+
+    case SAI_CLOCKSOURCE_PLL:
+        /* Enable PLL P output */
+        RCC_REG_BIT(PLLCFGR, PLLPEN) = 1;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Returns the input clock frequency of the SAI.
+ * @param pxSAI: pointer to the SAI handle structure
+ * @return The clock frequency of the SAI in Hz
+ */
+uint32_t SAI_ulClockFreq_Hz(SAI_HandleType * pxSAI)
+{
+    uint32_t ulSource = RCC->CCIPR.b.SAI1SEL;
+
+#ifdef SAI2
+    if (pxSAI->CtrlPos == RCC_POS_SAI2)
+    {
+        ulSource = RCC->CCIPR.b.SAI2SEL;
+    }
+#endif
+
+    switch (ulSource)
+    {
+        case SAI_CLOCKSOURCE_PLLSAI1:
+            return RCC_PLLP_FREQ(PLLSAI1);
+
+#ifdef RCC_PLLSAI2_SUPPORT
+        case SAI_CLOCKSOURCE_PLLSAI2:
+            return RCC_PLLP_FREQ(PLLSAI2);
+#endif
+
+        case SAI_CLOCKSOURCE_PLL:
+            return RCC_PLLP_FREQ(PLL);
+
+#ifdef EXTERNAL_CLOCK_VALUE_Hz
+        case SAI_CLOCKSOURCE_EXT:
+            return EXTERNAL_CLOCK_VALUE_Hz;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/** @} */
+
+#endif /* SAI1 */
+
+#if defined(SDMMC1)
+
+/** @ingroup SDMMC_Clock_Source
+ * @defgroup SDMMC_Clock_Source_Exported_Functions SDMMC Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the SDMMC.
+ * @note  The 48 MHz clock source is shared with the USB and RNG peripherals.
+ * @param eClockSource: the new source clock which should be configured
+ */
+void SDMMC_vClockConfig(SDMMC_ClockSourceType eClockSource)
+{
+    RCC->CCIPR.b.CLK48SEL = eClockSource;
+
+    switch (eClockSource)
+    {
+    case SDMMC_CLOCKSOURCE_PLL:
+        /* Enable PLL Q output */
+        RCC_REG_BIT(PLLCFGR, PLLQEN) = 1;
+        break;
+
+    case SDMMC_CLOCKSOURCE_PLLSAI1:
+        /* Enable PLLSAI1 Q output */
+        RCC_REG_BIT(PLLSAI1CFGR, PLLSAI1QEN) = 1;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Returns the input clock frequency of the SDMMC.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @return The clock frequency of the SDMMC in Hz
+ */
+uint32_t SDMMC_ulClockFreq_Hz(SDMMC_HandleType * pxSDMMC)
+{
+    switch (RCC->CCIPR.b.CLK48SEL)
+    {
+#ifdef RCC_HSI48_SUPPORT
+        case SDMMC_CLOCKSOURCE_HSI48:
+            return RCC_ulOscFreq_Hz(HSI48);
+#endif
+
+        case SDMMC_CLOCKSOURCE_PLLSAI1:
+            return RCC_PLLQ_FREQ(PLLSAI1);
+
+        case SDMMC_CLOCKSOURCE_PLL:
+            return RCC_PLLQ_FREQ(PLL);
+
+        case SDMMC_CLOCKSOURCE_MSI:
+            return RCC_ulOscFreq_Hz(MSI);
+
+        default:
+            return 0;
+    }
+}
+
+/** @} */
+
+#endif /* SDMMC1 */
+
+#if defined(RNG)
+
+/** @ingroup RNG_Clock_Source
+ * @defgroup RNG_Clock_Source_Exported_Functions RNG Clock Source Exported Functions
+ * @{ */
+
+/**
+ * @brief Sets the new source clock for the RNG.
+ * @note  The 48 MHz clock source is shared with the USB and SDMMC peripherals.
+ * @param eClockSource: the new source clock which should be configured
+ */
+void RNG_vClockConfig(RNG_ClockSourceType eClockSource)
+{
+    RCC->CCIPR.b.CLK48SEL = eClockSource;
+
+    switch (eClockSource)
+    {
+    case RNG_CLOCKSOURCE_PLL:
+        /* Enable PLL Q output */
+        RCC_REG_BIT(PLLCFGR, PLLQEN) = 1;
+        break;
+
+    case RNG_CLOCKSOURCE_PLLSAI1:
+        /* Enable PLLSAI1 Q output */
+        RCC_REG_BIT(PLLSAI1CFGR, PLLSAI1QEN) = 1;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/** @} */
+
+#endif /* RNG */
+
 #if defined(USB)
 
 /** @ingroup USB_Clock_Source
@@ -0,0 +1,1101 @@
+/**
+  ******************************************************************************
+  * @file    xpd_sdmmc.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers SD/MMC Host Module
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_sdmmc.h>
+#include <xpd_utils.h>
+
+#if defined(SDMMC1)
+
+/** @addtogroup SDMMC
+ * @{ */
+
+#define SDMMC_MSK(NAME)             (SDMMC_##NAME)
+
+#define SDMMC_INIT_FREQ_Hz          400000
+#define SDMMC_DEFAULT_FREQ_Hz       25000000
+#define SDMMC_HIGHSPEED_FREQ_Hz     50000000
+
+#define SDMMC_BLOCK_SIZE            512
+#define SDMMC_BLOCK_SIZE_POW2       9
+#define SDMMC_MAX_BLOCK_COUNT       (0xFFFF / (SDMMC_BLOCK_SIZE / sizeof(uint32_t)))
+#define SDMMC_DATA_TIMEOUT          0xFFFFFFFF
+
+#define SDMMC_CMD_TIMEOUT           100
+#define SDMMC_POWERUP_TIMEOUT       1000
+#define SDMMC_SWITCH_TIMEOUT        100
+
+/* SD command indexes */
+#define SD_CMD_GO_IDLE_STATE        0
+#define SD_CMD_ALL_SEND_CID         2
+#define SD_CMD_SEND_RELATIVE_ADDR   3
+#define SD_CMD_SWITCH_FUNC          6
+#define SD_CMD_SELECT_CARD          7
+#define SD_CMD_SEND_IF_COND         8
+#define SD_CMD_SEND_CSD             9
+#define SD_CMD_STOP_TRANSMISSION    12
+#define SD_CMD_SEND_STATUS          13
+#define SD_CMD_SET_BLOCKLEN         16
+#define SD_CMD_READ_SINGLE_BLOCK    17
+#define SD_CMD_READ_MULTIPLE_BLOCK  18
+#define SD_CMD_WRITE_BLOCK          24
+#define SD_CMD_WRITE_MULTIPLE_BLOCK 25
+#define SD_CMD_APP_CMD              55
+
+/* SD application specific command indexes */
+#define SD_ACMD_SET_BUS_WIDTH       6
+#define SD_ACMD_SET_WR_BLK_ERASE_COUNT 23
+#define SD_ACMD_SD_SEND_OP_COND     41
+
+#define SD_CHECK_PATTERN            0x000001AA
+#define SD_OCR_BUSY                 0x80000000
+#define SD_OCR_HCS                  0x40000000
+#define SD_OCR_VOLTAGE_WINDOW       0x00FF8000
+#define SD_SWITCH_HIGHSPEED         0x80FFFFF1
+#define SD_BUS_WIDTH_4BIT           2
+
+#define SD_R1_ERRORS                0xFDFFE008
+#define SD_R1_READY_FOR_DATA        0x00000100
+#define SD_R1_STATE(R1)             (((R1) >> 9) & 0xF)
+#define SD_STATE_TRAN               4
+
+/* Response types, with driver specific flags above the CMD register bits */
+#define SDMMC_RESP_NOCRC            0x80000000
+#define SDMMC_RESP_CHECK_R1         0x40000000
+#define SDMMC_RESP_FLAGS            (SDMMC_RESP_NOCRC | SDMMC_RESP_CHECK_R1)
+
+#define SDMMC_RESP_NONE             0
+#define SDMMC_RESP_SHORT            SDMMC_MSK(CMD_WAITRESP_0)
+#define SDMMC_RESP_R1               (SDMMC_RESP_SHORT | SDMMC_RESP_CHECK_R1)
+#define SDMMC_RESP_R2               SDMMC_MSK(CMD_WAITRESP)
+#define SDMMC_RESP_R3               (SDMMC_RESP_SHORT | SDMMC_RESP_NOCRC)
+#define SDMMC_RESP_R6               SDMMC_RESP_SHORT
+#define SDMMC_RESP_R7               SDMMC_RESP_SHORT
+
+#define SDMMC_STA_CMD_FLAGS         (SDMMC_MSK(STA_CCRCFAIL) | SDMMC_MSK(STA_CTIMEOUT) | \
+                                     SDMMC_MSK(STA_CMDREND)  | SDMMC_MSK(STA_CMDSENT))
+#define SDMMC_STA_DATA_ERRORS       (SDMMC_MSK(STA_DCRCFAIL) | SDMMC_MSK(STA_DTIMEOUT) | \
+                                     SDMMC_MSK(STA_TXUNDERR) | SDMMC_MSK(STA_RXOVERR)  | \
+                                     SDMMC_MSK(STA_STBITERR))
+
+#define SDMMC_ICR_CMD_FLAGS         (SDMMC_MSK(ICR_CCRCFAILC) | SDMMC_MSK(ICR_CTIMEOUTC) | \
+                                     SDMMC_MSK(ICR_CMDRENDC)  | SDMMC_MSK(ICR_CMDSENTC))
+#define SDMMC_ICR_DATA_FLAGS        (SDMMC_MSK(ICR_DCRCFAILC) | SDMMC_MSK(ICR_DTIMEOUTC) | \
+                                     SDMMC_MSK(ICR_TXUNDERRC) | SDMMC_MSK(ICR_RXOVERRC)  | \
+                                     SDMMC_MSK(ICR_STBITERRC) | SDMMC_MSK(ICR_DATAENDC)  | \
+                                     SDMMC_MSK(ICR_DBCKENDC))
+#define SDMMC_ICR_STATIC_FLAGS      (SDMMC_ICR_CMD_FLAGS | SDMMC_ICR_DATA_FLAGS)
+
+#define SDMMC_TRANSFER_IT_MASK      (SDMMC_MSK(MASK_CCRCFAILIE) | SDMMC_MSK(MASK_CTIMEOUTIE) | \
+                                     SDMMC_MSK(MASK_CMDRENDIE)  | SDMMC_MSK(MASK_DCRCFAILIE) | \
+                                     SDMMC_MSK(MASK_DTIMEOUTIE) | SDMMC_MSK(MASK_TXUNDERRIE) | \
+                                     SDMMC_MSK(MASK_RXOVERRIE)  | SDMMC_MSK(MASK_DATAENDIE))
+
+/* Asynchronous transfer states */
+#define SDMMC_STATE_IDLE            0
+#define SDMMC_STATE_APP_CMD         1
+#define SDMMC_STATE_BLOCK_COUNT     2
+#define SDMMC_STATE_TRANSFER        3
+#define SDMMC_STATE_DATA            4
+#define SDMMC_STATE_STOP            5
+#define SDMMC_STATE_STATUS          6
+
+/* Pending completion events of the data phase */
+#define SDMMC_PENDING_DMA           0x1
+#define SDMMC_PENDING_DATAEND       0x2
+
+#define SDMMC_QUEUE_MASK            (SDMMC_QUEUE_LENGTH - 1)
+
+#define SDMMC_ACTIVE_REQUEST(HANDLE)    \
+    ((HANDLE)->Queue.Items[(HANDLE)->Queue.Head & SDMMC_QUEUE_MASK])
+
+static void SDMMC_prvStartRequest(SDMMC_HandleType * pxSDMMC);
+
+/* Calculates the CLKCR clock setting for the target bus frequency */
+static uint32_t SDMMC_prvClockDivider(uint32_t ulClockFreq, uint32_t ulBusFreq)
+{
+    uint32_t ulDiv;
+
+    if (ulClockFreq <= ulBusFreq)
+    {
+        return SDMMC_MSK(CLKCR_BYPASS);
+    }
+
+    /* SDMMC_CK = SDMMCCLK / (CLKDIV + 2), shall not exceed the target */
+    ulDiv = (ulClockFreq + ulBusFreq - 1) / ulBusFreq - 2;
+    if (ulDiv > 0xFF)
+    {
+        ulDiv = 0xFF;
+    }
+    return ulDiv;
+}
+
+/* Calculates the number of 512 byte blocks from the CSD register */
+static uint32_t SDMMC_prvCardCapacity(const uint32_t * pulCSD)
+{
+    if ((pulCSD[0] >> 30) != 0)
+    {
+        /* CSD version 2.0: C_SIZE [69:48] in 512 kB units */
+        uint32_t ulCSize = ((pulCSD[1] & 0x3F) << 16) | (pulCSD[2] >> 16);
+
+        return (ulCSize + 1) << 10;
+    }
+    else
+    {
+        /* CSD version 1.0: (C_SIZE [73:62] + 1) * 2^(C_SIZE_MULT [49:47] + 2) * 2^READ_BL_LEN [83:80] */
+        uint32_t ulCSize = ((pulCSD[1] & 0x3FF) << 2) | (pulCSD[2] >> 30);
+        uint32_t ulMult  = (pulCSD[2] >> 15) & 0x7;
+        uint32_t ulBlLen = (pulCSD[1] >> 16) & 0xF;
+
+        return ((ulCSize + 1) << (ulMult + 2 + ulBlLen)) >> SDMMC_BLOCK_SIZE_POW2;
+    }
+}
+
+/* Sends a command and waits for its response */
+static XPD_ReturnType SDMMC_prvSendCommand(
+        SDMMC_HandleType *  pxSDMMC,
+        uint32_t            ulCmdIndex,
+        uint32_t            ulArgument,
+        uint32_t            ulResponse)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulTimeout = SDMMC_CMD_TIMEOUT;
+    uint32_t ulSTA;
+
+    pxSDMMC->Inst->ICR.w = SDMMC_ICR_CMD_FLAGS;
+    pxSDMMC->Inst->ARG   = ulArgument;
+    pxSDMMC->Inst->CMD.w = ulCmdIndex | (ulResponse & ~SDMMC_RESP_FLAGS) | SDMMC_MSK(CMD_CPSMEN);
+
+    eResult = XPD_eWaitForDiff((volatile uint32_t *)&pxSDMMC->Inst->STA.w,
+            SDMMC_STA_CMD_FLAGS, 0, &ulTimeout);
+
+    ulSTA = pxSDMMC->Inst->STA.w;
+    pxSDMMC->Inst->ICR.w = SDMMC_ICR_CMD_FLAGS;
+
+    if ((eResult != XPD_OK) || ((ulSTA & SDMMC_MSK(STA_CTIMEOUT)) != 0))
+    {
+        pxSDMMC->Errors |= SDMMC_ERROR_CMD_TIMEOUT;
+        eResult = XPD_TIMEOUT;
+    }
+    else if (((ulSTA & SDMMC_MSK(STA_CCRCFAIL)) != 0) && ((ulResponse & SDMMC_RESP_NOCRC) == 0))
+    {
+        pxSDMMC->Errors |= SDMMC_ERROR_CMD_CRC;
+        eResult = XPD_ERROR;
+    }
+    else if (((ulResponse & SDMMC_RESP_CHECK_R1) != 0)
+          && ((pxSDMMC->Inst->RESP1 & SD_R1_ERRORS) != 0))
+    {
+        pxSDMMC->Errors |= SDMMC_ERROR_CARD_STATUS;
+        eResult = XPD_ERROR;
+    }
+    return eResult;
+}
+
+/* Sends an application specific command and waits for its response */
+static XPD_ReturnType SDMMC_prvSendAppCommand(
+        SDMMC_HandleType *  pxSDMMC,
+        uint32_t            ulCmdIndex,
+        uint32_t            ulArgument,
+        uint32_t            ulResponse)
+{
+    XPD_ReturnType eResult = SDMMC_prvSendCommand(pxSDMMC,
+            SD_CMD_APP_CMD, (uint32_t)pxSDMMC->Card.RCA << 16, SDMMC_RESP_R1);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = SDMMC_prvSendCommand(pxSDMMC, ulCmdIndex, ulArgument, ulResponse);
+    }
+    return eResult;
+}
+
+/* Brings the card from idle to ready state */
+static XPD_ReturnType SDMMC_prvCardPowerUp(SDMMC_HandleType * pxSDMMC)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulOCR = SD_OCR_VOLTAGE_WINDOW;
+    uint32_t ulTimeout = SDMMC_POWERUP_TIMEOUT;
+
+    eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_GO_IDLE_STATE, 0, SDMMC_RESP_NONE);
+
+    if (eResult == XPD_OK)
+    {
+        /* Only version 2.00 cards respond to the interface condition,
+         * these may have high capacity */
+        if ((SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SEND_IF_COND,
+                SD_CHECK_PATTERN, SDMMC_RESP_R7) == XPD_OK)
+            && ((pxSDMMC->Inst->RESP1 & 0xFFF) == SD_CHECK_PATTERN))
+        {
+            ulOCR |= SD_OCR_HCS;
+        }
+        pxSDMMC->Errors = SDMMC_ERROR_NONE;
+
+        /* Repeat the operating condition request until the card is powered up */
+        do
+        {
+            eResult = SDMMC_prvSendAppCommand(pxSDMMC,
+                    SD_ACMD_SD_SEND_OP_COND, ulOCR, SDMMC_RESP_R3);
+
+            if ((eResult != XPD_OK) || ((pxSDMMC->Inst->RESP1 & SD_OCR_BUSY) != 0))
+            {
+                break;
+            }
+            XPD_vDelay_ms(1);
+        }
+        while (--ulTimeout > 0);
+
+        if (eResult != XPD_OK)
+        {
+            /* MMC cards do not respond to application commands */
+            pxSDMMC->Errors |= SDMMC_ERROR_UNSUPPORTED;
+        }
+        else if ((pxSDMMC->Inst->RESP1 & SD_OCR_BUSY) == 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_UNSUPPORTED;
+            eResult = XPD_TIMEOUT;
+        }
+        else
+        {
+            pxSDMMC->Card.Type = ((pxSDMMC->Inst->RESP1 & SD_OCR_HCS) != 0) ?
+                    SDMMC_CARD_SDHC : SDMMC_CARD_SDSC;
+        }
+    }
+    return eResult;
+}
+
+/* Reads the card identification data and assigns its relative address */
+static XPD_ReturnType SDMMC_prvCardIdentify(SDMMC_HandleType * pxSDMMC)
+{
+    XPD_ReturnType eResult;
+
+    eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_ALL_SEND_CID, 0, SDMMC_RESP_R2);
+
+    if (eResult == XPD_OK)
+    {
+        pxSDMMC->Card.CID[0] = pxSDMMC->Inst->RESP1;
+        pxSDMMC->Card.CID[1] = pxSDMMC->Inst->RESP2;
+        pxSDMMC->Card.CID[2] = pxSDMMC->Inst->RESP3;
+        pxSDMMC->Card.CID[3] = pxSDMMC->Inst->RESP4;
+
+        eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SEND_RELATIVE_ADDR, 0, SDMMC_RESP_R6);
+    }
+    if (eResult == XPD_OK)
+    {
+        pxSDMMC->Card.RCA = pxSDMMC->Inst->RESP1 >> 16;
+
+        eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SEND_CSD,
+                (uint32_t)pxSDMMC->Card.RCA << 16, SDMMC_RESP_R2);
+    }
+    if (eResult == XPD_OK)
+    {
+        pxSDMMC->Card.CSD[0] = pxSDMMC->Inst->RESP1;
+        pxSDMMC->Card.CSD[1] = pxSDMMC->Inst->RESP2;
+        pxSDMMC->Card.CSD[2] = pxSDMMC->Inst->RESP3;
+        pxSDMMC->Card.CSD[3] = pxSDMMC->Inst->RESP4;
+
+        pxSDMMC->Card.BlockCount = SDMMC_prvCardCapacity(pxSDMMC->Card.CSD);
+    }
+    return eResult;
+}
+
+/* Puts the card to transfer state and configures its bus */
+static XPD_ReturnType SDMMC_prvCardSelect(
+        SDMMC_HandleType *      pxSDMMC,
+        SDMMC_BusWidthType      eBusWidth)
+{
+    XPD_ReturnType eResult;
+
+    eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SELECT_CARD,
+            (uint32_t)pxSDMMC->Card.RCA << 16, SDMMC_RESP_R1);
+
+    /* Standard capacity cards use byte addressing with variable block length */
+    if ((eResult == XPD_OK) && (pxSDMMC->Card.Type == SDMMC_CARD_SDSC))
+    {
+        eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SET_BLOCKLEN,
+                SDMMC_BLOCK_SIZE, SDMMC_RESP_R1);
+    }
+    if ((eResult == XPD_OK) && (eBusWidth == SDMMC_BUS_4BIT))
+    {
+        eResult = SDMMC_prvSendAppCommand(pxSDMMC, SD_ACMD_SET_BUS_WIDTH,
+                SD_BUS_WIDTH_4BIT, SDMMC_RESP_R1);
+    }
+    if (eResult == XPD_OK)
+    {
+        pxSDMMC->Inst->CLKCR.b.WIDBUS = eBusWidth;
+    }
+    return eResult;
+}
+
+/* Switches the card to high speed mode */
+static XPD_ReturnType SDMMC_prvSwitchHighSpeed(SDMMC_HandleType * pxSDMMC)
+{
+    XPD_ReturnType eResult;
+    uint32_t aulStatus[16];
+    uint32_t ulIndex = 0;
+    uint32_t ulTimeout = SDMMC_SWITCH_TIMEOUT;
+
+    /* The 512 bit switch status is read by polling */
+    pxSDMMC->Inst->DTIMER  = SDMMC_DATA_TIMEOUT;
+    pxSDMMC->Inst->DLEN    = sizeof(aulStatus);
+    pxSDMMC->Inst->DCTRL.w = (6 << SDMMC_MSK(DCTRL_DBLOCKSIZE_Pos))
+                           | SDMMC_MSK(DCTRL_DTDIR) | SDMMC_MSK(DCTRL_DTEN);
+
+    eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SWITCH_FUNC,
+            SD_SWITCH_HIGHSPEED, SDMMC_RESP_R1);
+
+    while (eResult == XPD_OK)
+    {
+        uint32_t ulSTA;
+
+        eResult = XPD_eWaitForDiff((volatile uint32_t *)&pxSDMMC->Inst->STA.w,
+                SDMMC_MSK(STA_RXDAVL) | SDMMC_MSK(STA_DATAEND) | SDMMC_STA_DATA_ERRORS,
+                0, &ulTimeout);
+        ulSTA = pxSDMMC->Inst->STA.w;
+
+        if (eResult != XPD_OK)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_DATA_TIMEOUT;
+        }
+        else if ((ulSTA & SDMMC_MSK(STA_RXDAVL)) != 0)
+        {
+            uint32_t ulData = pxSDMMC->Inst->FIFO;
+
+            if (ulIndex < (sizeof(aulStatus) / sizeof(aulStatus[0])))
+            {
+                aulStatus[ulIndex++] = ulData;
+            }
+        }
+        else if ((ulSTA & SDMMC_STA_DATA_ERRORS) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_DATA_CRC;
+            eResult = XPD_ERROR;
+        }
+        else
+        {
+            /* Data end with empty FIFO */
+            break;
+        }
+    }
+
+    pxSDMMC->Inst->DCTRL.w = 0;
+    pxSDMMC->Inst->ICR.w = SDMMC_ICR_DATA_FLAGS;
+
+    /* Function group 1 result is in bits [379:376] of the big endian status */
+    if ((eResult == XPD_OK) &&
+        ((ulIndex < 5) || ((((uint8_t*)aulStatus)[16] & 0xF) != 1)))
+    {
+        eResult = XPD_ERROR;
+    }
+    return eResult;
+}
+
+/* Sends a command with short response without waiting */
+static void SDMMC_prvSendCommand_IT(
+        SDMMC_HandleType *  pxSDMMC,
+        uint32_t            ulCmdIndex,
+        uint32_t            ulArgument)
+{
+    pxSDMMC->Inst->ARG   = ulArgument;
+    pxSDMMC->Inst->CMD.w = ulCmdIndex | SDMMC_RESP_SHORT | SDMMC_MSK(CMD_CPSMEN);
+}
+
+/* Disables the data path and its DMA */
+static void SDMMC_prvStopData(SDMMC_HandleType * pxSDMMC)
+{
+    if (SDMMC_REG_BIT(pxSDMMC, DCTRL, DMAEN) != 0)
+    {
+        DMA_HandleType * pxDMA = (SDMMC_REG_BIT(pxSDMMC, DCTRL, DTDIR) != 0) ?
+                pxSDMMC->DMA.Receive : pxSDMMC->DMA.Transmit;
+
+        pxSDMMC->Inst->DCTRL.w = 0;
+
+        DMA_vStop_IT(pxDMA);
+    }
+    pxSDMMC->Inst->DCTRL.w = 0;
+    pxSDMMC->Pending = 0;
+}
+
+/* Finishes the active request and starts the next one */
+static void SDMMC_prvCompleteRequest(SDMMC_HandleType * pxSDMMC, XPD_ReturnType eResult)
+{
+    SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+
+    pxSDMMC->State = SDMMC_STATE_IDLE;
+    pxSDMMC->Queue.Head++;
+    pxRequest->Result = eResult;
+
+    /* Continue with the next request before notifying, so that
+     * requests submitted from the callbacks are only queued */
+    if (pxSDMMC->Queue.Head != pxSDMMC->Queue.Tail)
+    {
+        SDMMC_prvStartRequest(pxSDMMC);
+    }
+    else
+    {
+        pxSDMMC->Inst->MASK.w = 0;
+    }
+
+    if (eResult != XPD_OK)
+    {
+        XPD_SAFE_CALLBACK(pxSDMMC->Callbacks.Error, pxSDMMC);
+    }
+
+    XPD_SAFE_CALLBACK(pxRequest->Callback, pxRequest);
+
+    if (pxSDMMC->Queue.Head == pxSDMMC->Queue.Tail)
+    {
+        XPD_SAFE_CALLBACK(pxSDMMC->Callbacks.QueueEmpty, pxSDMMC);
+    }
+}
+
+static void SDMMC_prvDataComplete(SDMMC_HandleType * pxSDMMC)
+{
+    if ((pxSDMMC->State == SDMMC_STATE_DATA) && (pxSDMMC->Pending == 0))
+    {
+        SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+
+        pxSDMMC->Inst->DCTRL.w = 0;
+
+        if (pxRequest->BlockCount > 1)
+        {
+            /* Open-ended multiple block transfers are terminated by command */
+            pxSDMMC->State = SDMMC_STATE_STOP;
+            SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_STOP_TRANSMISSION, 0);
+        }
+        else if (pxRequest->Operation == SDMMC_OPERATION_WRITE)
+        {
+            /* Wait until the card finishes programming */
+            pxSDMMC->State = SDMMC_STATE_STATUS;
+            SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_SEND_STATUS,
+                    (uint32_t)pxSDMMC->Card.RCA << 16);
+        }
+        else
+        {
+            SDMMC_prvCompleteRequest(pxSDMMC, XPD_OK);
+        }
+    }
+}
+
+static void SDMMC_prvDataError(SDMMC_HandleType * pxSDMMC)
+{
+    SDMMC_prvStopData(pxSDMMC);
+
+    /* When the command is still in progress, its response completes the request */
+    if (pxSDMMC->State == SDMMC_STATE_DATA)
+    {
+        if (SDMMC_ACTIVE_REQUEST(pxSDMMC)->BlockCount > 1)
+        {
+            pxSDMMC->State = SDMMC_STATE_STOP;
+            SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_STOP_TRANSMISSION, 0);
+        }
+        else
+        {
+            SDMMC_prvCompleteRequest(pxSDMMC, XPD_ERROR);
+        }
+    }
+}
+
+static void SDMMC_prvDmaRedirect(void * pxDMA)
+{
+    SDMMC_HandleType * pxSDMMC = (SDMMC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxSDMMC->Pending &= ~SDMMC_PENDING_DMA;
+
+    SDMMC_prvDataComplete(pxSDMMC);
+}
+
+#ifdef __XPD_DMA_ERROR_DETECT
+static void SDMMC_prvDmaErrorRedirect(void * pxDMA)
+{
+    SDMMC_HandleType * pxSDMMC = (SDMMC_HandleType*) ((DMA_HandleType*) pxDMA)->Owner;
+
+    pxSDMMC->Errors |= SDMMC_ERROR_DMA;
+
+    SDMMC_prvDataError(pxSDMMC);
+}
+#endif
+
+/* Sets up the DMA and the data path for the active request */
+static XPD_ReturnType SDMMC_prvStartData(SDMMC_HandleType * pxSDMMC)
+{
+    XPD_ReturnType eResult;
+    SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+    DMA_HandleType * pxDMA;
+    uint32_t ulDCTRL = (SDMMC_BLOCK_SIZE_POW2 << SDMMC_MSK(DCTRL_DBLOCKSIZE_Pos))
+                     | SDMMC_MSK(DCTRL_DMAEN) | SDMMC_MSK(DCTRL_DTEN);
+
+    if (pxRequest->Operation == SDMMC_OPERATION_READ)
+    {
+        pxDMA = pxSDMMC->DMA.Receive;
+        ulDCTRL |= SDMMC_MSK(DCTRL_DTDIR);
+    }
+    else
+    {
+        pxDMA = pxSDMMC->DMA.Transmit;
+    }
+
+    eResult = DMA_eStart_IT(pxDMA, (void*)&pxSDMMC->Inst->FIFO, pxRequest->Buffer,
+            pxRequest->BlockCount * (SDMMC_BLOCK_SIZE / sizeof(uint32_t)));
+
+    if (eResult == XPD_OK)
+    {
+        /* Set the callback owner */
+        pxDMA->Owner = pxSDMMC;
+
+        /* Set the DMA transfer callbacks */
+        pxDMA->Callbacks.Complete     = SDMMC_prvDmaRedirect;
+#ifdef __XPD_DMA_ERROR_DETECT
+        pxDMA->Callbacks.Error        = SDMMC_prvDmaErrorRedirect;
+#endif
+
+        pxSDMMC->Pending = SDMMC_PENDING_DMA | SDMMC_PENDING_DATAEND;
+
+        pxSDMMC->Inst->ICR.w   = SDMMC_ICR_DATA_FLAGS;
+        pxSDMMC->Inst->DTIMER  = SDMMC_DATA_TIMEOUT;
+        pxSDMMC->Inst->DLEN    = (uint32_t)pxRequest->BlockCount * SDMMC_BLOCK_SIZE;
+        pxSDMMC->Inst->DCTRL.w = ulDCTRL;
+    }
+    else
+    {
+        pxSDMMC->Errors |= SDMMC_ERROR_DMA;
+    }
+    return eResult;
+}
+
+/* Sends the block transfer command of the active request */
+static void SDMMC_prvStartTransfer(SDMMC_HandleType * pxSDMMC)
+{
+    SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+    uint32_t ulAddress = pxRequest->Address;
+    uint32_t ulCmdIndex;
+
+    if (pxSDMMC->Card.Type != SDMMC_CARD_SDHC)
+    {
+        ulAddress *= SDMMC_BLOCK_SIZE;
+    }
+
+    pxSDMMC->State = SDMMC_STATE_TRANSFER;
+
+    if (pxRequest->Operation == SDMMC_OPERATION_READ)
+    {
+        /* The data path has to be ready before the card starts sending */
+        if (SDMMC_prvStartData(pxSDMMC) != XPD_OK)
+        {
+            SDMMC_prvCompleteRequest(pxSDMMC, XPD_ERROR);
+            return;
+        }
+        ulCmdIndex = (pxRequest->BlockCount > 1) ?
+                SD_CMD_READ_MULTIPLE_BLOCK : SD_CMD_READ_SINGLE_BLOCK;
+    }
+    else
+    {
+        ulCmdIndex = (pxRequest->BlockCount > 1) ?
+                SD_CMD_WRITE_MULTIPLE_BLOCK : SD_CMD_WRITE_BLOCK;
+    }
+
+    SDMMC_prvSendCommand_IT(pxSDMMC, ulCmdIndex, ulAddress);
+}
+
+/* Starts processing the request at the head of the queue */
+static void SDMMC_prvStartRequest(SDMMC_HandleType * pxSDMMC)
+{
+    SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+
+    pxSDMMC->Errors = SDMMC_ERROR_NONE;
+    pxSDMMC->Pending = 0;
+    pxSDMMC->Inst->ICR.w = SDMMC_ICR_STATIC_FLAGS;
+    pxSDMMC->Inst->MASK.w = SDMMC_TRANSFER_IT_MASK;
+
+    if ((pxRequest->Operation == SDMMC_OPERATION_WRITE) && (pxRequest->BlockCount > 1))
+    {
+        /* Pre-erasing the written blocks speeds up multiple block writes */
+        pxSDMMC->State = SDMMC_STATE_APP_CMD;
+        SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_APP_CMD,
+                (uint32_t)pxSDMMC->Card.RCA << 16);
+    }
+    else
+    {
+        SDMMC_prvStartTransfer(pxSDMMC);
+    }
+}
+
+/* Advances the transfer state machine on command response */
+static void SDMMC_prvCommandComplete(SDMMC_HandleType * pxSDMMC)
+{
+    SDMMC_RequestType * pxRequest = SDMMC_ACTIVE_REQUEST(pxSDMMC);
+
+    switch (pxSDMMC->State)
+    {
+        case SDMMC_STATE_APP_CMD:
+            pxSDMMC->State = SDMMC_STATE_BLOCK_COUNT;
+            SDMMC_prvSendCommand_IT(pxSDMMC, SD_ACMD_SET_WR_BLK_ERASE_COUNT,
+                    pxRequest->BlockCount);
+            break;
+
+        case SDMMC_STATE_BLOCK_COUNT:
+            SDMMC_prvStartTransfer(pxSDMMC);
+            break;
+
+        case SDMMC_STATE_TRANSFER:
+            pxSDMMC->State = SDMMC_STATE_DATA;
+
+            if (pxSDMMC->Errors != SDMMC_ERROR_NONE)
+            {
+                /* Data error occurred before the response */
+                SDMMC_prvDataError(pxSDMMC);
+            }
+            else if (pxRequest->Operation == SDMMC_OPERATION_WRITE)
+            {
+                if (SDMMC_prvStartData(pxSDMMC) != XPD_OK)
+                {
+                    /* The card is waiting for data, which has to be cancelled */
+                    pxSDMMC->State = SDMMC_STATE_STOP;
+                    SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_STOP_TRANSMISSION, 0);
+                }
+            }
+            else
+            {
+                SDMMC_prvDataComplete(pxSDMMC);
+            }
+            break;
+
+        case SDMMC_STATE_STOP:
+            if (pxSDMMC->Errors != SDMMC_ERROR_NONE)
+            {
+                SDMMC_prvCompleteRequest(pxSDMMC, XPD_ERROR);
+            }
+            else if (pxRequest->Operation == SDMMC_OPERATION_WRITE)
+            {
+                pxSDMMC->State = SDMMC_STATE_STATUS;
+                SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_SEND_STATUS,
+                        (uint32_t)pxSDMMC->Card.RCA << 16);
+            }
+            else
+            {
+                SDMMC_prvCompleteRequest(pxSDMMC, XPD_OK);
+            }
+            break;
+
+        case SDMMC_STATE_STATUS:
+        {
+            uint32_t ulR1 = pxSDMMC->Inst->RESP1;
+
+            if (((ulR1 & SD_R1_READY_FOR_DATA) != 0) && (SD_R1_STATE(ulR1) == SD_STATE_TRAN))
+            {
+                SDMMC_prvCompleteRequest(pxSDMMC, XPD_OK);
+            }
+            else
+            {
+                /* Programming is still in progress */
+                SDMMC_prvSendCommand_IT(pxSDMMC, SD_CMD_SEND_STATUS,
+                        (uint32_t)pxSDMMC->Card.RCA << 16);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/** @defgroup SDMMC_Exported_Functions SDMMC Exported Functions
+ * @{ */
+
+/**
+ * @brief Initializes the SDMMC peripheral and identifies the inserted SD card.
+ * @note  The DMA handles have to be initialized for word transfers between the
+ *        FIFO and memory with memory increment.
+ *        The SDMMC and DMA interrupts must have the same priority.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @param pxConfig: SDMMC setup configuration
+ * @return ERROR if the card is not supported or failed, TIMEOUT if no card responds, OK if successful
+ */
+XPD_ReturnType SDMMC_eInit(SDMMC_HandleType * pxSDMMC, const SDMMC_InitType * pxConfig)
+{
+    XPD_ReturnType eResult;
+    uint32_t ulClockFreq;
+
+    /* enable clock */
+    RCC_vClockEnable(pxSDMMC->CtrlPos);
+
+    pxSDMMC->Queue.Head = pxSDMMC->Queue.Tail = 0;
+    pxSDMMC->State      = SDMMC_STATE_IDLE;
+    pxSDMMC->Pending    = 0;
+    pxSDMMC->Errors     = SDMMC_ERROR_NONE;
+    pxSDMMC->Card.Type  = SDMMC_CARD_NONE;
+    pxSDMMC->Card.RCA   = 0;
+
+    /* dependencies initialization */
+    XPD_SAFE_CALLBACK(pxSDMMC->Callbacks.DepInit, pxSDMMC);
+
+    ulClockFreq = SDMMC_ulClockFreq_Hz(pxSDMMC);
+
+    /* Identification is performed on a single data line with a slow clock */
+    pxSDMMC->Inst->MASK.w  = 0;
+    pxSDMMC->Inst->DCTRL.w = 0;
+    pxSDMMC->Inst->ICR.w   = SDMMC_ICR_STATIC_FLAGS;
+    pxSDMMC->Inst->CLKCR.w = SDMMC_prvClockDivider(ulClockFreq, SDMMC_INIT_FREQ_Hz);
+    pxSDMMC->Inst->POWER.w = SDMMC_MSK(POWER_PWRCTRL);
+
+    /* Wait for the card power ramp-up */
+    XPD_vDelay_ms(2);
+
+    SDMMC_REG_BIT(pxSDMMC, CLKCR, CLKEN) = 1;
+
+    /* At least 74 bus clock cycles have to pass before the first command */
+    XPD_vDelay_ms(1);
+
+    eResult = SDMMC_prvCardPowerUp(pxSDMMC);
+
+    if (eResult == XPD_OK)
+    {
+        eResult = SDMMC_prvCardIdentify(pxSDMMC);
+    }
+    if (eResult == XPD_OK)
+    {
+        eResult = SDMMC_prvCardSelect(pxSDMMC, pxConfig->BusWidth);
+    }
+    if (eResult == XPD_OK)
+    {
+        uint32_t ulCLKCR = SDMMC_prvClockDivider(ulClockFreq, SDMMC_DEFAULT_FREQ_Hz);
+
+        pxSDMMC->Inst->CLKCR.w = ulCLKCR | SDMMC_MSK(CLKCR_CLKEN)
+                | (pxConfig->BusWidth << SDMMC_MSK(CLKCR_WIDBUS_Pos));
+
+        if (pxConfig->HighSpeed == ENABLE)
+        {
+            if (SDMMC_prvSwitchHighSpeed(pxSDMMC) == XPD_OK)
+            {
+                ulCLKCR = SDMMC_prvClockDivider(ulClockFreq, SDMMC_HIGHSPEED_FREQ_Hz);
+            }
+            else
+            {
+                /* Older cards do not support the switch function,
+                 * the status read clears the reported illegal command */
+                (void) SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SEND_STATUS,
+                        (uint32_t)pxSDMMC->Card.RCA << 16, SDMMC_RESP_SHORT);
+            }
+            pxSDMMC->Errors = SDMMC_ERROR_NONE;
+        }
+
+        pxSDMMC->Inst->CLKCR.w = ulCLKCR | SDMMC_MSK(CLKCR_CLKEN)
+                | (pxConfig->BusWidth    << SDMMC_MSK(CLKCR_WIDBUS_Pos))
+                | (pxConfig->PowerSave   << SDMMC_MSK(CLKCR_PWRSAV_Pos))
+                | (pxConfig->FlowControl << SDMMC_MSK(CLKCR_HWFC_EN_Pos));
+    }
+    else
+    {
+        pxSDMMC->Card.Type = SDMMC_CARD_NONE;
+    }
+
+    return eResult;
+}
+
+/**
+ * @brief Aborts all requests, powers off the card and restores the SDMMC peripheral to its default inactive state.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ */
+void SDMMC_vDeinit(SDMMC_HandleType * pxSDMMC)
+{
+    SDMMC_vAbort(pxSDMMC);
+
+    pxSDMMC->Inst->CLKCR.w = 0;
+    pxSDMMC->Inst->POWER.w = 0;
+    pxSDMMC->Card.Type = SDMMC_CARD_NONE;
+
+    /* dependencies deinitialization */
+    XPD_SAFE_CALLBACK(pxSDMMC->Callbacks.DepDeinit, pxSDMMC);
+
+    /* disable clock */
+    RCC_vClockDisable(pxSDMMC->CtrlPos);
+}
+
+/**
+ * @brief Adds a block transfer request to the queue of the SDMMC.
+ * @note  The request is processed in the background, its callback is called from interrupt context
+ *        after the request's Result is set. The request structure and its buffer
+ *        must remain valid until then.
+ *        When requests are submitted from different interrupt priorities, XPD_ENTER_CRITICAL
+ *        has to mask the SDMMC interrupt.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @param pxRequest: pointer to the block transfer request
+ * @return ERROR if the request is invalid, BUSY if the queue is full, OK if the request is queued
+ */
+XPD_ReturnType SDMMC_eSubmit(SDMMC_HandleType * pxSDMMC, SDMMC_RequestType * pxRequest)
+{
+    XPD_ReturnType eResult = XPD_BUSY;
+
+    if ((pxSDMMC->Card.Type == SDMMC_CARD_NONE) || (pxRequest->BlockCount == 0)
+     || (pxRequest->BlockCount > SDMMC_MAX_BLOCK_COUNT))
+    {
+        return XPD_ERROR;
+    }
+
+    XPD_ENTER_CRITICAL(pxSDMMC);
+
+    if ((uint8_t)(pxSDMMC->Queue.Tail - pxSDMMC->Queue.Head) < SDMMC_QUEUE_LENGTH)
+    {
+        pxRequest->Result = XPD_BUSY;
+        pxSDMMC->Queue.Items[pxSDMMC->Queue.Tail & SDMMC_QUEUE_MASK] = pxRequest;
+        pxSDMMC->Queue.Tail++;
+
+        /* Start processing if no request is in progress */
+        if (pxSDMMC->State == SDMMC_STATE_IDLE)
+        {
+            SDMMC_prvStartRequest(pxSDMMC);
+        }
+        eResult = XPD_OK;
+    }
+
+    XPD_EXIT_CRITICAL(pxSDMMC);
+
+    return eResult;
+}
+
+/* Submits a single request and waits for its completion */
+static XPD_ReturnType SDMMC_prvTransferBlocks(
+        SDMMC_HandleType *  pxSDMMC,
+        SDMMC_RequestType * pxRequest,
+        uint32_t            ulTimeout)
+{
+    XPD_ReturnType eResult = SDMMC_eSubmit(pxSDMMC, pxRequest);
+
+    if (eResult == XPD_OK)
+    {
+        /* Wait until the request's result is set */
+        eResult = XPD_eWaitForResult(&pxRequest->Result, &ulTimeout);
+
+        if (eResult == XPD_OK)
+        {
+            eResult = pxRequest->Result;
+        }
+        else
+        {
+            SDMMC_vAbort(pxSDMMC);
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief Reads consecutive blocks from the card and waits for the completion.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @param pvData: word aligned pointer to the destination buffer
+ * @param ulAddress: block address of the first block
+ * @param usBlockCount: amount of 512 byte blocks to read
+ * @param ulTimeout: the timeout in ms for the transfer
+ * @return BUSY if the queue is full, TIMEOUT if timed out, ERROR if failed, OK if successful
+ */
+XPD_ReturnType SDMMC_eReadBlocks(
+        SDMMC_HandleType *  pxSDMMC,
+        void *              pvData,
+        uint32_t            ulAddress,
+        uint16_t            usBlockCount,
+        uint32_t            ulTimeout)
+{
+    SDMMC_RequestType xRequest = {
+        .Buffer     = pvData,
+        .Address    = ulAddress,
+        .BlockCount = usBlockCount,
+        .Operation  = SDMMC_OPERATION_READ,
+        .Callback   = NULL,
+    };
+
+    return SDMMC_prvTransferBlocks(pxSDMMC, &xRequest, ulTimeout);
+}
+
+/**
+ * @brief Writes consecutive blocks to the card and waits for the completion.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @param pvData: word aligned pointer to the source buffer
+ * @param ulAddress: block address of the first block
+ * @param usBlockCount: amount of 512 byte blocks to write
+ * @param ulTimeout: the timeout in ms for the transfer
+ * @return BUSY if the queue is full, TIMEOUT if timed out, ERROR if failed, OK if successful
+ */
+XPD_ReturnType SDMMC_eWriteBlocks(
+        SDMMC_HandleType *  pxSDMMC,
+        void *              pvData,
+        uint32_t            ulAddress,
+        uint16_t            usBlockCount,
+        uint32_t            ulTimeout)
+{
+    SDMMC_RequestType xRequest = {
+        .Buffer     = pvData,
+        .Address    = ulAddress,
+        .BlockCount = usBlockCount,
+        .Operation  = SDMMC_OPERATION_WRITE,
+        .Callback   = NULL,
+    };
+
+    return SDMMC_prvTransferBlocks(pxSDMMC, &xRequest, ulTimeout);
+}
+
+/**
+ * @brief Stops the active transfer and removes all queued requests with ERROR result.
+ * @note  The request callbacks are not called.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ */
+void SDMMC_vAbort(SDMMC_HandleType * pxSDMMC)
+{
+    boolean_t xStop;
+
+    XPD_ENTER_CRITICAL(pxSDMMC);
+
+    pxSDMMC->Inst->MASK.w = 0;
+
+    /* The card only has to be stopped when it is in a multiple block data phase */
+    xStop = ((pxSDMMC->State >= SDMMC_STATE_TRANSFER) && (pxSDMMC->State <= SDMMC_STATE_DATA)
+          && (SDMMC_ACTIVE_REQUEST(pxSDMMC)->BlockCount > 1)) ? 1 : 0;
+
+    SDMMC_prvStopData(pxSDMMC);
+    pxSDMMC->Inst->ICR.w = SDMMC_ICR_STATIC_FLAGS;
+
+    while (pxSDMMC->Queue.Head != pxSDMMC->Queue.Tail)
+    {
+        SDMMC_ACTIVE_REQUEST(pxSDMMC)->Result = XPD_ERROR;
+        pxSDMMC->Queue.Head++;
+    }
+    pxSDMMC->State = SDMMC_STATE_IDLE;
+
+    XPD_EXIT_CRITICAL(pxSDMMC);
+
+    if (xStop != 0)
+    {
+        (void) SDMMC_prvSendCommand(pxSDMMC, SD_CMD_STOP_TRANSMISSION, 0, SDMMC_RESP_SHORT);
+    }
+}
+
+/**
+ * @brief Reads the status register of the card.
+ * @note  This function shall only be used while the request queue is empty.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ * @param pulStatus: pointer to the card status output
+ * @return BUSY if a request is in progress, TIMEOUT if the card does not respond, OK if successful
+ */
+XPD_ReturnType SDMMC_eGetCardStatus(SDMMC_HandleType * pxSDMMC, uint32_t * pulStatus)
+{
+    XPD_ReturnType eResult = XPD_BUSY;
+
+    if (SDMMC_eGetStatus(pxSDMMC) == XPD_OK)
+    {
+        eResult = SDMMC_prvSendCommand(pxSDMMC, SD_CMD_SEND_STATUS,
+                (uint32_t)pxSDMMC->Card.RCA << 16, SDMMC_RESP_SHORT);
+
+        if (eResult == XPD_OK)
+        {
+            *pulStatus = pxSDMMC->Inst->RESP1;
+        }
+    }
+    return eResult;
+}
+
+/**
+ * @brief SDMMC transfer state machine interrupt handler.
+ * @param pxSDMMC: pointer to the SDMMC handle structure
+ */
+void SDMMC_vIRQHandler(SDMMC_HandleType * pxSDMMC)
+{
+    uint32_t ulSTA = pxSDMMC->Inst->STA.w & pxSDMMC->Inst->MASK.w;
+    uint8_t ucHead = pxSDMMC->Queue.Head;
+
+    /* Command response */
+    if ((ulSTA & SDMMC_STA_CMD_FLAGS) != 0)
+    {
+        pxSDMMC->Inst->ICR.w = SDMMC_ICR_CMD_FLAGS;
+
+        SDMMC_ErrorType eError = SDMMC_ERROR_NONE;
+
+        if ((ulSTA & SDMMC_MSK(STA_CTIMEOUT)) != 0)
+        {
+            eError = SDMMC_ERROR_CMD_TIMEOUT;
+        }
+        else if ((ulSTA & SDMMC_MSK(STA_CCRCFAIL)) != 0)
+        {
+            eError = SDMMC_ERROR_CMD_CRC;
+        }
+        else if ((pxSDMMC->Inst->RESP1 & SD_R1_ERRORS) != 0)
+        {
+            eError = SDMMC_ERROR_CARD_STATUS;
+        }
+
+        if (eError == SDMMC_ERROR_NONE)
+        {
+            SDMMC_prvCommandComplete(pxSDMMC);
+        }
+        else if (pxSDMMC->State != SDMMC_STATE_IDLE)
+        {
+            /* The command is rejected, the card remains in transfer state */
+            pxSDMMC->Errors |= eError;
+            SDMMC_prvStopData(pxSDMMC);
+            SDMMC_prvCompleteRequest(pxSDMMC, XPD_ERROR);
+        }
+
+        /* The flags of a newly started request are evaluated on the next interrupt */
+        if (pxSDMMC->Queue.Head != ucHead)
+        {
+            return;
+        }
+    }
+
+    /* Data path errors */
+    if ((ulSTA & SDMMC_STA_DATA_ERRORS) != 0)
+    {
+        pxSDMMC->Inst->ICR.w = SDMMC_ICR_DATA_FLAGS;
+
+        if ((ulSTA & SDMMC_MSK(STA_DCRCFAIL)) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_DATA_CRC;
+        }
+        if ((ulSTA & SDMMC_MSK(STA_DTIMEOUT)) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_DATA_TIMEOUT;
+        }
+        if ((ulSTA & SDMMC_MSK(STA_TXUNDERR)) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_UNDERRUN;
+        }
+        if ((ulSTA & SDMMC_MSK(STA_RXOVERR)) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_OVERRUN;
+        }
+        if ((ulSTA & SDMMC_MSK(STA_STBITERR)) != 0)
+        {
+            pxSDMMC->Errors |= SDMMC_ERROR_START_BIT;
+        }
+
+        SDMMC_prvDataError(pxSDMMC);
+    }
+    /* Data transfer end */
+    else if ((ulSTA & SDMMC_MSK(STA_DATAEND)) != 0)
+    {
+        SDMMC_FLAG_CLEAR(pxSDMMC, DATAEND);
+
+        pxSDMMC->Pending &= ~SDMMC_PENDING_DATAEND;
+
+        SDMMC_prvDataComplete(pxSDMMC);
+    }
+}
+
+/** @} */
+
+/** @} */
+
+#endif /* SDMMC1 */
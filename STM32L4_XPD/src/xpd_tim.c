@@ -40,6 +40,16 @@
 
 #define TIM_ACTIVE_CHANNELS(HANDLE) (HANDLE->Inst->CCER.w & TIM_ALL_CHANNELS)
 
+#ifdef TIM1_OR2_BKCMP1E
+/* Internal break sources have the same layout in OR2 (break) and OR3 (break 2) */
+#ifdef TIM1_OR2_BKDF1BK0E
+#define TIM_BREAKSOURCE_MASK (TIM1_OR2_BKCMP1E | TIM1_OR2_BKCMP2E | TIM1_OR2_BKDF1BK0E)
+#else
+#define TIM_BREAKSOURCE_MASK (TIM1_OR2_BKCMP1E | TIM1_OR2_BKCMP2E)
+#endif
+#endif
+
+#ifndef __XPD_TIM_NO_DMA
 #ifdef __XPD_DMA_ERROR_DETECT
 static void TIM_prvDmaErrorRedirect(void *pxDMA)
 {
@@ -103,6 +113,7 @@ static const XPD_HandleCallbackType TIM_apxDmaRedirects[] = {
         TIM_prvDmaCommutationCallbackRedirect,
         TIM_prvDmaTriggerCallbackRedirect,
 };
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @defgroup TIM_Common_Exported_Functions TIM Common Exported Functions
  *  @brief    TIM common functions (timer, channels control)
@@ -213,6 +224,7 @@ void TIM_vIRQHandler_UP(TIM_HandleType * pxTIM)
     }
 }
 
+#ifndef __XPD_TIM_NO_DMA
 /**
  * @brief Sets up and enables a DMA transfer for the TIM counter.
  * @param pxTIM: pointer to the TIM handle structure
@@ -264,6 +276,7 @@ void TIM_vCounterStop_DMA(TIM_HandleType * pxTIM)
     /* disable the counter */
     TIM_vCounterStop(pxTIM);
 }
+#endif /* __XPD_TIM_NO_DMA */
 
 /**
  * @brief Starts the selected timer channel (and the timer if required).
@@ -353,6 +366,7 @@ void TIM_vIRQHandler_CC(TIM_HandleType * pxTIM)
     }
 }
 
+#ifndef __XPD_TIM_NO_DMA
 /**
  * @brief Starts the selected timer channel (and the timer if required)
  *        using a DMA transfer to provide channel pulse values.
@@ -407,11 +421,13 @@ void TIM_vChannelStop_DMA(TIM_HandleType * pxTIM, TIM_ChannelType eChannel)
 
     TIM_vChannelStop(pxTIM, eChannel);
 }
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @} */
 
 /** @} */
 
+#ifndef __XPD_TIM_NO_DMA
 /** @addtogroup TIM_Burst
  * @{ */
 
@@ -480,6 +496,7 @@ void TIM_vBurstStop_DMA(TIM_HandleType * pxTIM, TIM_EventType Source)
 /** @} */
 
 /** @} */
+#endif /* __XPD_TIM_NO_DMA */
 
 /** @addtogroup TIM_Output
  * @{ */
@@ -582,6 +599,9 @@ void TIM_vBreakConfig(
         TIM_REG_BIT(pxTIM, BDTR, BK2E) = pxConfig->State;
         TIM_REG_BIT(pxTIM, BDTR, BK2P) = 1 - pxConfig->Polarity;
         pxTIM->Inst->BDTR.b.BK2F       = pxConfig->Filter;
+#ifdef TIM1_OR2_BKCMP1E
+        MODIFY_REG(pxTIM->Inst->OR3, TIM_BREAKSOURCE_MASK, pxConfig->InternalSources);
+#endif
     }
     else
 #endif
@@ -591,6 +611,9 @@ void TIM_vBreakConfig(
         TIM_REG_BIT(pxTIM, BDTR, BKP)  = 1 - pxConfig->Polarity;
 #ifdef TIM_BDTR_BKF
         pxTIM->Inst->BDTR.b.BKF        = pxConfig->Filter;
+#endif
+#ifdef TIM1_OR2_BKCMP1E
+        MODIFY_REG(pxTIM->Inst->OR2, TIM_BREAKSOURCE_MASK, pxConfig->InternalSources);
 #endif
     }
 }
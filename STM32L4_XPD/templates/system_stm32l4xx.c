@@ -40,6 +40,20 @@ uint32_t SystemCoreClock;
  */
 void SystemInit(void)
 {
+#ifdef __XPD_SRAM2_INIT
+    {
+        /* Copy the initial values of the SRAM2 variables */
+        extern uint32_t _sisram2, _ssram2, _esram2;
+        const uint32_t * pulSrc = &_sisram2;
+        uint32_t * pulDest;
+
+        for (pulDest = &_ssram2; pulDest < &_esram2; pulDest++)
+        {
+            *pulDest = *pulSrc++;
+        }
+    }
+#endif
+
     /* Reset all peripherals */
     XPD_vDeinit();
 
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    xpd_rtos_port.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers RTOS Port for FreeRTOS
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_RTOS_PORT_H_
+#define __XPD_RTOS_PORT_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+/* Enables the RTOS module */
+#define __XPD_RTOS
+
+/* The interrupt mask variant is used, as the XPD critical sections
+ * are entered from both thread and interrupt contexts */
+#define XPD_ENTER_CRITICAL(HANDLE)                              \
+    UBaseType_t uxXpdSavedMask = taskENTER_CRITICAL_FROM_ISR()
+#define XPD_EXIT_CRITICAL(HANDLE)                               \
+    taskEXIT_CRITICAL_FROM_ISR(uxXpdSavedMask)
+
+/* Binary semaphore which is given from interrupt context and taken by a task */
+typedef SemaphoreHandle_t XPD_RTOS_SemaphoreType;
+
+#define XPD_RTOS_SEM_INIT(SEM)                                  \
+    ((SEM) = xSemaphoreCreateBinary())
+
+#define XPD_RTOS_SEM_TAKE(SEM, TIMEOUT_MS)                      \
+    (xSemaphoreTake((SEM), pdMS_TO_TICKS(TIMEOUT_MS)) == pdTRUE)
+
+#define XPD_RTOS_SEM_GIVE_FROM_ISR(SEM)                         \
+    do { BaseType_t xWoken = pdFALSE;                           \
+         (void) xSemaphoreGiveFromISR((SEM), &xWoken);          \
+         portYIELD_FROM_ISR(xWoken); } while (0)
+
+#endif /* __XPD_RTOS_PORT_H_ */
@@ -0,0 +1,44 @@
+/**
+  ******************************************************************************
+  * @file    xpd_usb_wrapper.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Universal Serial Bus Module
+  *          stand-in of the USB device library callbacks for the benchmark host build
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <xpd_usb.h>
+
+#if defined(USB) || defined(USB_OTG_FS)
+/* The benchmark does not run the device stack, the callbacks are empty */
+
+void USB_vResetCallback(USB_HandleType *pxUSB, USB_SpeedType eSpeed)
+{
+}
+
+void USB_vSetupCallback(USB_HandleType *pxUSB)
+{
+}
+
+void USB_vDataInCallback(USB_HandleType *pxUSB, USB_EndPointHandleType *pxEP)
+{
+}
+
+void USB_vDataOutCallback(USB_HandleType *pxUSB, USB_EndPointHandleType *pxEP)
+{
+}
+#endif /* USB */
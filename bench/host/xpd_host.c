@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file    xpd_host.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers host register model and benchmark runner
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "xpd_bench.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE     0x100000
+#endif
+
+/* The register model is plain zero initialized memory at the device addresses:
+ * registers keep the written values, and the status flags are set by the benchmark.
+ * The bit-band alias regions are not modelled, the drivers are built without them. */
+static const struct {
+    uint32_t Base;
+    uint32_t Size;
+} host_axRegions[] = {
+    { 0x1FFF0000, 0x00010000 }, /* System memory with the factory calibration values */
+    { 0x40000000, 0x20000000 }, /* Peripherals on APB, AHB1 and AHB2 */
+    { 0xE0000000, 0x00100000 }, /* Core private peripherals */
+};
+
+uint32_t ulHostPRIMASK = 0;
+uint32_t ulHostMSP = 0;
+
+static void HOST_prvMapRegions(void)
+{
+    uint32_t ulRegion;
+
+    for (ulRegion = 0; ulRegion < sizeof(host_axRegions) / sizeof(host_axRegions[0]); ulRegion++)
+    {
+        void * pvBase = (void *)(uintptr_t)host_axRegions[ulRegion].Base;
+
+        if (mmap(pvBase, host_axRegions[ulRegion].Size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED_NOREPLACE, -1, 0) != pvBase)
+        {
+            fprintf(stderr, "Register model region 0x%08x cannot be mapped\n",
+                    (unsigned)host_axRegions[ulRegion].Base);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+static void HOST_prvLoadCalibration(void)
+{
+    /* Typical factory calibration values at 3.3V */
+    *(uint16_t *)&ADC_CALIB->VREFINT         = 1500;
+    *(uint16_t *)&ADC_CALIB->TEMPSENSOR_LOW  = 940;
+    *(uint16_t *)&ADC_CALIB->TEMPSENSOR_HIGH = 1240;
+}
+
+/**
+ * @brief Writes a character of the benchmark results to the standard output.
+ * @param cChar: the character to write
+ */
+void BENCH_vPutChar(char cChar)
+{
+    (void) putchar(cChar);
+}
+
+/**
+ * @brief Reads the host timestamp counter.
+ * @return The current counter value
+ */
+uint32_t BENCH_ulGetCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    /* Prevent the counter read from being executed out of order */
+    _mm_lfence();
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec xTime;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &xTime);
+    return (uint32_t)(xTime.tv_sec * 1000000000UL + xTime.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Calculates the elapsed timestamp counter ticks.
+ * @param ulStart: the earlier counter value from @ref BENCH_ulGetCycles
+ * @return The elapsed ticks since the start value
+ */
+uint32_t BENCH_ulCyclesSince(uint32_t ulStart)
+{
+    return BENCH_ulGetCycles() - ulStart;
+}
+
+int main(void)
+{
+    HOST_prvMapRegions();
+    HOST_prvLoadCalibration();
+
+    BENCH_vRunAll();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************
+  * @file    xpd_host.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers host build compiler support
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_HOST_H_
+#define __XPD_HOST_H_
+
+/* This header is force-included into every host compiled source.
+ * It replaces the CMSIS compiler layer, as the Cortex-M intrinsics
+ * cannot be assembled for the host. The core behavior is modelled
+ * only to the extent the drivers rely on it. */
+
+/* Prevent the inclusion of the CMSIS compiler layer */
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+/* Enables the host specific parts of the benchmark */
+#define __XPD_HOST
+
+#define __ASM                                  __asm
+#define __INLINE                               inline
+#define __STATIC_INLINE                        static inline
+#define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#define __NO_RETURN                            __attribute__((__noreturn__))
+#define __USED                                 __attribute__((used))
+#define __WEAK                                 __attribute__((weak))
+#define __PACKED                               __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT                        struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION                         union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                           __attribute__((aligned(x)))
+#define __RESTRICT                             __restrict
+
+/* Modelled core state */
+extern uint32_t ulHostPRIMASK;
+extern uint32_t ulHostMSP;
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+    ulHostPRIMASK = 0;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+    ulHostPRIMASK = 1;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+    return ulHostPRIMASK;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+    ulHostPRIMASK = priMask;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_MSP(void)
+{
+    return ulHostMSP;
+}
+
+__STATIC_FORCEINLINE void __set_MSP(uint32_t topOfMainStack)
+{
+    ulHostMSP = topOfMainStack;
+}
+
+/* Memory barriers only need to prevent compiler reordering */
+#define __ISB()                                __asm volatile ("" ::: "memory")
+#define __DSB()                                __asm volatile ("" ::: "memory")
+#define __DMB()                                __asm volatile ("" ::: "memory")
+
+/* There is no event or interrupt to wait for */
+#define __NOP()                                __asm volatile ("nop")
+#define __WFI()                                __asm volatile ("" ::: "memory")
+#define __WFE()                                __asm volatile ("" ::: "memory")
+#define __SEV()                                __asm volatile ("" ::: "memory")
+
+#define __REV(value)                           __builtin_bswap32(value)
+#define __CLZ(value)                           ((value) == 0U ? 32U : (uint32_t)__builtin_clz(value))
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t i;
+
+    for (i = 0; i < 32; i++, value >>= 1)
+    {
+        result = (result << 1) | (value & 1);
+    }
+    return result;
+}
+
+/* Exclusive access always succeeds in the single threaded host */
+__STATIC_FORCEINLINE uint32_t __LDREXW(volatile uint32_t *addr)
+{
+    return *addr;
+}
+
+__STATIC_FORCEINLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr)
+{
+    *addr = value;
+    return 0;
+}
+
+#define __CLREX()                              ((void)0)
+
+#define __PKHBT(ARG1,ARG2,ARG3)                ((((uint32_t)(ARG1))          & 0x0000FFFFUL) |  \
+                                                ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL)  )
+
+#endif /* __XPD_HOST_H_ */
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    xpd_bench_target.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Benchmark Suite target runner
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include "../xpd_bench.h"
+
+/** @addtogroup BENCH
+ * @{ */
+
+/** @addtogroup BENCH_Exported_Platform_Functions
+ * @{ */
+
+/**
+ * @brief Writes a character of the benchmark results through the ITM stimulus port 0.
+ * @param cChar: the character to write
+ * @note  Cortex-M0 has no ITM, the application has to provide the output
+ *        (e.g. a polled USART) by overriding this function.
+ */
+__weak void BENCH_vPutChar(char cChar)
+{
+#if (__CORTEX_M >= 3U)
+    (void) ITM_SendChar((uint32_t)cChar);
+#endif
+}
+
+/**
+ * @brief Reads the core cycle counter.
+ * @return The current counter value
+ */
+uint32_t BENCH_ulGetCycles(void)
+{
+    return XPD_ulGetCycles();
+}
+
+/**
+ * @brief Calculates the elapsed core cycles.
+ * @param ulStart: the earlier counter value from @ref BENCH_ulGetCycles
+ * @return The elapsed cycles since the start value
+ */
+uint32_t BENCH_ulCyclesSince(uint32_t ulStart)
+{
+    return XPD_ulCyclesSince(ulStart);
+}
+
+/** @} */
+
+/** @addtogroup BENCH_Exported_Functions
+ * @{ */
+
+/**
+ * @brief Starts the core cycle counter and runs the benchmark suite.
+ * @note  On Cortex-M0 the cycles are counted by the SysTick, which has to be
+ *        running from HCLK (e.g. by @ref XPD_vInitTimer) before this call.
+ */
+void BENCH_vTargetRun(void)
+{
+    XPD_vInitCycleCounter();
+
+    BENCH_vRunAll();
+}
+
+/** @} */
+
+/** @} */
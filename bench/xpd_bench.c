@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file    xpd_bench.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Benchmark Suite
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include "xpd_bench.h"
+
+/** @addtogroup BENCH
+ * @{ */
+
+/* Empty operation to measure the cost of the measurement itself */
+static void BENCH_prvNothing(void)
+{
+}
+
+static void BENCH_prvPutString(const char * pcString)
+{
+    while (*pcString != '\0')
+    {
+        BENCH_vPutChar(*pcString++);
+    }
+}
+
+static void BENCH_prvPutNumber(uint64_t ullValue)
+{
+    char acDigits[20];
+    uint8_t ucCount = 0;
+
+    do {
+        acDigits[ucCount++] = '0' + (char)(ullValue % 10);
+        ullValue /= 10;
+    } while (ullValue > 0);
+
+    while (ucCount > 0)
+    {
+        BENCH_vPutChar(acDigits[--ucCount]);
+    }
+}
+
+static void BENCH_prvPutField(const char * pcName, uint64_t ullValue, const char * pcSeparator)
+{
+    BENCH_vPutChar('"');
+    BENCH_prvPutString(pcName);
+    BENCH_prvPutString("\": ");
+    BENCH_prvPutNumber(ullValue);
+    BENCH_prvPutString(pcSeparator);
+}
+
+static void BENCH_prvPutStringField(const char * pcName, const char * pcValue)
+{
+    BENCH_prvPutString("  \"");
+    BENCH_prvPutString(pcName);
+    BENCH_prvPutString("\": \"");
+    BENCH_prvPutString(pcValue);
+    BENCH_prvPutString("\",\n");
+}
+
+/*
+ * @brief Measures a benchmark case with interrupts masked.
+ * @param pxCase: pointer to the benchmark case
+ * @param pxStat: pointer to the cycle statistics to fill
+ * @param ulOverhead: measurement overhead to deduct from each run
+ */
+static void BENCH_prvMeasure(const BENCH_CaseType * pxCase,
+        XPD_CycleStatType * pxStat, uint32_t ulOverhead)
+{
+    uint32_t ulRun, ulCycles, ulPrimask;
+
+    XPD_vCycleStatReset(pxStat);
+
+    /* The first run is not measured, it warms up the caches and the flash accelerator */
+    for (ulRun = 0; ulRun <= XPD_BENCH_ITERATIONS; ulRun++)
+    {
+        if (pxCase->Setup != NULL)
+        {
+            pxCase->Setup();
+        }
+
+        ulPrimask = __get_PRIMASK();
+        __disable_irq();
+
+        pxStat->Start = BENCH_ulGetCycles();
+        pxCase->Run();
+        ulCycles = BENCH_ulCyclesSince(pxStat->Start);
+
+        __set_PRIMASK(ulPrimask);
+
+        if (ulRun == 0)
+        {
+            continue;
+        }
+
+        ulCycles = (ulCycles > ulOverhead) ? (ulCycles - ulOverhead) : 0;
+
+        pxStat->Last   = ulCycles;
+        pxStat->Total += ulCycles;
+        pxStat->Count++;
+
+        if (ulCycles < pxStat->Min)
+        {
+            pxStat->Min = ulCycles;
+        }
+        if (ulCycles > pxStat->Max)
+        {
+            pxStat->Max = ulCycles;
+        }
+    }
+}
+
+/*
+ * @brief Measures and emits the results of a case table.
+ * @param axCases: the benchmark cases
+ * @param ulCount: the number of cases
+ * @param ulOverhead: measurement overhead to deduct from each run
+ * @param pbFirst: set when no result has been emitted yet
+ */
+static void BENCH_prvRunCases(const BENCH_CaseType axCases[], uint32_t ulCount,
+        uint32_t ulOverhead, uint8_t * pbFirst)
+{
+    XPD_CycleStatType xStat;
+    uint32_t ulCase;
+
+    for (ulCase = 0; ulCase < ulCount; ulCase++)
+    {
+        BENCH_prvMeasure(&axCases[ulCase], &xStat, ulOverhead);
+
+        BENCH_prvPutString((*pbFirst != 0) ? "\n    \"" : ",\n    \"");
+        *pbFirst = 0;
+        BENCH_prvPutString(axCases[ulCase].Name);
+        BENCH_prvPutString("\": {");
+        BENCH_prvPutField("min",   xStat.Min, ", ");
+        BENCH_prvPutField("mean",  (xStat.Total + (xStat.Count / 2)) / xStat.Count, ", ");
+        BENCH_prvPutField("max",   xStat.Max, ", ");
+        BENCH_prvPutField("count", xStat.Count, "}");
+    }
+}
+
+/** @defgroup BENCH_Exported_Functions BENCH Exported Functions
+ * @{ */
+
+/**
+ * @brief Runs the whole benchmark suite, and emits the results as a JSON object
+ *        through @ref BENCH_vPutChar.
+ * @note  The results are keyed by family, device, configuration and platform,
+ *        the measured values are in core cycles on target, and in timestamp counter
+ *        ticks on the host. Each value has the measurement overhead deducted.
+ */
+void BENCH_vRunAll(void)
+{
+    const BENCH_CaseType xNothing = BENCH_CASE("overhead", NULL, BENCH_prvNothing);
+    XPD_CycleStatType xStat;
+    uint8_t bFirst = 1;
+
+    BENCH_prvMeasure(&xNothing, &xStat, 0);
+
+    BENCH_prvPutString("{\n");
+    BENCH_prvPutStringField("family",   XPD_BENCH_FAMILY);
+    BENCH_prvPutStringField("device",   XPD_BENCH_DEVICE);
+    BENCH_prvPutStringField("config",   XPD_BENCH_CONFIG);
+    BENCH_prvPutStringField("platform", XPD_BENCH_PLATFORM);
+    BENCH_prvPutStringField("unit",     XPD_BENCH_UNIT);
+    BENCH_prvPutString("  ");
+    BENCH_prvPutField("iterations", XPD_BENCH_ITERATIONS, ",\n  ");
+    BENCH_prvPutField("overhead", xStat.Min, ",\n");
+    BENCH_prvPutString("  \"results\": {");
+
+    BENCH_prvRunCases(bench_axCases, bench_ulCaseCount, xStat.Min, &bFirst);
+    BENCH_prvRunCases(bench_axPrivateCases, bench_ulPrivateCaseCount, xStat.Min, &bFirst);
+
+    BENCH_prvPutString("\n  }\n}\n");
+}
+
+/** @} */
+
+/** @} */
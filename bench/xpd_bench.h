@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file    xpd_bench.h
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Benchmark Suite
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#ifndef __XPD_BENCH_H_
+#define __XPD_BENCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <xpd_common.h>
+#include <xpd_utils.h>
+
+/** @defgroup BENCH
+ * @{ */
+
+/** @defgroup BENCH_Exported_Macros BENCH Exported Macros
+ * @{ */
+
+#ifndef XPD_BENCH_FAMILY
+#error "XPD_BENCH_FAMILY shall be defined as the XPD family name string, e.g. \"F4\""
+#endif
+
+#ifndef XPD_BENCH_DEVICE
+#error "XPD_BENCH_DEVICE shall be defined as the device header name string, e.g. \"stm32f407xx\""
+#endif
+
+/* The configuration name keys the results together with the family */
+#ifndef XPD_BENCH_CONFIG
+#define XPD_BENCH_CONFIG                "default"
+#endif
+
+/* Number of timed runs of each benchmark */
+#ifndef XPD_BENCH_ITERATIONS
+#define XPD_BENCH_ITERATIONS            1000
+#endif
+
+#ifdef __XPD_HOST
+#define XPD_BENCH_PLATFORM              "host"
+#define XPD_BENCH_UNIT                  "ticks"
+#else
+#define XPD_BENCH_PLATFORM              "target"
+#define XPD_BENCH_UNIT                  "cycles"
+#endif
+
+/**
+ * @brief  Defines a benchmark table entry.
+ * @param  NAME: the result identifier, typically "<function>/<variant>"
+ * @param  SETUP: untimed preparation function called before each run, or NULL
+ * @param  RUN: the timed function
+ */
+#define BENCH_CASE(NAME, SETUP, RUN)    { (NAME), (SETUP), (RUN) }
+
+/** @} */
+
+/** @defgroup BENCH_Exported_Types BENCH Exported Types
+ * @{ */
+
+/** @brief Benchmark case structure */
+typedef struct
+{
+    const char * Name;      /*!< Result identifier */
+    void (*Setup)(void);    /*!< Untimed preparation before each run, optional */
+    void (*Run)(void);      /*!< The measured operation */
+}BENCH_CaseType;
+
+/** @} */
+
+/** @addtogroup BENCH_Exported_Functions
+ * @{ */
+void            BENCH_vRunAll           (void);
+#ifndef __XPD_HOST
+void            BENCH_vTargetRun        (void);
+#endif
+/** @} */
+
+/** @defgroup BENCH_Exported_Platform_Functions BENCH Platform Functions
+ *  @brief    The platform runner has to provide these functions.
+ * @{ */
+extern void     BENCH_vPutChar          (char cChar);
+extern uint32_t BENCH_ulGetCycles       (void);
+extern uint32_t BENCH_ulCyclesSince     (uint32_t ulStart);
+/** @} */
+
+/** @} */
+
+/* Cases of the benchmark suite */
+extern const BENCH_CaseType bench_axCases[];
+extern const uint32_t bench_ulCaseCount;
+extern const BENCH_CaseType bench_axPrivateCases[];
+extern const uint32_t bench_ulPrivateCaseCount;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XPD_BENCH_H_ */
@@ -0,0 +1,331 @@
+/**
+  ******************************************************************************
+  * @file    xpd_bench_cases.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Benchmark Suite public API cases
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include "xpd_bench.h"
+#include <xpd_adc_calc.h>
+#include <xpd_dma.h>
+#include <xpd_gpio.h>
+#include <xpd_rcc.h>
+#include <xpd_spi.h>
+#include <xpd_usart.h>
+
+/** @addtogroup BENCH
+ * @{ */
+
+/* The interrupt handlers are measured on RAM images of the peripheral registers,
+ * as the status flags of the real peripherals cannot be set by software.
+ * The instruction path is the same, only the bus access latency is missing. */
+#ifdef SRAM_BB
+#define BENCH_SHADOW_BB(TYPE, SHADOW)   ((TYPE *)SRAM_BB(&(SHADOW)))
+#endif
+
+/* The pin which is reconfigured by the GPIO benchmarks */
+#ifndef XPD_BENCH_GPIO
+#define XPD_BENCH_GPIO                  GPIOA
+#define XPD_BENCH_GPIO_PIN              8
+#endif
+
+/* Written results, so that the measured calculations are not optimized away */
+static volatile int32_t bench_lResult;
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+static volatile float   bench_fResult;
+#endif
+
+static uint32_t bench_aulBuffer[16];
+
+/* Data stream --------------------------------------------------------------*/
+static uint32_t bench_ulRegister = 0x12345678;
+static DataStreamType bench_xStream;
+
+static void BENCH_prvStreamSetup8(void)
+{
+    bench_xStream.buffer = bench_aulBuffer;
+    bench_xStream.length = 1;
+    bench_xStream.size   = sizeof(uint8_t);
+}
+
+static void BENCH_prvStreamSetup16(void)
+{
+    bench_xStream.buffer = bench_aulBuffer;
+    bench_xStream.length = 1;
+    bench_xStream.size   = sizeof(uint16_t);
+}
+
+static void BENCH_prvStreamSetup32(void)
+{
+    bench_xStream.buffer = bench_aulBuffer;
+    bench_xStream.length = 1;
+    bench_xStream.size   = sizeof(uint32_t);
+}
+
+static void BENCH_prvReadToStream(void)
+{
+    XPD_vReadToStream(&bench_ulRegister, &bench_xStream);
+}
+
+/* USART interrupt ----------------------------------------------------------*/
+#if defined(USART1)
+#ifdef USART_ISR_RXNE
+#define BENCH_USART_STATUS              (bench_xUsartRegs.ISR.w)
+#define BENCH_USART_FLAG(NAME)          (USART_ISR_##NAME)
+#else
+#define BENCH_USART_STATUS              (bench_xUsartRegs.SR.w)
+#define BENCH_USART_FLAG(NAME)          (USART_SR_##NAME)
+#endif
+
+static USART_TypeDef bench_xUsartRegs;
+static USART_HandleType bench_xUsart;
+
+static void BENCH_prvUsartSetup(uint16_t usRxLength, uint16_t usTxLength, uint32_t ulCR1, uint32_t ulSR)
+{
+    bench_xUsart.Inst = &bench_xUsartRegs;
+#ifdef USART_BB
+    bench_xUsart.Inst_BB = BENCH_SHADOW_BB(USART_BitBand_TypeDef, bench_xUsartRegs);
+#endif
+    bench_xUsart.RxStream.buffer = bench_aulBuffer;
+    bench_xUsart.RxStream.length = usRxLength;
+    bench_xUsart.RxStream.size   = sizeof(uint8_t);
+    bench_xUsart.TxStream.buffer = bench_aulBuffer;
+    bench_xUsart.TxStream.length = usTxLength;
+    bench_xUsart.TxStream.size   = sizeof(uint8_t);
+
+    bench_xUsartRegs.CR1.w = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE | ulCR1;
+    BENCH_USART_STATUS = ulSR;
+}
+
+static void BENCH_prvUsartRxSetup(void)
+{
+    BENCH_prvUsartSetup(2, 0, USART_CR1_RXNEIE,
+            BENCH_USART_FLAG(RXNE) | BENCH_USART_FLAG(TXE) | BENCH_USART_FLAG(TC));
+}
+
+static void BENCH_prvUsartRxLastSetup(void)
+{
+    BENCH_prvUsartSetup(1, 0, USART_CR1_RXNEIE,
+            BENCH_USART_FLAG(RXNE) | BENCH_USART_FLAG(TXE) | BENCH_USART_FLAG(TC));
+}
+
+static void BENCH_prvUsartTxSetup(void)
+{
+    BENCH_prvUsartSetup(0, 2, USART_CR1_TXEIE, BENCH_USART_FLAG(TXE));
+}
+
+static void BENCH_prvUsartTcSetup(void)
+{
+    BENCH_prvUsartSetup(0, 0, USART_CR1_TCIE,
+            BENCH_USART_FLAG(TXE) | BENCH_USART_FLAG(TC));
+}
+
+static void BENCH_prvUsartIRQ(void)
+{
+    USART_vIRQHandler(&bench_xUsart);
+}
+#endif /* USART1 */
+
+/* SPI interrupt ------------------------------------------------------------*/
+#if defined(SPI1)
+static SPI_TypeDef bench_xSpiRegs;
+static SPI_HandleType bench_xSpi;
+
+static void BENCH_prvSpiSetup(uint16_t usRxLength, uint16_t usTxLength, uint32_t ulCR2, uint32_t ulSR)
+{
+    bench_xSpi.Inst = &bench_xSpiRegs;
+#ifdef SPI_BB
+    bench_xSpi.Inst_BB = BENCH_SHADOW_BB(SPI_BitBand_TypeDef, bench_xSpiRegs);
+#endif
+    bench_xSpi.RxStream.buffer = bench_aulBuffer;
+    bench_xSpi.RxStream.length = usRxLength;
+    bench_xSpi.RxStream.size   = sizeof(uint8_t);
+    bench_xSpi.TxStream.buffer = bench_aulBuffer;
+    bench_xSpi.TxStream.length = usTxLength;
+    bench_xSpi.TxStream.size   = sizeof(uint8_t);
+
+    bench_xSpiRegs.CR1.w = SPI_CR1_MSTR | SPI_CR1_SPE;
+    bench_xSpiRegs.CR2.w = ulCR2;
+    bench_xSpiRegs.SR.w  = ulSR;
+}
+
+static void BENCH_prvSpiRxSetup(void)
+{
+    BENCH_prvSpiSetup(2, 2, SPI_CR2_RXNEIE, SPI_SR_RXNE);
+}
+
+static void BENCH_prvSpiTxSetup(void)
+{
+    BENCH_prvSpiSetup(2, 2, SPI_CR2_TXEIE, SPI_SR_TXE);
+}
+
+static void BENCH_prvSpiIRQ(void)
+{
+    SPI_vIRQHandler(&bench_xSpi);
+}
+#endif /* SPI1 */
+
+/* DMA ----------------------------------------------------------------------*/
+#ifdef DMA_LISR_TCIF0
+static DMA_Stream_TypeDef bench_xDmaRegs;
+#else
+static DMA_Channel_TypeDef bench_xDmaRegs;
+#endif
+static DMA_TypeDef bench_xDmaBaseRegs;
+static DMA_HandleType bench_xDma;
+
+static void BENCH_prvDmaSetup(void)
+{
+    bench_xDma.Inst = &bench_xDmaRegs;
+    bench_xDma.Base = &bench_xDmaBaseRegs;
+#ifdef DMA_LISR_TCIF0
+#ifdef DMA_Stream_BB
+    bench_xDma.Inst_BB = BENCH_SHADOW_BB(DMA_Stream_BitBand_TypeDef, bench_xDmaRegs);
+#endif
+    bench_xDma.StreamOffset = 0;
+
+    bench_xDmaRegs.CR.w = DMA_SxCR_TCIE | DMA_SxCR_MINC;
+    bench_xDmaRegs.PAR  = (uint32_t)&bench_ulRegister;
+    bench_xDmaBaseRegs.LISR.w = DMA_LISR_TCIF0;
+#else
+#ifdef DMA_Channel_BB
+    bench_xDma.Inst_BB = BENCH_SHADOW_BB(DMA_Channel_BitBand_TypeDef, bench_xDmaRegs);
+#endif
+    bench_xDma.ChannelOffset = 0;
+
+    bench_xDmaRegs.CCR.w = DMA_CCR_TCIE | DMA_CCR_MINC;
+    bench_xDmaRegs.CPAR  = (uint32_t)&bench_ulRegister;
+    bench_xDmaBaseRegs.ISR.w = DMA_ISR_TCIF1;
+#endif
+}
+
+static void BENCH_prvDmaStart(void)
+{
+    (void) DMA_eStart(&bench_xDma, &bench_ulRegister, bench_aulBuffer, 16);
+}
+
+static void BENCH_prvDmaIRQ(void)
+{
+    DMA_vIRQHandler(&bench_xDma);
+}
+
+/* GPIO ---------------------------------------------------------------------*/
+static const GPIO_InitType bench_xGpioInput = {
+    .Mode = GPIO_MODE_INPUT,
+    .Pull = GPIO_PULL_DOWN,
+};
+
+static const GPIO_InitType bench_xGpioAnalog = {
+    .Mode = GPIO_MODE_ANALOG,
+    .Pull = GPIO_PULL_FLOAT,
+};
+
+static void BENCH_prvGpioInput(void)
+{
+    GPIO_vInitPin(XPD_BENCH_GPIO, XPD_BENCH_GPIO_PIN, &bench_xGpioInput);
+}
+
+static void BENCH_prvGpioAnalog(void)
+{
+    GPIO_vInitPin(XPD_BENCH_GPIO, XPD_BENCH_GPIO_PIN, &bench_xGpioAnalog);
+}
+
+/* RCC ----------------------------------------------------------------------*/
+static void BENCH_prvSysclk(void)
+{
+    bench_lResult = (int32_t)RCC_ulClockFreq_Hz(SYSCLK);
+}
+
+static void BENCH_prvHclk(void)
+{
+    bench_lResult = (int32_t)RCC_ulClockFreq_Hz(HCLK);
+}
+
+static void BENCH_prvPclk1(void)
+{
+    bench_lResult = (int32_t)RCC_ulClockFreq_Hz(PCLK1);
+}
+
+/* ADC calculations ---------------------------------------------------------*/
+static void BENCH_prvCalcVDDA(void)
+{
+    bench_lResult = ADC_lCalcVDDA_mV(1500);
+}
+
+static void BENCH_prvCalcExt(void)
+{
+    bench_lResult = ADC_lCalcExt_mV(2048);
+}
+
+static void BENCH_prvCalcTemp(void)
+{
+    bench_lResult = ADC_lCalcTemp_C(950);
+}
+
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+static void BENCH_prvCalcExtf(void)
+{
+    bench_fResult = ADC_fCalcExt_V(2048);
+}
+
+static void BENCH_prvCalcTempf(void)
+{
+    bench_fResult = ADC_fCalcTemp_C(950);
+}
+#endif
+
+/** @defgroup BENCH_Cases BENCH Cases
+ * @{ */
+
+/** @brief Benchmark cases of the public driver API */
+const BENCH_CaseType bench_axCases[] = {
+    BENCH_CASE("XPD_vReadToStream/8bit",        BENCH_prvStreamSetup8,      BENCH_prvReadToStream),
+    BENCH_CASE("XPD_vReadToStream/16bit",       BENCH_prvStreamSetup16,     BENCH_prvReadToStream),
+    BENCH_CASE("XPD_vReadToStream/32bit",       BENCH_prvStreamSetup32,     BENCH_prvReadToStream),
+#if defined(USART1)
+    BENCH_CASE("USART_vIRQHandler/RXNE",        BENCH_prvUsartRxSetup,      BENCH_prvUsartIRQ),
+    BENCH_CASE("USART_vIRQHandler/RXNE_last",   BENCH_prvUsartRxLastSetup,  BENCH_prvUsartIRQ),
+    BENCH_CASE("USART_vIRQHandler/TXE",         BENCH_prvUsartTxSetup,      BENCH_prvUsartIRQ),
+    BENCH_CASE("USART_vIRQHandler/TC",          BENCH_prvUsartTcSetup,      BENCH_prvUsartIRQ),
+#endif
+#if defined(SPI1)
+    BENCH_CASE("SPI_vIRQHandler/RXNE",          BENCH_prvSpiRxSetup,        BENCH_prvSpiIRQ),
+    BENCH_CASE("SPI_vIRQHandler/TXE",           BENCH_prvSpiTxSetup,        BENCH_prvSpiIRQ),
+#endif
+    BENCH_CASE("DMA_vIRQHandler/TC",            BENCH_prvDmaSetup,          BENCH_prvDmaIRQ),
+    BENCH_CASE("DMA_eStart",                    BENCH_prvDmaSetup,          BENCH_prvDmaStart),
+    BENCH_CASE("GPIO_vInitPin/input",           NULL,                       BENCH_prvGpioInput),
+    BENCH_CASE("GPIO_vInitPin/analog",          NULL,                       BENCH_prvGpioAnalog),
+    BENCH_CASE("RCC_ulClockFreq_Hz/SYSCLK",     NULL,                       BENCH_prvSysclk),
+    BENCH_CASE("RCC_ulClockFreq_Hz/HCLK",       NULL,                       BENCH_prvHclk),
+    BENCH_CASE("RCC_ulClockFreq_Hz/PCLK1",      NULL,                       BENCH_prvPclk1),
+    BENCH_CASE("ADC_lCalcVDDA_mV",              NULL,                       BENCH_prvCalcVDDA),
+    BENCH_CASE("ADC_lCalcExt_mV",               NULL,                       BENCH_prvCalcExt),
+    BENCH_CASE("ADC_lCalcTemp_C",               NULL,                       BENCH_prvCalcTemp),
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+    BENCH_CASE("ADC_fCalcExt_V",                NULL,                       BENCH_prvCalcExtf),
+    BENCH_CASE("ADC_fCalcTemp_C",               NULL,                       BENCH_prvCalcTempf),
+#endif
+};
+
+/** @brief Number of public driver API cases */
+const uint32_t bench_ulCaseCount = sizeof(bench_axCases) / sizeof(bench_axCases[0]);
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Compares XPD benchmark results against a baseline, and reports the regressions.
+#
+#   xpd_bench_compare.py <baseline> <current> [--threshold 5] [--metric min]
+#
+# Both arguments are either a JSON result file or a directory of them.
+# The results are matched by family, device, configuration and platform,
+# then by case name. The exit status is 1 when any case has regressed.
+
+import argparse
+import json
+import os
+import sys
+
+
+def load_results(path):
+    """Loads the result files, keyed by (family, device, config, platform)."""
+    if os.path.isdir(path):
+        files = sorted(os.path.join(path, name) for name in os.listdir(path)
+                       if name.endswith('.json'))
+    else:
+        files = [path]
+
+    results = {}
+    for name in files:
+        with open(name) as f:
+            data = json.load(f)
+        key = (data['family'], data['device'], data['config'], data['platform'])
+        results[key] = data
+    return results
+
+
+def compare(baseline, current, metric, threshold, min_delta):
+    """Prints the differences, and returns the number of regressions."""
+    regressions = 0
+
+    for key in sorted(set(baseline) | set(current)):
+        title = '/'.join(key)
+        if key not in current:
+            print('%s: missing from the current results' % title)
+            continue
+        if key not in baseline:
+            print('%s: no baseline' % title)
+            continue
+
+        old_cases = baseline[key]['results']
+        new_cases = current[key]['results']
+        unit = current[key].get('unit', '')
+        lines = []
+
+        for case in new_cases:
+            if case not in old_cases:
+                lines.append('  new         %-40s %8d %s' % (case, new_cases[case][metric], unit))
+                continue
+
+            old = old_cases[case][metric]
+            new = new_cases[case][metric]
+            delta = new - old
+            percent = (100.0 * delta / old) if old > 0 else (0.0 if delta == 0 else 100.0)
+
+            if abs(delta) < min_delta or abs(percent) < threshold:
+                continue
+
+            if delta > 0:
+                status = 'REGRESSION'
+                regressions += 1
+            else:
+                status = 'improved'
+            lines.append('  %-11s %-40s %8d -> %8d %s (%+.1f%%)'
+                         % (status, case, old, new, unit, percent))
+
+        for case in old_cases:
+            if case not in new_cases:
+                lines.append('  removed     %s' % case)
+
+        print('%s: %d cases, %s' % (title, len(new_cases),
+                                    'changed' if lines else 'no significant change'))
+        for line in lines:
+            print(line)
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare XPD benchmark results.')
+    parser.add_argument('baseline', help='baseline result file or directory')
+    parser.add_argument('current', help='current result file or directory')
+    parser.add_argument('--metric', choices=('min', 'mean', 'max'), default='min',
+                        help='compared statistic (default: min)')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='reported change in percent (default: 5)')
+    parser.add_argument('--min-delta', type=int, default=2,
+                        help='ignored absolute change in cycles or ticks (default: 2)')
+    args = parser.parse_args()
+
+    regressions = compare(load_results(args.baseline), load_results(args.current),
+                          args.metric, args.threshold, args.min_delta)
+    if regressions > 0:
+        print('%d regression(s) over %.1f%%' % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file    xpd_bench_private.c
+  * @author  Benedek Kupper
+  * @version 0.1
+  * @date    2018-01-28
+  * @brief   STM32 eXtensible Peripheral Drivers Benchmark Suite private function cases
+  *
+  * Copyright (c) 2018 Benedek Kupper
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+#include "xpd_bench.h"
+
+/* The CAN and USB driver sources are compiled as part of this file,
+ * so that their private functions can be measured directly.
+ * These driver sources must not be linked separately to the benchmark.
+ * The USB driver is only measured when XPD_BENCH_USB is defined,
+ * as it requires the xpd_usb_wrapper.h of the USB device library. */
+#include <xpd_can.c>
+#ifdef XPD_BENCH_USB
+#if defined(USB_OTG_FS)
+#include <xpd_usb_otg.c>
+#elif defined(USB)
+#include <xpd_usb.c>
+#endif
+#endif /* XPD_BENCH_USB */
+
+/** @addtogroup BENCH
+ * @{ */
+
+/* CAN ----------------------------------------------------------------------*/
+#if defined(CAN) || defined(CAN1)
+#ifdef CAN_BB
+#define BENCH_SHADOW_BB(TYPE, SHADOW)   ((TYPE *)SRAM_BB(&(SHADOW)))
+#endif
+
+static CAN_TypeDef bench_xCanRegs;
+static CAN_HandleType bench_xCan;
+static CAN_FrameType bench_xTxFrame, bench_xRxFrame;
+
+static void BENCH_prvCanSetup(void)
+{
+    bench_xCan.Inst = &bench_xCanRegs;
+#ifdef CAN_BB
+    bench_xCan.Inst_BB = BENCH_SHADOW_BB(CAN_BitBand_TypeDef, bench_xCanRegs);
+#endif
+    bench_xCan.RxFrame[0] = &bench_xRxFrame;
+
+    /* all mailboxes are empty, a standard frame is pending in FIFO 0 */
+    bench_xCanRegs.TSR.w = CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2;
+    bench_xCanRegs.RFR[0].w = 1 << CAN_RF0R_FMP0_Pos;
+    bench_xCanRegs.sFIFOMailBox[0].RIR.w  = 0x123 << 21;
+    bench_xCanRegs.sFIFOMailBox[0].RDTR.w = 8;
+    bench_xCanRegs.sFIFOMailBox[0].RDLR.w = 0x03020100;
+    bench_xCanRegs.sFIFOMailBox[0].RDHR.w = 0x07060504;
+}
+
+static void BENCH_prvCanStdSetup(void)
+{
+    BENCH_prvCanSetup();
+    bench_xTxFrame.Id.Value = 0x123;
+    bench_xTxFrame.Id.Type  = CAN_IDTYPE_STD_DATA;
+    bench_xTxFrame.DLC      = 8;
+}
+
+static void BENCH_prvCanExtSetup(void)
+{
+    BENCH_prvCanSetup();
+    bench_xTxFrame.Id.Value = 0x1234567;
+    bench_xTxFrame.Id.Type  = CAN_IDTYPE_EXT_DATA;
+    bench_xTxFrame.DLC      = 8;
+}
+
+static void BENCH_prvCanRxIRQSetup(void)
+{
+    BENCH_prvCanSetup();
+    bench_xCanRegs.IER.w = CAN_IER_FMPIE0;
+    bench_xCan.State = CAN_STATE_RECEIVE0;
+}
+
+static void BENCH_prvCanTxIRQSetup(void)
+{
+    BENCH_prvCanSetup();
+    bench_xCanRegs.TSR.w |= CAN_TSR_RQCP0 | CAN_TSR_TXOK0;
+    bench_xCanRegs.IER.w = CAN_IER_TMEIE;
+    bench_xCan.State = 1;
+}
+
+static void BENCH_prvCanTransmit(void)
+{
+    (void) CAN_prvFrameTransmit(&bench_xCan, &bench_xTxFrame);
+}
+
+static void BENCH_prvCanReceive(void)
+{
+    CAN_prvFrameReceive(&bench_xCan, 0);
+}
+
+static void BENCH_prvCanRxIRQ(void)
+{
+    CAN_vIRQHandlerRX0(&bench_xCan);
+}
+
+static void BENCH_prvCanTxIRQ(void)
+{
+    CAN_vIRQHandlerTX(&bench_xCan);
+}
+#endif /* CAN */
+
+/* USB ----------------------------------------------------------------------*/
+#ifdef XPD_BENCH_USB
+#if defined(USB_OTG_FS) || defined(USB)
+static uint32_t bench_aulPacket[16];
+#endif
+
+#if defined(USB_OTG_FS)
+static USB_HandleType bench_xUsb;
+
+static void BENCH_prvUsbSetup(void)
+{
+    USB_INST2HANDLE(&bench_xUsb, USB_OTG_FS);
+    RCC_vClockEnable(RCC_POS_OTG_FS);
+}
+
+static void BENCH_prvUsbWrite(void)
+{
+    USB_prvWriteFifo(&bench_xUsb, 1, (uint8_t *)bench_aulPacket, sizeof(bench_aulPacket));
+}
+#elif defined(USB)
+static void BENCH_prvUsbSetup(void)
+{
+    RCC_vClockEnable(RCC_POS_USB);
+}
+
+static void BENCH_prvUsbWrite(void)
+{
+    USB_prvWritePMA((uint8_t *)bench_aulPacket, 0x40, sizeof(bench_aulPacket));
+}
+#endif
+#endif /* XPD_BENCH_USB */
+
+/** @addtogroup BENCH_Cases
+ * @{ */
+
+#if defined(CAN) || defined(CAN1) || \
+   (defined(XPD_BENCH_USB) && (defined(USB_OTG_FS) || defined(USB)))
+/** @brief Benchmark cases of driver private functions and their interrupt handlers */
+const BENCH_CaseType bench_axPrivateCases[] = {
+#if defined(CAN) || defined(CAN1)
+    BENCH_CASE("CAN_prvFrameTransmit/std",      BENCH_prvCanStdSetup,       BENCH_prvCanTransmit),
+    BENCH_CASE("CAN_prvFrameTransmit/ext",      BENCH_prvCanExtSetup,       BENCH_prvCanTransmit),
+    BENCH_CASE("CAN_prvFrameReceive/std",       BENCH_prvCanSetup,          BENCH_prvCanReceive),
+    BENCH_CASE("CAN_vIRQHandlerRX0/FMP0",       BENCH_prvCanRxIRQSetup,     BENCH_prvCanRxIRQ),
+    BENCH_CASE("CAN_vIRQHandlerTX/TXOK0",       BENCH_prvCanTxIRQSetup,     BENCH_prvCanTxIRQ),
+#endif
+#ifdef XPD_BENCH_USB
+#if defined(USB_OTG_FS)
+    BENCH_CASE("USB_prvWriteFifo/64",           BENCH_prvUsbSetup,          BENCH_prvUsbWrite),
+#elif defined(USB)
+    BENCH_CASE("USB_prvWritePMA/64",            BENCH_prvUsbSetup,          BENCH_prvUsbWrite),
+#endif
+#endif /* XPD_BENCH_USB */
+};
+
+/** @brief Number of driver private function cases */
+const uint32_t bench_ulPrivateCaseCount = sizeof(bench_axPrivateCases) / sizeof(bench_axPrivateCases[0]);
+#else
+const BENCH_CaseType bench_axPrivateCases[1] = { BENCH_CASE(NULL, NULL, NULL) };
+const uint32_t bench_ulPrivateCaseCount = 0;
+#endif
+
+/** @} */
+
+/** @} */